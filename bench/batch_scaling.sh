@@ -0,0 +1,50 @@
+#!/bin/sh
+# Scaling of `Calculator --batch` across --threads 1..N.
+#
+#   bench/batch_scaling.sh CALCULATOR [SIZE_MB] [MAX_THREADS]
+#
+# Generates SIZE_MB (default 2048) of arithmetic lines once into
+# $TMPDIR/calc_batch_input.txt, then times each thread count and prints
+# wall-clock seconds, MB/s and the speed-up over one thread.
+
+set -eu
+
+CALCULATOR=${1:?usage: batch_scaling.sh CALCULATOR [SIZE_MB] [MAX_THREADS]}
+SIZE_MB=${2:-2048}
+MAX_THREADS=${3:-$(getconf _NPROCESSORS_ONLN 2>/dev/null || echo 1)}
+INPUT=${TMPDIR:-/tmp}/calc_batch_input.txt
+
+if [ ! -f "$INPUT" ] || [ "$(wc -c < "$INPUT")" -lt $((SIZE_MB * 1048576)) ]; then
+    echo "Generating ${SIZE_MB} MB of input in $INPUT" >&2
+    awk -v bytes=$((SIZE_MB * 1048576)) 'BEGIN {
+        srand(42)
+        while (written < bytes) {
+            line = sprintf("(%d.%d + %d) * %d / (%d - %d.5) ^ 2",
+                rand() * 1e4, rand() * 100, rand() * 1e3, rand() * 50 + 1,
+                rand() * 90 + 10, rand() * 9)
+            print line
+            written += length(line) + 1
+        }
+    }' > "$INPUT"
+fi
+
+now() { date +%s.%N; }
+
+printf '%8s %10s %10s %8s\n' threads seconds MB/s speedup
+base=""
+threads=1
+while [ "$threads" -le "$MAX_THREADS" ]; do
+    start=$(now)
+    "$CALCULATOR" --batch "$INPUT" --threads "$threads" > /dev/null
+    end=$(now)
+
+    awk -v s="$start" -v e="$end" -v mb="$SIZE_MB" -v t="$threads" -v b="${base:-0}" 'BEGIN {
+        sec = e - s
+        printf "%8d %10.2f %10.1f %8.2f\n", t, sec, mb / sec, (b > 0 ? b / sec : 1)
+    }'
+
+    if [ -z "$base" ]; then
+        base=$(awk -v s="$start" -v e="$end" 'BEGIN { print e - s }')
+    fi
+    threads=$((threads * 2))
+done
@@ -0,0 +1,423 @@
+#include "engine/batch.h"
+#include "engine/big_decimal.h"
+#include "engine/big_integer.h"
+#include "engine/calculator.h"
+#include "engine/column_evaluator.h"
+#include "engine/direct_evaluator.h"
+#include "engine/expression.h"
+#include "engine/instrumentation.h"
+#include "engine/number_entry.h"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <utility>
+#include <vector>
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                        ⏱️ МИКРОБЕНЧМАРКИ CALC_CORE                        ║
+ ║       Google Benchmark: разбор, вычисление, форматирование, длинная       ║
+ ║       арифметика и пакетный режим; без окна и без wxWidgets               ║
+ ║                                                                           ║
+ ║  📊 Запуск:                                                               ║
+ ║   • calc_bench --benchmark_out=current.json --benchmark_out_format=json   ║
+ ║   • Цель calc_bench_check сравнивает лучшие из повторов (агрегат min)     ║
+ ║     с bench/baseline.json через bench/compare.py и падает при             ║
+ ║     замедлении больше чем на 5%                                           ║
+ ║   • Имена бенчмарков — ключи сравнения: не переименовывать без            ║
+ ║     обновления базовой линии (цель calc_bench_baseline)                   ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+
+namespace
+{
+
+constexpr std::size_t COLUMN_ROWS = 1 << 16;
+constexpr std::size_t BATCH_BYTES = 4 << 20;
+
+struct Formula
+{
+    const char* name;
+    const char* text;
+};
+
+const Formula FORMULAS[] = {
+    { "constant",  "2 + 3 * 4 - (10 / 4) ^ 2" },
+    { "interest",  "principal * (1 + rate / 12) ^ months - fee" },
+    { "cse",       "(a + b) * (a + b) + (a + b) / (b + a) - a * b" },
+    { "long",      "x*x*x - 3*x*x + 2*x - 7 + x/3 - x/5 + x*x/7 - 11*x + 13" },
+    { "functions", "sqrt(x) * sin(x) + exp(-x) - ln(1 + x)" },
+};
+
+const calc::SimdLevel SIMD_LEVELS[] = { calc::SimdLevel::Scalar, calc::SimdLevel::Sse2, calc::SimdLevel::Avx2 };
+
+std::vector<double> MakeColumn(std::size_t rows)
+{
+    std::vector<double> column(rows);
+    for (std::size_t row = 0; row < rows; ++row)
+    {
+        column[row] = 1.0 + (row & 1023) * 0.001;
+    }
+    return column;
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 📝 Разбор и вычисление
+//──────────────────────────────────────────────────────────────────────────────
+
+void BenchCompile(benchmark::State& state, const Formula& formula)
+{
+    calc::Expression expression;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(expression.Compile(formula.text));
+    }
+}
+
+void BenchDirect(benchmark::State& state, const Formula& formula)
+{
+    // Разбор со счётом на лету — путь вставки из буфера обмена
+    calc::DirectEvaluator evaluator;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(evaluator.Evaluate(formula.text));
+    }
+}
+
+void BenchEvaluate(benchmark::State& state, const Formula& formula)
+{
+    calc::Expression expression;
+    if (expression.Compile(formula.text) != calc::CalcError::None)
+    {
+        state.SkipWithError("compile error");
+        return;
+    }
+
+    const std::size_t variableCount = expression.GetProgram().GetVariableCount();
+    std::vector<double> variables(variableCount == 0 ? 1 : variableCount, 1.0);
+
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        variables[0] = 1.0 + (i++ & 1023) * 0.001;
+        benchmark::DoNotOptimize(expression.Evaluate(variables.data()));
+    }
+    state.counters["instructions"] = static_cast<double>(expression.GetProgram().code.size());
+}
+
+void BenchColumns(benchmark::State& state, const Formula& formula, calc::SimdLevel level)
+{
+    calc::Expression expression;
+    if (expression.Compile(formula.text) != calc::CalcError::None)
+    {
+        state.SkipWithError("compile error");
+        return;
+    }
+
+    const calc::Program& program = expression.GetProgram();
+    const std::size_t variableCount = program.GetVariableCount();
+
+    std::vector<std::vector<double>> columns(variableCount, MakeColumn(COLUMN_ROWS));
+    std::vector<const double*> columnPointers;
+    for (const std::vector<double>& column : columns)
+    {
+        columnPointers.push_back(column.data());
+    }
+    std::vector<double> output(COLUMN_ROWS);
+
+    calc::ColumnEvaluator evaluator;
+    evaluator.SetSimdLevel(level);
+    evaluator.Load(program);
+
+    for (auto _ : state)
+    {
+        evaluator.Evaluate(columnPointers.data(), COLUMN_ROWS, output.data());
+        benchmark::DoNotOptimize(output.data());
+    }
+
+    const auto rows = static_cast<std::int64_t>(state.iterations() * COLUMN_ROWS);
+    state.SetItemsProcessed(rows);
+    state.SetBytesProcessed(rows * static_cast<std::int64_t>((variableCount + 1) * sizeof(double)));
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🖨️ Форматирование
+//──────────────────────────────────────────────────────────────────────────────
+
+void BenchFormat(benchmark::State& state, calc::NumberFormat format)
+{
+    const double values[] = { 0.1 + 0.2, 1.0 / 3.0, 6.02214076e23, -1234.5, 1e-300, 42.0, 2.718281828459045 };
+    char buffer[64];
+
+    std::size_t i = 0;
+    for (auto _ : state)
+    {
+        const double value = values[i++ % (sizeof(values) / sizeof(values[0]))];
+        benchmark::DoNotOptimize(calc::Calculator::FormatNumber(value, buffer, sizeof(buffer), format));
+    }
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// ⌨️ Ввод числа
+//──────────────────────────────────────────────────────────────────────────────
+
+void BenchEntry(benchmark::State& state)
+{
+    // Набор, правка и показ числа — то, что происходит на каждое нажатие клавиши
+    calc::NumberEntry entry;
+    char buffer[calc::NumberEntry::MAX_TEXT_LENGTH];
+
+    const std::uint64_t allocationsBefore = calc::GetThreadAllocationCount();
+    for (auto _ : state)
+    {
+        entry.Clear();
+        for (const char digit : std::string_view("31415926"))
+        {
+            entry.AppendDigit(digit);
+        }
+        entry.AppendDecimalPoint();
+        entry.AppendDigit('5');
+        entry.BeginExponent();
+        entry.AppendDigit('7');
+        entry.ToggleExponentSign();
+        entry.Backspace();
+        benchmark::DoNotOptimize(entry.Format(buffer, sizeof(buffer)));
+    }
+    const std::uint64_t allocations = calc::GetThreadAllocationCount() - allocationsBefore;
+
+    // С CALC_INSTRUMENTATION выделения считаются: ввод обязан обходиться без кучи
+    if (calc::INSTRUMENTATION_ENABLED)
+    {
+        state.counters["allocations"] = static_cast<double>(allocations);
+        if (allocations != 0)
+        {
+            state.SkipWithError("number entry allocated memory");
+        }
+    }
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 💰 Длинная арифметика
+//──────────────────────────────────────────────────────────────────────────────
+
+void BenchDecimal(benchmark::State& state, calc::Operator op)
+{
+    // Операнды на всю точность: худший случай для выравнивания и округления
+    const auto precision = static_cast<std::uint32_t>(state.range(0));
+    std::string digits(precision, '7');
+    digits[0] = '3';
+
+    calc::BigDecimal a;
+    calc::BigDecimal b;
+    a.Parse("1." + digits, precision);
+    b.Parse("2." + digits + "e-3", precision);
+
+    calc::BigDecimal result;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(calc::BigDecimal::Apply(op, a, b, result, precision));
+    }
+}
+
+void BenchDecimalSqrt(benchmark::State& state)
+{
+    const auto precision = static_cast<std::uint32_t>(state.range(0));
+    calc::BigDecimal a;
+    a.Parse("2", precision);
+
+    calc::BigDecimal result;
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(calc::BigDecimal::SquareRoot(a, result, precision));
+    }
+}
+
+calc::BigInteger MakeFactorial(std::int64_t n)
+{
+    calc::BigInteger argument;
+    argument.SetInteger(n);
+
+    calc::BigInteger factorial;
+    calc::BigInteger::Factorial(argument, factorial);
+    return factorial;
+}
+
+void BenchIntegerFactorial(benchmark::State& state)
+{
+    calc::BigInteger argument;
+    argument.SetInteger(state.range(0));
+
+    calc::BigInteger factorial;
+    for (auto _ : state)
+    {
+        calc::BigInteger::Factorial(argument, factorial);
+    }
+}
+
+void BenchIntegerSquare(benchmark::State& state)
+{
+    const calc::BigInteger factorial = MakeFactorial(state.range(0));
+
+    calc::BigInteger square;
+    for (auto _ : state)
+    {
+        calc::BigInteger::Multiply(factorial, factorial, square);
+    }
+}
+
+void BenchIntegerToDecimal(benchmark::State& state)
+{
+    const calc::BigInteger factorial = MakeFactorial(state.range(0));
+
+    std::size_t digits = 0;
+    for (auto _ : state)
+    {
+        digits = 0;
+        factorial.WriteDecimal([&digits](std::string_view chunk)
+        {
+            digits += chunk.size();
+            return true;
+        });
+    }
+    state.counters["digits"] = static_cast<double>(digits);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 📦 Пакетный режим
+//──────────────────────────────────────────────────────────────────────────────
+
+std::string MakeBatchInput(std::size_t bytes)
+{
+    // Те же строки, что у bench/batch_scaling.sh, но с фиксированной последовательностью
+    std::string input;
+    input.reserve(bytes + 64);
+    unsigned seed = 42;
+    char line[96];
+    while (input.size() < bytes)
+    {
+        seed = seed * 1103515245u + 12345u;
+        const unsigned r = seed >> 8;
+        const int length = std::snprintf(line, sizeof(line), "(%u.%u + %u) * %u / (%u - %u.5) ^ 2\n",
+            r % 10000, r % 100, r % 1000, r % 50 + 1, r % 90 + 10, r % 9);
+        input.append(line, static_cast<std::size_t>(length));
+    }
+    return input;
+}
+
+void BenchBatch(benchmark::State& state)
+{
+    static const std::string input = MakeBatchInput(BATCH_BYTES);
+
+#ifdef _WIN32
+    std::FILE* sink = std::fopen("NUL", "wb");
+#else
+    std::FILE* sink = std::fopen("/dev/null", "wb");
+#endif
+    if (!sink)
+    {
+        state.SkipWithError("cannot open the null device");
+        return;
+    }
+
+    const auto threads = static_cast<unsigned>(state.range(0));
+    for (auto _ : state)
+    {
+        calc::BatchRunner runner(sink, threads);
+        benchmark::DoNotOptimize(runner.ProcessBuffer(input));
+    }
+    std::fclose(sink);
+
+    state.SetBytesProcessed(static_cast<std::int64_t>(state.iterations() * input.size()));
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🗂️ Регистрация
+//──────────────────────────────────────────────────────────────────────────────
+
+double Minimum(const std::vector<double>& values)
+{
+    return *std::min_element(values.begin(), values.end());
+}
+
+/// Регистрация с агрегатом "min": лучший из повторов меньше всех зависит от соседей по машине
+template<typename... Args>
+benchmark::internal::Benchmark* Register(const std::string& name, Args&&... args)
+{
+    return benchmark::RegisterBenchmark(name.c_str(), std::forward<Args>(args)...)
+        ->ComputeStatistics("min", Minimum);
+}
+
+void RegisterBenchmarks()
+{
+    for (const Formula& formula : FORMULAS)
+    {
+        const std::string name = formula.name;
+        Register("Compile/" + name, BenchCompile, formula);
+        Register("Direct/" + name, BenchDirect, formula);
+        Register("Evaluate/" + name, BenchEvaluate, formula);
+
+        for (const calc::SimdLevel level : SIMD_LEVELS)
+        {
+            if (level > calc::ColumnEvaluator::DetectSimdLevel())
+            {
+                break;
+            }
+            Register("Columns/" + name + "/" + calc::ColumnEvaluator::SimdLevelName(level),
+                BenchColumns, formula, level);
+        }
+    }
+
+    Register("Format/compact", BenchFormat, calc::NumberFormat::Compact);
+    Register("Format/full", BenchFormat, calc::NumberFormat::Full);
+    Register("Entry/keystrokes", BenchEntry);
+
+    const std::int64_t precisions[] = { calc::BigDecimal::DEFAULT_PRECISION, 1000 };
+    const std::pair<const char*, calc::Operator> decimalOperators[] = {
+        { "Decimal/add", calc::Operator::Add },
+        { "Decimal/multiply", calc::Operator::Multiply },
+        { "Decimal/divide", calc::Operator::Divide },
+    };
+    for (const auto& [name, op] : decimalOperators)
+    {
+        benchmark::internal::Benchmark* bench = Register(name, BenchDecimal, op);
+        for (const std::int64_t precision : precisions)
+        {
+            bench->Arg(precision);
+        }
+    }
+    benchmark::internal::Benchmark* sqrt = Register("Decimal/sqrt", BenchDecimalSqrt);
+    for (const std::int64_t precision : precisions)
+    {
+        sqrt->Arg(precision);
+    }
+
+    for (benchmark::internal::Benchmark* bench : {
+        Register("Integer/factorial", BenchIntegerFactorial),
+        Register("Integer/square", BenchIntegerSquare),
+        Register("Integer/to_decimal", BenchIntegerToDecimal) })
+    {
+        bench->Arg(1000)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond);
+    }
+
+    Register("Batch/threads", BenchBatch)
+        ->Arg(1)->Arg(2)->Arg(4)->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return 1;
+    }
+
+    RegisterBenchmarks();
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
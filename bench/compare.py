@@ -0,0 +1,109 @@
+#!/usr/bin/env python3
+"""Compare two calc_bench JSON reports and fail on slowdowns.
+
+    bench/compare.py BASELINE CURRENT [--threshold 0.05] [--metric auto]
+
+BASELINE and CURRENT are files written by
+`calc_bench --benchmark_out=FILE --benchmark_out_format=json`. When a report
+holds repetitions, the "min" aggregate (best of the repetitions, the least
+disturbed by other load) is compared, then the median, then the single run.
+The default metric is CPU time, except for benchmarks measured in real time
+(multithreaded ones, named ".../real_time").
+
+Prints one line per benchmark and exits with 1 if any benchmark is slower
+than the baseline by more than the threshold (0.05 = 5%), with 2 on
+unreadable input. Benchmarks present in only one report are listed but do
+not fail the comparison.
+"""
+
+import argparse
+import json
+import sys
+
+NS_PER_UNIT = {"ns": 1.0, "us": 1e3, "ms": 1e6, "s": 1e9}
+AGGREGATE_PREFERENCE = ("min", "median")
+
+
+def load(path, metric):
+    """Benchmark name -> time in nanoseconds (best aggregate when repeated)."""
+    with open(path, encoding="utf-8") as file:
+        report = json.load(file)
+
+    aggregates = {}
+    runs = {}
+    for bench in report.get("benchmarks", []):
+        if bench.get("error_occurred"):
+            continue
+        name = bench.get("run_name", bench["name"])
+        field = metric
+        if field == "auto":
+            field = "real_time" if name.endswith("/real_time") else "cpu_time"
+        value = bench[field] * NS_PER_UNIT[bench.get("time_unit", "ns")]
+
+        if bench.get("run_type") != "aggregate":
+            runs.setdefault(name, value)
+            continue
+        aggregate = bench.get("aggregate_name")
+        if aggregate in AGGREGATE_PREFERENCE:
+            rank = AGGREGATE_PREFERENCE.index(aggregate)
+            if name not in aggregates or rank < aggregates[name][0]:
+                aggregates[name] = (rank, value)
+
+    runs.update({name: value for name, (_, value) in aggregates.items()})
+    return runs
+
+
+def format_time(ns):
+    for unit in ("s", "ms", "us"):
+        if ns >= NS_PER_UNIT[unit]:
+            return "%.3f %s" % (ns / NS_PER_UNIT[unit], unit)
+    return "%.2f ns" % ns
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Fail on calc_bench regressions.")
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=0.05,
+                        help="allowed slowdown as a fraction (default 0.05)")
+    parser.add_argument("--metric", choices=("auto", "real_time", "cpu_time"), default="auto")
+    args = parser.parse_args()
+
+    try:
+        baseline = load(args.baseline, args.metric)
+        current = load(args.current, args.metric)
+    except (OSError, ValueError, KeyError) as error:
+        print("compare.py: %s" % error, file=sys.stderr)
+        return 2
+
+    width = max((len(name) for name in baseline.keys() | current.keys()), default=10)
+    regressions = []
+    for name in sorted(baseline.keys() | current.keys()):
+        if name not in current:
+            print("%-*s  %12s  %12s  missing" % (width, name, format_time(baseline[name]), "-"))
+            continue
+        if name not in baseline:
+            print("%-*s  %12s  %12s  new" % (width, name, "-", format_time(current[name])))
+            continue
+
+        change = current[name] / baseline[name] - 1.0
+        slower = change > args.threshold
+        if slower:
+            regressions.append(name)
+        print("%-*s  %12s  %12s  %+7.1f%%%s" % (width, name, format_time(baseline[name]),
+                                               format_time(current[name]), change * 100,
+                                               "  REGRESSION" if slower else ""))
+
+    if regressions:
+        print("\n%d benchmark(s) slower than the baseline by more than %.0f%%:"
+              % (len(regressions), args.threshold * 100))
+        for name in regressions:
+            print("  " + name)
+        return 1
+
+    print("\nNo regressions above %.0f%%." % (args.threshold * 100))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
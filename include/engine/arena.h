@@ -0,0 +1,75 @@
+﻿#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                          🧱 ЛИНЕЙНЫЙ АЛЛОКАТОР                            ║
+ ║        Блочная арена для узлов AST: выделение сдвигом указателя,         ║
+ ║             освобождение всего сразу через Reset() / деструктор          ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class Arena
+{
+public:
+    //──────────────────────────────────────────────────────────────────────────
+    // 🏗️ Конструктор и деструктор
+    //──────────────────────────────────────────────────────────────────────────
+
+    explicit Arena(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+    ~Arena() = default;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🚫 Запрет копирования, ↔️ разрешение перемещения
+    //──────────────────────────────────────────────────────────────────────────
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+    Arena(Arena&&) noexcept = default;
+    Arena& operator=(Arena&&) noexcept = default;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🎮 Выделение памяти
+    //──────────────────────────────────────────────────────────────────────────
+
+    void* Allocate(std::size_t size, std::size_t alignment);   // 📦 Сырой блок памяти
+    void Reset();                                            // 🔄 Сброс без возврата блоков ОС
+    std::size_t GetBytesUsed() const;                        // 📊 Занято байт
+
+    /// 🏭 Создание объекта в арене (только тривиально разрушаемые типы)
+    template<typename T, typename... Args>
+    T* Make(Args&&... args)
+    {
+        static_assert(std::is_trivially_destructible_v<T>,
+            "Arena never runs destructors");
+        void* memory = Allocate(sizeof(T), alignof(T));
+        return new (memory) T{ std::forward<Args>(args)... };
+    }
+
+private:
+    struct Block
+    {
+        std::unique_ptr<std::byte[]> data;  // 💾 Память блока
+        std::size_t size = 0;               // 📏 Размер блока
+    };
+
+    static constexpr std::size_t DEFAULT_BLOCK_SIZE = 16 * 1024; // 📏 Размер блока по умолчанию
+
+    std::vector<Block> m_blocks;    // 🧱 Выделенные блоки
+    std::size_t m_blockSize;        // 📏 Размер новых блоков
+    std::size_t m_current;          // 👉 Индекс текущего блока
+    std::size_t m_offset;           // 📍 Смещение в текущем блоке
+};
+
+} // namespace calc
+
+#endif // ARENA_H
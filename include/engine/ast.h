@@ -0,0 +1,39 @@
+﻿#ifndef AST_H
+#define AST_H
+
+#include "engine/types.h"
+
+#include <cstdint>
+#include <string_view>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                       🌳 АБСТРАКТНОЕ СИНТАКСИЧЕСКОЕ ДЕРЕВО                ║
+ ║      Узлы размещаются в Arena и живут до её сброса или уничтожения        ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+enum class NodeKind : std::uint8_t
+{
+    Number,   // 🔢 Константа
+    Variable, // 🏷️ Переменная
+    Negate,   // ➖ Унарный минус
+    Binary,   // ➕ Бинарная операция
+    Call      // 🧮 Функция от lhs (op — функция реестра)
+};
+
+struct Node
+{
+    NodeKind kind = NodeKind::Number;   // 🏷️ Тип узла
+    Operator op = Operator::None;       // ➕ Оператор (для Binary) или функция (для Call)
+    double value = 0.0;                 // 🔢 Значение (для Number)
+    std::string_view name;              // 🏷️ Имя (для Variable, ссылается на исходный текст)
+    const Node* lhs = nullptr;          // ⬅️ Левый операнд / аргумент
+    const Node* rhs = nullptr;          // ➡️ Правый операнд
+};
+
+} // namespace calc
+
+#endif // AST_H
@@ -0,0 +1,150 @@
+﻿#ifndef BATCH_H
+#define BATCH_H
+
+#include "engine/big_decimal.h"
+#include "engine/big_integer.h"
+#include "engine/decimal_evaluator.h"
+#include "engine/direct_evaluator.h"
+#include "engine/integer_evaluator.h"
+#include "engine/result_cache.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace calc
+{
+
+class ThreadPool;
+
+struct BatchOptions
+{
+    bool enabled = false;       // 📦 Запуск в пакетном режиме (--batch)
+    std::string inputPath;      // 📄 Входной файл (пусто или "-" — stdin)
+    unsigned threads = 1;       // 🧵 Рабочие потоки (--threads N, 0 — по числу ядер)
+    NumberFormat format = NumberFormat::Compact;  // 📐 --full-precision: точная запись
+    NumberMode mode = NumberMode::Binary;         // 💰 --decimal / --integer: BigDecimal / BigInteger
+    std::uint32_t precision = BigDecimal::DEFAULT_PRECISION;  // 🎯 --precision N: цифр в --decimal
+    std::string cachePath;      // 💾 --result-cache FILE: кеш --decimal/--integer между запусками
+    std::string invalidArgument; // ❌ Первый нераспознанный аргумент или значение (Run: код 2)
+};
+
+/// 🧮 Вычислители одного потока: двоичный, десятичный и целый
+struct BatchEvaluators
+{
+    DirectEvaluator direct;     // ⚡ double
+    DecimalEvaluator decimal;   // 💰 BigDecimal
+    BigDecimal result;          // 💾 Буфер десятичного результата
+    IntegerEvaluator integer;   // 🔢 BigInteger
+    BigInteger integerResult;   // 💾 Буфер целого результата
+    ResultCache* cache = nullptr; // 💾 Общий кеш потоков (nullptr — без кеша)
+    std::string cacheKey;       // 🔑 Ключ строки
+    CachedResult cached;        // 💾 Буфер найденного результата
+};
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                          📦 ПАКЕТНЫЙ РЕЖИМ                                ║
+ ║     Calculator --batch [FILE] [--threads N] [--full-precision]            ║
+ ║                           [--decimal [--precision N] | --integer]         ║
+ ║                           [--result-cache FILE]                           ║
+ ║                                                                           ║
+ ║  📊 Особенности:                                                          ║
+ ║   • GUI не инициализируется                                               ║
+ ║   • Файл отображается в память, stdin читается крупными блоками           ║
+ ║   • Вход режется на куски по границам строк                               ║
+ ║   • Куски считаются в пуле с кражей задач, вывод — строго по порядку      ║
+ ║   • В работе не больше WINDOW_PER_THREAD кусков на поток                  ║
+ ║   • Ошибки выводятся в строке результата: "Error: <сообщение>"            ║
+ ║   • --integer: цифры пишутся в вывод куска прямо из перевода основания    ║
+ ║   • --result-cache: повторы --decimal/--integer берутся из ResultCache,   ║
+ ║     файл читается до прогона и пишется после                              ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class BatchRunner
+{
+public:
+    BatchRunner(std::FILE* output, unsigned threads = 1,
+        NumberFormat format = NumberFormat::Compact);
+    BatchRunner(std::FILE* output, const BatchOptions& options);
+    ~BatchRunner();
+
+    BatchRunner(const BatchRunner&) = delete;
+    BatchRunner& operator=(const BatchRunner&) = delete;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🎮 Точки входа
+    //──────────────────────────────────────────────────────────────────────────
+
+    /// 🔍 Разбор командной строки; true — нужно запускать пакетный режим
+    ///    (с неверным аргументом тоже: Run печатает подсказку и возвращает 2)
+    static bool ParseArguments(int argc, char** argv, BatchOptions& options);
+
+    /// ▶️ Полный прогон по опциям, возвращает код завершения процесса
+    static int Run(const BatchOptions& options);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // ⚙️ Обработка
+    //──────────────────────────────────────────────────────────────────────────
+
+    bool ProcessStream(std::FILE* input);           // 📥 Поток (stdin, каналы)
+    bool ProcessBuffer(std::string_view data);      // 🗺️ Данные целиком в памяти (mmap)
+
+    std::uint64_t GetLineCount() const { return m_lineCount; }
+    std::uint64_t GetErrorCount() const { return m_errorCount; }
+
+    /// 💾 Кеш десятичного и целого режимов для всех потоков (владеет вызывающий)
+    void SetResultCache(ResultCache* cache);
+
+    /// 📝 Вычисление всех строк куска с дописыванием результатов в output
+    static void EvaluateLines(BatchEvaluators& evaluators, std::string_view lines, NumberFormat format,
+        NumberMode mode, std::string& output, std::uint64_t& lineCount, std::uint64_t& errorCount);
+
+private:
+    struct Chunk
+    {
+        std::vector<char> storage;          // 💾 Владение данными (для потокового входа)
+        std::string_view input;             // 📥 Строки куска
+        std::string output;                 // 📤 Результаты куска
+        std::uint64_t lineCount = 0;        // 📊 Строк в куске
+        std::uint64_t errorCount = 0;       // 📊 Ошибок в куске
+        bool done = false;                  // ✅ Готов (под m_doneMutex)
+    };
+
+    bool NextStreamChunk(std::FILE* input, Chunk& chunk);      // 📥 Следующий кусок из потока
+    bool NextBufferChunk(std::string_view& rest, Chunk& chunk); // 🗺️ Следующий кусок из памяти
+    template<typename NextChunk>
+    bool ProcessChunks(NextChunk&& next);                      // 🔁 Общий конвейер
+    void Dispatch(Chunk& chunk);                               // 🧵 Вычисление куска (в пуле или сразу)
+    bool WriteChunk(Chunk& chunk);                             // ✍️ Вывод готового куска
+
+    static constexpr std::size_t CHUNK_SIZE = 4 << 20;          // 📏 4 МиБ на кусок
+    static constexpr std::size_t WINDOW_PER_THREAD = 4;         // 🪟 Кусков в работе на поток
+
+    std::FILE* m_output;                        // 📤 Поток результатов
+    std::unique_ptr<ThreadPool> m_pool;         // 🧵 Пул (nullptr — однопоточный режим)
+    std::size_t m_window;                       // 🪟 Максимум кусков в работе
+    NumberFormat m_format;                      // 📐 Формат результатов
+    NumberMode m_mode;                          // 💰 Двоичный или десятичный счёт
+    std::uint32_t m_precision;                  // 🎯 Цифр в десятичном режиме
+    BatchEvaluators m_evaluators;               // ⚡ Вычислители для однопоточного режима
+    std::vector<char> m_carry;                  // ↩️ Хвост незавершённой строки потока
+    bool m_streamEnded;                         // 🏁 Поток дочитан
+    bool m_readFailed;                          // ❌ Ошибка чтения
+    bool m_writeFailed;                         // ❌ Ошибка записи
+    std::mutex m_doneMutex;                     // 🔒 Готовность кусков
+    std::condition_variable m_doneSignal;       // 🔔 Кусок готов
+    std::uint64_t m_lineCount;                  // 📊 Обработано строк
+    std::uint64_t m_errorCount;                 // 📊 Строк с ошибками
+    ResultCache* m_cache;                       // 💾 Кеш результатов (nullptr — без кеша)
+};
+
+} // namespace calc
+
+#endif // BATCH_H
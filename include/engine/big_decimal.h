@@ -0,0 +1,98 @@
+﻿#ifndef BIG_DECIMAL_H
+#define BIG_DECIMAL_H
+
+#include "engine/types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                     💰 ДЕСЯТИЧНОЕ ЧИСЛО ПРОИЗВОЛЬНОЙ ТОЧНОСТИ             ║
+ ║              значение = ±коэффициент × 10^exponent                        ║
+ ║                                                                           ║
+ ║  📊 Устройство:                                                           ║
+ ║   • Коэффициент — лимбы по основанию 10^9 (младший первый)                ║
+ ║   • Каждая операция округляет до precision значащих цифр                  ║
+ ║     (половина — к чётному, как в IEEE 754 decimal)                        ║
+ ║   • Умножение: школьное, Карацуба от KARATSUBA_THRESHOLD лимбов           ║
+ ║   • Деление: алгоритм D Кнута, обратная величина Ньютоном                 ║
+ ║     от NEWTON_THRESHOLD лимбов делителя                                   ║
+ ║   • Результаты пишутся в out — буферы переиспользуются без аллокаций      ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class BigDecimal
+{
+public:
+    using Limb = std::uint32_t;
+
+    static constexpr Limb BASE = 1000000000;                 // 🔢 10^9
+    static constexpr unsigned BASE_DIGITS = 9;               // 🔢 Цифр в лимбе
+    static constexpr std::uint32_t DEFAULT_PRECISION = 34;   // 🎯 Как decimal128
+    static constexpr std::uint32_t MAX_PRECISION = 100000;   // 🎯 Верхняя граница настройки
+    static constexpr std::int64_t MAX_EXPONENT = 999999999;  // 📏 Предел порядка (переполнение)
+    static constexpr std::size_t KARATSUBA_THRESHOLD = 32;   // ✖️ Лимбов для Карацубы
+    static constexpr std::size_t NEWTON_THRESHOLD = 4096;    // ➗ Лимбов делителя для Ньютона
+
+    BigDecimal() = default;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🔄 Преобразования
+    //──────────────────────────────────────────────────────────────────────────
+
+    /// 📥 Разбор "[-]цифры[.цифры][e[±]цифры]" с округлением до precision
+    bool Parse(std::string_view text, std::uint32_t precision);
+
+    void SetDouble(double value, std::uint32_t precision);  // 📥 Через кратчайшую запись double
+    void SetInteger(std::int64_t value);                    // 📥 Точное целое
+    double ToDouble() const;                                // 📤 Ближайшее double
+
+    /// 📝 Запись без лишних нулей: обычная или научная (как "%g")
+    std::string ToString() const;
+    void AppendTo(std::string& out) const;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // ⚡ Арифметика (out может совпадать с операндом)
+    //──────────────────────────────────────────────────────────────────────────
+
+    static CalcError Add(const BigDecimal& a, const BigDecimal& b, BigDecimal& out, std::uint32_t precision);
+    static CalcError Subtract(const BigDecimal& a, const BigDecimal& b, BigDecimal& out, std::uint32_t precision);
+    static CalcError Multiply(const BigDecimal& a, const BigDecimal& b, BigDecimal& out, std::uint32_t precision);
+    static CalcError Divide(const BigDecimal& a, const BigDecimal& b, BigDecimal& out, std::uint32_t precision);
+    static CalcError Power(const BigDecimal& a, const BigDecimal& b, BigDecimal& out, std::uint32_t precision);
+
+    /// ⚡ Применение оператора калькулятора
+    static CalcError Apply(Operator op, const BigDecimal& a, const BigDecimal& b, BigDecimal& out,
+        std::uint32_t precision);
+
+    /// √ Корень, правильно округлённый до precision (Ньютон, выбор соседа — по точному остатку)
+    static CalcError SquareRoot(const BigDecimal& a, BigDecimal& out, std::uint32_t precision);
+
+    /// 🧮 Функция реестра: √ — точно, остальные — через double (как дробная степень)
+    static CalcError Function(Operator op, const BigDecimal& a, BigDecimal& out, std::uint32_t precision);
+
+    void Negate() { m_negative = !m_negative && !IsZero(); }
+
+    bool IsZero() const { return m_limbs.empty(); }
+    bool IsNegative() const { return m_negative; }
+    std::int64_t GetExponent() const { return m_exponent; }
+    std::size_t GetDigitCount() const;                      // 📏 Цифр в коэффициенте
+
+private:
+    CalcError Round(std::uint32_t precision);               // 🎯 Округление и проверка порядка
+    bool IsInteger() const;                                 // 🔢 Дробная часть равна нулю
+
+    std::vector<Limb> m_limbs;     // 🔢 Коэффициент (без старших нулевых лимбов, 0 — пусто)
+    std::int64_t m_exponent = 0;   // 📏 Десятичный порядок
+    bool m_negative = false;       // ➖ Знак (у нуля всегда false)
+};
+
+} // namespace calc
+
+#endif // BIG_DECIMAL_H
@@ -0,0 +1,98 @@
+#ifndef BIG_INTEGER_H
+#define BIG_INTEGER_H
+
+#include "engine/session_file.h"
+#include "engine/types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                     🔢 ЦЕЛОЕ ЧИСЛО ПРОИЗВОЛЬНОЙ ДЛИНЫ                     ║
+ ║         Факториалы и степени на миллионы цифр без переполнения            ║
+ ║                                                                           ║
+ ║  📊 Устройство:                                                           ║
+ ║   • Модуль — двоичные лимбы по 32 бита (младший первый) и знак            ║
+ ║   • Умножение: школьное → Карацуба → Тоом-3 → NTT (по порогам в лимбах)   ║
+ ║   • Деление: алгоритм D Кнута, для длинных делителей — Ньютон             ║
+ ║   • В десятичную запись: «разделяй и властвуй» по степеням 10^(9·2^k),    ║
+ ║     цифры отдаются приёмнику кусками от старших к младшим —               ║
+ ║     вся строка целиком нигде не собирается                                ║
+ ║   • Факториал — дерево произведений, степень — бинарный метод             ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class BigInteger
+{
+public:
+    using Limb = std::uint32_t;
+
+    /// 📤 Приёмник цифр: очередной кусок записи; false — остановить вывод
+    using DigitSink = std::function<bool(std::string_view digits)>;
+
+    static constexpr std::size_t KARATSUBA_THRESHOLD = 40;   // ✖️ Лимбов для Карацубы
+    static constexpr std::size_t TOOM3_THRESHOLD = 160;      // ✖️ Лимбов для Тоома-3
+    static constexpr std::size_t NTT_THRESHOLD = 5000;       // 🌀 Лимбов для NTT
+    static constexpr std::size_t NEWTON_THRESHOLD = 600;     // ➗ Лимбов делителя для Ньютона
+    static constexpr std::uint64_t MAX_BITS = std::uint64_t(1) << 31;  // 📏 ~646 млн цифр
+    static constexpr std::uint64_t MAX_FACTORIAL = 20000000;           // 📏 Предел аргумента n!
+
+    BigInteger() = default;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🔄 Преобразования
+    //──────────────────────────────────────────────────────────────────────────
+
+    bool Parse(std::string_view text);              // 📥 "[-]цифры", длинные — делением пополам
+    void SetInteger(std::int64_t value);            // 📥 Точное целое
+    double ToDouble() const;                        // 📤 Ближайшее double (±inf при переполнении)
+    bool ToUint64(std::uint64_t& value) const;      // 📤 false — отрицательное или не влезает
+
+    /// 📤 Десятичная запись кусками; false — приёмник прервал вывод
+    bool WriteDecimal(const DigitSink& sink) const;
+    std::string ToString() const;
+
+    /// 💾 Знак и лимбы как есть — без перевода в десятичную запись (файлы этой же машины)
+    void Write(SessionWriter& writer) const;
+    bool Read(SessionReader& reader);               // 📤 false — данные не читаются
+
+    /// 📤 Не больше count старших цифр (одно короткое деление вместо полной записи)
+    std::string LeadingDigits(std::size_t count) const;
+
+    std::size_t GetDecimalDigitCount() const;       // 📏 Цифр в десятичной записи
+    std::uint64_t GetBitLength() const;             // 📏 Бит в модуле
+
+    //──────────────────────────────────────────────────────────────────────────
+    // ⚡ Арифметика (out может совпадать с операндом)
+    //──────────────────────────────────────────────────────────────────────────
+
+    static CalcError Add(const BigInteger& a, const BigInteger& b, BigInteger& out);
+    static CalcError Subtract(const BigInteger& a, const BigInteger& b, BigInteger& out);
+    static CalcError Multiply(const BigInteger& a, const BigInteger& b, BigInteger& out);
+    static CalcError Divide(const BigInteger& a, const BigInteger& b, BigInteger& out);   // ➗ С отбрасыванием дроби
+    static CalcError Power(const BigInteger& a, const BigInteger& b, BigInteger& out);
+    static CalcError Factorial(const BigInteger& n, BigInteger& out);
+
+    /// ⚡ Применение бинарного оператора калькулятора
+    static CalcError Apply(Operator op, const BigInteger& a, const BigInteger& b, BigInteger& out);
+
+    void Negate() { m_negative = !m_negative && !IsZero(); }
+
+    bool IsZero() const { return m_limbs.empty(); }
+    bool IsNegative() const { return m_negative; }
+
+private:
+    std::vector<Limb> m_limbs;     // 🔢 Модуль (без старших нулевых лимбов, 0 — пусто)
+    bool m_negative = false;       // ➖ Знак (у нуля всегда false)
+};
+
+} // namespace calc
+
+#endif // BIG_INTEGER_H
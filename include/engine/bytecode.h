@@ -0,0 +1,81 @@
+﻿#ifndef BYTECODE_H
+#define BYTECODE_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                            ⚙️ КОДЫ ОПЕРАЦИЙ                              ║
+ ║        Регистровая машина: dst = lhs OP rhs над файлом регистров          ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+enum class OpCode : std::uint8_t
+{
+    Add,        // ➕ dst = lhs + rhs
+    Subtract,   // ➖ dst = lhs - rhs
+    Multiply,   // ✖️ dst = lhs * rhs
+    Divide,     // ➗ dst = lhs / rhs (ошибка при rhs == 0)
+    Power,      // 🔺 dst = pow(lhs, rhs)
+    Negate,     // ➖ dst = -lhs
+    Call,       // 🧮 dst = f(lhs), f — функция реестра (Operator в поле rhs)
+    Return      // 🏁 результат = lhs
+};
+
+struct Instruction
+{
+    OpCode op = OpCode::Return;  // ⚙️ Операция
+    std::uint32_t dst = 0;       // 🎯 Регистр результата
+    std::uint32_t lhs = 0;       // ⬅️ Левый операнд
+    std::uint32_t rhs = 0;       // ➡️ Правый операнд
+};
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                          📜 СКОМПИЛИРОВАННАЯ ПРОГРАММА                    ║
+ ║                                                                           ║
+ ║  📊 Раскладка файла регистров:                                            ║
+ ║   • [0, constants)                       константы (загружаются один раз) ║
+ ║   • [constants, constants + variables)   переменные (на каждый вызов)     ║
+ ║   • [..., registerCount)                 временные значения               ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+struct Program
+{
+    std::vector<Instruction> code;            // 📜 Плоский массив инструкций (Return в конце)
+    std::vector<double> constants;            // 🔢 Пул констант
+    std::vector<std::string> variableNames;   // 🏷️ Имена переменных по слотам
+    std::uint32_t registerCount = 0;          // 📏 Размер файла регистров
+
+    std::uint32_t GetVariableBase() const { return static_cast<std::uint32_t>(constants.size()); }
+    std::uint32_t GetVariableCount() const { return static_cast<std::uint32_t>(variableNames.size()); }
+
+    /// 🔍 Слот переменной по имени (-1, если нет)
+    int FindVariable(const std::string& name) const
+    {
+        for (std::size_t i = 0; i < variableNames.size(); ++i)
+        {
+            if (variableNames[i] == name)
+            {
+                return static_cast<int>(i);
+            }
+        }
+        return -1;
+    }
+
+    void Clear()
+    {
+        code.clear();
+        constants.clear();
+        variableNames.clear();
+        registerCount = 0;
+    }
+};
+
+} // namespace calc
+
+#endif // BYTECODE_H
@@ -0,0 +1,217 @@
+﻿#ifndef CALCULATOR_H
+#define CALCULATOR_H
+
+#include "engine/big_decimal.h"
+#include "engine/big_integer.h"
+#include "engine/decimal_evaluator.h"
+#include "engine/direct_evaluator.h"
+#include "engine/expression.h"
+#include "engine/integer_evaluator.h"
+#include "engine/lexer.h"
+#include "engine/result_cache.h"
+#include "engine/session_file.h"
+#include "engine/symbol_table.h"
+#include "engine/types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace calc
+{
+
+/// 📋 Итог вставки колонки чисел (для одного выражения все поля нулевые)
+struct PasteSummary
+{
+    std::uint64_t lineCount = 0;        // 📊 Непустых строк
+    std::uint64_t errorCount = 0;       // ❌ Строк, которые не посчитались (в сумму не вошли)
+    std::uint64_t firstErrorLine = 0;   // 📍 Номер первой такой строки (с 1)
+    std::uint64_t assignmentCount = 0;  // 🏷️ Строк "имя = выражение" (в сумму не входят)
+};
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                          🧮 ВЫЧИСЛИТЕЛЬНОЕ ЯДРО                           ║
+ ║         Хранит числовое состояние калькулятора и выполняет операции       ║
+ ║                                                                           ║
+ ║  📊 Функциональность:                                                     ║
+ ║   • Накопление выражения с кнопок (операнд, оператор, ...)                ║
+ ║   • Приоритеты операторов (2 + 3 × 4 = 14)                                ║
+ ║   • Вычисление целых выражений из текста                                  ║
+ ║   • Десятичный режим: операнды хранятся текстом, считает BigDecimal       ║
+ ║   • Целый режим: BigInteger, результат — имя ans, а не миллионы цифр      ║
+ ║   • Память M+ M- MR MC — в числах текущего режима                         ║
+ ║   • Переменные сеанса (x = 3.2) в таблице имён; в двоичном режиме         ║
+ ║     выражение с именами компилируется в байткод со слотами таблицы        ║
+ ║   • Десятичные и целые результаты — через общий ResultCache               ║
+ ║   • Коды ошибок вместо исключений                                         ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class Calculator
+{
+public:
+    //──────────────────────────────────────────────────────────────────────────
+    // 🏗️ Конструктор
+    //──────────────────────────────────────────────────────────────────────────
+
+    Calculator() = default;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🎮 Пошаговый ввод (кнопки)
+    //──────────────────────────────────────────────────────────────────────────
+
+    void SetOperand(double value);                 // 🔢 Текущий операнд
+    bool SetOperand(std::string_view text);        // 🔤 Операнд из строки (from_chars)
+    void PushOperator(Operator op);                // ➕ Операнд и оператор в выражение
+    void SetPendingOperator(Operator op);          // 🔁 Замена последнего оператора
+    EvalResult ApplyFunction(Operator function);   // 🧮 Функция к текущему операнду (sin, √...)
+    EvalResult Equals();                           // 🟰 Вычисление накопленного выражения
+    void Clear();                                  // 🗑️ Полный сброс
+
+    void SetNumberFormat(NumberFormat format) { m_format = format; }
+    void SetNumberMode(NumberMode mode);           // 💰 Двоичный/десятичный/целый режим (со сбросом)
+    void SetDecimalPrecision(std::uint32_t precision) { m_decimal.SetPrecision(precision); }
+
+    NumberMode GetNumberMode() const { return m_mode; }
+    std::uint32_t GetDecimalPrecision() const { return m_decimal.GetPrecision(); }
+
+    /// 💰 Точная запись последнего результата десятичного режима
+    const std::string& GetResultText() const { return m_resultText; }
+
+    /// 🔢 Последний результат целого режима (выводится потоком, а не строкой)
+    const BigInteger& GetIntegerResult() const { return m_integerResult; }
+
+    bool HasPendingOperator() const { return !m_tokens.empty(); }
+    double GetOperand() const { return m_operand; }
+    const std::string& GetExpressionText() const { return m_expressionText; }
+    bool IsOperandAnswer() const { return m_operandText == "ans"; }  // 🔢 Операнд — ans целого режима
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 💾 Память (M+, M-, MR, MC)
+    //──────────────────────────────────────────────────────────────────────────
+
+    CalcError MemoryAdd() { return UpdateMemory(Operator::Add); }            // ➕ Операнд в память
+    CalcError MemorySubtract() { return UpdateMemory(Operator::Subtract); }  // ➖ Операнд из памяти
+    void MemoryRecall();                           // 📤 Память становится операндом
+    void MemoryClear();                            // 🗑️ Обнуление памяти
+
+    bool HasMemory() const { return m_hasMemory; }
+    double GetMemory() const { return m_memory; }  // 💾 Память (ближайшее double)
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🏷️ Переменные сеанса
+    //──────────────────────────────────────────────────────────────────────────
+
+    const SymbolTable& GetSymbols() const { return m_symbols; }
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 💾 Кеш результатов
+    //──────────────────────────────────────────────────────────────────────────
+
+    /// 💾 Кеш десятичного и целого режимов (владеет вызывающий; nullptr — без кеша)
+    void SetResultCache(ResultCache* cache) { m_cache = cache; }
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 💾 Сохранение сеанса
+    //──────────────────────────────────────────────────────────────────────────
+
+    /// 💾 Режим, накопленное выражение, последний результат, память и переменные
+    void SaveState(SessionWriter& writer) const;
+
+    /// 📤 Восстановление; false — данные не читаются (ядро сброшено)
+    bool RestoreState(SessionReader& reader);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 📝 Вычисление целых выражений
+    //──────────────────────────────────────────────────────────────────────────
+
+    /// 🟰 Компиляция (с кешем последнего текста) и вычисление;
+    ///    "имя = выражение" ещё и присваивает (переменные — только в двоичном режиме)
+    EvalResult EvaluateExpression(std::string_view text);
+
+    /// 📋 Вставленный текст: одно выражение или колонка, строки которой складываются.
+    /// Результат становится текущим операндом; вызывается из JobService (отмена, прогресс)
+    EvalResult EvaluatePasted(std::string_view text, PasteSummary& summary);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🛠️ Статические утилиты
+    //──────────────────────────────────────────────────────────────────────────
+
+    /// ⚡ Применение бинарного оператора
+    static EvalResult Apply(Operator op, double lhs, double rhs);
+
+    /// 🔍 Оператор по символу из реестра ("+", "-", "*", "/", "^", "!")
+    static Operator ParseOperator(std::string_view symbol);
+
+    /// 🏷️ Символ оператора для отображения
+    static const char* OperatorSymbol(Operator op);
+
+    /// 📝 Форматирование числа без локали, возвращает длину строки
+    static std::size_t FormatNumber(double value, char* buffer, std::size_t size,
+        NumberFormat format = NumberFormat::Compact);
+
+    /// 💬 Текст сообщения об ошибке
+    static const char* ErrorMessage(CalcError error);
+
+    /// 📏 Самый длинный ans, который сохраняется в сеанс (~10 000 цифр)
+    static constexpr std::uint64_t MAX_SAVED_ANSWER_BITS = 33220;
+
+private:
+    void AppendToken(const Token& token);          // 📋 Добавление токена в выражение
+    EvalResult EvaluateDecimal(std::string_view text); // 💰 Вычисление через BigDecimal
+    EvalResult EvaluateInteger(std::string_view text); // 🔢 Вычисление через BigInteger
+    EvalResult EvaluatePastedExpression(std::string_view text);            // 📋 Вставка одним выражением
+    EvalResult EvaluateColumn(std::string_view text, PasteSummary& summary); // 📋 Сумма строк
+    static bool IsColumn(std::string_view text);   // 📋 Число в конце строки и в начале следующей
+    EvalResult EvaluateLine(std::string_view line, bool& assigned);      // ⚡ Сразу, с именами — байткодом
+    EvalResult EvaluateStatement(std::string_view text, bool& assigned); // 🏷️ Выражение или присваивание
+    CalcError UpdateMemory(Operator op);           // 💾 M+ / M-
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 💾 Состояние ядра
+    //──────────────────────────────────────────────────────────────────────────
+
+    double m_operand = 0.0;             // 🔢 Текущее число
+    std::vector<Token> m_tokens;        // 📋 Накопленное выражение (без End)
+    std::string m_expressionText;       // 📝 Текст выражения для строки состояния
+    Expression m_expression;            // 📐 Скомпилированное выражение
+    std::string m_compiledText;         // 🗂️ Текст, для которого m_expression актуально
+    NumberFormat m_format = NumberFormat::Compact;  // 📐 Формат чисел в тексте выражения
+    DirectEvaluator m_direct;           // ⚡ Вставка: счёт при разборе, без AST и копии текста
+    SymbolTable m_symbols;              // 🏷️ Переменные сеанса
+    ResultCache* m_cache = nullptr;     // 💾 Кеш результатов (общий с другими)
+    std::string m_cacheKey;             // 🔑 Ключ последнего выражения
+    CachedResult m_cached;              // 💾 Буфер найденного результата
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 💾 Память
+    //──────────────────────────────────────────────────────────────────────────
+
+    bool m_hasMemory = false;           // 💾 M+/M- были после MC
+    double m_memory = 0.0;              // 💾 Двоичный режим (в остальных — ближайшее double)
+    BigDecimal m_decimalMemory;         // 💰 Десятичный режим
+    BigInteger m_integerMemory;         // 🔢 Целый режим
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 💰 Десятичный режим
+    //──────────────────────────────────────────────────────────────────────────
+
+    NumberMode m_mode = NumberMode::Binary;  // ⚙️ Текущий режим
+    std::string m_operandText = "0";         // 🔢 Операнд в исходной записи
+    std::string m_resultText;                // 📝 Результат в десятичной записи
+    DecimalEvaluator m_decimal;              // 💰 Вычислитель десятичного режима
+    BigDecimal m_decimalResult;              // 💾 Буфер результата (без переаллокаций)
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🔢 Целый режим
+    //──────────────────────────────────────────────────────────────────────────
+
+    IntegerEvaluator m_integer;              // 🔢 Вычислитель целого режима
+    BigInteger m_integerResult;              // 💾 Результат (он же ans для следующего шага)
+};
+
+} // namespace calc
+
+#endif // CALCULATOR_H
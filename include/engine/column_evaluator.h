@@ -0,0 +1,82 @@
+#ifndef COLUMN_EVALUATOR_H
+#define COLUMN_EVALUATOR_H
+
+#include "engine/bytecode.h"
+#include "engine/column_kernels.h"
+#include "engine/types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace calc
+{
+
+enum class SimdLevel : std::uint8_t
+{
+    Scalar,     // 🐢 Переносимые циклы
+    Sse2,       // ⚡ 2 double за инструкцию
+    Avx2        // 🚀 4 double за инструкцию
+};
+
+struct ColumnResult
+{
+    CalcError error = CalcError::None;  // ❌ Код ошибки
+    std::size_t errorRow = 0;           // 📍 Первая строка с ошибкой (строки до неё посчитаны)
+
+    bool Ok() const { return error == CalcError::None; }
+};
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                      📊 ПОКОЛОНОЧНОЕ ВЫЧИСЛЕНИЕ                           ║
+ ║   Одна программа над массивами: output[i] = f(columns[0][i], ...)         ║
+ ║                                                                           ║
+ ║  📊 Особенности:                                                          ║
+ ║   • Строки обрабатываются блоками по BLOCK_ROWS                           ║
+ ║   • Каждая инструкция байткода — один проход ядра по блоку                ║
+ ║     (диспетчеризация амортизируется на весь блок)                         ║
+ ║   • Константы размножены в блок один раз в Load()                         ║
+ ║   • Колонки читаются напрямую, без копирования                            ║
+ ║   • Набор ядер (AVX2/SSE2/скаляр) выбирается по CPUID при запуске         ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class ColumnEvaluator
+{
+public:
+    static constexpr std::size_t BLOCK_ROWS = 256;   // 📏 Строк в блоке (блок регистров в L1/L2)
+
+    ColumnEvaluator();
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🎮 Публичный интерфейс
+    //──────────────────────────────────────────────────────────────────────────
+
+    void Load(const Program& program);               // 📥 Привязка программы
+
+    /// ▶️ columns[i] — колонка i-й переменной программы, rows строк в каждой
+    ColumnResult Evaluate(const double* const* columns, std::size_t rows, double* output);
+
+    bool IsLoaded() const { return m_program != nullptr; }
+
+    //──────────────────────────────────────────────────────────────────────────
+    // ⚡ Выбор набора инструкций
+    //──────────────────────────────────────────────────────────────────────────
+
+    void SetSimdLevel(SimdLevel level);              // 🎚️ Принудительно (не выше поддерживаемого)
+    SimdLevel GetSimdLevel() const { return m_level; }
+
+    static SimdLevel DetectSimdLevel();              // 🔍 Лучший уровень для этого CPU
+    static const char* SimdLevelName(SimdLevel level);
+
+private:
+    const Program* m_program;                 // 📜 Загруженная программа
+    const ColumnKernels* m_kernels;           // 🧮 Активный набор ядер
+    SimdLevel m_level;                        // ⚡ Активный уровень
+    std::vector<double> m_blocks;             // 💾 Блок на регистр (константы и временные)
+    std::vector<const double*> m_operands;    // 🎯 Источник каждого регистра в текущем блоке
+};
+
+} // namespace calc
+
+#endif // COLUMN_EVALUATOR_H
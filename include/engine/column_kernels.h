@@ -0,0 +1,86 @@
+#ifndef COLUMN_KERNELS_H
+#define COLUMN_KERNELS_H
+
+#include <cstddef>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                      🧮 ЯДРА ПОКОЛОНОЧНЫХ ОПЕРАЦИЙ                        ║
+ ║        out[i] = lhs[i] OP rhs[i] для i < count, без выравнивания          ║
+ ║                                                                           ║
+ ║  📊 Реализации:                                                           ║
+ ║   • Scalar — переносимые циклы (всегда доступны)                          ║
+ ║   • SSE2 / AVX2 — отдельные единицы трансляции со своими флагами ISA      ║
+ ║   • Get*Kernels() возвращает nullptr, если набор не собран                ║
+ ║   • Power, log10 и gamma во всех наборах скалярные (libm)                 ║
+ ║                                                                           ║
+ ║  🎯 Точность функций (ULP, максимум по 2.5·10⁶ случайных точек            ║
+ ║     на диапазон против long double):                                      ║
+ ║   • Scalar (libm, как VM и интерактивный ввод):                           ║
+ ║     sqrt 0.5 · exp, ln, sin, cos, tan < 0.6 · log10 < 2                   ║
+ ║     sinh, cosh < 2 · tanh < 2.5 · gamma < 6.5 (glibc)                     ║
+ ║   • SSE2: sqrt — инструкция (0.5), остальное — скалярные ядра             ║
+ ║   • AVX2 (свои приближения fdlibm, без FMA; в 3–6 раз быстрее libm):      ║
+ ║     sqrt 0.5 · exp, ln < 0.9 · sin, cos < 2 · tan < 3                     ║
+ ║     sinh, cosh, tanh < 3                                                  ║
+ ║     sin/cos/tan при |x| > 2¹⁹·π/2 — скалярные ядра (точная редукция)      ║
+ ║   • Пакет может разойтись с VM в пределах этих границ                     ║
+ ║   • Границы проверяет tests/column_kernels_test.cpp                       ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+using BinaryKernel = void (*)(const double* lhs, const double* rhs, double* out, std::size_t count);
+using UnaryKernel = void (*)(const double* in, double* out, std::size_t count);
+
+/// Возвращает индекс первого нулевого делителя или count, если нулей нет
+using DivideKernel = std::size_t (*)(const double* lhs, const double* rhs, double* out, std::size_t count);
+
+struct ColumnKernels
+{
+    BinaryKernel add;         // ➕
+    BinaryKernel subtract;    // ➖
+    BinaryKernel multiply;    // ✖️
+    DivideKernel divide;      // ➗
+    BinaryKernel power;       // 🔺
+    UnaryKernel negate;       // ➖ унарный
+    UnaryKernel sqrt;         // √
+    UnaryKernel exp;          // 📈
+    UnaryKernel ln;           // 📉
+    UnaryKernel log10;        // 🔟
+    UnaryKernel sin;          // 〰️
+    UnaryKernel cos;          // 〰️
+    UnaryKernel tan;          // 📐
+    UnaryKernel sinh;         // 〰️
+    UnaryKernel cosh;         // 〰️
+    UnaryKernel tanh;         // 📐
+    UnaryKernel gamma;        // Γ
+};
+
+const ColumnKernels* GetScalarKernels();
+const ColumnKernels* GetSse2Kernels();
+const ColumnKernels* GetAvx2Kernels();
+
+/// 🔺 Общий скалярный pow для всех наборов
+void PowerColumns(const double* lhs, const double* rhs, double* out, std::size_t count);
+
+/// 🧮 Скалярные (libm) ядра функций — общие для всех наборов
+void SqrtColumns(const double* in, double* out, std::size_t count);
+void ExpColumns(const double* in, double* out, std::size_t count);
+void LnColumns(const double* in, double* out, std::size_t count);
+void Log10Columns(const double* in, double* out, std::size_t count);
+void SinColumns(const double* in, double* out, std::size_t count);
+void CosColumns(const double* in, double* out, std::size_t count);
+void TanColumns(const double* in, double* out, std::size_t count);
+void SinhColumns(const double* in, double* out, std::size_t count);
+void CoshColumns(const double* in, double* out, std::size_t count);
+void TanhColumns(const double* in, double* out, std::size_t count);
+void GammaColumns(const double* in, double* out, std::size_t count);
+
+/// 🔍 Первый нулевой элемент (count, если нет)
+std::size_t FindFirstZero(const double* values, std::size_t count);
+
+} // namespace calc
+
+#endif // COLUMN_KERNELS_H
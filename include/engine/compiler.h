@@ -0,0 +1,94 @@
+﻿#ifndef COMPILER_H
+#define COMPILER_H
+
+#include "engine/ast.h"
+#include "engine/bytecode.h"
+
+#include <cstdint>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                       🏭 КОМПИЛЯТОР AST → БАЙТКОД                         ║
+ ║                                                                           ║
+ ║  📊 Этапы:                                                                ║
+ ║   • Нумерация значений с хеш-консингом (устранение общих подвыражений)   ║
+ ║   • Свёртка констант (деление на ноль остаётся на время выполнения)       ║
+ ║   • Распределение регистров по счётчикам использований                    ║
+ ║   • Итеративный обход: глубина дерева не ограничена стеком                ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class BytecodeCompiler
+{
+public:
+    BytecodeCompiler() = default;
+
+    /// 🏭 Компиляция дерева в программу (буферы переиспользуются между вызовами)
+    void Compile(const Node* root, Program& program);
+
+private:
+    enum class ValueKind : std::uint8_t
+    {
+        Constant,   // 🔢 Элемент пула констант
+        Variable,   // 🏷️ Слот переменной
+        Operation   // ⚙️ Результат инструкции
+    };
+
+    struct Value
+    {
+        ValueKind kind = ValueKind::Constant;  // 🏷️ Вид значения
+        OpCode op = OpCode::Return;            // ⚙️ Операция (для Operation)
+        std::uint32_t lhs = 0;                 // ⬅️ Номер значения-операнда
+        std::uint32_t rhs = 0;                 // ➡️ Номер значения-операнда (Call — функция)
+        std::uint32_t slot = 0;                // 📍 Константа/переменная: индекс в пуле/слоте
+        double constant = 0.0;                 // 🔢 Значение константы
+    };
+
+    struct OperationKey
+    {
+        OpCode op;
+        std::uint32_t lhs;
+        std::uint32_t rhs;
+
+        bool operator==(const OperationKey& other) const
+        {
+            return op == other.op && lhs == other.lhs && rhs == other.rhs;
+        }
+    };
+
+    struct OperationKeyHash
+    {
+        std::size_t operator()(const OperationKey& key) const
+        {
+            std::uint64_t hash = (static_cast<std::uint64_t>(key.lhs) << 32) ^ key.rhs;
+            hash ^= static_cast<std::uint64_t>(key.op) * 0x9E3779B97F4A7C15ull;
+            hash ^= hash >> 29;
+            return static_cast<std::size_t>(hash * 0xBF58476D1CE4E5B9ull);
+        }
+    };
+
+    std::uint32_t BuildValues(const Node* root);                   // 🌳 AST → таблица значений
+    std::uint32_t MakeConstant(double value);                      // 🔢 Константа (с дедупликацией)
+    std::uint32_t MakeVariable(const Node* node);                  // 🏷️ Переменная по имени
+    std::uint32_t MakeOperation(OpCode op, std::uint32_t lhs, std::uint32_t rhs); // ⚙️ Операция
+    std::uint32_t MakeCall(Operator function, std::uint32_t operand); // 🧮 Вызов функции
+    std::uint32_t InternOperation(OpCode op, std::uint32_t lhs, std::uint32_t rhs); // 🔁 С дедупликацией
+    void Emit(std::uint32_t rootValue, Program& program);          // 📜 Распределение регистров
+
+    std::vector<Value> m_values;                                             // 📋 Нумерованные значения
+    std::unordered_map<std::uint64_t, std::uint32_t> m_constantIds;          // 🔢 Биты double → значение
+    std::unordered_map<std::string_view, std::uint32_t> m_variableIds;       // 🏷️ Имя → значение
+    std::unordered_map<OperationKey, std::uint32_t, OperationKeyHash> m_operationIds; // ⚙️ CSE
+    std::vector<std::uint32_t> m_useCounts;                                  // 📊 Число использований
+    std::vector<std::uint32_t> m_registers;                                  // 🎯 Значение → регистр
+    Program* m_program = nullptr;                                            // 📜 Текущая программа
+};
+
+} // namespace calc
+
+#endif // COMPILER_H
@@ -0,0 +1,54 @@
+﻿#ifndef DECIMAL_EVALUATOR_H
+#define DECIMAL_EVALUATOR_H
+
+#include "engine/big_decimal.h"
+#include "engine/lexer.h"
+#include "engine/pratt_parser.h"
+#include "engine/types.h"
+
+#include <cstdint>
+#include <string_view>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                    💰 ВЫЧИСЛЕНИЕ В ДЕСЯТИЧНОМ РЕЖИМЕ                      ║
+ ║      Тот же Пратт-разбор, что у DirectEvaluator, но значения —            ║
+ ║      BigDecimal, прочитанные прямо из текста лексем                       ║
+ ║                                                                           ║
+ ║  📊 Отличия от двоичного режима:                                          ║
+ ║   • 0.1 + 0.2 == 0.3 — литералы не проходят через double                  ║
+ ║   • каждая операция округляется до precision значащих цифр               ║
+ ║   • порядок до ±MAX_EXPONENT — "1e400" допустимое число                   ║
+ ║   • выход порядка за предел — CalcError::Overflow                         ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class DecimalEvaluator : public PrattParser<DecimalEvaluator, BigDecimal>
+{
+public:
+    explicit DecimalEvaluator(std::uint32_t precision = BigDecimal::DEFAULT_PRECISION);
+
+    /// 🟰 Разбор и вычисление, результат пишется в result
+    CalcError Evaluate(std::string_view text, BigDecimal& result);
+
+    void SetPrecision(std::uint32_t precision);   // 🎯 1..BigDecimal::MAX_PRECISION
+    std::uint32_t GetPrecision() const { return m_precision; }
+
+private:
+    friend class PrattParser<DecimalEvaluator, BigDecimal>;
+
+    Token NextToken() { return m_lexer.Next(); }
+    BigDecimal Number(const Token& token);
+    CalcError Apply(Operator op, BigDecimal& lhs, const BigDecimal& rhs);
+    CalcError Function(Operator op, BigDecimal& argument);
+    void Negate(BigDecimal& operand) { operand.Negate(); }
+
+    Lexer m_lexer;                 // 🔍 Лексер текущей строки
+    std::uint32_t m_precision;     // 🎯 Значащих цифр результата
+};
+
+} // namespace calc
+
+#endif // DECIMAL_EVALUATOR_H
@@ -0,0 +1,46 @@
+﻿#ifndef DIRECT_EVALUATOR_H
+#define DIRECT_EVALUATOR_H
+
+#include "engine/lexer.h"
+#include "engine/pratt_parser.h"
+#include "engine/types.h"
+
+#include <string_view>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                       ⚡ ВЫЧИСЛЕНИЕ ПРИ РАЗБОРЕ                           ║
+ ║      Однократные выражения (пакетный режим): Пратт-разбор сразу           ║
+ ║      считает значения — без токенов в памяти, AST и байткода              ║
+ ║                                                                           ║
+ ║  📊 Семантика совпадает с Expression:                                     ║
+ ║   • та же грамматика (PrattParser)                                        ║
+ ║   • синтаксическая ошибка важнее арифметической                          ║
+ ║   • переменные не поддерживаются (UnknownVariable)                        ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class DirectEvaluator : public PrattParser<DirectEvaluator, double>
+{
+public:
+    DirectEvaluator();
+
+    EvalResult Evaluate(std::string_view text);     // 🟰 Разбор и вычисление
+
+private:
+    friend class PrattParser<DirectEvaluator, double>;
+
+    Token NextToken() { return m_lexer.Next(); }
+    double Number(const Token& token);
+    CalcError Apply(Operator op, double& lhs, double rhs);
+    CalcError Function(Operator op, double& argument);
+    void Negate(double& operand) { operand = -operand; }
+
+    Lexer m_lexer;                 // 🔍 Лексер текущей строки
+};
+
+} // namespace calc
+
+#endif // DIRECT_EVALUATOR_H
@@ -0,0 +1,85 @@
+﻿#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include "engine/arena.h"
+#include "engine/bytecode.h"
+#include "engine/compiler.h"
+#include "engine/lexer.h"
+#include "engine/symbol_table.h"
+#include "engine/vm.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                       📐 СКОМПИЛИРОВАННОЕ ВЫРАЖЕНИЕ                       ║
+ ║          Разбирается один раз, вычисляется сколько угодно раз             ║
+ ║                                                                           ║
+ ║  📊 Функциональность:                                                     ║
+ ║   • Компиляция из текста или готовых токенов                              ║
+ ║   • Текст → AST (в арене) → байткод регистровой машины                    ║
+ ║   • Вычисление с подстановкой переменных без аллокаций                    ║
+ ║   • Переменные сеанса: Bind переводит имена в слоты SymbolTable,          ║
+ ║     Evaluate(symbols) читает значения по номерам — без поиска имён        ║
+ ║   • Позиция синтаксической ошибки                                         ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class Expression
+{
+public:
+    //──────────────────────────────────────────────────────────────────────────
+    // 🏗️ Конструктор
+    //──────────────────────────────────────────────────────────────────────────
+
+    Expression();
+
+    Expression(const Expression&) = delete;
+    Expression& operator=(const Expression&) = delete;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🎮 Компиляция и вычисление
+    //──────────────────────────────────────────────────────────────────────────
+
+    CalcError Compile(std::string_view text);                // 📝 Из текста
+    CalcError Compile(const std::vector<Token>& tokens,      // 📋 Из токенов (End в конце)
+        std::string_view source = std::string_view());
+
+    /// 🟰 Вычисление; variables[i] — значение i-й переменной программы
+    EvalResult Evaluate(const double* variables = nullptr);
+
+    /// 🏷️ Переменные программы → слоты таблицы; UnknownVariable — имени в таблице нет
+    ///    (таблица не растёт: слот заводит только присваивание)
+    CalcError Bind(const SymbolTable& symbols);
+
+    /// 🟰 Вычисление со значениями из таблицы (после Bind той же таблицы)
+    EvalResult Evaluate(const SymbolTable& symbols);
+
+    bool IsCompiled() const { return m_compiled; }
+    bool IsBound() const { return m_compiled && m_bound; }
+    CalcError GetError() const { return m_error; }
+    std::size_t GetErrorPosition() const { return m_errorPosition; }
+    const Program& GetProgram() const { return m_program; }
+
+private:
+    Arena m_arena;                 // 🧱 Память узлов AST
+    std::vector<Token> m_tokens;   // 📋 Буфер токенов (переиспользуется)
+    BytecodeCompiler m_compiler;   // 🏭 Компилятор (буферы переиспользуются)
+    Program m_program;             // 📜 Байткод
+    VirtualMachine m_vm;           // 🖥️ Интерпретатор
+    std::vector<std::uint32_t> m_symbols;  // 🏷️ Слот таблицы для каждой переменной программы
+    std::vector<double> m_variables;       // 💾 Значения переменных перед запуском
+    bool m_compiled;               // ✅ Программа готова
+    bool m_bound;                  // 🔗 m_symbols соответствуют программе
+    CalcError m_error;             // ❌ Ошибка компиляции
+    std::size_t m_errorPosition;   // 📍 Позиция ошибки
+};
+
+} // namespace calc
+
+#endif // EXPRESSION_H
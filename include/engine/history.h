@@ -0,0 +1,134 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include "engine/session_file.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace calc
+{
+
+/// 📜 Одна запись истории (представления указывают в хранилище History)
+struct HistoryEntry
+{
+    std::string_view expression;    // 📝 Выражение
+    std::string_view result;        // 🟰 Результат в том виде, как он был на дисплее
+    std::int64_t timestamp = 0;     // 🕒 Секунды Unix
+};
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                        📜 ИСТОРИЯ ВЫЧИСЛЕНИЙ                              ║
+ ║       Хранилище только на дописывание, рассчитанное на миллионы записей  ║
+ ║                                                                           ║
+ ║  📊 Устройство:                                                           ║
+ ║   • Записи лежат в блоках по SessionFile::BLOCK_SIZE: в начале блока —    ║
+ ║     счётчик и описатели записей, текст растёт навстречу с конца блока     ║
+ ║   • Блоки живут в куче или, после Attach(), прямо в отображённом файле    ║
+ ║     сеанса — формат один, поэтому подключение файла с миллионом записей   ║
+ ║     стоит O(число блоков), а не O(число записей)                          ║
+ ║   • Дописывание O(1): текст, описатель, затем счётчик — прерванная        ║
+ ║     запись просто не видна                                                ║
+ ║   • Блоки не перемещаются, поэтому string_view из GetEntry() живут        ║
+ ║     до Clear()                                                            ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class History
+{
+public:
+    static constexpr std::size_t MAX_TEXT_LENGTH = 16 * 1024;   // 📏 Длиннее — обрезается
+
+    History();
+
+    History(const History&) = delete;
+    History& operator=(const History&) = delete;
+
+    /// 💾 Перенос в файл сеанса: записи файла идут первыми, затем уже накопленные
+    void Attach(SessionFile& file);
+
+    /// 📥 Дописывание записи
+    void Append(std::string_view expression, std::string_view result, std::int64_t timestamp);
+
+    /// 📜 Запись по индексу (0 — самая старая)
+    HistoryEntry GetEntry(std::size_t index) const;
+
+    std::size_t GetSize() const { return m_size; }
+    bool IsEmpty() const { return m_size == 0; }
+
+    void Clear();                           // 🗑️ Удаление всех записей
+
+private:
+    struct BlockHeader
+    {
+        std::uint32_t count;                // 📏 Записей в блоке
+        std::uint32_t textStart;            // 📍 Начало занятого текста (0 — блок не размечен)
+    };
+
+    struct Slot
+    {
+        std::int64_t timestamp;             // 🕒 Секунды Unix
+        std::uint32_t textOffset;           // 📍 Выражение от начала блока, сразу за ним результат
+        std::uint32_t expressionLength;     // 📏 Длина выражения
+        std::uint32_t resultLength;         // 📏 Длина результата
+        std::uint32_t reserved;             // 🧱 Выравнивание (0)
+    };
+
+    static constexpr std::size_t BLOCK_SIZE = SessionFile::BLOCK_SIZE;
+
+    char* NewBlock();                               // ➕ Пустой размеченный блок
+    void AddBlock(char* block);                     // 📦 Учёт блока с его записями
+
+    SessionFile* m_file;                            // 💾 Файл сеанса (nullptr — история в памяти)
+    std::vector<char*> m_blocks;                    // 📦 Блоки по порядку
+    std::vector<std::size_t> m_blockStarts;         // 📍 Индекс первой записи каждого блока
+    std::vector<std::unique_ptr<char[]>> m_ownedBlocks; // 📦 Блоки в куче (без файла)
+    std::size_t m_size;                             // 📏 Число записей
+};
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                      🔍 ИНКРЕМЕНТАЛЬНЫЙ ПОИСК ПО ИСТОРИИ                  ║
+ ║                                                                           ║
+ ║  📊 Устройство:                                                           ║
+ ║   • Advance() просматривает не больше budget записей за вызов —           ║
+ ║     UI вызывает его в idle и показывает найденное по мере поиска          ║
+ ║   • Если новый запрос содержит прежний, проверяются только прежние        ║
+ ║     совпадения, а не вся история                                          ║
+ ║   • Дописанные после поиска записи досматриваются следующим Advance()     ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class HistorySearch
+{
+public:
+    HistorySearch();
+
+    /// ✏️ Новый текст запроса (пустой — поиск выключен)
+    void SetQuery(std::string_view query);
+
+    /// 🔁 Шаг поиска; true — все записи истории просмотрены
+    bool Advance(const History& history, std::size_t budget);
+
+    bool IsActive() const { return !m_query.empty(); }
+    const std::string& GetQuery() const { return m_query; }
+
+    std::size_t GetMatchCount() const { return m_matches.size(); }
+    std::size_t GetMatch(std::size_t index) const { return m_matches[index]; }
+
+private:
+    bool Matches(const HistoryEntry& entry) const;
+
+    std::string m_query;                      // 🔤 Текущий запрос
+    std::vector<std::uint32_t> m_matches;     // ✅ Индексы совпадений по возрастанию
+    std::vector<std::uint32_t> m_candidates;  // 🔁 Совпадения прежнего запроса на перепроверку
+    std::size_t m_candidateCursor;            // 👉 Следующий кандидат
+    std::size_t m_scanned;                    // 📏 Записи [0, m_scanned) уже просмотрены
+};
+
+} // namespace calc
+
+#endif // HISTORY_H
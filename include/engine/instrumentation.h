@@ -0,0 +1,120 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+// Включается опцией CMake CALC_INSTRUMENTATION; без неё макросы ниже — пустые
+#ifndef CALC_INSTRUMENTATION
+#define CALC_INSTRUMENTATION 0
+#endif
+
+namespace calc
+{
+
+inline constexpr bool INSTRUMENTATION_ENABLED = CALC_INSTRUMENTATION != 0;
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                      ⏱️ ИНСТРУМЕНТИРОВАНИЕ ГОРЯЧЕГО ПУТИ                   ║
+ ║     Где уходит время между нажатием клавиши и обновлением дисплея         ║
+ ║                                                                           ║
+ ║  📊 Устройство:                                                           ║
+ ║   • CALC_TRACE_SCOPE — интервал от входа в блок до выхода из него         ║
+ ║   • У каждого потока своё кольцо на RING_CAPACITY событий: пишет только   ║
+ ║     владелец, без блокировок; старые события затираются новыми            ║
+ ║   • Кольцо регистрируется один раз — при первом событии потока            ║
+ ║   • CALC_TRACE_INPUT / CALC_TRACE_PAINT — задержка событие → отрисовка    ║
+ ║     в гистограмме по степеням двойки микросекунд                          ║
+ ║   • CALC_TRACE_OPERATION — операция UI: интервал, число операций и        ║
+ ║     выделений памяти за неё (счёт ведёт замещённый operator new)          ║
+ ║   • ExportChromeTrace — все кольца в JSON для chrome://tracing/Perfetto   ║
+ ║                                                                           ║
+ ║  🚫 Без CALC_INSTRUMENTATION макросы не порождают кода, operator new      ║
+ ║     не замещается; функции остаются и возвращают пустые данные            ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+
+constexpr std::size_t LATENCY_BUCKETS = 16;     // 📊 Корзина i — до 2^(i+1) мкс; последняя — всё, что дольше
+
+/// 📊 Накопленные метрики (копия на момент запроса)
+struct TraceMetrics
+{
+    std::array<std::uint64_t, LATENCY_BUCKETS> latency{};   // 📊 Событие → отрисовка
+    std::uint64_t evaluations = 0;                          // 🧮 Вычисленных выражений
+    std::uint64_t operations = 0;                           // 🎛️ Операций UI
+    std::uint64_t operationAllocations = 0;                 // 💾 Выделений памяти в них
+};
+
+std::uint64_t TraceNow();                       // 🕒 Наносекунды от начала трассировки
+
+/// ⏱️ Интервал [start, end) в кольцо текущего потока
+void RecordTraceScope(const char* name, std::uint64_t start, std::uint64_t end);
+
+void AddTraceEvaluations(std::uint64_t count);  // 🧮 Вычислено ещё count выражений
+void MarkTraceInput();                          // 👆 Ввод; отсчёт до ближайшей отрисовки
+void MarkTracePaint();                          // 🖼️ Отрисовка: задержка от первого ввода — в гистограмму
+void NameTraceThread(const char* name);         // 🏷️ Имя потока в экспорте (строковый литерал)
+std::uint64_t GetThreadAllocationCount();       // 💾 Выделений памяти текущим потоком
+
+TraceMetrics GetTraceMetrics();                 // 📊 Копия метрик
+double GetLatencyPercentile(const TraceMetrics& metrics, double fraction); // 📊 Верхняя граница корзины, мкс
+bool ExportChromeTrace(std::FILE* file);        // 💾 Chrome trace JSON; false — ошибка записи
+
+/// ⏱️ Интервал блока: имя — строковый литерал, событие пишется в деструкторе
+class TraceScope
+{
+public:
+    explicit TraceScope(const char* name)
+        : m_name(name)
+        , m_start(TraceNow())
+    {
+    }
+
+    ~TraceScope() { RecordTraceScope(m_name, m_start, TraceNow()); }
+
+    TraceScope(const TraceScope&) = delete;
+    TraceScope& operator=(const TraceScope&) = delete;
+
+private:
+    const char* m_name;         // 🏷️ Имя интервала
+    std::uint64_t m_start;      // 🕒 Вход в блок
+};
+
+/// 🎛️ Операция UI: интервал плюс её выделения памяти в счётчиках метрик
+class TraceOperation
+{
+public:
+    explicit TraceOperation(const char* name);
+    ~TraceOperation();
+
+    TraceOperation(const TraceOperation&) = delete;
+    TraceOperation& operator=(const TraceOperation&) = delete;
+
+private:
+    TraceScope m_scope;                 // ⏱️ Интервал операции
+    std::uint64_t m_allocations;        // 💾 Счётчик потока на входе
+};
+
+} // namespace calc
+
+#define CALC_TRACE_CONCAT_(a, b) a##b
+#define CALC_TRACE_CONCAT(a, b) CALC_TRACE_CONCAT_(a, b)
+
+#if CALC_INSTRUMENTATION
+#define CALC_TRACE_SCOPE(name) const ::calc::TraceScope CALC_TRACE_CONCAT(calcTraceScope, __LINE__)(name)
+#define CALC_TRACE_OPERATION(name) const ::calc::TraceOperation CALC_TRACE_CONCAT(calcTraceOperation, __LINE__)(name)
+#define CALC_TRACE_EVALUATIONS(count) ::calc::AddTraceEvaluations(count)
+#define CALC_TRACE_INPUT() ::calc::MarkTraceInput()
+#define CALC_TRACE_PAINT() ::calc::MarkTracePaint()
+#else
+#define CALC_TRACE_SCOPE(name) ((void)0)
+#define CALC_TRACE_OPERATION(name) ((void)0)
+#define CALC_TRACE_EVALUATIONS(count) ((void)sizeof(count))
+#define CALC_TRACE_INPUT() ((void)0)
+#define CALC_TRACE_PAINT() ((void)0)
+#endif
+
+#endif // INSTRUMENTATION_H
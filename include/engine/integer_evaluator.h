@@ -0,0 +1,59 @@
+#ifndef INTEGER_EVALUATOR_H
+#define INTEGER_EVALUATOR_H
+
+#include "engine/big_integer.h"
+#include "engine/lexer.h"
+#include "engine/pratt_parser.h"
+#include "engine/types.h"
+
+#include <string_view>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                      🔢 ВЫЧИСЛЕНИЕ В ЦЕЛОМ РЕЖИМЕ                         ║
+ ║      Тот же Пратт-разбор, что у DecimalEvaluator, но значения —           ║
+ ║      BigInteger: 1000! и 3^1000000 считаются точно, а не в inf            ║
+ ║                                                                           ║
+ ║  📊 Отличия от двоичного режима:                                          ║
+ ║   • постфиксный факториал n! сильнее ^ (2^3! = 2^6)                       ║
+ ║   • деление отбрасывает дробную часть (7 / 2 = 3, -7 / 2 = -3)            ║
+ ║   • литералы только целые — "1.5" даёт CalcError::InvalidNumber           ║
+ ║   • имя ans — предыдущий результат (до SetAnswer — неизвестное имя)       ║
+ ║   • результат длиннее MAX_BITS — CalcError::Overflow                      ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class IntegerEvaluator : public PrattParser<IntegerEvaluator, BigInteger>
+{
+public:
+    IntegerEvaluator();
+
+    /// 🟰 Разбор и вычисление, результат пишется в result
+    CalcError Evaluate(std::string_view text, BigInteger& result);
+
+    /// 💾 Значение для имени ans
+    void SetAnswer(const BigInteger& answer) { m_answer = answer; m_hasAnswer = true; }
+
+private:
+    friend class PrattParser<IntegerEvaluator, BigInteger>;
+
+    Token NextToken() { return m_lexer.Next(); }
+    BigInteger Number(const Token& token);
+    BigInteger Identifier(const Token& token);     // 💾 ans
+    CalcError Apply(Operator op, BigInteger& lhs, const BigInteger& rhs);
+    void Negate(BigInteger& operand) { operand.Negate(); }
+
+    bool IsFunction(Operator) const { return false; }     // 🚫 sqrt и др. — только в double
+    bool IsPostfix(Operator op) const { return op == Operator::Factorial; }
+    CalcError Postfix(Operator op, BigInteger& operand);
+
+    Lexer m_lexer;                 // 🔍 Лексер текущей строки
+    BigInteger m_answer;           // 💾 Предыдущий результат (ans)
+    bool m_hasAnswer;              // 💾 ans уже задан
+};
+
+} // namespace calc
+
+#endif // INTEGER_EVALUATOR_H
@@ -0,0 +1,80 @@
+#ifndef JOB_SERVICE_H
+#define JOB_SERVICE_H
+
+#include "engine/thread_pool.h"
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace calc
+{
+
+/// 🎫 Состояние одной фоновой задачи: отмена и прогресс (общие с UI)
+class JobContext
+{
+public:
+    void Cancel() { m_cancelled.store(true, std::memory_order_relaxed); }
+    bool IsCancelled() const { return m_cancelled.load(std::memory_order_relaxed); }
+
+    /// 📊 Доля выполненной работы 0..1 — пишет рабочий, читает таймер UI
+    void SetProgress(double fraction) { m_progress.store(fraction, std::memory_order_relaxed); }
+    double GetProgress() const { return m_progress.load(std::memory_order_relaxed); }
+
+    bool IsFinished() const { return m_finished.load(std::memory_order_acquire); }
+
+private:
+    friend class JobService;
+
+    std::atomic<bool> m_cancelled{ false };   // ⏹️ Запрошена отмена
+    std::atomic<double> m_progress{ 0.0 };    // 📊 Прогресс
+    std::atomic<bool> m_finished{ false };    // ✅ Работа завершена
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🔍 Для длинных циклов ядра: задача текущего потока (вне задачи — no-op)
+//──────────────────────────────────────────────────────────────────────────────
+
+bool IsJobCancelled();                      // ⏹️ Пора прервать вычисление
+void ReportJobProgress(double fraction);    // 📊 Прогресс текущей задачи
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                      ⏳ СЕРВИС ФОНОВЫХ ВЫЧИСЛЕНИЙ                         ║
+ ║        Длинные вычисления уходят из обработчика событий в пул            ║
+ ║                                                                           ║
+ ║  📊 Устройство:                                                           ║
+ ║   • Submit ставит работу в ThreadPool и возвращает JobContext             ║
+ ║   • Пока работа идёт, её JobContext — текущий для рабочего потока:        ║
+ ║     BigInteger/BigDecimal опрашивают IsJobCancelled() в длинных циклах    ║
+ ║     и возвращают CalcError::Cancelled                                     ║
+ ║   • Результат работа доставляет сама (GUI — через wxThreadEvent),        ║
+ ║     поэтому отменённая задача тоже доходит до конца и сообщает о себе     ║
+ ║   • Деструктор отменяет незавершённые задачи и дожидается их              ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class JobService
+{
+public:
+    using Work = std::function<void(JobContext& job)>;
+
+    explicit JobService(unsigned threadCount = 1);
+    ~JobService();
+
+    JobService(const JobService&) = delete;
+    JobService& operator=(const JobService&) = delete;
+
+    std::shared_ptr<JobContext> Submit(Work work);  // 📥 Постановка задачи
+    void CancelAll();                                // ⏹️ Отмена всех незавершённых
+
+private:
+    std::mutex m_mutex;                              // 🔒 Защита m_jobs
+    std::vector<std::weak_ptr<JobContext>> m_jobs;   // 📋 Поставленные задачи
+    ThreadPool m_pool;                               // 🧵 Рабочие потоки (гасятся первыми)
+};
+
+} // namespace calc
+
+#endif // JOB_SERVICE_H
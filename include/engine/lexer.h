@@ -0,0 +1,73 @@
+﻿#ifndef LEXER_H
+#define LEXER_H
+
+#include "engine/types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                              🔤 ТОКЕНЫ                                    ║
+ ║         Лексемы выражения: числа, имена, операторы и скобки              ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+enum class TokenType : std::uint8_t
+{
+    Number,       // 🔢 Числовой литерал
+    Identifier,   // 🏷️ Имя переменной
+    Operator,     // ➕ Бинарный/унарный оператор или имя функции
+    LeftParen,    // ( Открывающая скобка
+    RightParen,   // ) Закрывающая скобка
+    End,          // 🏁 Конец ввода
+    Invalid       // ❌ Нераспознанный символ
+};
+
+struct Token
+{
+    TokenType type = TokenType::End;   // 🏷️ Тип лексемы
+    Operator op = Operator::None;      // ➕ Оператор (для TokenType::Operator)
+    double number = 0.0;               // 🔢 Значение (для TokenType::Number)
+    std::uint32_t position = 0;        // 📍 Смещение в исходном тексте
+    std::uint32_t length = 0;          // 📏 Длина лексемы в исходном тексте
+};
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                           🔍 ЛЕКСИЧЕСКИЙ АНАЛИЗ                           ║
+ ║         Однопроходный разбор текста без копирования исходной строки      ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class Lexer
+{
+public:
+    explicit Lexer(std::string_view text);
+
+    Token Next();                                   // 👉 Следующая лексема
+
+    /// 📋 Разбор всего текста в вектор (завершается токеном End);
+    ///    в фоновой задаче опрашивает отмену (CalcError::Cancelled)
+    static CalcError Tokenize(std::string_view text, std::vector<Token>& tokens,
+        std::size_t* errorPosition = nullptr);
+
+    /// 🏷️ "имя = выражение" → имя и выражение; false — не присваивание
+    static bool SplitAssignment(std::string_view text, std::string_view& name, std::string_view& value);
+
+private:
+    Token LexNumber();                              // 🔢 Разбор числа
+    Token LexIdentifier();                          // 🏷️ Разбор имени
+
+    static constexpr std::size_t PROGRESS_TOKENS = 4096; // ⏹️ Лексем между проверками отмены
+
+    std::string_view m_text;   // 📝 Исходный текст
+    std::size_t m_position;    // 📍 Текущая позиция
+};
+
+} // namespace calc
+
+#endif // LEXER_H
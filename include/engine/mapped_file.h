@@ -0,0 +1,47 @@
+﻿#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                      🗺️ ФАЙЛ, ОТОБРАЖЁННЫЙ В ПАМЯТЬ                      ║
+ ║         Только чтение: mmap (POSIX) / CreateFileMapping (Windows)         ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool Open(const std::string& path);     // 📂 Отображение целиком; false — нет файла или не обычный файл
+    void Close();                           // 🚪 Снятие отображения
+
+    const char* GetData() const { return m_data; }
+    std::size_t GetSize() const { return m_size; }
+    std::string_view GetView() const { return std::string_view(m_data, m_size); }
+    bool IsOpen() const { return m_data != nullptr || m_isEmpty; }
+
+private:
+    const char* m_data = nullptr;   // 💾 Начало отображения
+    std::size_t m_size = 0;         // 📏 Размер файла
+    bool m_isEmpty = false;         // 📭 Файл открыт, но пуст (отображать нечего)
+
+#ifdef _WIN32
+    void* m_file = nullptr;         // 🪟 HANDLE файла
+    void* m_mapping = nullptr;      // 🪟 HANDLE отображения
+#endif
+};
+
+} // namespace calc
+
+#endif // MAPPED_FILE_H
@@ -0,0 +1,105 @@
+#ifndef NUMBER_ENTRY_H
+#define NUMBER_ENTRY_H
+
+#include "engine/types.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                          🔢 БУФЕР ВВОДА ЧИСЛА                             ║
+ ║       Мантисса и порядок хранятся цифрами, значение — без потерь          ║
+ ║                                                                           ║
+ ║  📊 Особенности:                                                          ║
+ ║   • Набор: цифры, точка, EXP, знак порядка, забой                         ║
+ ║   • Разбор через from_chars (без локали, точное округление)               ║
+ ║   • Результат хранится как double, а не как отформатированный текст —    ║
+ ║     цепочки вычислений не теряют точность на отображении                  ║
+ ║   • Отображение: "%.10g" или кратчайшее точное представление             ║
+ ║   • Assign — точная десятичная запись результата без double              ║
+ ║   • Цифры во встроенных массивах: набор и вывод на дисплей не выделяют    ║
+ ║     память; стадия набора — явная (целая часть, дробная, порядок)         ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class NumberEntry
+{
+public:
+    static constexpr std::size_t MAX_MANTISSA_DIGITS = 34;  // 📏 Цифр мантиссы (как decimal128)
+    static constexpr std::size_t MAX_EXPONENT_DIGITS = 9;   // 📏 Цифр порядка (как BigDecimal)
+    static constexpr std::size_t MAX_TEXT_LENGTH = 64;      // 📏 Длина текста с запасом
+
+    NumberEntry();
+
+    //──────────────────────────────────────────────────────────────────────────
+    // ⌨️ Редактирование
+    //──────────────────────────────────────────────────────────────────────────
+
+    void Clear();                          // 🧹 Сброс в "0"
+    bool AppendDigit(char digit);          // 🔢 Цифра в мантиссу или порядок
+    bool AppendDecimalPoint();             // • Десятичная точка
+    bool BeginExponent();                  // 🔺 Переход к вводу порядка (EXP)
+    bool ToggleExponentSign();             // ➖ Знак порядка
+    bool Backspace();                      // ⌫ Удаление последнего символа
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 💾 Значение и отображение
+    //──────────────────────────────────────────────────────────────────────────
+
+    void SetValue(double value);           // 📥 Результат вычисления
+    bool GetValue(double& value) const;    // 📤 false — число вне диапазона double
+
+    /// 📥 Готовая запись числа ("-1.5e-7") как набранная — для десятичного режима
+    bool Assign(std::string_view text);
+
+    /// 📤 Запись для разбора: набранный текст без незаконченного порядка
+    ///    или кратчайшая точная запись результата
+    std::size_t GetText(char* buffer, std::size_t size) const;
+
+    void SetFormat(NumberFormat format) { m_format = format; }
+    NumberFormat GetFormat() const { return m_format; }
+
+    /// 📝 Текст для дисплея (с завершающим нулём), возвращает длину
+    std::size_t Format(char* buffer, std::size_t size) const;
+
+    bool HasValue() const { return m_stage == Stage::Value; }
+    bool HasDecimalPoint() const { return m_pointPosition != NO_POINT; }
+    bool HasExponent() const { return m_stage == Stage::Exponent; }
+
+private:
+    /// ⌨️ Что сейчас набирается
+    enum class Stage : std::uint8_t
+    {
+        Integer,        // 🔢 Цифры до точки
+        Fraction,       // • Цифры после точки
+        Exponent,       // 🔺 Цифры порядка (после EXP)
+        Value           // 💾 Хранится результат, а не набор
+    };
+
+    static constexpr std::size_t NO_POINT = MAX_TEXT_LENGTH;   // • Точки нет
+
+    bool Materialize();                    // ✏️ Значение → редактируемые цифры
+    bool IsZero() const;                   // 0️⃣ Мантисса — единственный "0" без точки
+    Stage MantissaStage() const;           // 🔢 Integer или Fraction — по наличию точки
+    std::size_t WriteText(char* buffer, std::size_t size) const;
+
+    std::array<char, MAX_TEXT_LENGTH> m_digits;          // 🔢 Цифры мантиссы без точки
+    std::array<char, MAX_EXPONENT_DIGITS> m_exponent;    // 🔺 Цифры порядка
+    std::size_t m_digitCount;              // 📏 Цифр мантиссы
+    std::size_t m_pointPosition;           // • Цифр до точки (NO_POINT — точки нет)
+    std::size_t m_exponentLength;          // 📏 Цифр порядка
+    Stage m_stage;                         // ⌨️ Стадия набора
+    bool m_negative;                       // ➖ Знак мантиссы
+    bool m_exponentNegative;               // ➖ Знак порядка
+    double m_value;                        // 💾 Точное значение результата
+    NumberFormat m_format;                 // 📐 Формат отображения результата
+};
+
+} // namespace calc
+
+#endif // NUMBER_ENTRY_H
@@ -0,0 +1,271 @@
+#ifndef OPERATORS_H
+#define OPERATORS_H
+
+#include "engine/bytecode.h"
+#include "engine/types.h"
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <string_view>
+
+namespace calc
+{
+
+//──────────────────────────────────────────────────────────────────────────────
+// 📊 Приоритеты (общие для Parser и всех вычислителей)
+//──────────────────────────────────────────────────────────────────────────────
+
+constexpr int PRECEDENCE_ADDITIVE = 10;        // ➕ + -
+constexpr int PRECEDENCE_MULTIPLICATIVE = 20;  // ✖️ * /
+constexpr int PRECEDENCE_UNARY = 30;           // ➖ унарный минус
+constexpr int PRECEDENCE_POWER = 40;           // 🔺 ^
+constexpr int PRECEDENCE_POSTFIX = 50;         // ❗ n! (только целый режим)
+
+enum class Associativity : std::uint8_t
+{
+    Left,       // ⬅️ a - b - c = (a - b) - c
+    Right       // ➡️ a ^ b ^ c = a ^ (b ^ c)
+};
+
+enum class OperatorForm : std::uint8_t
+{
+    None,       // ∅ Не оператор выражения
+    Infix,      // ↔️ Двуместный: a OP b
+    Postfix,    // ❗ Одноместный после операнда: a OP
+    Function    // 🧮 Вызов с аргументом в скобках: name(a)
+};
+
+/// ⚡ Ядро для double: ошибка кодом, без исключений
+using OperatorKernel = EvalResult (*)(double lhs, double rhs);
+
+/// 🧮 Скалярное ядро функции: IEEE-семантика (NaN вне области определения)
+using FunctionKernel = double (*)(double value);
+
+namespace kernels
+{
+
+inline EvalResult Add(double lhs, double rhs) { return EvalResult{ lhs + rhs, CalcError::None }; }
+inline EvalResult Subtract(double lhs, double rhs) { return EvalResult{ lhs - rhs, CalcError::None }; }
+inline EvalResult Multiply(double lhs, double rhs) { return EvalResult{ lhs * rhs, CalcError::None }; }
+
+inline EvalResult Divide(double lhs, double rhs)
+{
+    if (rhs == 0.0)
+    {
+        return EvalResult{ 0.0, CalcError::DivisionByZero };
+    }
+    return EvalResult{ lhs / rhs, CalcError::None };
+}
+
+inline EvalResult Power(double lhs, double rhs) { return EvalResult{ std::pow(lhs, rhs), CalcError::None }; }
+
+// Функции — libm; поколоночные SIMD-версии и их точность описаны в column_kernels.h
+inline double Sqrt(double x) { return std::sqrt(x); }
+inline double Exp(double x) { return std::exp(x); }
+inline double Ln(double x) { return std::log(x); }
+inline double Log10(double x) { return std::log10(x); }
+inline double Sin(double x) { return std::sin(x); }
+inline double Cos(double x) { return std::cos(x); }
+inline double Tan(double x) { return std::tan(x); }
+inline double Sinh(double x) { return std::sinh(x); }
+inline double Cosh(double x) { return std::cosh(x); }
+inline double Tanh(double x) { return std::tanh(x); }
+inline double Gamma(double x) { return std::tgamma(x); }
+
+} // namespace kernels
+
+/// 🚫 Итог в double: NaN — InvalidNumber, ±∞ — Overflow, как в десятичном и целом режимах
+///    (промежуточные значения не проверяются: 1/(1e308*10) — это 0)
+inline CalcError NonFiniteError(double value)
+{
+    if (std::isnan(value))
+    {
+        return CalcError::InvalidNumber;
+    }
+    return std::isinf(value) ? CalcError::Overflow : CalcError::None;
+}
+
+inline EvalResult FiniteResult(double value)
+{
+    const CalcError error = NonFiniteError(value);
+    return EvalResult{ error == CalcError::None ? value : 0.0, error };
+}
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                         🗂️ РЕЕСТР ОПЕРАТОРОВ                             ║
+ ║     Одно описание на оператор: лексер, парсер, компилятор байт-кода,      ║
+ ║     вычисление в double, клавиатура и клавиши панели читают его же        ║
+ ║                                                                           ║
+ ║  📊 Устройство:                                                           ║
+ ║   • OPERATORS индексируется самим Operator — поиск описания O(1)          ║
+ ║   • Символ → Operator: таблица на 256 байт, собранная при компиляции      ║
+ ║   • Событие клавиши несёт Operator числом — строки на горячем пути нет    ║
+ ║   • Функции — те же записи с OperatorForm::Function: лексер узнаёт имя,   ║
+ ║     VM вызывает function через OpCode::Call                               ║
+ ║   • Новый оператор: значение в enum, строка здесь и место на панели       ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+struct OperatorInfo
+{
+    Operator op;                    // 🏷️ Код (совпадает с индексом в таблице)
+    const char* symbol;             // ✏️ ASCII-запись в выражении и истории
+    const char* label;              // 🏷️ Подпись клавиши (UTF-8), её же принимает лексер
+    char key;                       // ⌨️ Клавиша клавиатуры ('\0' — нет)
+    OperatorForm form;              // ↔️ Инфиксный / постфиксный
+    int precedence;                 // 📊 Приоритет
+    Associativity associativity;    // ➡️ Ассоциативность
+    OpCode opcode;                  // ⚙️ Инструкция VM (Return — не компилируется)
+    OperatorKernel kernel;          // ⚡ Вычисление в double (nullptr — нет)
+    FunctionKernel function;        // 🧮 Функция в double (OperatorForm::Function)
+};
+
+inline constexpr OperatorInfo OPERATORS[] =
+{
+    { Operator::None, "", "", '\0', OperatorForm::None,
+        0, Associativity::Left, OpCode::Return, nullptr, nullptr },
+    { Operator::Add, "+", "+", '+', OperatorForm::Infix,
+        PRECEDENCE_ADDITIVE, Associativity::Left, OpCode::Add, &kernels::Add, nullptr },
+    { Operator::Subtract, "-", "-", '-', OperatorForm::Infix,
+        PRECEDENCE_ADDITIVE, Associativity::Left, OpCode::Subtract, &kernels::Subtract, nullptr },
+    { Operator::Multiply, "*", "\xC3\x97", '*', OperatorForm::Infix,       // × в UTF-8
+        PRECEDENCE_MULTIPLICATIVE, Associativity::Left, OpCode::Multiply, &kernels::Multiply, nullptr },
+    { Operator::Divide, "/", "\xC3\xB7", '/', OperatorForm::Infix,         // ÷ в UTF-8
+        PRECEDENCE_MULTIPLICATIVE, Associativity::Left, OpCode::Divide, &kernels::Divide, nullptr },
+    { Operator::Power, "^", "^", '^', OperatorForm::Infix,
+        PRECEDENCE_POWER, Associativity::Right, OpCode::Power, &kernels::Power, nullptr },
+    // Постфиксный: пошаговый ввод с панели и клавиатуры его не применяет
+    { Operator::Factorial, "!", "!", '\0', OperatorForm::Postfix,
+        PRECEDENCE_POSTFIX, Associativity::Left, OpCode::Return, nullptr, nullptr },
+
+    // Функции: аргумент всегда в скобках, приоритет не нужен
+    { Operator::Sqrt, "sqrt", "\xE2\x88\x9A", '\0', OperatorForm::Function,      // √ в UTF-8
+        0, Associativity::Left, OpCode::Call, nullptr, &kernels::Sqrt },
+    { Operator::Exp, "exp", "exp", '\0', OperatorForm::Function,
+        0, Associativity::Left, OpCode::Call, nullptr, &kernels::Exp },
+    { Operator::Ln, "ln", "ln", '\0', OperatorForm::Function,
+        0, Associativity::Left, OpCode::Call, nullptr, &kernels::Ln },
+    { Operator::Log10, "log", "log", '\0', OperatorForm::Function,
+        0, Associativity::Left, OpCode::Call, nullptr, &kernels::Log10 },
+    { Operator::Sin, "sin", "sin", '\0', OperatorForm::Function,
+        0, Associativity::Left, OpCode::Call, nullptr, &kernels::Sin },
+    { Operator::Cos, "cos", "cos", '\0', OperatorForm::Function,
+        0, Associativity::Left, OpCode::Call, nullptr, &kernels::Cos },
+    { Operator::Tan, "tan", "tan", '\0', OperatorForm::Function,
+        0, Associativity::Left, OpCode::Call, nullptr, &kernels::Tan },
+    { Operator::Sinh, "sinh", "sinh", '\0', OperatorForm::Function,
+        0, Associativity::Left, OpCode::Call, nullptr, &kernels::Sinh },
+    { Operator::Cosh, "cosh", "cosh", '\0', OperatorForm::Function,
+        0, Associativity::Left, OpCode::Call, nullptr, &kernels::Cosh },
+    { Operator::Tanh, "tanh", "tanh", '\0', OperatorForm::Function,
+        0, Associativity::Left, OpCode::Call, nullptr, &kernels::Tanh },
+    { Operator::Gamma, "gamma", "\xCE\x93", '\0', OperatorForm::Function,        // Γ в UTF-8
+        0, Associativity::Left, OpCode::Call, nullptr, &kernels::Gamma }
+};
+
+inline constexpr std::size_t OPERATOR_COUNT = sizeof(OPERATORS) / sizeof(OPERATORS[0]);
+
+constexpr bool OperatorTableIsIndexed()
+{
+    for (std::size_t i = 0; i < OPERATOR_COUNT; ++i)
+    {
+        if (static_cast<std::size_t>(OPERATORS[i].op) != i)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static_assert(OperatorTableIsIndexed(), "OPERATORS must be ordered like enum Operator");
+
+/// 🔍 Описание оператора; вне таблицы — описание Operator::None
+constexpr const OperatorInfo& GetOperatorInfo(Operator op)
+{
+    const auto index = static_cast<std::size_t>(op);
+    return index < OPERATOR_COUNT ? OPERATORS[index] : OPERATORS[0];
+}
+
+namespace detail
+{
+
+constexpr std::array<Operator, 256> MakeSymbolTable()
+{
+    std::array<Operator, 256> table{};
+    for (std::size_t i = 1; i < OPERATOR_COUNT; ++i)
+    {
+        if (OPERATORS[i].symbol[0] != '\0' && OPERATORS[i].symbol[1] == '\0')
+        {
+            table[static_cast<unsigned char>(OPERATORS[i].symbol[0])] = OPERATORS[i].op;
+        }
+    }
+    return table;
+}
+
+constexpr std::array<Operator, 256> MakeKeyTable()
+{
+    std::array<Operator, 256> table{};
+    for (std::size_t i = 1; i < OPERATOR_COUNT; ++i)
+    {
+        if (OPERATORS[i].key != '\0')
+        {
+            table[static_cast<unsigned char>(OPERATORS[i].key)] = OPERATORS[i].op;
+        }
+    }
+    return table;
+}
+
+inline constexpr std::array<Operator, 256> SYMBOL_TABLE = MakeSymbolTable();
+inline constexpr std::array<Operator, 256> KEY_TABLE = MakeKeyTable();
+
+} // namespace detail
+
+/// ✏️ Оператор по ASCII-символу выражения (None — не оператор)
+constexpr Operator OperatorFromSymbol(char symbol)
+{
+    return detail::SYMBOL_TABLE[static_cast<unsigned char>(symbol)];
+}
+
+/// ⌨️ Оператор по клавише (None — клавиша не оператор)
+constexpr Operator OperatorFromKey(char key)
+{
+    return detail::KEY_TABLE[static_cast<unsigned char>(key)];
+}
+
+/// 🏷️ Оператор по подписи UTF-8 ("×", "√") в начале text; length — её длина в байтах
+constexpr Operator OperatorFromLabel(std::string_view text, std::size_t& length)
+{
+    for (std::size_t i = 1; i < OPERATOR_COUNT; ++i)
+    {
+        const std::string_view label = OPERATORS[i].label;
+        if (label.size() > 1 && static_cast<unsigned char>(label[0]) >= 0x80
+            && text.substr(0, label.size()) == label)
+        {
+            length = label.size();
+            return OPERATORS[i].op;
+        }
+    }
+    return Operator::None;
+}
+
+/// 🧮 Функция по имени ("sin", "sqrt"...; None — не функция)
+constexpr Operator FunctionFromName(std::string_view name)
+{
+    for (std::size_t i = 1; i < OPERATOR_COUNT; ++i)
+    {
+        if (OPERATORS[i].form == OperatorForm::Function && name == OPERATORS[i].symbol)
+        {
+            return OPERATORS[i].op;
+        }
+    }
+    return Operator::None;
+}
+
+static_assert(OperatorFromSymbol('*') == Operator::Multiply, "symbol table is built at compile time");
+static_assert(OperatorFromKey('^') == Operator::Power, "key table is built at compile time");
+static_assert(OperatorFromSymbol('s') == Operator::None, "function names are not one-character symbols");
+
+} // namespace calc
+
+#endif // OPERATORS_H
@@ -0,0 +1,62 @@
+﻿#ifndef PARSER_H
+#define PARSER_H
+
+#include "engine/arena.h"
+#include "engine/ast.h"
+#include "engine/lexer.h"
+#include "engine/operators.h"
+#include "engine/pratt_parser.h"
+
+#include <cstddef>
+#include <string_view>
+
+namespace calc
+{
+
+struct ParseResult
+{
+    const Node* root = nullptr;         // 🌳 Корень дерева
+    CalcError error = CalcError::None;  // ❌ Код ошибки
+    std::size_t position = 0;           // 📍 Позиция ошибки в тексте
+};
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                       🧩 ПАРСЕР С ПРИОРИТЕТАМИ (PRATT)                    ║
+ ║                                                                           ║
+ ║  📊 Приоритеты (от низшего к высшему):                                    ║
+ ║   • + -      левоассоциативные                                            ║
+ ║   • * /      левоассоциативные                                            ║
+ ║   • унарный - (префикс)                                                   ║
+ ║   • ^        правоассоциативный                                           ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class Parser : public PrattParser<Parser, const Node*>
+{
+public:
+    /// 🏗️ Токены должны завершаться TokenType::End; source нужен для имён переменных
+    Parser(const Token* tokens, std::size_t count, Arena& arena,
+        std::string_view source = std::string_view());
+
+    ParseResult Parse();                        // 🌳 Разбор всего выражения
+
+private:
+    friend class PrattParser<Parser, const Node*>;
+
+    Token NextToken();
+    const Node* Number(const Token& token);
+    const Node* Identifier(const Token& token);
+    CalcError Apply(Operator op, const Node*& lhs, const Node* rhs);
+    CalcError Function(Operator op, const Node*& argument);
+    void Negate(const Node*& operand);
+
+    const Token* m_tokens;     // 📋 Входные токены
+    std::string_view m_source; // 📝 Исходный текст
+    std::size_t m_count;       // 📏 Число токенов
+    std::size_t m_index;       // 👉 Следующий токен
+    Arena& m_arena;            // 🧱 Память для узлов
+};
+
+} // namespace calc
+
+#endif // PARSER_H
@@ -0,0 +1,279 @@
+#ifndef PRATT_PARSER_H
+#define PRATT_PARSER_H
+
+#include "engine/job_service.h"
+#include "engine/lexer.h"
+#include "engine/operators.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                     🔁 ОБЩИЙ ЦИКЛ ПРАТТА (ГРАММАТИКА)                     ║
+ ║      Единственное место, где записана грамматика выражений: Parser        ║
+ ║      строит из неё AST, вычислители — сразу double/BigDecimal/BigInteger  ║
+ ║                                                                           ║
+ ║  🧩 Derived (CRTP) даёт значения, грамматика остаётся здесь:              ║
+ ║   • Token NextToken()                      — следующая лексема            ║
+ ║   • Value Number(const Token&)             — литерал                      ║
+ ║   • CalcError Apply(op, Value&, const Value&) — lhs = lhs op rhs          ║
+ ║   • void Negate(Value&)                    — унарный минус                ║
+ ║   • Identifier, IsFunction, Function, IsPostfix, Postfix — если нужны     ║
+ ║                                                                           ║
+ ║  📊 Ошибки:                                                               ║
+ ║   • Fail — синтаксическая, останавливает разбор                           ║
+ ║   • код из Apply/Function/Postfix — арифметическая: разбор идёт дальше,   ║
+ ║     значения больше не считаются, синтаксическая ошибка важнее            ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+template<typename Derived, typename Value>
+class PrattParser
+{
+public:
+    //──────────────────────────────────────────────────────────────────────────
+    // 📊 Приоритеты из реестра операторов
+    //──────────────────────────────────────────────────────────────────────────
+
+    static constexpr int MAX_DEPTH = 512;                 // 🪜 Ограничение рекурсии
+
+    /// 📊 0 — не инфиксный оператор
+    static constexpr int InfixPrecedence(Operator op)
+    {
+        const OperatorInfo& info = GetOperatorInfo(op);
+        return info.form == OperatorForm::Infix ? info.precedence : 0;
+    }
+
+    /// ➡️ Правая ассоциативность
+    static constexpr bool IsRightAssociative(Operator op)
+    {
+        return GetOperatorInfo(op).associativity == Associativity::Right;
+    }
+
+    std::size_t GetErrorPosition() const { return m_errorPosition; }
+
+protected:
+    PrattParser()
+        : m_depth(0)
+        , m_steps(0)
+        , m_syntaxError(CalcError::None)
+        , m_mathError(CalcError::None)
+        , m_errorPosition(0)
+    {
+    }
+
+    /// 🟰 Разбор всего текста; источник лексем Derived готовит заранее
+    Value Run(std::string_view text)
+    {
+        m_text = text;
+        m_depth = 0;
+        m_steps = 0;
+        m_syntaxError = CalcError::None;
+        m_mathError = CalcError::None;
+        m_errorPosition = 0;
+
+        Advance();
+        Value value = ParseExpression(0);
+
+        if (m_syntaxError == CalcError::None && m_token.type != TokenType::End)
+        {
+            Fail(m_token.type == TokenType::RightParen
+                ? CalcError::UnbalancedParentheses
+                : CalcError::SyntaxError, m_token.position);
+        }
+        return value;
+    }
+
+    /// ❌ Итог Run: синтаксическая ошибка важнее арифметической
+    CalcError GetError() const
+    {
+        return m_syntaxError != CalcError::None ? m_syntaxError : m_mathError;
+    }
+
+    /// ✏️ Синтаксическая ошибка (запоминается первая)
+    Value Fail(CalcError error, std::size_t position)
+    {
+        if (m_syntaxError == CalcError::None)
+        {
+            m_syntaxError = error;
+            m_errorPosition = position;
+        }
+        return Value();
+    }
+
+    /// ➗ Арифметическая ошибка (запоминается первая)
+    void MathError(CalcError error)
+    {
+        if (m_mathError == CalcError::None)
+        {
+            m_mathError = error;
+        }
+    }
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🧩 Поведение по умолчанию (Derived перекрывает одноимёнными)
+    //──────────────────────────────────────────────────────────────────────────
+
+    Value Identifier(const Token&)
+    {
+        MathError(CalcError::UnknownVariable);
+        return Value();
+    }
+
+    bool IsFunction(Operator op) const { return GetOperatorInfo(op).form == OperatorForm::Function; }
+    CalcError Function(Operator, Value&) { return CalcError::None; }
+    bool IsPostfix(Operator) const { return false; }
+    CalcError Postfix(Operator, Value&) { return CalcError::None; }
+
+    std::string_view m_text;       // 📝 Текст (литералы, имена, доля разобранного)
+
+private:
+    static constexpr std::uint32_t PROGRESS_STEPS = 4096; // ⏹️ Звеньев между проверками отмены
+
+    Derived& Self() { return static_cast<Derived&>(*this); }
+    void Advance() { m_token = Self().NextToken(); }
+    bool Computing() const { return m_syntaxError == CalcError::None && m_mathError == CalcError::None; }
+
+    /// 🔁 Цикл Пратта
+    Value ParseExpression(int minPrecedence)
+    {
+        if (++m_depth > MAX_DEPTH)
+        {
+            return Fail(CalcError::NestingTooDeep, m_token.position);
+        }
+
+        Value lhs = ParsePrefix();
+
+        while (m_syntaxError == CalcError::None && m_token.type == TokenType::Operator)
+        {
+            // Мегабайтная вставка бывает одной цепочкой: отмена и прогресс между звеньями
+            if (++m_steps % PROGRESS_STEPS == 0)
+            {
+                if (IsJobCancelled())
+                {
+                    Fail(CalcError::Cancelled, m_token.position);
+                    break;
+                }
+                if (!m_text.empty())
+                {
+                    ReportJobProgress(static_cast<double>(m_token.position) / static_cast<double>(m_text.size()));
+                }
+            }
+
+            const Operator op = m_token.op;
+
+            // Постфиксный оператор связывает сильнее всех инфиксных
+            if (Self().IsPostfix(op))
+            {
+                Advance();
+                if (Computing())
+                {
+                    MathError(Self().Postfix(op, lhs));
+                }
+                continue;
+            }
+
+            const int precedence = InfixPrecedence(op);
+            if (precedence <= minPrecedence)
+            {
+                break;
+            }
+
+            Advance();
+            const int nextMin = IsRightAssociative(op) ? precedence - 1 : precedence;
+            const Value rhs = ParseExpression(nextMin);
+
+            if (Computing())
+            {
+                MathError(Self().Apply(op, lhs, rhs));
+            }
+        }
+
+        --m_depth;
+        return lhs;
+    }
+
+    /// 🔢 Числа, имена, скобки, функции, унарные операторы
+    Value ParsePrefix()
+    {
+        const Token token = m_token;
+        Advance();
+
+        switch (token.type)
+        {
+        case TokenType::Number:
+            return Self().Number(token);
+
+        case TokenType::Identifier:
+            return Self().Identifier(token);
+
+        case TokenType::LeftParen:
+        {
+            Value inner = ParseExpression(0);
+            if (m_syntaxError != CalcError::None)
+            {
+                return Value();
+            }
+
+            if (m_token.type != TokenType::RightParen)
+            {
+                return Fail(CalcError::UnbalancedParentheses, m_token.position);
+            }
+
+            Advance();
+            return inner;
+        }
+
+        case TokenType::Operator:
+            if (Self().IsFunction(token.op))
+            {
+                // Аргумент функции — всегда в скобках: их разбирает ParsePrefix
+                if (m_token.type != TokenType::LeftParen)
+                {
+                    return Fail(CalcError::SyntaxError, m_token.position);
+                }
+
+                Value argument = ParsePrefix();
+                if (Computing())
+                {
+                    MathError(Self().Function(token.op, argument));
+                }
+                return argument;
+            }
+            if (token.op == Operator::Subtract || token.op == Operator::Add)
+            {
+                Value operand = ParseExpression(PRECEDENCE_UNARY);
+                if (token.op == Operator::Subtract && m_syntaxError == CalcError::None)
+                {
+                    Self().Negate(operand);
+                }
+                return operand;
+            }
+            break;
+
+        case TokenType::RightParen:
+            return Fail(CalcError::UnbalancedParentheses, token.position);
+
+        case TokenType::End:
+        case TokenType::Invalid:
+            break;
+        }
+
+        return Fail(CalcError::SyntaxError, token.position);
+    }
+
+    Token m_token;                 // 👉 Текущая лексема
+    int m_depth;                   // 🪜 Глубина рекурсии
+    std::uint32_t m_steps;         // 🔁 Пройдено звеньев (опрос отмены)
+    CalcError m_syntaxError;       // ✏️ Первая синтаксическая ошибка
+    CalcError m_mathError;         // ➗ Первая арифметическая ошибка
+    std::size_t m_errorPosition;   // 📍 Позиция синтаксической ошибки
+};
+
+} // namespace calc
+
+#endif // PRATT_PARSER_H
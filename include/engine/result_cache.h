@@ -0,0 +1,115 @@
+#ifndef RESULT_CACHE_H
+#define RESULT_CACHE_H
+
+#include "engine/big_integer.h"
+#include "engine/types.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace calc
+{
+
+/// 💾 Результат в кеше: число и точная запись своего режима
+struct CachedResult
+{
+    double value = 0.0;         // 🔢 Ближайшее double
+    std::string text;           // 💰 Десятичный режим: точная запись
+    BigInteger integer;         // 🔢 Целый режим
+};
+
+/// 📊 Статистика кеша с момента создания (или Load)
+struct ResultCacheStats
+{
+    std::uint64_t hits = 0;     // ✅ Найдено
+    std::uint64_t misses = 0;   // ❌ Не найдено (посчитано заново)
+    std::size_t entries = 0;    // 📋 Записей сейчас
+    std::size_t bytes = 0;      // 📏 Занято ими
+
+    std::uint64_t GetLookups() const { return hits + misses; }
+    double GetHitRate() const { return hits + misses != 0 ? static_cast<double>(hits) / (hits + misses) : 0.0; }
+};
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                          💾 КЕШ РЕЗУЛЬТАТОВ                               ║
+ ║       Дорогие вычисления (1000000!, корень на 10 000 цифр) не             ║
+ ║       повторяются: результат ищется по канонической записи выражения      ║
+ ║                                                                           ║
+ ║  📊 Устройство:                                                           ║
+ ║   • Ключ — лексемы выражения без пробелов и переносов, плюс режим         ║
+ ║     и точность; выражение с именами (ans, переменные) не кешируется       ║
+ ║   • Индекс — хеш ключа → ячейка; сам ключ сверяется при поиске            ║
+ ║   • Вытеснение CLOCK: бит обращения вместо перестановок списка LRU,       ║
+ ║     поиск под мьютексом только читает и ставит бит                        ║
+ ║   • Предел и по записям, и по байтам: один огромный результат             ║
+ ║     не вытесняет всё, больше четверти бюджета не кешируется               ║
+ ║   • Один кеш на GUI (задачи JobService) или на все потоки пакета          ║
+ ║   • Save/Load — двоичный файл: целые лимбами, без перевода в текст        ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class ResultCache
+{
+public:
+    static constexpr std::size_t DEFAULT_CAPACITY = 4096;             // 📏 Записей
+    static constexpr std::size_t DEFAULT_BYTE_BUDGET = 64 << 20;      // 📏 Байт результатов
+    static constexpr std::size_t MAX_KEY_LENGTH = 4096;               // 📏 Ключ длиннее — не кешируется
+    static constexpr std::uint32_t FILE_VERSION = 1;                  // 🏷️ Версия файла
+
+    explicit ResultCache(std::size_t capacity = DEFAULT_CAPACITY,
+        std::size_t byteBudget = DEFAULT_BYTE_BUDGET);
+
+    ResultCache(const ResultCache&) = delete;
+    ResultCache& operator=(const ResultCache&) = delete;
+
+    /// 🔑 Канонический ключ выражения; false — не кешируется (имена, ошибка лексера, длинное)
+    static bool MakeKey(std::string_view text, NumberMode mode, std::uint32_t precision, std::string& key);
+
+    bool Find(std::string_view key, CachedResult& result);        // 🔍 Копия результата
+    void Insert(std::string_view key, CachedResult result);       // 📥 С вытеснением
+    void Clear();                                                 // 🗑️ Записи и статистика
+
+    ResultCacheStats GetStats() const;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 💽 Между сеансами
+    //──────────────────────────────────────────────────────────────────────────
+
+    bool Save(const std::string& path) const;  // 💾 false — ошибка записи
+    bool Load(const std::string& path);        // 📤 false — файла нет или он не читается (кеш пуст)
+
+private:
+    struct Entry
+    {
+        std::string key;                // 🔑 Каноническая запись
+        std::uint64_t hash = 0;         // #️⃣ Хеш ключа
+        CachedResult result;            // 💾 Значение
+        std::size_t bytes = 0;          // 📏 Учтено в бюджете
+        bool used = false;              // 📋 Ячейка занята
+        bool referenced = false;        // 🕐 Бит CLOCK: было обращение после прохода стрелки
+    };
+
+    static std::uint64_t Hash(std::string_view key);
+    void InsertLocked(std::string_view key, std::uint64_t hash, CachedResult&& result);
+    std::size_t TakeSlot(std::size_t keep);     // 🕐 Свободная или вытесненная ячейка (не keep)
+    void Release(std::size_t slot);             // 🗑️ Запись из ячейки и индекса
+
+    mutable std::mutex m_mutex;                 // 🔒 Задачи GUI и потоки пакета
+    std::vector<Entry> m_entries;               // 📋 Кольцо CLOCK
+    std::unordered_map<std::uint64_t, std::uint32_t> m_index; // 🗂️ Хеш → ячейка
+    std::size_t m_hand = 0;                     // 🕐 Стрелка CLOCK
+    std::size_t m_count = 0;                    // 📋 Занятых ячеек
+    std::size_t m_bytes = 0;                    // 📏 Байт в записях
+    std::size_t m_byteBudget;                   // 📏 Предел байт
+    std::uint64_t m_hits = 0;                   // ✅ Попаданий
+    std::uint64_t m_misses = 0;                 // ❌ Промахов
+};
+
+} // namespace calc
+
+#endif // RESULT_CACHE_H
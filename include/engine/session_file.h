@@ -0,0 +1,172 @@
+#ifndef SESSION_FILE_H
+#define SESSION_FILE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                    💾 ФАЙЛ СЕАНСА (ИСТОРИЯ + СОСТОЯНИЕ)                   ║
+ ║        Двоичный файл с версией, отображённый в память для записи          ║
+ ║                                                                           ║
+ ║  📊 Устройство:                                                           ║
+ ║   • [0, HEADER_SIZE) — заголовок и два слота состояния сеанса:            ║
+ ║     запись идёт в неактивный слот, затем растёт номер поколения —         ║
+ ║     оборванная запись не портит прежнее состояние                         ║
+ ║   • Дальше — блоки истории по BLOCK_SIZE, каждый отображён отдельно:      ║
+ ║     рост файла не сдвигает уже выданные указатели                         ║
+ ║   • Open читает только заголовки — время старта не зависит от числа       ║
+ ║     записей; страницы подгружаются по мере чтения                         ║
+ ║   • Flush сбрасывает на диск заголовок и изменённые блоки                 ║
+ ║   • Файл открывается монопольно: второе окно получает Locked              ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class SessionFile
+{
+public:
+    static constexpr std::uint32_t VERSION = 1;                  // 🏷️ Версия формата
+    static constexpr std::size_t HEADER_SIZE = 64 * 1024;        // 📏 Заголовок (кратен гранулярности отображения)
+    static constexpr std::size_t BLOCK_SIZE = 1024 * 1024;       // 📏 Блок истории
+    static constexpr std::size_t SESSION_SLOT_OFFSET = 4096;     // 📍 Первый слот состояния
+    static constexpr std::size_t SESSION_SLOT_SIZE = 30 * 1024;  // 📏 Слот состояния
+    static constexpr std::size_t SESSION_CAPACITY = SESSION_SLOT_SIZE - 16; // 📏 Байт состояния
+
+    enum class OpenStatus
+    {
+        Opened,         // ✅ Прочитан существующий файл
+        Created,        // 🆕 Файла не было (или он был повреждён) — создан пустой
+        Locked,         // 🔒 Файл занят другим экземпляром
+        Incompatible,   // 🏷️ Файл новой версии — не трогаем
+        Failed          // ❌ Ошибка ввода-вывода
+    };
+
+    SessionFile() = default;
+    ~SessionFile();
+
+    SessionFile(const SessionFile&) = delete;
+    SessionFile& operator=(const SessionFile&) = delete;
+
+    OpenStatus Open(const std::string& path);   // 📂 Открытие или создание
+    void Close();                               // 🚪 Flush и снятие отображений
+
+    bool IsOpen() const { return m_header != nullptr; }
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 📜 Блоки истории
+    //──────────────────────────────────────────────────────────────────────────
+
+    std::size_t GetBlockCount() const { return m_blocks.size(); }
+    char* GetBlock(std::size_t index) const { return m_blocks[index]; }
+    char* AppendBlock();                        // ➕ Новый блок в конце файла (нули)
+    void MarkBlockDirty(std::size_t index);     // ✏️ Блок изменён с прошлого Flush
+    bool RemoveBlocks();                        // 🗑️ Файл укорачивается до заголовка
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🧩 Состояние сеанса
+    //──────────────────────────────────────────────────────────────────────────
+
+    std::string_view ReadSession() const;       // 📤 Последнее целое состояние (пусто — нет)
+    bool WriteSession(std::string_view state);  // 📥 false — больше SESSION_CAPACITY
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 💽 Долговечность
+    //──────────────────────────────────────────────────────────────────────────
+
+    bool IsDirty() const { return m_headerDirty || m_dirtyFrom < m_blocks.size(); }
+    bool Flush();                               // 💽 Изменённое — на диск (синхронно)
+
+private:
+    bool Resize(std::size_t size);              // 📏 Новый размер файла
+    char* MapRange(std::size_t offset, std::size_t size); // 🗺️ Отображение участка
+    void Unmap(char* view, std::size_t size);   // 🚪 Снятие отображения участка
+    bool FlushRange(char* view, std::size_t size); // 💽 Сброс участка на диск
+    void InitializeHeader();                    // 🆕 Заголовок пустого файла
+    int FindIntactSlot() const;                 // 🧩 Слот последнего целого состояния (-1 — нет)
+
+    char* m_header = nullptr;                   // 🗺️ Отображение заголовка
+    std::vector<char*> m_blocks;                // 🗺️ Отображения блоков
+    std::size_t m_dirtyFrom = 0;                // ✏️ Первый изменённый блок
+    bool m_headerDirty = false;                 // ✏️ Заголовок изменён
+
+#ifdef _WIN32
+    void* m_file = nullptr;                     // 🪟 HANDLE файла
+#else
+    int m_fd = -1;                              // 🐧 Дескриптор файла
+#endif
+};
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                    🧩 ДВОИЧНАЯ ЗАПИСЬ СОСТОЯНИЯ СЕАНСА                    ║
+ ║     Значения подряд в родном порядке байт; файл не покидает машину       ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class SessionWriter
+{
+public:
+    template<typename T>
+    void Write(T value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only plain values are written");
+        const std::size_t offset = m_data.size();
+        m_data.resize(offset + sizeof(T));
+        std::memcpy(&m_data[offset], &value, sizeof(T));
+    }
+
+    void WriteString(std::string_view text)
+    {
+        Write(static_cast<std::uint32_t>(text.size()));
+        m_data.append(text.data(), text.size());
+    }
+
+    const std::string& GetData() const { return m_data; }
+
+private:
+    std::string m_data;     // 💾 Накопленные байты
+};
+
+class SessionReader
+{
+public:
+    explicit SessionReader(std::string_view data) : m_data(data) {}
+
+    template<typename T>
+    bool Read(T& value)
+    {
+        static_assert(std::is_trivially_copyable_v<T>, "Only plain values are read");
+        if (m_data.size() < sizeof(T))
+        {
+            return false;
+        }
+        std::memcpy(&value, m_data.data(), sizeof(T));
+        m_data.remove_prefix(sizeof(T));
+        return true;
+    }
+
+    bool ReadString(std::string& text)
+    {
+        std::uint32_t length = 0;
+        if (!Read(length) || m_data.size() < length)
+        {
+            return false;
+        }
+        text.assign(m_data.data(), length);
+        m_data.remove_prefix(length);
+        return true;
+    }
+
+private:
+    std::string_view m_data;    // 📤 Непрочитанный остаток
+};
+
+} // namespace calc
+
+#endif // SESSION_FILE_H
@@ -0,0 +1,91 @@
+#ifndef SYMBOL_TABLE_H
+#define SYMBOL_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                          🏷️ ТАБЛИЦА ИМЁН                                   ║
+ ║       Переменные сеанса (x = 3.2): имя интернируется один раз и           ║
+ ║       дальше известно только по номеру слота                              ║
+ ║                                                                           ║
+ ║  📊 Устройство:                                                           ║
+ ║   • Открытая адресация с линейным пробированием в плоском массиве;        ║
+ ║     заполнение не больше половины, размер — степень двойки                ║
+ ║   • Номер слота выдаётся при первом упоминании имени и не меняется:       ║
+ ║     компиляция выражения переводит имена в номера, вычисление             ║
+ ║     читает значения по номерам, не хешируя строк                          ║
+ ║   • Все имена — подряд в одном буфере; значения — в плотном массиве       ║
+ ║   • Слот без значения (имя упомянуто, но не присвоено) — UnknownVariable  ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class SymbolTable
+{
+public:
+    static constexpr std::uint32_t NO_SYMBOL = 0xFFFFFFFFu;  // 🚫 Имени нет или таблица полна
+    static constexpr std::size_t MAX_SYMBOLS = 256;           // 📏 Имён в сеансе
+    static constexpr std::size_t MAX_NAME_LENGTH = 64;        // 📏 Символов в имени
+
+    /// 📏 capacity — предел имён (лист формул держит больше, чем сеанс)
+    explicit SymbolTable(std::size_t capacity = MAX_SYMBOLS);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🔍 Имена (хешируются только здесь)
+    //──────────────────────────────────────────────────────────────────────────
+
+    /// 🏷️ Слот имени, новый при первом упоминании; NO_SYMBOL — нет места или имя длинное
+    std::uint32_t Intern(std::string_view name);
+
+    /// 🔍 Слот имени без добавления; NO_SYMBOL — не встречалось
+    std::uint32_t Find(std::string_view name) const;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 💾 Значения (по номеру слота)
+    //──────────────────────────────────────────────────────────────────────────
+
+    void SetValue(std::uint32_t symbol, double value)
+    {
+        m_values[symbol] = value;
+        m_defined[symbol] = 1;
+    }
+
+    double GetValue(std::uint32_t symbol) const { return m_values[symbol]; }
+    bool IsDefined(std::uint32_t symbol) const { return m_defined[symbol] != 0; }
+
+    std::string_view GetName(std::uint32_t symbol) const
+    {
+        return std::string_view(m_names).substr(m_nameOffsets[symbol],
+            m_nameOffsets[symbol + 1] - m_nameOffsets[symbol]);
+    }
+
+    std::uint32_t GetCount() const { return static_cast<std::uint32_t>(m_values.size()); }
+    std::size_t GetCapacity() const { return m_capacity; }
+
+    void Clear();                               // 🗑️ Все имена и значения
+
+private:
+    static std::uint32_t Hash(std::string_view name);
+
+    /// 📍 Ячейка с этим именем или пустая ячейка, где ему место
+    std::size_t Probe(std::string_view name, std::uint32_t hash) const;
+    void Grow();                                // 📏 Вдвое больше ячеек
+
+    std::size_t m_capacity;                     // 📏 Предел имён
+    std::vector<std::uint32_t> m_cells;         // 🗂️ Номер слота + 1; 0 — пусто
+    std::vector<std::uint32_t> m_hashes;        // #️⃣ Хеш имени по слотам
+    std::vector<std::uint32_t> m_nameOffsets;   // 📍 Начало имени в m_names (слотов + 1)
+    std::string m_names;                        // 🔤 Имена подряд
+    std::vector<double> m_values;               // 💾 Значения по слотам
+    std::vector<std::uint8_t> m_defined;        // ✅ Значение присвоено
+};
+
+} // namespace calc
+
+#endif // SYMBOL_TABLE_H
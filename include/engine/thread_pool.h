@@ -0,0 +1,77 @@
+﻿#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                       🧵 ПУЛ ПОТОКОВ С КРАЖЕЙ ЗАДАЧ                       ║
+ ║                                                                           ║
+ ║  📊 Устройство:                                                           ║
+ ║   • У каждого рабочего своя очередь                                       ║
+ ║   • Владелец берёт задачи с конца (LIFO, тёплый кеш)                      ║
+ ║   • Простаивающий рабочий крадёт с начала чужой очереди (FIFO)            ║
+ ║   • Внешние Submit() раскладываются по очередям по кругу                  ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class ThreadPool
+{
+public:
+    using Task = std::function<void()>;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🏗️ Конструктор и деструктор
+    //──────────────────────────────────────────────────────────────────────────
+
+    explicit ThreadPool(unsigned threadCount = 0);  // 0 — по числу ядер
+    ~ThreadPool();                                  // ⏹️ Дожидается всех задач
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🎮 Публичный интерфейс
+    //──────────────────────────────────────────────────────────────────────────
+
+    void Submit(Task task);                         // 📥 Постановка задачи
+    void WaitIdle();                                // ⏳ Ожидание опустошения пула
+
+    unsigned GetThreadCount() const { return static_cast<unsigned>(m_threads.size()); }
+    static unsigned DefaultThreadCount();           // 🖥️ Число аппаратных потоков
+
+private:
+    struct WorkerQueue
+    {
+        std::mutex mutex;             // 🔒 Защита очереди
+        std::deque<Task> tasks;       // 📋 Задачи рабочего
+    };
+
+    void WorkerLoop(unsigned index);                // 🔁 Цикл рабочего потока
+    bool TryPopLocal(unsigned index, Task& task);   // 👉 Своя очередь (с конца)
+    bool TrySteal(unsigned index, Task& task);      // 🥷 Чужая очередь (с начала)
+
+    std::vector<std::unique_ptr<WorkerQueue>> m_queues;  // 📋 Очереди рабочих
+    std::vector<std::thread> m_threads;                  // 🧵 Рабочие потоки
+
+    std::mutex m_wakeMutex;                 // 🔒 Сон/пробуждение
+    std::condition_variable m_wake;         // 🔔 Появилась работа / остановка
+    std::condition_variable m_idle;         // 💤 Все задачи выполнены
+    std::atomic<std::size_t> m_pending;     // 📊 Поставлено и не завершено
+    std::atomic<unsigned> m_nextQueue;      // 🔄 Круговой выбор очереди
+    bool m_stopping;                        // ⏹️ Флаг остановки (под m_wakeMutex)
+};
+
+} // namespace calc
+
+#endif // THREAD_POOL_H
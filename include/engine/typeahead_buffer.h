@@ -0,0 +1,62 @@
+#ifndef TYPEAHEAD_BUFFER_H
+#define TYPEAHEAD_BUFFER_H
+
+#include <array>
+#include <cstddef>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                      ⌨️ БУФЕР ОПЕРЕЖАЮЩЕГО ВВОДА                          ║
+ ║       Кольцо фиксированного размера: клавиши копятся между кадрами,       ║
+ ║       UI забирает их разом и обновляет дисплей один раз за пачку          ║
+ ║                                                                           ║
+ ║  📊 Устройство:                                                           ║
+ ║   • CAPACITY — степень двойки, индекс — счётчик по маске                  ║
+ ║   • Ни одного выделения памяти: Push/Pop — O(1)                           ║
+ ║   • Один поток (UI): и запись, и чтение идут из цикла событий             ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class TypeaheadBuffer
+{
+public:
+    static constexpr std::size_t CAPACITY = 4096;     // 📏 Клавиш в буфере
+    static_assert((CAPACITY & (CAPACITY - 1)) == 0, "CAPACITY must be a power of two");
+
+    /// 📥 Клавиша в конец; false — буфер полон, клавиша отброшена
+    bool Push(char key)
+    {
+        if (m_tail - m_head == CAPACITY)
+        {
+            return false;
+        }
+        m_keys[m_tail++ & (CAPACITY - 1)] = key;
+        return true;
+    }
+
+    /// 📤 Самая старая клавиша; false — буфер пуст
+    bool Pop(char& key)
+    {
+        if (m_head == m_tail)
+        {
+            return false;
+        }
+        key = m_keys[m_head++ & (CAPACITY - 1)];
+        return true;
+    }
+
+    void Clear() { m_head = m_tail; }                  // 🗑️ Отброс всего набранного
+    bool IsEmpty() const { return m_head == m_tail; }
+    std::size_t GetSize() const { return m_tail - m_head; }
+
+private:
+    std::array<char, CAPACITY> m_keys{};    // ⌨️ Клавиши
+    std::size_t m_head = 0;                 // 📤 Счётчик прочитанных
+    std::size_t m_tail = 0;                 // 📥 Счётчик записанных
+};
+
+} // namespace calc
+
+#endif // TYPEAHEAD_BUFFER_H
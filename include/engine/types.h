@@ -0,0 +1,73 @@
+﻿#ifndef ENGINE_TYPES_H
+#define ENGINE_TYPES_H
+
+#include <cstdint>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                        ➕ ОПЕРАТОРЫ И ОШИБКИ ЯДРА                         ║
+ ║              Базовые типы вычислительного ядра без wxWidgets              ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+enum class Operator : std::uint8_t
+{
+    None,       // ∅ Нет отложенного оператора
+    Add,        // ➕ Сложение
+    Subtract,   // ➖ Вычитание
+    Multiply,   // ✖️ Умножение
+    Divide,     // ➗ Деление
+    Power,      // 🔺 Возведение в степень
+    Factorial,  // ❗ Факториал (постфиксный, только целый режим)
+    Sqrt,       // √ Квадратный корень
+    Exp,        // 📈 Экспонента
+    Ln,         // 📉 Натуральный логарифм
+    Log10,      // 🔟 Десятичный логарифм
+    Sin,        // 〰️ Синус (радианы)
+    Cos,        // 〰️ Косинус
+    Tan,        // 📐 Тангенс
+    Sinh,       // 〰️ Гиперболический синус
+    Cosh,       // 〰️ Гиперболический косинус
+    Tanh,       // 📐 Гиперболический тангенс
+    Gamma       // Γ Гамма-функция
+};
+
+enum class CalcError : std::uint8_t
+{
+    None,                   // ✅ Без ошибок
+    InvalidNumber,          // 🔢 Некорректное число
+    DivisionByZero,         // ➗ Деление на ноль
+    SyntaxError,            // ✏️ Синтаксическая ошибка выражения
+    UnbalancedParentheses,  // 🔗 Несбалансированные скобки
+    NestingTooDeep,         // 🪜 Слишком глубокая вложенность
+    UnknownVariable,        // 🏷️ Переменная без значения
+    Overflow,               // 📏 Порядок результата вне допустимого диапазона
+    Cancelled               // ⏹️ Фоновое вычисление отменено
+};
+
+enum class NumberFormat : std::uint8_t
+{
+    Compact,    // 🔟 Как "%.10g" — 10 значащих цифр
+    Full        // 🎯 Кратчайшая запись, читающаяся обратно в то же double
+};
+
+enum class NumberMode : std::uint8_t
+{
+    Binary,     // ⚡ double — быстро, но 0.1 + 0.2 ≠ 0.3
+    Decimal,    // 💰 BigDecimal — точная десятичная арифметика с заданной точностью
+    Integer     // 🔢 BigInteger — целые любой длины (факториалы, степени)
+};
+
+struct EvalResult
+{
+    double value = 0.0;                 // 💾 Результат вычисления
+    CalcError error = CalcError::None;  // ❌ Код ошибки
+
+    bool Ok() const { return error == CalcError::None; }
+};
+
+} // namespace calc
+
+#endif // ENGINE_TYPES_H
@@ -0,0 +1,40 @@
+﻿#ifndef VM_H
+#define VM_H
+
+#include "engine/bytecode.h"
+#include "engine/types.h"
+
+#include <vector>
+
+namespace calc
+{
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                         🖥️ ВИРТУАЛЬНАЯ МАШИНА                            ║
+ ║                                                                           ║
+ ║  📊 Особенности:                                                          ║
+ ║   • Файл регистров выделяется один раз в Load()                           ║
+ ║   • Константы загружаются один раз, Run() копирует только переменные      ║
+ ║   • Computed goto (GCC/Clang) или switch (MSVC)                           ║
+ ║   • Ни одной аллокации на вычисление                                      ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class VirtualMachine
+{
+public:
+    VirtualMachine() = default;
+
+    void Load(const Program& program);            // 📥 Привязка программы
+    EvalResult Run(const double* variables);      // ▶️ Вычисление (variables[i] → слот i)
+
+    bool IsLoaded() const { return m_program != nullptr; }
+
+private:
+    const Program* m_program = nullptr;   // 📜 Загруженная программа
+    std::vector<double> m_registers;      // 🎯 Файл регистров
+};
+
+} // namespace calc
+
+#endif // VM_H
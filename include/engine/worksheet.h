@@ -0,0 +1,152 @@
+#ifndef WORKSHEET_H
+#define WORKSHEET_H
+
+#include "engine/arena.h"
+#include "engine/bytecode.h"
+#include "engine/compiler.h"
+#include "engine/lexer.h"
+#include "engine/symbol_table.h"
+#include "engine/types.h"
+#include "engine/vm.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace calc
+{
+
+class ThreadPool;
+
+/// 📊 Итог последнего пересчёта листа
+struct WorksheetStats
+{
+    std::size_t recomputed = 0;     // 🔁 Пересчитано строк
+    std::size_t components = 0;     // 🧩 Независимых подграфов среди них
+    unsigned threads = 0;           // 🧵 Потоков (1 — считалось в вызывающем)
+};
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                          📊 ЛИСТ ФОРМУЛ                                   ║
+ ║       Строка — формула "имя = выражение" (или просто выражение);          ║
+ ║       выражение ссылается на имена строк выше                             ║
+ ║                                                                           ║
+ ║  📊 Устройство:                                                           ║
+ ║   • Строка компилируется в байткод при правке, имена переводятся          ║
+ ║     в слоты таблицы имён; вычисление строк не разбирает                   ║
+ ║   • Ссылка ведёт на ближайшую строку выше с этим именем; связи            ║
+ ║     пересобираются одним проходом по массиву "слот → строка"              ║
+ ║   • Правка помечает строку грязной, грязь течёт к зависимым;              ║
+ ║     пересчитываются только грязные строки, в порядке строк                ║
+ ║     (это и есть топологический порядок — ссылки только вверх)             ║
+ ║   • Независимые подграфы грязных строк считаются в пуле потоков,          ║
+ ║     у каждого потока своя виртуальная машина                              ║
+ ║   • Ошибка строки переходит к зависимым; имени ниже нет — UnknownVariable ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class Worksheet
+{
+public:
+    static constexpr std::size_t MAX_NAMES = 65536;          // 📏 Имён в таблице листа
+    static constexpr std::size_t PARALLEL_MIN_CELLS = 512;   // 🧵 Меньше грязных строк — без пула
+
+    explicit Worksheet(unsigned threadCount = 0);  // 0 — по числу ядер
+    ~Worksheet();
+
+    Worksheet(const Worksheet&) = delete;
+    Worksheet& operator=(const Worksheet&) = delete;
+
+    //──────────────────────────────────────────────────────────────────────────
+    // ✏️ Правка (строка компилируется сразу, считается в Recalculate)
+    //──────────────────────────────────────────────────────────────────────────
+
+    void SetLine(std::size_t line, std::string_view text);     // ✏️ Тот же текст — ничего не делает
+    void InsertLine(std::size_t line, std::string_view text);  // ➕ Новая строка перед line
+    void RemoveLine(std::size_t line);                         // ➖ Зависимые ищут имя выше
+    void SetText(std::string_view text);   // 📋 Весь лист; совпавшие начало и конец не трогаются
+    void Clear();                          // 🗑️ Пустой лист
+
+    /// 🔁 Пересчёт грязных строк и их зависимых
+    const WorksheetStats& Recalculate();
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🔍 Чтение
+    //──────────────────────────────────────────────────────────────────────────
+
+    std::size_t GetLineCount() const { return m_order.size(); }
+    const std::string& GetLine(std::size_t line) const { return m_cells[m_order[line]].text; }
+    std::string_view GetName(std::size_t line) const;           // 🏷️ Пусто — строка без имени
+    bool IsBlank(std::size_t line) const;                       // ⬜ Строка без формулы
+    const EvalResult& GetResult(std::size_t line) const { return m_cells[m_order[line]].result; }
+
+    const WorksheetStats& GetStats() const { return m_stats; }
+    bool HasPendingEdits() const { return m_pendingEdits; }
+
+    /// 💾 Все строки через '\n' (для сохранения в файл)
+    void WriteText(std::string& text) const;
+
+private:
+    static constexpr std::uint32_t NO_CELL = 0xFFFFFFFFu;
+
+    /// 📄 Строка листа; номер ячейки не меняется при вставке и удалении строк
+    struct Cell
+    {
+        std::string text;                              // 📝 Формула как набрана
+        Program program;                               // 📜 Байткод выражения
+        std::vector<std::uint32_t> symbols;            // 🏷️ Переменная программы → слот имени
+        std::vector<std::uint32_t> inputs;             // 🔗 Переменная программы → ячейка-источник
+        std::uint32_t name = SymbolTable::NO_SYMBOL;   // 🏷️ Имя, которое строка определяет
+        CalcError error = CalcError::None;             // ❌ Ошибка разбора (считать нечего)
+        EvalResult result;                             // 💾 Последнее значение
+        bool dirty = true;                             // ✏️ Нужен пересчёт
+    };
+
+    /// 🧵 Рабочее место потока пересчёта
+    struct Worker
+    {
+        VirtualMachine vm;                             // ▶️ Своя машина
+        std::vector<double> values;                    // 🔢 Значения входов строки
+        std::vector<std::uint32_t> cells;              // 📋 Ячейки группы в порядке строк
+    };
+
+    std::uint32_t NewCell(std::string_view text);      // 📄 Ячейка (из освобождённых или новая)
+    void Compile(Cell& cell);                          // 📜 Текст → байткод и слоты имён
+    std::uint32_t InternName(std::string_view name);   // 🏷️ Со сжатием таблицы при переполнении
+    void CompactSymbols();                             // 🗜️ Таблица заново — только живые имена
+    void Relink();                                     // 🔗 Входы строк и грязь зависимых
+    std::size_t Partition(unsigned threads);           // 🧩 Подграфы → группы потоков
+    std::uint32_t FindRoot(std::uint32_t cell);        // 🌳 Корень подграфа (union-find)
+    void Evaluate(Cell& cell, Worker& worker);         // ▶️ Одна строка
+
+    std::vector<Cell> m_cells;                         // 📄 Ячейки (в том числе свободные)
+    std::vector<std::uint32_t> m_order;                // 📋 Строка → ячейка
+    std::vector<std::uint32_t> m_freeCells;            // ♻️ Свободные ячейки
+    std::vector<std::uint32_t> m_releasedCells;        // ⏳ Удалены до Relink (на них ещё ссылаются)
+    bool m_pendingEdits = false;                       // ✏️ Правки после Recalculate
+
+    SymbolTable m_symbols;                             // 🏷️ Имена листа
+    std::vector<std::uint32_t> m_definers;             // 🔗 Слот имени → ближайшая ячейка выше
+
+    std::vector<Token> m_tokens;                       // 📋 Буфер лексера
+    Arena m_arena;                                     // 📦 AST компилируемой строки
+    BytecodeCompiler m_compiler;                       // ⚙️ Общий компилятор
+
+    std::vector<std::uint32_t> m_dirtyCells;           // ✏️ Грязные ячейки в порядке строк
+    std::vector<std::uint32_t> m_parents;              // 🌳 Union-find по ячейкам
+    std::vector<std::uint32_t> m_sizes;                // 📏 Размер подграфа у корня
+    std::vector<std::uint32_t> m_groupOf;              // 🧵 Корень → группа
+    std::vector<std::uint32_t> m_roots;                // 🧩 Корни подграфов
+
+    unsigned m_threadCount;                            // 🧵 Предел потоков
+    std::vector<Worker> m_workers;                     // 🧵 Рабочие места (нулевое — вызывающий)
+    std::unique_ptr<ThreadPool> m_pool;                // 🧵 Создаётся при первом большом пересчёте
+    WorksheetStats m_stats;                            // 📊 Последний пересчёт
+};
+
+} // namespace calc
+
+#endif // WORKSHEET_H
@@ -4,10 +4,10 @@
 
 #include <wx/wx.h>
 
+#include "engine/operators.h"
+
 #include <array>
-#include <memory>
-#include <unordered_map>
-#include <string_view>
+#include <cstdint>
 
 /*
  ╔═══════════════════════════════════════════════════════════════════════════╗
@@ -16,23 +16,41 @@
  ╚═══════════════════════════════════════════════════════════════════════════╝
 */
 wxDECLARE_EVENT(EVT_CALC_NUMBER, wxCommandEvent);      // 🔢 Ввод числа
-wxDECLARE_EVENT(EVT_CALC_OPERATOR, wxCommandEvent);    // ➕ Математический оператор
+wxDECLARE_EVENT(EVT_CALC_OPERATOR, wxCommandEvent);    // ➕ Математический оператор (GetInt() — calc::Operator)
 wxDECLARE_EVENT(EVT_CALC_EQUALS, wxCommandEvent);      // 🟰 Вычисление результата
 wxDECLARE_EVENT(EVT_CALC_CLEAR, wxCommandEvent);       // 🗑️ Полная очистка
 wxDECLARE_EVENT(EVT_CALC_CLEAR_ENTRY, wxCommandEvent); // ❌ Очистка текущего ввода
 wxDECLARE_EVENT(EVT_CALC_DECIMAL, wxCommandEvent);     // • Десятичная точка
 wxDECLARE_EVENT(EVT_CALC_BACKSPACE, wxCommandEvent);   // ⌫ Удаление символа
+wxDECLARE_EVENT(EVT_CALC_EXPONENT, wxCommandEvent);    // 🔺 Ввод порядка (EXP)
+wxDECLARE_EVENT(EVT_CALC_FUNCTION, wxCommandEvent);    // 🧮 Функция к операнду (GetInt() — calc::Operator)
+wxDECLARE_EVENT(EVT_CALC_MEMORY, wxCommandEvent);      // 💾 Память (GetInt() — MemoryOp)
+
+/// 💾 Клавиша памяти — числом в событии, как оператор
+enum class MemoryOp : int
+{
+    Clear,      // 🗑️ MC
+    Recall,     // 📤 MR
+    Add,        // ➕ M+
+    Subtract    // ➖ M-
+};
 
 /*
  ╔═══════════════════════════════════════════════════════════════════════════╗
  ║                           🎛️ ПАНЕЛЬ КНОПОК                                ║
- ║          Основной класс для управления кнопками калькулятора              ║
+ ║          Клавиатура калькулятора — одно окно, рисуемое вручную            ║
  ║                                                                           ║
  ║  📊 Функциональность:                                                     ║
- ║   • Создание и управление кнопками                                        ║
- ║   • Обработка событий нажатий                                             ║
- ║   • Визуальные эффекты и подсветка                                        ║
- ║   • Адаптивная раскладка                                                  ║
+ ║   • 32 клавиши без дочерних wxButton: попадание мыши считает сама панель  ║
+ ║   • Две верхние строки — страницы научных функций; 2nd/1st листает их,    ║
+ ║     подписи и функции берутся из реестра операторов ядра                  ║
+ ║   • Под ними — строка памяти: MC MR M+ M-                                 ║
+ ║   • Клавиши рисуются в кешированный задний буфер; OnPaint только          ║
+ ║     копирует из него обновляемые прямоугольники                           ║
+ ║   • Нажатие, наведение и подсветка перерисовывают лишь свою клавишу       ║
+ ║   • Полная перерисовка буфера — только после изменения размера            ║
+ ║   • Шрифт, отступы и размеры подписей заранее рассчитаны для трёх         ║
+ ║     классов размера; при resize пересчитываются только прямоугольники     ║
  ╚═══════════════════════════════════════════════════════════════════════════╝
 */
 class ButtonPanel : public wxPanel
@@ -56,13 +74,6 @@ public:
     ButtonPanel(const ButtonPanel&) = delete;
     ButtonPanel& operator=(const ButtonPanel&) = delete;
 
-    //┌─────────────────────────────────────────────────────────────────────────┐
-    //│                        ↔️ РАЗРЕШЕНИЕ ПЕРЕМЕЩЕНИЯ                        │
-    //└─────────────────────────────────────────────────────────────────────────┘
-    
-    ButtonPanel(ButtonPanel&&) = default;
-    ButtonPanel& operator=(ButtonPanel&&) = default;
-
     //┌─────────────────────────────────────────────────────────────────────────┐
     //│                         🎮 ПУБЛИЧНЫЕ МЕТОДЫ                             │
     //└─────────────────────────────────────────────────────────────────────────┘
@@ -71,11 +82,18 @@ public:
     void SetButtonEnabled(const wxString& label, bool enabled);
     
     /// ✨ Подсветка операторной кнопки
-    void HighlightOperator(const wxString& op, bool highlight = true);
+    void HighlightOperator(calc::Operator op, bool highlight = true);
     
     /// 💡 Сброс всех подсветок
     void ClearHighlights();
 
+    /// 🧮 Доступность клавиш функций (в целом режиме функций нет)
+    void SetFunctionsEnabled(bool enabled);
+
+protected:
+    /// 📐 Размер, при котором клавиши не меньше BUTTON_WIDTH × BUTTON_HEIGHT
+    wxSize DoGetBestClientSize() const override;
+
 private:
     /*
      ╔═══════════════════════════════════════════════════════════════════════╗
@@ -86,25 +104,97 @@ private:
     static constexpr int BUTTON_HEIGHT = 50;    // 📏 Высота кнопки
     static constexpr int BUTTON_SPACING = 5;    // 📊 Интервал между кнопками
     static constexpr int PANEL_MARGIN = 10;     // 🖼️ Отступы панели
+    static constexpr int GRID_ROWS = 8;         // ↕️ Строк клавиш
+    static constexpr int GRID_COLUMNS = 4;      // ↔️ Столбцов клавиш
+    static constexpr int KEY_COUNT = GRID_ROWS * GRID_COLUMNS;
+    static constexpr int PAGE_KEYS = 2 * GRID_COLUMNS;  // 🧮 Клавиш на странице функций (верхние строки)
+    static constexpr int PAGE_COUNT = 2;        // 📑 Страниц функций
+    static constexpr int NO_KEY = -1;           // 🚫 Индекс «ни одной клавиши»
+
+    static_assert(KEY_COUNT <= 32, "m_dirtyButtons holds one bit per key");
+
+    /*
+     ╔═══════════════════════════════════════════════════════════════════════╗
+     ║                        📐 КЛАССЫ РАЗМЕРА                             ║
+     ║     Класс выбирается по высоте клавиши; всё, что зависит от          ║
+     ║     шрифта, измеряется один раз на класс                             ║
+     ╚═══════════════════════════════════════════════════════════════════════╝
+    */
+    enum SizeClass
+    {
+        SIZE_COMPACT,               // 🤏 Клавиши ниже BUTTON_HEIGHT
+        SIZE_REGULAR,               // 🔘 Обычное окно
+        SIZE_LARGE,                 // 🖥️ Развёрнутое или полноэкранное окно
+        SIZE_CLASS_COUNT
+    };
+
+    struct SizeClassStyle
+    {
+        int minButtonHeight;        // 📏 С какой высоты клавиши действует класс
+        int spacing;                // 📊 Интервал между кнопками
+        int margin;                 // 🖼️ Отступы панели
+        int radius;                 // ⭕ Скругление углов
+        int fontPoints;             // 🔤 Кегль подписей
+    };
+
+    static constexpr SizeClassStyle SIZE_CLASSES[SIZE_CLASS_COUNT] =
+    {
+        { 0,                  3, 6,             4,  11 },
+        { BUTTON_HEIGHT,      BUTTON_SPACING, PANEL_MARGIN, 6,  14 },
+        { 2 * BUTTON_HEIGHT,  8, 14,            10, 20 }
+    };
+
+    /// 📏 Измеренное для класса: шрифт и размеры всех подписей
+    struct SizeClassMetrics
+    {
+        bool measured = false;
+        wxFont font;
+        std::array<wxSize, KEY_COUNT> labelSizes;
+    };
 
     /*
      ╔═══════════════════════════════════════════════════════════════════════╗
      ║                         📝 СТРУКТУРА КНОПКИ                          ║
-     ║                    Содержит всю информацию о кнопке                   ║
+     ║          Клавиша — запись в таблице, а не отдельное окно             ║
      ╚═══════════════════════════════════════════════════════════════════════╝
     */
+    enum class KeyKind
+    {
+        Digit,          // 🔢 0-9
+        Operator,       // ➕ + - × ÷
+        Decimal,        // • Десятичная точка
+        Exponent,       // 🔺 EXP
+        Equals,         // 🟰 =
+        Clear,          // 🗑️ C
+        ClearEntry,     // ❌ CE
+        Backspace,      // ⌫ <-
+        Function,       // 🧮 sin, √, ln...
+        Memory,         // 💾 MC MR M+ M-
+        Page            // 📑 Следующая страница функций
+    };
+
+    struct KeySpec
+    {
+        const char* label;           // 🏷️ Подпись (UTF-8)
+        const char* value;           // 💾 Значение для передачи
+        KeyKind kind;                // 🧩 Что делает нажатие
+        calc::Operator op;           // ➕ Оператор или функция из реестра
+        MemoryOp memory = MemoryOp::Clear; // 💾 Действие клавиши памяти
+    };
+
+    /// 🗂️ Клавиша оператора или функции — подпись и значение из реестра
+    static constexpr KeySpec RegistryKey(calc::Operator op);
+
     struct ButtonInfo {
         wxString label;              // 🏷️ Текст на кнопке
         wxString value;              // 💾 Значение для передачи
-        wxColour normalColor;        // 🎨 Обычный цвет
-        wxColour highlightColor;     // ✨ Цвет при подсветке
-        bool isOperator = false;     // ⚡ Флаг операторной кнопки
-
-        ButtonInfo(const wxString& lbl, const wxString& val,
-            const wxColour& normalCol, const wxColour& highlightCol = wxNullColour,
-            bool op = false)
-            : label(lbl), value(val), normalColor(normalCol), highlightColor(highlightCol), isOperator(op) {
-        }
+        KeyKind kind = KeyKind::Digit; // 🧩 Что делает нажатие
+        calc::Operator op = calc::Operator::None; // ➕ Оператор или функция из реестра
+        MemoryOp memory = MemoryOp::Clear; // 💾 Действие клавиши памяти
+        wxRect rect;                 // 📐 Место на панели
+        wxPoint labelOrigin;         // 🏷️ Левый верхний угол подписи (по центру rect)
+        bool enabled = true;         // 🔘 Кнопка доступна
+        bool highlighted = false;    // ✨ Подсвечен выбранный оператор
     };
 
     //┌─────────────────────────────────────────────────────────────────────────┐
@@ -112,44 +202,67 @@ private:
     //└─────────────────────────────────────────────────────────────────────────┘
     
     void InitializeComponents();    // 🏗️ Основная инициализация
-    void CreateButtons();          // 🎛️ Создание всех кнопок
-    void SetupLayout();           // 📐 Настройка расположения
+    void CreateButtons();          // 🎛️ Заполнение таблицы клавиш
+    void AssignKey(int index, const KeySpec& spec); // 🏷️ Клавиша из описания
+    void ShowPage(int page);       // 📑 Смена страницы функций
+    void SetupLayout();           // 📐 Прямоугольники клавиш по размеру панели
+
+    /// 📐 Класс размера для высоты панели
+    static int ChooseSizeClass(int clientHeight);
+
+    /// 📏 Метрики класса (измеряются при первом обращении)
+    const SizeClassMetrics& GetSizeClassMetrics(int sizeClass);
     void BindEvents();            // 🔗 Привязка событий
 
     //┌─────────────────────────────────────────────────────────────────────────┐
-    //│                       🎨 МЕТОДЫ СТИЛИЗАЦИИ                              │
+    //│                       🎨 МЕТОДЫ ОТРИСОВКИ                               │
     //└─────────────────────────────────────────────────────────────────────────┘
     
-    /// 🏭 Фабрика стилизованных кнопок
-    std::unique_ptr<wxButton> CreateStyledButton(const ButtonInfo& info);
+    /// 🖼️ Перерисовка всего заднего буфера
+    void RenderAll(wxDC& dc);
     
-    /// 🖌️ Применение стиля к кнопке
-    void StyleButton(wxButton* button, const wxColour& bgColor);
+    /// 🖌️ Перерисовка одной клавиши в задний буфер
+    void RenderButton(wxDC& dc, int index);
+    
+    /// ♻️ Клавиша изменилась: пометить и запросить перерисовку её прямоугольника
+    void InvalidateButton(int index);
+
+    /// 🎨 Цвет клавиши с учётом подсветки, нажатия и наведения
+    wxColour GetButtonColor(int index) const;
 
     //┌─────────────────────────────────────────────────────────────────────────┐
     //│                      🎯 ОБРАБОТЧИКИ СОБЫТИЙ                             │
     //└─────────────────────────────────────────────────────────────────────────┘
     
-    void OnNumberClick(wxCommandEvent& event);      // 🔢 Нажатие цифры
-    void OnOperatorClick(wxCommandEvent& event);    // ➕ Нажатие оператора
-    void OnEqualsClick(wxCommandEvent& event);      // 🟰 Нажатие равно
-    void OnClearClick(wxCommandEvent& event);       // 🗑️ Полная очистка
-    void OnClearEntryClick(wxCommandEvent& event);  // ❌ Очистка ввода
-    void OnDecimalClick(wxCommandEvent& event);     // • Десятичная точка
-    void OnBackspaceClick(wxCommandEvent& event);   // ⌫ Удаление символа
+    void OnPaint(wxPaintEvent& event);                  // 🖼️ Копирование из буфера
+    void OnMouseDown(wxMouseEvent& event);              // 👇 Нажатие клавиши
+    void OnMouseUp(wxMouseEvent& event);                // 👆 Срабатывание клавиши
+    void OnMouseMove(wxMouseEvent& event);              // 🖱️ Наведение
+    void OnMouseLeave(wxMouseEvent& event);             // 🚪 Уход мыши с панели
+    void OnCaptureLost(wxMouseCaptureLostEvent& event); // 🔓 Захват мыши потерян
+    void OnSize(wxSizeEvent& event);                    // 📐 Изменение размера
+    void OnDpiChanged(wxDPIChangedEvent& event);        // 🔍 Смена DPI: метрики заново
 
     //┌─────────────────────────────────────────────────────────────────────────┐
     //│                       🛠️ УТИЛИТЫ                                        │
     //└─────────────────────────────────────────────────────────────────────────┘
     
+    /// 🎯 Клавиша под точкой (NO_KEY — мимо)
+    int HitTest(const wxPoint& point) const;
+
+    /// ⚡ Действие клавиши: подсветка и событие для MainWindow
+    void ActivateButton(int index);
+
+    /// 🖱️ Смена клавиши под курсором
+    void SetHotButton(int index);
+
+    /// ♻️ Подписи изменились: метрики и раскладка — заново
+    void RemeasureLabels();
+
     /// 📡 Отправка пользовательского события
     void SendCustomEvent(wxEventType eventType, const wxString& data = wxEmptyString);
-    
-    /// 🎨 Получение цвета кнопки по типу
-    wxColour GetButtonColor(const wxString& buttonType) const;
-    
-    /// 📐 Обработка изменения размера
-    void OnSize(wxSizeEvent& event);
+    void SendOperatorEvent(wxEventType eventType, calc::Operator op);  // ➕ Оператор числом, без строк
+    void SendMemoryEvent(MemoryOp op);                                 // 💾 Клавиша памяти числом
 
     /*
      ╔═══════════════════════════════════════════════════════════════════════╗
@@ -157,20 +270,21 @@ private:
      ╚═══════════════════════════════════════════════════════════════════════╝
     */
     
-    //┌─────────────────────────────────────────────────────────────────────────┐
-    //│                        🔢 КОНТЕЙНЕРЫ КНОПОК                             │
-    //└─────────────────────────────────────────────────────────────────────────┘
-    
-    std::array<std::unique_ptr<wxButton>, 10> m_numberButtons;              // 0-9
-    std::unordered_map<wxString, std::unique_ptr<wxButton>> m_operatorButtons;  // +-*/
-    std::unordered_map<wxString, std::unique_ptr<wxButton>> m_functionButtons;  // C, CE, =, etc.
+    std::array<ButtonInfo, KEY_COUNT> m_buttons;  // 🔢 Клавиши построчно, слева направо
 
-    //┌─────────────────────────────────────────────────────────────────────────┐
-    //│                        📋 ВСПОМОГАТЕЛЬНЫЕ ДАННЫЕ                        │
-    //└─────────────────────────────────────────────────────────────────────────┘
-    
-    std::unordered_map<int, wxString> m_buttonValues;  // 🔗 ID -> значение кнопки
-    std::unique_ptr<wxGridSizer> m_mainSizer;          // 📐 Главный компоновщик
+    wxBitmap m_backBuffer;        // 🖼️ Задний буфер размером с панель
+    bool m_bufferValid = false;   // ✅ Буфер отрисован целиком
+    std::uint32_t m_dirtyButtons = 0; // ♻️ Клавиши, не перерисованные в буфере (бит на клавишу)
+
+    std::array<SizeClassMetrics, SIZE_CLASS_COUNT> m_metrics; // 📏 Кеш метрик по классам
+    int m_sizeClass = SIZE_REGULAR;   // 📐 Текущий класс размера
+    wxSize m_layoutSize;              // 📐 Размер, для которого рассчитаны клавиши
+
+    int m_page = 0;               // 📑 Текущая страница функций
+    bool m_functionsEnabled = true; // 🧮 Клавиши функций доступны
+
+    int m_hotButton = NO_KEY;     // 🖱️ Клавиша под курсором
+    int m_pressedButton = NO_KEY; // 👇 Клавиша, нажатая мышью
 
     /*
      ╔═══════════════════════════════════════════════════════════════════════╗
@@ -179,6 +293,7 @@ private:
      ╚═══════════════════════════════════════════════════════════════════════╝
     */
     
+    static const inline wxColour COLOR_BACKGROUND{ 50, 50, 50 };          // 🖼️ Фон панели
     static const inline wxColour COLOR_NUMBER{ 240, 240, 240 };           // 🔘 Цифры
     static const inline wxColour COLOR_OPERATOR{ 255, 149, 0 };           // ➕ Операторы
     static const inline wxColour COLOR_OPERATOR_HIGHLIGHT{ 255, 179, 64 }; // ✨ Подсветка операторов
@@ -187,21 +302,7 @@ private:
     static const inline wxColour COLOR_CLEAR{ 255, 59, 48 };              // 🗑️ Очистка
     static const inline wxColour COLOR_TEXT{ 0, 0, 0 };                   // 🖤 Текст черный
     static const inline wxColour COLOR_TEXT_WHITE{ 255, 255, 255 };       // 🤍 Текст белый
+    static const inline wxColour COLOR_TEXT_DISABLED{ 128, 128, 128 };    // 🩶 Текст недоступной кнопки
 };
 
-/*
- ╔═══════════════════════════════════════════════════════════════════════════╗
- ║                        🔧 ШАБЛОННАЯ УТИЛИТА                               ║
- ║            Универсальная привязка событий для кнопок                      ║
- ╚═══════════════════════════════════════════════════════════════════════════╝
-*/
-template<typename Handler>
-void BindButtonEvent(wxButton* button, Handler&& handler) 
-{
-    if (button) 
-    {
-        button->Bind(wxEVT_COMMAND_BUTTON_CLICKED, std::forward<Handler>(handler));
-    }
-}
-
 #endif //BUTTON_PANEL_H
\ No newline at end of file
@@ -0,0 +1,81 @@
+﻿#ifndef HISTORY_PANEL_H
+#define HISTORY_PANEL_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+
+#include "engine/history.h"
+
+wxDECLARE_EVENT(EVT_CALC_HISTORY_RECALL, wxCommandEvent); // 📜 Результат из истории на дисплей
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                         📜 ПАНЕЛЬ ИСТОРИИ                                 ║
+ ║        Список вычислений поверх calc::History и строка поиска             ║
+ ║                                                                           ║
+ ║  📊 Функциональность:                                                     ║
+ ║   • Виртуальный wxListCtrl: строки создаются только для видимой части,    ║
+ ║     миллион записей стоит столько же, сколько десять                      ║
+ ║   • Новые записи сверху                                                   ║
+ ║   • Поиск идёт порциями в idle — ввод в строку поиска не ждёт             ║
+ ║     просмотра всей истории                                                ║
+ ║   • Двойной щелчок (Enter) — результат записи на дисплей                  ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class HistoryPanel : public wxPanel
+{
+public:
+    HistoryPanel(wxWindow* parent, const calc::History& history);
+
+    HistoryPanel(const HistoryPanel&) = delete;
+    HistoryPanel& operator=(const HistoryPanel&) = delete;
+
+    /// 📥 В историю дописаны записи
+    void SyncWithHistory();
+
+private:
+    /*
+     ╔═══════════════════════════════════════════════════════════════════════╗
+     ║                     📋 ВИРТУАЛЬНЫЙ СПИСОК                            ║
+     ║        Текст строки запрашивается у панели в момент отрисовки        ║
+     ╚═══════════════════════════════════════════════════════════════════════╝
+    */
+    class HistoryList : public wxListCtrl
+    {
+    public:
+        HistoryList(HistoryPanel* owner);
+
+    protected:
+        wxString OnGetItemText(long item, long column) const override;
+
+    private:
+        HistoryPanel* m_owner;      // 📜 Владелец: знает историю и поиск
+    };
+
+    enum Columns
+    {
+        COLUMN_TIME,
+        COLUMN_EXPRESSION,
+        COLUMN_RESULT
+    };
+
+    static constexpr std::size_t SEARCH_BUDGET = 100000;  // 🔍 Записей за один idle
+
+    std::size_t GetRowCount() const;                 // 📏 Строк в списке
+    std::size_t GetEntryIndex(long row) const;       // 🔢 Строка → индекс записи
+    wxString GetCellText(long row, long column) const; // 📝 Текст ячейки
+
+    void UpdateRowCount();                           // 📏 SetItemCount и сводка
+    void OnSearchText(wxCommandEvent& event);        // ✏️ Изменён запрос
+    void OnIdle(wxIdleEvent& event);                 // 🔁 Очередная порция поиска
+    void OnItemActivated(wxListEvent& event);        // 📜 Выбор записи
+
+    const calc::History& m_history;  // 📜 История (владеет MainWindow)
+    calc::HistorySearch m_search;    // 🔍 Состояние поиска
+    bool m_searchDone;               // ✅ Поиск просмотрел всю историю
+    wxTextCtrl* m_searchBox;         // 🔤 Строка поиска
+    wxStaticText* m_summary;         // 📊 Число записей или совпадений
+    HistoryList* m_list;             // 📋 Список
+};
+
+#endif // HISTORY_PANEL_H
@@ -2,15 +2,59 @@
 #define MAIN_WINDOW_H
 
 #include <wx/wx.h>
+#include <wx/timer.h>
+#include <array>
+#include <chrono>
+#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
 #include "ui/button_panel.h"
+#include "ui/history_panel.h"
+#include "ui/metrics_overlay.h"
+#include "ui/worksheet_panel.h"
+#include "engine/calculator.h"
+#include "engine/history.h"
+#include "engine/job_service.h"
+#include "engine/session_file.h"
+#include "engine/typeahead_buffer.h"
+#include "engine/number_entry.h"
+
+wxDECLARE_EVENT(EVT_CALC_JOB_DONE, wxThreadEvent);     // ✅ Фоновая задача завершена
 
 /*
  ╔═══════════════════════════════════════════════════════════════════════════╗
  ║                          🏠 ГЛАВНОЕ ОКНО КАЛЬКУЛЯТОРА                    ║
  ║                      Основной класс пользовательского                    ║
  ║                          интерфейса приложения                           ║
+ ║                                                                           ║
+ ║  ⏳ Вычисления (=, Save Result As) идут в JobService: пока задача         ║
+ ║     не вернула EVT_CALC_JOB_DONE, ядро принадлежит ей, ввод отклоняется,  ║
+ ║     Esc отменяет, таймер показывает прогресс в строке состояния           ║
+ ║                                                                           ║
+ ║  📐 wxEVT_SIZE только взводит m_layoutTimer: серия событий при            ║
+ ║     перетаскивании рамки даёт одну компоновку за кадр                     ║
+ ║                                                                           ║
+ ║  💾 История и состояние живут в файле сеанса (calc::SessionFile):         ║
+ ║     при старте подключаются без чтения записей, m_sessionTimer раз        ║
+ ║     в SESSION_INTERVAL_MS сохраняет изменившееся состояние и сбрасывает   ║
+ ║     файл на диск, OnClose — последний раз                                 ║
+ ║                                                                           ║
+ ║  ⌨️ Клавиатура минует события кнопок: символы копятся в m_typeahead,       ║
+ ║     m_typeaheadTimer раз за кадр отдаёт их ядру, дисплей — раз за пачку   ║
+ ║                                                                           ║
+ ║  📋 Ctrl+V считает выражение или колонку чисел из буфера обмена в         ║
+ ║     JobService: текст копируется из буфера один раз и разбирается         ║
+ ║     на лету, без AST и без посимвольного ввода; строки "x = 3.2"          ║
+ ║     задают переменные сеанса, выражения с именами идут через байткод      ║
+ ║                                                                           ║
+ ║  🚀 До первого кадра строится только то, что на нём видно; меню и стиль   ║
+ ║     — в первом wxEVT_IDLE. Фазы запуска отмечаются всегда, при            ║
+ ║     переменной окружения CALC_TRACE_STARTUP выводятся в stderr            ║
+ ║                                                                           ║
+ ║  ⏱️ В сборке с CALC_INSTRUMENTATION обработчики ввода размечены            ║
+ ║     CALC_TRACE_*: View → Metrics overlay показывает задержку ввод →       ║
+ ║     отрисовка, File → Export Trace пишет трассу для chrome://tracing      ║
  ╚═══════════════════════════════════════════════════════════════════════════╝
 */
 class MainWindow : public wxFrame
@@ -43,6 +87,7 @@ public:
 
     void UpdateDisplay(const wxString& value);        // 📺 Обновление дисплея
     void SetStatusMessage(const wxString& message);   // 📝 Сообщение в статусе
+    void SetStatusMessage(const char* message);       // 📝 ASCII-сообщение без выделения памяти
     void ClearDisplay();                              // 🧹 Очистка дисплея, не реализована
     void SetDisplayError(const wxString& errorMsg);   // ❌ Отображение ошибки
 
@@ -58,6 +103,9 @@ private:
     void OnClearEntry(wxCommandEvent& event);  // ❌ Очистка текущего ввода
     void OnDecimal(wxCommandEvent& event);     // • Десятичная точка
     void OnBackspace(wxCommandEvent& event);   // ⌫ Удаление символа
+    void OnExponent(wxCommandEvent& event);    // 🔺 Ввод порядка (EXP)
+    void OnFunction(wxCommandEvent& event);    // 🧮 Научная функция (sin, √...)
+    void OnMemory(wxCommandEvent& event);      // 💾 MC, MR, M+, M-
 
     //──────────────────────────────────────────────────────────────────────────
     // 🖼️ Обработчики системных событий
@@ -68,8 +116,29 @@ private:
     void OnClose(wxCloseEvent& event);         // ❌ Закрытие окна
     void OnThemeToggle(wxCommandEvent& event); // 🎨 Переключение темы
     void OnFullScreen(wxCommandEvent& event);  // 📺 Полноэкранный режим
-    void OnKeyDown(wxKeyEvent& event);         // ⌨️ Клавиатурный ввод
+    void OnFullPrecisionToggle(wxCommandEvent& event); // 🎯 Полная точность / 10 цифр
+    void OnDecimalModeToggle(wxCommandEvent& event);   // 💰 Десятичный режим / double
+    void OnIntegerModeToggle(wxCommandEvent& event);   // 🔢 Целый режим / double
+    void OnSaveResult(wxCommandEvent& event);  // 💾 Все цифры целого результата в файл
+    void OnCancelJob(wxCommandEvent& event);   // ⏹️ Отмена фонового вычисления (Esc)
+    void OnPaste(wxCommandEvent& event);       // 📋 Вставка и вычисление (Ctrl+V)
+    void OnJobDone(wxThreadEvent& event);      // ✅ Результат фоновой задачи
+    void OnProgressTimer(wxTimerEvent& event); // 📊 Прогресс задачи в строке состояния
+    void OnChar(wxKeyEvent& event);            // ⌨️ Клавиатурный ввод (в буфер)
+    void OnTypeaheadTimer(wxTimerEvent& event);// ⌨️ Набранное за кадр — в ядро
     void OnSize(wxSizeEvent& event);           // 📐 Изменение размера
+    void OnLayoutTimer(wxTimerEvent& event);   // 📐 Отложенная компоновка
+    void OnLayoutTimingToggle(wxCommandEvent& event); // ⏱️ Замер компоновки
+    void OnDpiChanged(wxDPIChangedEvent& event);      // 🔍 Смена DPI: кеш метрик дисплея заново
+    void OnHistoryToggle(wxCommandEvent& event);      // 📜 Показ/скрытие истории
+    void OnHistoryRecall(wxCommandEvent& event);      // 📜 Результат из истории на дисплей
+    void OnWorksheetToggle(wxCommandEvent& event);    // 📊 Показ/скрытие листа формул
+    void OnResultCacheToggle(wxCommandEvent& event);  // 💾 Кеш результатов между сеансами
+    void OnSessionTimer(wxTimerEvent& event);         // 💽 Периодическое сохранение сеанса
+    void OnFirstIdle(wxIdleEvent& event);             // 🚀 Первый кадр показан: отложенная инициализация
+    void OnMetricsToggle(wxCommandEvent& event);      // 📊 Показ/скрытие оверлея метрик
+    void OnExportTrace(wxCommandEvent& event);        // 💾 Трасса в Chrome trace JSON
+    void OnDisplayPaint(wxPaintEvent& event);         // 🖼️ Дисплей перерисован: конец замера задержки
 
     //──────────────────────────────────────────────────────────────────────────
     // 🔧 Методы инициализации
@@ -81,15 +150,110 @@ private:
     void SetupEventHandlers();     // 🔗 Привязка событий
     void ApplyModernStyle();       // 🎨 Применение стилей
     void SetDarkTheme(bool dark = true); // 🌙 Темная тема
+    void SyncMenuChecks();         // ☑️ Галочки меню по текущему состоянию
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🚀 Трассировка запуска
+    //──────────────────────────────────────────────────────────────────────────
+
+    void MarkStartupPhase(const char* phase);       // ⏱️ Конец фазы запуска
+    void ReportStartup(std::chrono::steady_clock::time_point firstFrame); // 📊 Фазы в stderr и статус
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 📐 Компоновка
+    //──────────────────────────────────────────────────────────────────────────
+
+    void PerformLayout();          // 📐 Компоновка накопленных изменений размера
+    void FitDisplayFont();         // 🔤 Кегль дисплея по ширине окна и длине текста
+    int GetDisplaySampleWidth(int pointSize); // 📏 Ширина DISPLAY_SAMPLE (с кешем)
+    int GetDisplayTextWidth(int pointSize);   // 📏 Ширина длинного m_displayText (без кеша)
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🧮 Связь с вычислительным ядром
+    //──────────────────────────────────────────────────────────────────────────
+
+    bool CommitOperand();                           // 🔢 Передача ввода в ядро
+    bool Evaluate();                                // 🟰 Запуск вычисления; false — ошибка ввода
+    void ShowEntry();                               // 🔢 Вывод буфера ввода на дисплей
+    static bool AssignAscii(wxString& target, std::string_view text); // ✏️ false — текст тот же
+    void ShowHistory(bool show);                    // 📜 Панель истории (создаётся при первом показе)
+    void ShowWorksheet(bool show);                  // 📊 Лист формул (создаётся при первом показе)
+
+    //──────────────────────────────────────────────────────────────────────────
+    // ⌨️ Ввод без обновления дисплея (общий для кнопок и клавиатуры)
+    //──────────────────────────────────────────────────────────────────────────
+
+    void InputDigit(char digit);                    // 🔢 Цифра
+    void InputDecimal();                            // • Десятичная точка
+    void InputExponent();                           // 🔺 EXP
+    bool InputOperator(calc::Operator op);          // ➕ Оператор; false — ошибка ввода
+    bool InputFunction(calc::Operator function);    // 🧮 Функция к операнду; false — ошибка
+    bool ApplyKey(char key);                        // ⌨️ Символ из буфера; false — ошибка
+    void DrainTypeahead();                          // ⌨️ Весь буфер, затем один вывод
+    static char TranslateKey(const wxKeyEvent& event); // ⌨️ Символ буфера (0 — не наш)
+    void PasteClipboard();                          // 📋 Текст буфера обмена — в задачу
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 💾 Файл сеанса
+    //──────────────────────────────────────────────────────────────────────────
+
+    void OpenSession();                             // 📂 История из файла и прежнее состояние
+    void SaveSession();                             // 💾 Изменившееся состояние и сброс на диск
+    bool RestoreSession(std::string_view state);    // 📤 false — состояние не читается
+    wxString GetResultCachePath() const;            // 💾 Файл кеша результатов рядом с сеансом
+
+    //──────────────────────────────────────────────────────────────────────────
+    // ⏳ Фоновые вычисления
+    //──────────────────────────────────────────────────────────────────────────
+
+    /// 📦 Итог задачи: всё дорогое (перевод в десятичную запись) сделано в пуле
+    struct JobOutcome
+    {
+        calc::EvalResult result;        // 🧮 Результат или ошибка ядра
+        bool hasResult = false;         // 📺 Результат нужно вывести на дисплей
+        std::string integerText;        // 🔢 Готовый текст целого результата
+        bool integerExact = false;      // 🔢 integerText — все цифры, а не старшие
+        std::string status;             // 📊 Сообщение для строки состояния
+        std::string expression;         // 📜 Выражение для истории
+    };
+
+    using JobWork = std::function<JobOutcome()>;
+
+    void StartJob(const wxString& activity, JobWork work); // ▶️ Задача в пул
+    void ShowResult(const JobOutcome& outcome);     // 📺 Вывод результата задачи
+    bool RejectWhileBusy();                         // ⏳ true — идёт задача, ввод отклонён
+    static void FormatIntegerResult(const calc::BigInteger& value, JobOutcome& outcome);
+
+    //──────────────────────────────────────────────────────────────────────────
+    // 🚀 Отметки запуска (объявлены первыми: начало отсчёта — до создания окна)
+    //──────────────────────────────────────────────────────────────────────────
+
+    struct StartupMark
+    {
+        const char* phase;                          // 🏷️ Завершившаяся фаза
+        std::chrono::steady_clock::time_point time; // 🕒 Момент завершения
+    };
+
+    static constexpr std::size_t MAX_STARTUP_MARKS = 12;
+
+    std::chrono::steady_clock::time_point m_startupBegin;   // 🕒 Вход в конструктор
+    std::array<StartupMark, MAX_STARTUP_MARKS> m_startupMarks; // ⏱️ Отметки по порядку
+    std::size_t m_startupMarkCount;                          // 📏 Заполнено отметок
 
     //──────────────────────────────────────────────────────────────────────────
     // 💾 Компоненты интерфейса
     //──────────────────────────────────────────────────────────────────────────
 
     std::unique_ptr<ButtonPanel> m_buttonPanel; // 🎛️ Панель с кнопками
+    HistoryPanel* m_historyPanel;               // 📜 История (создаётся при первом показе)
+    MetricsOverlay* m_metricsOverlay;           // 📊 Метрики (создаются при первом показе)
+    WorksheetPanel* m_worksheetPanel;           // 📊 Лист формул (создаётся при первом показе)
+    wxBoxSizer* m_bodySizer;                    // 📐 Клавиатура, история и лист рядом
     wxTextCtrl* m_display;                      // 📺 Дисплей для чисел
     wxPanel* m_mainPanel;                       // 🖼️ Главная панель
     wxStaticText* m_statusLabel;                // 📊 Строка состояния
+    wxString m_displayText;                     // 📺 Текст дисплея (ёмкость переживает ввод)
+    wxString m_statusText;                      // 📊 Текст строки состояния (так же)
 
     //──────────────────────────────────────────────────────────────────────────
     // ⚙️ Состояние приложения
@@ -98,15 +262,45 @@ private:
     bool m_isDarkTheme;         // 🌙 Флаг темной темы
     bool m_isFullscreen;        // 📺 Флаг полноэкранного режима
 
+    //──────────────────────────────────────────────────────────────────────────
+    // 📐 Состояние компоновки
+    //──────────────────────────────────────────────────────────────────────────
+
+    static constexpr int DISPLAY_MIN_POINTS = 8;   // 🔤 Наименьший кегль (34 цифры в узком окне)
+    static constexpr int DISPLAY_MAX_POINTS = 24;  // 🔤 Наибольший кегль (по высоте дисплея)
+
+    wxTimer m_layoutTimer;         // ⏲️ Компоновка не чаще раза за кадр
+    int m_pendingResizes;          // 📐 Событий размера с прошлой компоновки
+    bool m_measureLayout;          // ⏱️ Показывать время компоновки
+    int m_displayPointSize;        // 🔤 Текущий кегль дисплея
+    std::array<int, DISPLAY_MAX_POINTS - DISPLAY_MIN_POINTS + 1> m_displaySampleWidths; // 📏 0 — не измерено
+    bool m_displayFitsText;        // 🔤 Кегль подобран по длинному тексту, а не по образцу
+
     //──────────────────────────────────────────────────────────────────────────
     // 🧮 Состояние калькулятора
     //──────────────────────────────────────────────────────────────────────────
 
-    wxString m_currentNumber;    // 🔢 Текущее число
-    wxString m_previousNumber;   // 📝 Предыдущее число
-    wxString m_currentOperator;  // ➕ Текущий оператор
-    bool m_waitingForOperand;    // ⏳ Ожидание операнда
-    bool m_hasDecimal;           // • Наличие десятичной точки
+    calc::ResultCache m_resultCache; // 💾 Кеш результатов (объявлен раньше ядра — живёт дольше)
+    calc::Calculator m_calculator; // 🧮 Вычислительное ядро
+    calc::NumberEntry m_entry;     // 🔢 Текущее число (ввод или результат)
+    calc::SessionFile m_session;   // 💾 Файл сеанса (объявлен раньше истории — живёт дольше)
+    calc::History m_history;       // 📜 Все вычисления (в файле сеанса, если он открыт)
+    bool m_waitingForOperand;      // ⏳ Ожидание операнда
+    std::string m_savedSession;    // 💾 Последнее записанное состояние
+    wxTimer m_sessionTimer;        // 💽 Периодическое сохранение
+    calc::TypeaheadBuffer m_typeahead; // ⌨️ Набранное, но ещё не обработанное
+    wxTimer m_typeaheadTimer;      // ⌨️ Разбор буфера раз за кадр
+    bool m_keepResultCache;        // 💾 Кеш результатов сохраняется между сеансами
+    calc::ResultCacheStats m_reportedCache; // 📊 Статистика кеша в последнем сообщении
+
+    //──────────────────────────────────────────────────────────────────────────
+    // ⏳ Фоновые задачи (объявлены последними — гасятся раньше ядра)
+    //──────────────────────────────────────────────────────────────────────────
+
+    wxTimer m_progressTimer;                   // 📊 Опрос прогресса
+    wxString m_jobActivity;                    // 📝 Что делает текущая задача
+    std::shared_ptr<calc::JobContext> m_job;   // 🎫 Текущая задача (пусто — простой)
+    calc::JobService m_jobs;                   // 🧵 Один рабочий: кеши степеней остаются тёплыми
 
     //──────────────────────────────────────────────────────────────────────────
     // 🆔 Идентификаторы элементов
@@ -117,7 +311,23 @@ private:
         ID_ABOUT = wxID_ABOUT,
         ID_EXIT = wxID_EXIT,
         ID_THEME_TOGGLE = 2000,
-        ID_FULLSCREEN = 2001
+        ID_FULLSCREEN = 2001,
+        ID_FULL_PRECISION = 2002,
+        ID_DECIMAL_MODE = 2003,
+        ID_INTEGER_MODE = 2004,
+        ID_SAVE_RESULT = 2005,
+        ID_CANCEL_JOB = 2006,
+        ID_PROGRESS_TIMER = 2007,
+        ID_LAYOUT_TIMING = 2008,
+        ID_LAYOUT_TIMER = 2009,
+        ID_HISTORY = 2010,
+        ID_SESSION_TIMER = 2011,
+        ID_TYPEAHEAD_TIMER = 2012,
+        ID_PASTE = 2013,
+        ID_METRICS = 2014,
+        ID_EXPORT_TRACE = 2015,
+        ID_WORKSHEET = 2016,
+        ID_RESULT_CACHE = 2017
     };
 
     //──────────────────────────────────────────────────────────────────────────
@@ -128,6 +338,18 @@ private:
     static constexpr int MIN_HEIGHT = 480;     // 📏 Минимальная высота
     static constexpr int DISPLAY_HEIGHT = 60;  // 📺 Высота дисплея
     static constexpr int STATUS_HEIGHT = 25;   // 📊 Высота статус-бара
+    static constexpr std::size_t DISPLAY_DIGITS = 16;  // 🔢 Старших цифр длинного результата
+    static constexpr int PROGRESS_INTERVAL_MS = 100;   // 📊 Период опроса прогресса
+    static constexpr int LAYOUT_INTERVAL_MS = 16;      // 📐 Кадр компоновки при resize
+    static constexpr int SESSION_INTERVAL_MS = 5000;   // 💽 Период сохранения сеанса
+    static constexpr int TYPEAHEAD_INTERVAL_MS = 16;   // ⌨️ Кадр разбора клавиатуры
+    static constexpr std::size_t PASTE_PREVIEW_LENGTH = 80;  // 📋 Символов вставки в истории
+    static constexpr std::size_t STATUS_MESSAGE_LENGTH = 128; // 📝 Буфер сообщения на стеке
+    static constexpr char KEY_BACKSPACE = '\b';        // ⌨️ Коды буфера для клавиш без символа
+    static constexpr char KEY_CLEAR_ENTRY = '\x7f';
+    static constexpr std::uint32_t SESSION_STATE_VERSION = 3;  // 🏷️ Версия состояния окна в файле
+    static constexpr const char* DISPLAY_SAMPLE = "-8.8888888888888888e+888"; // 📏 Самое длинное двоичное число
+    static constexpr std::size_t DISPLAY_SAMPLE_LENGTH = std::char_traits<char>::length(DISPLAY_SAMPLE); // 📏 Длиннее — кегль по тексту
 };
 
 #endif // MAIN_WINDOW_H
\ No newline at end of file
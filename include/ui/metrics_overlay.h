@@ -0,0 +1,55 @@
+﻿#ifndef METRICS_OVERLAY_H
+#define METRICS_OVERLAY_H
+
+#include <wx/wx.h>
+#include <wx/timer.h>
+#include <chrono>
+
+#include "engine/instrumentation.h"
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                          📊 ОВЕРЛЕЙ МЕТРИК                                ║
+ ║      Полоса под дисплеем: что показывает calc::GetTraceMetrics()          ║
+ ║                                                                           ║
+ ║  📊 Функциональность:                                                     ║
+ ║   • Гистограмма задержки ввод → отрисовка дисплея, p50 и p99              ║
+ ║   • Вычислений в секунду между двумя опросами                             ║
+ ║   • Выделений памяти на операцию UI                                       ║
+ ║   • Опрос раз в REFRESH_INTERVAL_MS, только пока полоса показана          ║
+ ║                                                                           ║
+ ║  ⚠️ Данные есть только в сборке с CALC_INSTRUMENTATION                     ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class MetricsOverlay : public wxWindow
+{
+public:
+    explicit MetricsOverlay(wxWindow* parent);
+
+    MetricsOverlay(const MetricsOverlay&) = delete;
+    MetricsOverlay& operator=(const MetricsOverlay&) = delete;
+
+    bool Show(bool show = true) override;       // 👁️ Показ запускает опрос, скрытие — гасит
+
+private:
+    void Sample();                              // 📥 Новая копия метрик и темп вычислений
+    void OnTimer(wxTimerEvent& event);          // ⏲️ Опрос и перерисовка
+    void OnPaint(wxPaintEvent& event);          // 🖌️ Текст и гистограмма
+
+    static wxString FormatMicroseconds(double microseconds); // 🕒 "850 us" / "4 ms"
+
+    wxTimer m_timer;                                    // ⏲️ Период опроса
+    calc::TraceMetrics m_metrics;                       // 📊 Последняя копия
+    double m_evaluationRate;                            // 🧮 Вычислений в секунду
+    std::chrono::steady_clock::time_point m_sampleTime; // 🕒 Момент копии
+
+    static constexpr int OVERLAY_HEIGHT = 96;           // 📏 Высота полосы
+    static constexpr int REFRESH_INTERVAL_MS = 250;     // ⏲️ Период опроса
+    static constexpr int MARGIN = 6;                    // 🖼️ Отступы
+
+    static const inline wxColour COLOR_BACKGROUND{ 30, 30, 30 };  // 🖼️ Фон
+    static const inline wxColour COLOR_TEXT{ 220, 220, 220 };     // 📝 Текст
+    static const inline wxColour COLOR_BAR{ 255, 149, 0 };        // 📊 Столбцы гистограммы
+};
+
+#endif // METRICS_OVERLAY_H
@@ -0,0 +1,78 @@
+﻿#ifndef WORKSHEET_PANEL_H
+#define WORKSHEET_PANEL_H
+
+#include <wx/wx.h>
+#include <wx/listctrl.h>
+
+#include "engine/worksheet.h"
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                         📊 ПАНЕЛЬ ЛИСТА ФОРМУЛ                            ║
+ ║        Строки "имя = выражение" поверх calc::Worksheet                    ║
+ ║                                                                           ║
+ ║  📊 Функциональность:                                                     ║
+ ║   • Строка правки меняет выбранную строку листа на каждый символ;         ║
+ ║     пересчитываются только она и её зависимые                             ║
+ ║   • Виртуальный wxListCtrl: на экране только видимые строки,              ║
+ ║     лист в 5000 строк не замедляет отрисовку                              ║
+ ║   • Enter — новая строка под текущей, Delete в списке — удаление          ║
+ ║   • Открытие и сохранение листа в текстовый файл                          ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+class WorksheetPanel : public wxPanel
+{
+public:
+    explicit WorksheetPanel(wxWindow* parent);
+
+    WorksheetPanel(const WorksheetPanel&) = delete;
+    WorksheetPanel& operator=(const WorksheetPanel&) = delete;
+
+    /// 📋 Ctrl+V в строку правки, если фокус в ней (иначе меню вставит в калькулятор)
+    bool PasteIntoEditor();
+
+private:
+    /*
+     ╔═══════════════════════════════════════════════════════════════════════╗
+     ║                     📋 ВИРТУАЛЬНЫЙ СПИСОК                            ║
+     ║        Текст строки запрашивается у панели в момент отрисовки        ║
+     ╚═══════════════════════════════════════════════════════════════════════╝
+    */
+    class WorksheetList : public wxListCtrl
+    {
+    public:
+        WorksheetList(WorksheetPanel* owner);
+
+    protected:
+        wxString OnGetItemText(long item, long column) const override;
+
+    private:
+        WorksheetPanel* m_owner;    // 📊 Владелец: знает лист
+    };
+
+    enum Columns
+    {
+        COLUMN_LINE,
+        COLUMN_FORMULA,
+        COLUMN_VALUE
+    };
+
+    wxString GetCellText(long row, long column) const; // 📝 Текст ячейки
+
+    void SelectLine(std::size_t line);               // 👉 Строка в списке и в строке правки
+    void Recalculate();                              // 🔁 Пересчёт, список и сводка
+    void OnEditorText(wxCommandEvent& event);        // ✏️ Правка выбранной строки
+    void OnEditorEnter(wxCommandEvent& event);       // ➕ Новая строка под текущей
+    void OnItemSelected(wxListEvent& event);         // 👉 Выбор строки
+    void OnListKey(wxListEvent& event);              // ➖ Delete — удаление строки
+    void OnOpen(wxCommandEvent& event);              // 📂 Лист из файла
+    void OnSave(wxCommandEvent& event);              // 💾 Лист в файл
+
+    calc::Worksheet m_worksheet;     // 📊 Лист
+    std::size_t m_line;              // 👉 Строка в строке правки
+    wxTextCtrl* m_editor;            // ✏️ Строка правки
+    WorksheetList* m_list;           // 📋 Список
+    wxStaticText* m_summary;         // 📊 Строк и пересчитано
+};
+
+#endif // WORKSHEET_PANEL_H
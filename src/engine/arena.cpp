@@ -0,0 +1,59 @@
+#include "engine/arena.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace calc
+{
+
+Arena::Arena(std::size_t blockSize)
+    : m_blockSize(blockSize)
+    , m_current(0)
+    , m_offset(0)
+{
+}
+
+void* Arena::Allocate(std::size_t size, std::size_t alignment)
+{
+    while (m_current < m_blocks.size())
+    {
+        Block& block = m_blocks[m_current];
+        const auto base = reinterpret_cast<std::uintptr_t>(block.data.get());
+        const std::uintptr_t aligned = (base + m_offset + alignment - 1) & ~(alignment - 1);
+        const std::size_t offset = static_cast<std::size_t>(aligned - base);
+
+        if (offset + size <= block.size)
+        {
+            m_offset = offset + size;
+            return block.data.get() + offset;
+        }
+
+        ++m_current;
+        m_offset = 0;
+    }
+
+    const std::size_t blockSize = std::max(m_blockSize, size + alignment);
+    m_blocks.push_back(Block{ std::make_unique<std::byte[]>(blockSize), blockSize });
+    m_current = m_blocks.size() - 1;
+    m_offset = 0;
+
+    return Allocate(size, alignment);
+}
+
+void Arena::Reset()
+{
+    m_current = 0;
+    m_offset = 0;
+}
+
+std::size_t Arena::GetBytesUsed() const
+{
+    std::size_t used = m_offset;
+    for (std::size_t i = 0; i < m_current && i < m_blocks.size(); ++i)
+    {
+        used += m_blocks[i].size;
+    }
+    return used;
+}
+
+} // namespace calc
@@ -0,0 +1,570 @@
+#include "engine/batch.h"
+#include "engine/calculator.h"
+#include "engine/instrumentation.h"
+#include "engine/mapped_file.h"
+#include "engine/thread_pool.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace calc
+{
+
+namespace
+{
+
+constexpr const char* USAGE =
+    "Usage: Calculator --batch [FILE] [--threads N] [--full-precision]\n"
+    "                  [--decimal [--precision N] | --integer] [--result-cache FILE]\n";
+
+bool IsBlank(std::string_view line)
+{
+    for (const char c : line)
+    {
+        if (c != ' ' && c != '\t' && c != '\r')
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void WriteError(CalcError error, std::string& output, std::uint64_t& errorCount)
+{
+    ++errorCount;
+    output.append("Error: ");
+    output.append(Calculator::ErrorMessage(error));
+    output.push_back('\n');
+}
+
+void EvaluateLine(BatchEvaluators& evaluators, std::string_view line, NumberFormat format,
+    NumberMode mode, std::string& output, std::uint64_t& errorCount)
+{
+    if (!line.empty() && line.back() == '\r')
+    {
+        line.remove_suffix(1);
+    }
+
+    if (IsBlank(line))
+    {
+        output.push_back('\n');
+        return;
+    }
+
+    const std::uint32_t precision = mode == NumberMode::Decimal ? evaluators.decimal.GetPrecision() : 0;
+    const bool cacheable = mode != NumberMode::Binary && evaluators.cache
+        && ResultCache::MakeKey(line, mode, precision, evaluators.cacheKey);
+    CachedResult& cached = evaluators.cached;
+    const bool hit = cacheable && evaluators.cache->Find(evaluators.cacheKey, cached);
+
+    if (mode == NumberMode::Decimal)
+    {
+        if (hit)
+        {
+            output.append(cached.text);
+            output.push_back('\n');
+            return;
+        }
+
+        const CalcError error = evaluators.decimal.Evaluate(line, evaluators.result);
+        if (error != CalcError::None)
+        {
+            WriteError(error, output, errorCount);
+            return;
+        }
+
+        const std::size_t start = output.size();
+        evaluators.result.AppendTo(output);
+        if (cacheable)
+        {
+            cached.value = evaluators.result.ToDouble();
+            cached.text.assign(output, start, std::string::npos);
+            cached.integer = BigInteger();
+            evaluators.cache->Insert(evaluators.cacheKey, std::move(cached));
+        }
+        output.push_back('\n');
+        return;
+    }
+
+    if (mode == NumberMode::Integer)
+    {
+        if (!hit)
+        {
+            const CalcError error = evaluators.integer.Evaluate(line, evaluators.integerResult);
+            if (error != CalcError::None)
+            {
+                WriteError(error, output, errorCount);
+                return;
+            }
+        }
+
+        const BigInteger& value = hit ? cached.integer : evaluators.integerResult;
+        value.WriteDecimal([&output](std::string_view digits)
+        {
+            output.append(digits.data(), digits.size());
+            return true;
+        });
+        output.push_back('\n');
+
+        // Буфер результата отдаётся кешу: следующая строка всё равно его перезапишет
+        if (cacheable && !hit)
+        {
+            cached.value = evaluators.integerResult.ToDouble();
+            cached.text.clear();
+            cached.integer = std::move(evaluators.integerResult);
+            evaluators.cache->Insert(evaluators.cacheKey, std::move(cached));
+        }
+        return;
+    }
+
+    const EvalResult result = evaluators.direct.Evaluate(line);
+    if (!result.Ok())
+    {
+        WriteError(result.error, output, errorCount);
+        return;
+    }
+
+    char number[64];
+    const std::size_t length = Calculator::FormatNumber(result.value, number, sizeof(number) - 1, format);
+    number[length] = '\n';
+    output.append(number, length + 1);
+}
+
+} // namespace
+
+BatchRunner::BatchRunner(std::FILE* output, unsigned threads, NumberFormat format)
+    : m_output(output)
+    , m_window(1)
+    , m_format(format)
+    , m_mode(NumberMode::Binary)
+    , m_precision(BigDecimal::DEFAULT_PRECISION)
+    , m_streamEnded(false)
+    , m_readFailed(false)
+    , m_writeFailed(false)
+    , m_lineCount(0)
+    , m_errorCount(0)
+    , m_cache(nullptr)
+{
+    if (threads == 0)
+    {
+        threads = ThreadPool::DefaultThreadCount();
+    }
+
+    // Один поток — считаем прямо в вызывающем, без пула и очередей
+    if (threads > 1)
+    {
+        m_pool = std::make_unique<ThreadPool>(threads);
+        m_window = threads * WINDOW_PER_THREAD;
+    }
+}
+
+BatchRunner::BatchRunner(std::FILE* output, const BatchOptions& options)
+    : BatchRunner(output, options.threads, options.format)
+{
+    m_mode = options.mode;
+    m_precision = options.precision;
+    m_evaluators.decimal.SetPrecision(m_precision);
+}
+
+void BatchRunner::SetResultCache(ResultCache* cache)
+{
+    m_cache = cache;
+    m_evaluators.cache = cache;
+}
+
+BatchRunner::~BatchRunner()
+{
+    // Пул гасим первым: задачи обращаются к m_doneMutex/m_doneSignal
+    m_pool.reset();
+}
+
+bool BatchRunner::ParseArguments(int argc, char** argv, BatchOptions& options)
+{
+    // Первый неверный аргумент запоминается, а не прерывает разбор: без --batch
+    // командная строка принадлежит GUI, и решает только наличие --batch
+    const auto reject = [&options](const char* argument, const char* value = nullptr)
+    {
+        if (options.invalidArgument.empty())
+        {
+            options.invalidArgument = argument;
+            if (value)
+            {
+                options.invalidArgument.append(" ").append(value);
+            }
+        }
+    };
+
+    bool hasInput = false;
+    for (int i = 1; i < argc; ++i)
+    {
+        const bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(argv[i], "--threads") == 0)
+        {
+            char* end = nullptr;
+            const unsigned long threads = hasValue ? std::strtoul(argv[i + 1], &end, 10) : 0;
+            if (!hasValue || end == argv[i + 1] || *end != '\0')
+            {
+                reject(argv[i], hasValue ? argv[i + 1] : nullptr);
+            }
+            else
+            {
+                options.threads = static_cast<unsigned>(threads);
+            }
+            i += hasValue ? 1 : 0;
+            continue;
+        }
+
+        if (std::strcmp(argv[i], "--full-precision") == 0)
+        {
+            options.format = NumberFormat::Full;
+            continue;
+        }
+
+        if (std::strcmp(argv[i], "--decimal") == 0)
+        {
+            options.mode = NumberMode::Decimal;
+            continue;
+        }
+
+        if (std::strcmp(argv[i], "--integer") == 0)
+        {
+            options.mode = NumberMode::Integer;
+            continue;
+        }
+
+        if (std::strcmp(argv[i], "--precision") == 0)
+        {
+            char* end = nullptr;
+            const unsigned long precision = hasValue ? std::strtoul(argv[i + 1], &end, 10) : 0;
+            if (!hasValue || end == argv[i + 1] || *end != '\0'
+                || precision < 1 || precision > BigDecimal::MAX_PRECISION)
+            {
+                reject(argv[i], hasValue ? argv[i + 1] : nullptr);
+            }
+            else
+            {
+                options.precision = static_cast<std::uint32_t>(precision);
+            }
+            i += hasValue ? 1 : 0;
+            continue;
+        }
+
+        if (std::strcmp(argv[i], "--result-cache") == 0)
+        {
+            if (hasValue)
+            {
+                options.cachePath = argv[++i];
+            }
+            else
+            {
+                reject(argv[i]);
+            }
+            continue;
+        }
+
+        if (std::strcmp(argv[i], "--batch") == 0)
+        {
+            options.enabled = true;
+            continue;
+        }
+
+        // Один FILE где угодно после --batch; второй, как и FILE до --batch, — ошибка
+        if (options.enabled && !hasInput && std::strncmp(argv[i], "--", 2) != 0)
+        {
+            options.inputPath = argv[i];
+            hasInput = true;
+            continue;
+        }
+
+        reject(argv[i]);
+    }
+
+    return options.enabled;
+}
+
+int BatchRunner::Run(const BatchOptions& options)
+{
+    if (!options.invalidArgument.empty())
+    {
+        std::fprintf(stderr, "Invalid argument: %s\n%s", options.invalidArgument.c_str(), USAGE);
+        return 2;
+    }
+
+    const bool useStdin = options.inputPath.empty() || options.inputPath == "-";
+
+#ifdef _WIN32
+    _setmode(_fileno(stdin), _O_BINARY);
+    _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+    BatchRunner runner(stdout, options);
+
+    // Двоичные строки считаются быстрее, чем ищутся: кеш — только для --decimal и --integer
+    ResultCache cache;
+    const bool useCache = !options.cachePath.empty() && options.mode != NumberMode::Binary;
+    if (useCache)
+    {
+        cache.Load(options.cachePath);
+        runner.SetResultCache(&cache);
+    }
+
+    bool ok = false;
+    MappedFile mapped;
+    if (useStdin)
+    {
+        ok = runner.ProcessStream(stdin);
+    }
+    else if (mapped.Open(options.inputPath))
+    {
+        // Обычный файл отображаем в память; каналы и устройства читаем потоком
+        ok = runner.ProcessBuffer(mapped.GetView());
+    }
+    else
+    {
+        std::FILE* input = std::fopen(options.inputPath.c_str(), "rb");
+        if (!input)
+        {
+            std::fprintf(stderr, "Cannot open input file: %s\n", options.inputPath.c_str());
+            return 1;
+        }
+
+        ok = runner.ProcessStream(input);
+        std::fclose(input);
+    }
+
+    if (useCache)
+    {
+        const ResultCacheStats stats = cache.GetStats();
+        std::fprintf(stderr, "Result cache: %llu hits, %llu misses (%.0f%% hit rate)\n",
+            static_cast<unsigned long long>(stats.hits), static_cast<unsigned long long>(stats.misses),
+            stats.GetHitRate() * 100.0);
+        if (!cache.Save(options.cachePath))
+        {
+            std::fprintf(stderr, "Cannot write result cache: %s\n", options.cachePath.c_str());
+        }
+    }
+    return ok ? 0 : 1;
+}
+
+bool BatchRunner::ProcessStream(std::FILE* input)
+{
+    m_carry.clear();
+    m_streamEnded = false;
+    m_readFailed = false;
+
+    const bool ok = ProcessChunks([this, input](Chunk& chunk) { return NextStreamChunk(input, chunk); });
+    return ok && !m_readFailed;
+}
+
+bool BatchRunner::ProcessBuffer(std::string_view data)
+{
+    return ProcessChunks([this, &data](Chunk& chunk) { return NextBufferChunk(data, chunk); });
+}
+
+void BatchRunner::EvaluateLines(BatchEvaluators& evaluators, std::string_view lines, NumberFormat format,
+    NumberMode mode, std::string& output, std::uint64_t& lineCount, std::uint64_t& errorCount)
+{
+    CALC_TRACE_SCOPE("BatchRunner::EvaluateLines");
+
+    const std::uint64_t firstLine = lineCount;
+    const char* lineStart = lines.data();
+    const char* end = lines.data() + lines.size();
+
+    while (lineStart < end)
+    {
+        const auto* newline = static_cast<const char*>(
+            std::memchr(lineStart, '\n', static_cast<std::size_t>(end - lineStart)));
+        const char* lineEnd = newline ? newline : end;
+
+        ++lineCount;
+        EvaluateLine(evaluators, std::string_view(lineStart, static_cast<std::size_t>(lineEnd - lineStart)),
+            format, mode, output, errorCount);
+
+        lineStart = lineEnd + 1;
+    }
+
+    CALC_TRACE_EVALUATIONS(lineCount - firstLine);
+}
+
+template<typename NextChunk>
+bool BatchRunner::ProcessChunks(NextChunk&& next)
+{
+    std::deque<std::unique_ptr<Chunk>> inFlight;
+    std::vector<std::unique_ptr<Chunk>> spare;
+    bool inputEnded = false;
+
+    for (;;)
+    {
+        // Держим окно заполненным: пока пишется самый старый кусок, остальные считаются
+        while (!inputEnded && inFlight.size() < m_window)
+        {
+            std::unique_ptr<Chunk> chunk;
+            if (spare.empty())
+            {
+                chunk = std::make_unique<Chunk>();
+            }
+            else
+            {
+                chunk = std::move(spare.back());
+                spare.pop_back();
+            }
+
+            if (!next(*chunk))
+            {
+                inputEnded = true;
+                spare.push_back(std::move(chunk));
+                break;
+            }
+
+            Dispatch(*chunk);
+            inFlight.push_back(std::move(chunk));
+        }
+
+        if (inFlight.empty())
+        {
+            break;
+        }
+
+        Chunk& oldest = *inFlight.front();
+        {
+            std::unique_lock<std::mutex> lock(m_doneMutex);
+            m_doneSignal.wait(lock, [&oldest] { return oldest.done; });
+        }
+
+        WriteChunk(oldest);
+        spare.push_back(std::move(inFlight.front()));
+        inFlight.pop_front();
+    }
+
+    if (std::fflush(m_output) != 0)
+    {
+        m_writeFailed = true;
+    }
+
+    return !m_writeFailed;
+}
+
+void BatchRunner::Dispatch(Chunk& chunk)
+{
+    chunk.output.clear();
+    chunk.output.reserve(chunk.input.size());
+    chunk.lineCount = 0;
+    chunk.errorCount = 0;
+    chunk.done = false;
+
+    if (!m_pool)
+    {
+        EvaluateLines(m_evaluators, chunk.input, m_format, m_mode, chunk.output, chunk.lineCount, chunk.errorCount);
+        chunk.done = true;
+        return;
+    }
+
+    m_pool->Submit([this, &chunk]
+    {
+        // Вычислитель не потокобезопасен — у каждого рабочего свой
+        thread_local BatchEvaluators evaluators;
+        evaluators.decimal.SetPrecision(m_precision);
+        evaluators.cache = m_cache;
+        EvaluateLines(evaluators, chunk.input, m_format, m_mode, chunk.output, chunk.lineCount, chunk.errorCount);
+
+        // Сигналим под мьютексом, иначе ожидающий может уйти раньше notify
+        std::lock_guard<std::mutex> lock(m_doneMutex);
+        chunk.done = true;
+        m_doneSignal.notify_one();
+    });
+}
+
+bool BatchRunner::WriteChunk(Chunk& chunk)
+{
+    m_lineCount += chunk.lineCount;
+    m_errorCount += chunk.errorCount;
+
+    if (!m_writeFailed && !chunk.output.empty()
+        && std::fwrite(chunk.output.data(), 1, chunk.output.size(), m_output) != chunk.output.size())
+    {
+        m_writeFailed = true;
+    }
+
+    return !m_writeFailed;
+}
+
+bool BatchRunner::NextBufferChunk(std::string_view& rest, Chunk& chunk)
+{
+    if (rest.empty())
+    {
+        return false;
+    }
+
+    std::size_t size = rest.size();
+    if (size > CHUNK_SIZE)
+    {
+        // Режем только по концу строки
+        const auto* newline = static_cast<const char*>(
+            std::memchr(rest.data() + CHUNK_SIZE, '\n', size - CHUNK_SIZE));
+        if (newline)
+        {
+            size = static_cast<std::size_t>(newline - rest.data()) + 1;
+        }
+    }
+
+    chunk.input = rest.substr(0, size);
+    rest.remove_prefix(size);
+    return true;
+}
+
+bool BatchRunner::NextStreamChunk(std::FILE* input, Chunk& chunk)
+{
+    std::vector<char>& storage = chunk.storage;
+    storage.assign(m_carry.begin(), m_carry.end());
+    m_carry.clear();
+
+    for (;;)
+    {
+        if (m_streamEnded)
+        {
+            chunk.input = std::string_view(storage.data(), storage.size());
+            return !storage.empty();
+        }
+
+        const std::size_t filled = storage.size();
+        storage.resize(filled + CHUNK_SIZE);
+        const std::size_t read = std::fread(storage.data() + filled, 1, CHUNK_SIZE, input);
+        storage.resize(filled + read);
+
+        if (read < CHUNK_SIZE)
+        {
+            m_streamEnded = true;
+            m_readFailed = std::ferror(input) != 0;
+            continue;
+        }
+
+        // Хвост без перевода строки переносим в следующий кусок
+        const char* begin = storage.data();
+        const char* end = begin + storage.size();
+        const char* lastNewline = end;
+        while (lastNewline != begin && lastNewline[-1] != '\n')
+        {
+            --lastNewline;
+        }
+
+        // Строка длиннее куска — дочитываем дальше
+        if (lastNewline == begin)
+        {
+            continue;
+        }
+
+        m_carry.assign(lastNewline, end);
+        storage.resize(static_cast<std::size_t>(lastNewline - begin));
+        chunk.input = std::string_view(storage.data(), storage.size());
+        return true;
+    }
+}
+
+} // namespace calc
@@ -0,0 +1,1273 @@
+#include "engine/big_decimal.h"
+#include "engine/job_service.h"
+#include "engine/operators.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <system_error>
+#include <utility>
+
+namespace calc
+{
+
+namespace
+{
+
+using Limb = BigDecimal::Limb;
+using Limbs = std::vector<Limb>;
+
+constexpr std::uint64_t BASE = BigDecimal::BASE;
+constexpr unsigned BASE_DIGITS = BigDecimal::BASE_DIGITS;
+
+constexpr Limb POW10[] = {
+    1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000
+};
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🔢 Операции над модулями (лимбы по основанию 10^9, младший первый)
+//──────────────────────────────────────────────────────────────────────────────
+
+void Trim(Limbs& v)
+{
+    while (!v.empty() && v.back() == 0)
+    {
+        v.pop_back();
+    }
+}
+
+int Compare(const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    if (na != nb)
+    {
+        return na < nb ? -1 : 1;
+    }
+    for (std::size_t i = na; i-- > 0;)
+    {
+        if (a[i] != b[i])
+        {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+int Compare(const Limbs& a, const Limbs& b)
+{
+    return Compare(a.data(), a.size(), b.data(), b.size());
+}
+
+unsigned DigitsInLimb(Limb limb)
+{
+    unsigned digits = 1;
+    while (digits < BASE_DIGITS && limb >= POW10[digits])
+    {
+        ++digits;
+    }
+    return digits;
+}
+
+std::size_t DigitCount(const Limbs& v)
+{
+    return v.empty() ? 0 : (v.size() - 1) * BASE_DIGITS + DigitsInLimb(v.back());
+}
+
+void MulSmall(Limbs& v, Limb factor)
+{
+    std::uint64_t carry = 0;
+    for (Limb& limb : v)
+    {
+        const std::uint64_t t = static_cast<std::uint64_t>(limb) * factor + carry;
+        limb = static_cast<Limb>(t % BASE);
+        carry = t / BASE;
+    }
+    if (carry != 0)
+    {
+        v.push_back(static_cast<Limb>(carry));
+    }
+}
+
+Limb DivSmall(Limbs& v, Limb divisor)
+{
+    std::uint64_t remainder = 0;
+    for (std::size_t i = v.size(); i-- > 0;)
+    {
+        const std::uint64_t t = remainder * BASE + v[i];
+        v[i] = static_cast<Limb>(t / divisor);
+        remainder = t % divisor;
+    }
+    Trim(v);
+    return static_cast<Limb>(remainder);
+}
+
+void AddSmall(Limbs& v, Limb value)
+{
+    std::uint64_t carry = value;
+    for (std::size_t i = 0; carry != 0; ++i)
+    {
+        if (i == v.size())
+        {
+            v.push_back(0);
+        }
+        const std::uint64_t t = v[i] + carry;
+        v[i] = static_cast<Limb>(t % BASE);
+        carry = t / BASE;
+    }
+}
+
+void MulPow10(Limbs& v, std::size_t power)
+{
+    if (v.empty())
+    {
+        return;
+    }
+    if (power % BASE_DIGITS != 0)
+    {
+        MulSmall(v, POW10[power % BASE_DIGITS]);
+    }
+    v.insert(v.begin(), power / BASE_DIGITS, 0);
+}
+
+/// out = a + b (out не совпадает с a и b)
+void AddMag(const Limb* a, std::size_t na, const Limb* b, std::size_t nb, Limbs& out)
+{
+    if (na < nb)
+    {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+
+    out.resize(na + 1);
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < na; ++i)
+    {
+        const std::uint64_t t = static_cast<std::uint64_t>(a[i]) + (i < nb ? b[i] : 0) + carry;
+        out[i] = static_cast<Limb>(t >= BASE ? t - BASE : t);
+        carry = t >= BASE;
+    }
+    out[na] = static_cast<Limb>(carry);
+    Trim(out);
+}
+
+/// a -= b при a >= b, на месте
+void SubInPlace(Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    std::int64_t borrow = 0;
+    for (std::size_t i = 0; i < na; ++i)
+    {
+        std::int64_t t = static_cast<std::int64_t>(a[i]) - (i < nb ? b[i] : 0) - borrow;
+        borrow = t < 0;
+        if (borrow)
+        {
+            t += static_cast<std::int64_t>(BASE);
+        }
+        a[i] = static_cast<Limb>(t);
+        if (i >= nb && borrow == 0)
+        {
+            break;
+        }
+    }
+}
+
+/// a += b со сдвигом на offset лимбов, a достаточно длинный
+void AddInPlace(Limb* a, std::size_t na, const Limb* b, std::size_t nb, std::size_t offset)
+{
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < nb || carry != 0; ++i)
+    {
+        if (offset + i >= na)
+        {
+            break;
+        }
+        const std::uint64_t t = static_cast<std::uint64_t>(a[offset + i]) + (i < nb ? b[i] : 0) + carry;
+        a[offset + i] = static_cast<Limb>(t >= BASE ? t - BASE : t);
+        carry = t >= BASE;
+    }
+}
+
+void MulSchoolbook(const Limb* a, std::size_t na, const Limb* b, std::size_t nb, Limb* out)
+{
+    std::fill(out, out + na + nb, 0);
+    for (std::size_t i = 0; i < na; ++i)
+    {
+        const std::uint64_t ai = a[i];
+        if (ai == 0)
+        {
+            continue;
+        }
+
+        std::uint64_t carry = 0;
+        for (std::size_t j = 0; j < nb; ++j)
+        {
+            const std::uint64_t t = out[i + j] + ai * b[j] + carry;
+            out[i + j] = static_cast<Limb>(t % BASE);
+            carry = t / BASE;
+        }
+        out[i + nb] = static_cast<Limb>(carry);
+    }
+}
+
+/// out[0, na + nb) = a × b
+void MulRecursive(const Limb* a, std::size_t na, const Limb* b, std::size_t nb, Limb* out)
+{
+    if (na < nb)
+    {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+
+    if (nb < BigDecimal::KARATSUBA_THRESHOLD)
+    {
+        MulSchoolbook(a, na, b, nb, out);
+        return;
+    }
+
+    // Несбалансированные операнды — полосами по nb лимбов
+    if (na >= 2 * nb)
+    {
+        std::fill(out, out + na + nb, 0);
+        Limbs partial(2 * nb);
+        for (std::size_t offset = 0; offset < na; offset += nb)
+        {
+            const std::size_t width = std::min(nb, na - offset);
+            MulRecursive(a + offset, width, b, nb, partial.data());
+            AddInPlace(out, na + nb, partial.data(), width + nb, offset);
+        }
+        return;
+    }
+
+    // Карацуба: a = a1·B^m + a0, b = b1·B^m + b0
+    const std::size_t m = nb / 2;
+    const std::size_t na1 = na - m;
+    const std::size_t nb1 = nb - m;
+
+    Limbs sumA;
+    Limbs sumB;
+    AddMag(a, m, a + m, na1, sumA);
+    AddMag(b, m, b + m, nb1, sumB);
+
+    std::fill(out, out + na + nb, 0);
+    MulRecursive(a, m, b, m, out);                  // z0 → out[0, 2m)
+    MulRecursive(a + m, na1, b + m, nb1, out + 2 * m); // z2 → out[2m, na + nb)
+
+    Limbs z1(sumA.size() + sumB.size() + 1, 0);
+    if (!sumA.empty() && !sumB.empty())
+    {
+        MulRecursive(sumA.data(), sumA.size(), sumB.data(), sumB.size(), z1.data());
+    }
+
+    // z1 = (a0 + a1)(b0 + b1) − z0 − z2 ≥ 0
+    SubInPlace(z1.data(), z1.size(), out, 2 * m);
+    SubInPlace(z1.data(), z1.size(), out + 2 * m, na1 + nb1);
+    Trim(z1);
+    AddInPlace(out, na + nb, z1.data(), z1.size(), m);
+}
+
+void MulMag(const Limbs& a, const Limbs& b, Limbs& out)
+{
+    if (a.empty() || b.empty())
+    {
+        out.clear();
+        return;
+    }
+
+    out.assign(a.size() + b.size(), 0);
+    MulRecursive(a.data(), a.size(), b.data(), b.size(), out.data());
+    Trim(out);
+}
+
+/// Алгоритм D Кнута: q = u / v, r = u % v (v.size() >= 2)
+void DivKnuth(const Limbs& u, const Limbs& v, Limbs& q, Limbs& r)
+{
+    const std::size_t n = v.size();
+    const std::size_t m = u.size() - n;
+
+    // Нормализация: старший лимб делителя ≥ BASE / 2
+    const Limb scale = static_cast<Limb>(BASE / (static_cast<std::uint64_t>(v.back()) + 1));
+    Limbs un = u;
+    Limbs vn = v;
+    MulSmall(un, scale);
+    MulSmall(vn, scale);
+    un.resize(u.size() + 1, 0);
+
+    q.assign(m + 1, 0);
+    const std::uint64_t vTop = vn[n - 1];
+    const std::uint64_t vNext = vn[n - 2];
+
+    for (std::size_t j = m + 1; j-- > 0;)
+    {
+        const std::uint64_t numerator = static_cast<std::uint64_t>(un[j + n]) * BASE + un[j + n - 1];
+        std::uint64_t qhat = numerator / vTop;
+        std::uint64_t rhat = numerator % vTop;
+
+        while (qhat >= BASE || qhat * vNext > rhat * BASE + un[j + n - 2])
+        {
+            --qhat;
+            rhat += vTop;
+            if (rhat >= BASE)
+            {
+                break;
+            }
+        }
+
+        // un[j, j + n] −= qhat × vn
+        std::uint64_t carry = 0;
+        std::int64_t borrow = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const std::uint64_t product = qhat * vn[i] + carry;
+            carry = product / BASE;
+            std::int64_t t = static_cast<std::int64_t>(un[i + j])
+                - static_cast<std::int64_t>(product % BASE) - borrow;
+            borrow = t < 0;
+            if (borrow)
+            {
+                t += static_cast<std::int64_t>(BASE);
+            }
+            un[i + j] = static_cast<Limb>(t);
+        }
+
+        std::int64_t top = static_cast<std::int64_t>(un[j + n]) - static_cast<std::int64_t>(carry) - borrow;
+        if (top < 0)
+        {
+            // qhat оказался на единицу больше — возвращаем делитель
+            --qhat;
+            std::uint64_t addCarry = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                const std::uint64_t t = static_cast<std::uint64_t>(un[i + j]) + vn[i] + addCarry;
+                un[i + j] = static_cast<Limb>(t >= BASE ? t - BASE : t);
+                addCarry = t >= BASE;
+            }
+            top += static_cast<std::int64_t>(addCarry);
+        }
+        un[j + n] = static_cast<Limb>(top);
+        q[j] = static_cast<Limb>(qhat);
+    }
+
+    Trim(q);
+    un.resize(n);
+    Trim(un);
+    DivSmall(un, scale);
+    r.swap(un);
+}
+
+/// R ≈ B^(2n) / v для v из n лимбов: обратная величина старшей половины,
+/// затем один шаг Ньютона R += R·(B^(2n) − v·R) / B^(2n) — точность удваивается
+void ReciprocalEstimate(const Limb* v, std::size_t n, Limbs& result)
+{
+    if (n <= BigDecimal::KARATSUBA_THRESHOLD)
+    {
+        Limbs power(2 * n + 1, 0);
+        power[2 * n] = 1;
+        Limbs divisor(v, v + n);
+        Limbs remainder;
+        if (n == 1)
+        {
+            result = power;
+            DivSmall(result, v[0]);
+            return;
+        }
+        DivKnuth(power, divisor, result, remainder);
+        return;
+    }
+
+    const std::size_t half = n / 2 + 1;
+    Limbs estimate;
+    ReciprocalEstimate(v + (n - half), half, estimate);
+
+    // Масштаб к полной точности: B^(2·half) / v_top → B^(2n) / v
+    result.assign(n - half, 0);
+    result.insert(result.end(), estimate.begin(), estimate.end());
+
+    const Limbs divisor(v, v + n);
+    Limbs power(2 * n + 1, 0);
+    power[2 * n] = 1;
+
+    Limbs product;
+    MulMag(divisor, result, product);
+
+    const bool below = Compare(product, power) <= 0;
+    Limbs error = below ? power : product;
+    const Limbs& subtrahend = below ? product : power;
+    SubInPlace(error.data(), error.size(), subtrahend.data(), subtrahend.size());
+    Trim(error);
+
+    Limbs delta;
+    MulMag(result, error, delta);
+    if (delta.size() <= 2 * n)
+    {
+        return;
+    }
+    delta.erase(delta.begin(), delta.begin() + static_cast<std::ptrdiff_t>(2 * n));
+
+    if (below)
+    {
+        Limbs sum;
+        AddMag(result.data(), result.size(), delta.data(), delta.size(), sum);
+        result.swap(sum);
+    }
+    else if (Compare(delta, result) < 0)
+    {
+        SubInPlace(result.data(), result.size(), delta.data(), delta.size());
+        Trim(result);
+    }
+}
+
+/// q = u / v, r = u % v через обратную величину делителя
+void DivNewton(const Limbs& u, const Limbs& v, Limbs& q, Limbs& r)
+{
+    // Обратная величина из n лимбов даёт частное делимого не длиннее 2n лимбов —
+    // длинное делимое уравниваем, дописывая нулевые лимбы делителю
+    const std::size_t pad = u.size() > 2 * v.size() ? u.size() - 2 * v.size() : 0;
+    Limbs divisor(pad, 0);
+    divisor.insert(divisor.end(), v.begin(), v.end());
+    const std::size_t n = divisor.size();
+
+    Limbs reciprocal;
+    ReciprocalEstimate(divisor.data(), n, reciprocal);
+
+    MulMag(u, reciprocal, q);
+    const std::size_t shift = 2 * n - pad;
+    if (q.size() > shift)
+    {
+        q.erase(q.begin(), q.begin() + static_cast<std::ptrdiff_t>(shift));
+    }
+    else
+    {
+        q.clear();
+    }
+
+    // Оценка отличается от точного частного на единицы — правим по остатку
+    Limbs product;
+    MulMag(q, v, product);
+    while (Compare(product, u) > 0)
+    {
+        SubInPlace(product.data(), product.size(), v.data(), v.size());
+        Trim(product);
+        SubInPlace(q.data(), q.size(), POW10, 1);
+        Trim(q);
+    }
+
+    r = u;
+    SubInPlace(r.data(), r.size(), product.data(), product.size());
+    Trim(r);
+    while (Compare(r, v) >= 0)
+    {
+        SubInPlace(r.data(), r.size(), v.data(), v.size());
+        Trim(r);
+        AddSmall(q, 1);
+    }
+}
+
+void DivMag(const Limbs& u, const Limbs& v, Limbs& q, Limbs& r)
+{
+    if (Compare(u, v) < 0)
+    {
+        q.clear();
+        r = u;
+        return;
+    }
+
+    if (v.size() == 1)
+    {
+        q = u;
+        const Limb remainder = DivSmall(q, v[0]);
+        r.clear();
+        if (remainder != 0)
+        {
+            r.push_back(remainder);
+        }
+        return;
+    }
+
+    if (v.size() >= BigDecimal::NEWTON_THRESHOLD)
+    {
+        DivNewton(u, v, q, r);
+    }
+    else
+    {
+        DivKnuth(u, v, q, r);
+    }
+}
+
+unsigned DigitAt(const Limbs& v, std::size_t position)
+{
+    const std::size_t limb = position / BASE_DIGITS;
+    if (limb >= v.size())
+    {
+        return 0;
+    }
+    return (v[limb] / POW10[position % BASE_DIGITS]) % 10;
+}
+
+bool AnyNonZeroBelow(const Limbs& v, std::size_t position)
+{
+    const std::size_t limb = position / BASE_DIGITS;
+    for (std::size_t i = 0; i < limb && i < v.size(); ++i)
+    {
+        if (v[i] != 0)
+        {
+            return true;
+        }
+    }
+    return limb < v.size() && v[limb] % POW10[position % BASE_DIGITS] != 0;
+}
+
+/// v /= 10^power (отбрасывание младших цифр)
+void ShiftDigitsRight(Limbs& v, std::size_t power)
+{
+    const std::size_t limbs = power / BASE_DIGITS;
+    if (limbs >= v.size())
+    {
+        v.clear();
+        return;
+    }
+    v.erase(v.begin(), v.begin() + static_cast<std::ptrdiff_t>(limbs));
+    if (power % BASE_DIGITS != 0)
+    {
+        DivSmall(v, POW10[power % BASE_DIGITS]);
+    }
+}
+
+thread_local Limbs t_scratch;   // 💾 Результат операции до копирования в out
+
+} // namespace
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🔄 Преобразования
+//──────────────────────────────────────────────────────────────────────────────
+
+bool BigDecimal::Parse(std::string_view text, std::uint32_t precision)
+{
+    std::size_t i = 0;
+    bool negative = false;
+    if (i < text.size() && (text[i] == '-' || text[i] == '+'))
+    {
+        negative = text[i] == '-';
+        ++i;
+    }
+
+    const std::size_t mantissaStart = i;
+    std::size_t digits = 0;
+    std::size_t fractionDigits = 0;
+    bool seenPoint = false;
+    for (; i < text.size(); ++i)
+    {
+        const char c = text[i];
+        if (c >= '0' && c <= '9')
+        {
+            ++digits;
+            fractionDigits += seenPoint;
+        }
+        else if (c == '.' && !seenPoint)
+        {
+            seenPoint = true;
+        }
+        else
+        {
+            break;
+        }
+    }
+    const std::size_t mantissaEnd = i;
+    if (digits == 0)
+    {
+        return false;
+    }
+
+    std::int64_t exponent = 0;
+    if (i < text.size() && (text[i] == 'e' || text[i] == 'E'))
+    {
+        ++i;
+        bool exponentNegative = false;
+        if (i < text.size() && (text[i] == '-' || text[i] == '+'))
+        {
+            exponentNegative = text[i] == '-';
+            ++i;
+        }
+        if (i == text.size())
+        {
+            return false;
+        }
+        for (; i < text.size(); ++i)
+        {
+            if (text[i] < '0' || text[i] > '9')
+            {
+                return false;
+            }
+            exponent = std::min<std::int64_t>(exponent * 10 + (text[i] - '0'), 4 * MAX_EXPONENT);
+        }
+        if (exponentNegative)
+        {
+            exponent = -exponent;
+        }
+    }
+    if (i != text.size())
+    {
+        return false;
+    }
+
+    // Цифры мантиссы собираются в лимбы с младшего конца
+    m_limbs.clear();
+    Limb limb = 0;
+    unsigned limbDigits = 0;
+    for (std::size_t j = mantissaEnd; j-- > mantissaStart;)
+    {
+        if (text[j] == '.')
+        {
+            continue;
+        }
+        limb += static_cast<Limb>(text[j] - '0') * POW10[limbDigits];
+        if (++limbDigits == BASE_DIGITS)
+        {
+            m_limbs.push_back(limb);
+            limb = 0;
+            limbDigits = 0;
+        }
+    }
+    if (limbDigits != 0)
+    {
+        m_limbs.push_back(limb);
+    }
+    Trim(m_limbs);
+
+    m_exponent = exponent - static_cast<std::int64_t>(fractionDigits);
+    m_negative = negative && !m_limbs.empty();
+    return Round(precision) == CalcError::None;
+}
+
+void BigDecimal::SetDouble(double value, std::uint32_t precision)
+{
+    char buffer[32];
+    const auto [end, error] = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    if (error != std::errc() || !std::isfinite(value) || !Parse(std::string_view(buffer, end - buffer), precision))
+    {
+        SetInteger(0);
+    }
+}
+
+void BigDecimal::SetInteger(std::int64_t value)
+{
+    m_limbs.clear();
+    m_exponent = 0;
+    m_negative = value < 0;
+
+    std::uint64_t magnitude = value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+    while (magnitude != 0)
+    {
+        m_limbs.push_back(static_cast<Limb>(magnitude % BASE));
+        magnitude /= BASE;
+    }
+}
+
+double BigDecimal::ToDouble() const
+{
+    if (IsZero())
+    {
+        return 0.0;
+    }
+
+    // 40 старших цифр с запасом покрывают точность double
+    static constexpr std::size_t MAX_DIGITS = 40;
+
+    char buffer[64];
+    std::size_t length = 0;
+    if (m_negative)
+    {
+        buffer[length++] = '-';
+    }
+
+    const std::size_t digits = GetDigitCount();
+    const std::size_t used = std::min(digits, MAX_DIGITS);
+    for (std::size_t k = 0; k < used; ++k)
+    {
+        buffer[length++] = static_cast<char>('0' + DigitAt(m_limbs, digits - 1 - k));
+    }
+
+    const std::int64_t exponent = m_exponent + static_cast<std::int64_t>(digits - used);
+    buffer[length++] = 'e';
+    const auto [end, error] = std::to_chars(buffer + length, buffer + sizeof(buffer), exponent);
+    length = static_cast<std::size_t>(end - buffer);
+
+    double value = 0.0;
+    const auto [parsed, parseError] = std::from_chars(buffer, buffer + length, value);
+    if (parseError == std::errc::result_out_of_range)
+    {
+        const bool huge = exponent > 0;
+        value = huge ? HUGE_VAL : 0.0;
+        return m_negative ? -value : value;
+    }
+    return value;
+}
+
+std::string BigDecimal::ToString() const
+{
+    std::string text;
+    AppendTo(text);
+    return text;
+}
+
+void BigDecimal::AppendTo(std::string& out) const
+{
+    if (IsZero())
+    {
+        out += '0';
+        return;
+    }
+
+    // Хвостовые нули коэффициента в записи не нужны
+    const std::size_t digits = GetDigitCount();
+    std::size_t trailing = 0;
+    while (trailing + 1 < digits && DigitAt(m_limbs, trailing) == 0)
+    {
+        ++trailing;
+    }
+
+    const std::size_t significant = digits - trailing;
+    const std::int64_t adjusted = m_exponent + static_cast<std::int64_t>(digits) - 1;
+    const auto digit = [&](std::size_t k) { return static_cast<char>('0' + DigitAt(m_limbs, digits - 1 - k)); };
+
+    if (m_negative)
+    {
+        out += '-';
+    }
+
+    // Как "%g": обычная запись, пока целая часть не длиннее значащих цифр
+    static constexpr std::int64_t MIN_PLAIN = -7;
+    static constexpr std::int64_t MIN_INTEGER_DIGITS = 21;
+    const std::int64_t maxPlain = std::max(static_cast<std::int64_t>(significant), MIN_INTEGER_DIGITS);
+    if (adjusted >= MIN_PLAIN && adjusted < maxPlain)
+    {
+        if (adjusted < 0)
+        {
+            out += "0.";
+            out.append(static_cast<std::size_t>(-adjusted - 1), '0');
+            for (std::size_t k = 0; k < significant; ++k)
+            {
+                out += digit(k);
+            }
+            return;
+        }
+
+        const std::size_t integerDigits = static_cast<std::size_t>(adjusted) + 1;
+        for (std::size_t k = 0; k < std::max(integerDigits, significant); ++k)
+        {
+            if (k == integerDigits)
+            {
+                out += '.';
+            }
+            out += k < significant ? digit(k) : '0';
+        }
+        return;
+    }
+
+    out += digit(0);
+    if (significant > 1)
+    {
+        out += '.';
+        for (std::size_t k = 1; k < significant; ++k)
+        {
+            out += digit(k);
+        }
+    }
+
+    char exponent[24];
+    const auto [end, error] = std::to_chars(exponent, exponent + sizeof(exponent),
+        adjusted < 0 ? -adjusted : adjusted);
+    out += 'e';
+    out += adjusted < 0 ? '-' : '+';
+    if (end - exponent < 2)
+    {
+        out += '0';
+    }
+    out.append(exponent, end);
+}
+
+std::size_t BigDecimal::GetDigitCount() const
+{
+    return DigitCount(m_limbs);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// ⚡ Арифметика
+//──────────────────────────────────────────────────────────────────────────────
+
+CalcError BigDecimal::Add(const BigDecimal& a, const BigDecimal& b, BigDecimal& out, std::uint32_t precision)
+{
+    if (b.IsZero() || a.IsZero())
+    {
+        out = a.IsZero() ? b : a;
+        return out.Round(precision);
+    }
+
+    // Операнды длиннее precision (точность сменили на ходу) сначала округляются
+    if (a.GetDigitCount() > precision || b.GetDigitCount() > precision)
+    {
+        BigDecimal ra = a;
+        BigDecimal rb = b;
+        ra.Round(precision);
+        rb.Round(precision);
+        return Add(ra, rb, out, precision);
+    }
+
+    const BigDecimal* big = &a;
+    const BigDecimal* small = &b;
+    std::int64_t topBig = a.m_exponent + static_cast<std::int64_t>(a.GetDigitCount());
+    std::int64_t topSmall = b.m_exponent + static_cast<std::int64_t>(b.GetDigitCount());
+    if (topSmall > topBig)
+    {
+        std::swap(big, small);
+        std::swap(topBig, topSmall);
+    }
+
+    // Слагаемое целиком ниже разряда округления заменяется «липкой» единицей
+    const std::int64_t stickyPosition = topBig - static_cast<std::int64_t>(precision) - 3;
+    Limbs& scratch = t_scratch;
+    std::int64_t smallExponent = small->m_exponent;
+    const Limbs* smallLimbs = &small->m_limbs;
+    static thread_local Limbs s_sticky;
+    if (topSmall < stickyPosition)
+    {
+        s_sticky.assign(1, 1);
+        smallLimbs = &s_sticky;
+        smallExponent = stickyPosition;
+    }
+
+    const std::int64_t exponent = std::min(big->m_exponent, smallExponent);
+    static thread_local Limbs s_big;
+    static thread_local Limbs s_small;
+    s_big = big->m_limbs;
+    s_small = *smallLimbs;
+    MulPow10(s_big, static_cast<std::size_t>(big->m_exponent - exponent));
+    MulPow10(s_small, static_cast<std::size_t>(smallExponent - exponent));
+
+    bool negative = big->m_negative;
+    if (big->m_negative == small->m_negative)
+    {
+        AddMag(s_big.data(), s_big.size(), s_small.data(), s_small.size(), scratch);
+    }
+    else
+    {
+        const int order = Compare(s_big, s_small);
+        if (order < 0)
+        {
+            std::swap(s_big, s_small);
+            negative = small->m_negative;
+        }
+        scratch = s_big;
+        SubInPlace(scratch.data(), scratch.size(), s_small.data(), s_small.size());
+        Trim(scratch);
+    }
+
+    out.m_limbs.assign(scratch.begin(), scratch.end());
+    out.m_exponent = exponent;
+    out.m_negative = negative && !out.m_limbs.empty();
+    return out.Round(precision);
+}
+
+CalcError BigDecimal::Subtract(const BigDecimal& a, const BigDecimal& b, BigDecimal& out, std::uint32_t precision)
+{
+    BigDecimal negated = b;
+    negated.Negate();
+    return Add(a, negated, out, precision);
+}
+
+CalcError BigDecimal::Multiply(const BigDecimal& a, const BigDecimal& b, BigDecimal& out, std::uint32_t precision)
+{
+    Limbs& scratch = t_scratch;
+    MulMag(a.m_limbs, b.m_limbs, scratch);
+
+    const bool negative = a.m_negative != b.m_negative;
+    out.m_exponent = a.m_exponent + b.m_exponent;
+    out.m_limbs.assign(scratch.begin(), scratch.end());
+    out.m_negative = negative && !out.m_limbs.empty();
+    return out.Round(precision);
+}
+
+CalcError BigDecimal::Divide(const BigDecimal& a, const BigDecimal& b, BigDecimal& out, std::uint32_t precision)
+{
+    if (b.IsZero())
+    {
+        return CalcError::DivisionByZero;
+    }
+    if (a.IsZero())
+    {
+        out.SetInteger(0);
+        return CalcError::None;
+    }
+
+    // Частное ca·10^s / cb должно иметь не меньше precision + 1 цифр
+    const std::int64_t da = static_cast<std::int64_t>(a.GetDigitCount());
+    const std::int64_t db = static_cast<std::int64_t>(b.GetDigitCount());
+    const std::int64_t scale = std::max<std::int64_t>(0, static_cast<std::int64_t>(precision) + 2 + db - da);
+
+    static thread_local Limbs s_numerator;
+    static thread_local Limbs s_remainder;
+    s_numerator = a.m_limbs;
+    MulPow10(s_numerator, static_cast<std::size_t>(scale));
+
+    Limbs& quotient = t_scratch;
+    DivMag(s_numerator, b.m_limbs, quotient, s_remainder);
+
+    // Ненулевой остаток — «липкая» цифра для правильного округления
+    MulSmall(quotient, 10);
+    if (!s_remainder.empty())
+    {
+        AddSmall(quotient, 1);
+    }
+
+    const bool negative = a.m_negative != b.m_negative;
+    out.m_limbs.assign(quotient.begin(), quotient.end());
+    out.m_exponent = a.m_exponent - b.m_exponent - scale - 1;
+    out.m_negative = negative && !out.m_limbs.empty();
+    return out.Round(precision);
+}
+
+CalcError BigDecimal::Power(const BigDecimal& a, const BigDecimal& b, BigDecimal& out, std::uint32_t precision)
+{
+    // Целый показатель — точное возведение бинарным методом с запасом цифр
+    const std::int64_t integerDigits = static_cast<std::int64_t>(b.GetDigitCount()) + b.m_exponent;
+    if (b.IsZero() || (b.IsInteger() && integerDigits <= 10))
+    {
+        Limbs integer = b.m_limbs;
+        if (b.m_exponent < 0)
+        {
+            ShiftDigitsRight(integer, static_cast<std::size_t>(-b.m_exponent));
+        }
+
+        std::uint64_t n = 0;
+        for (std::size_t i = integer.size(); i-- > 0;)
+        {
+            n = n * BASE + integer[i];
+        }
+        for (std::int64_t e = b.m_exponent; e > 0; --e)
+        {
+            n *= 10;
+        }
+
+        if (a.IsZero())
+        {
+            if (b.m_negative && n != 0)
+            {
+                return CalcError::DivisionByZero;
+            }
+            out.SetInteger(n == 0 ? 1 : 0);
+            return CalcError::None;
+        }
+
+        const std::uint32_t working = precision + 12;
+        BigDecimal result;
+        result.SetInteger(1);
+        BigDecimal base = a;
+        CalcError error = base.Round(working);
+
+        while (n != 0 && error == CalcError::None)
+        {
+            if (IsJobCancelled())
+            {
+                return CalcError::Cancelled;
+            }
+            if (n & 1)
+            {
+                error = Multiply(result, base, result, working);
+            }
+            n >>= 1;
+            if (n != 0 && error == CalcError::None)
+            {
+                error = Multiply(base, base, base, working);
+            }
+        }
+
+        if (error == CalcError::None && b.m_negative)
+        {
+            BigDecimal one;
+            one.SetInteger(1);
+            error = Divide(one, result, result, working);
+        }
+        if (error != CalcError::None)
+        {
+            return error;
+        }
+
+        out = result;
+        return out.Round(precision);
+    }
+
+    // Дробный показатель — через double (точность double, а не precision)
+    const double base = a.ToDouble();
+    const double exponent = b.ToDouble();
+    if (base == 0.0 && exponent < 0.0)
+    {
+        return CalcError::DivisionByZero;
+    }
+
+    const double value = std::pow(base, exponent);
+    if (std::isnan(value))
+    {
+        return CalcError::InvalidNumber;
+    }
+    if (std::isinf(value))
+    {
+        return CalcError::Overflow;
+    }
+
+    out.SetDouble(value, precision);
+    return CalcError::None;
+}
+
+CalcError BigDecimal::Apply(Operator op, const BigDecimal& a, const BigDecimal& b, BigDecimal& out,
+    std::uint32_t precision)
+{
+    switch (op)
+    {
+    case Operator::Add:      return Add(a, b, out, precision);
+    case Operator::Subtract: return Subtract(a, b, out, precision);
+    case Operator::Multiply: return Multiply(a, b, out, precision);
+    case Operator::Divide:   return Divide(a, b, out, precision);
+    case Operator::Power:    return Power(a, b, out, precision);
+    default:                 break;     // ❗ Постфиксные и функции — не бинарные
+    }
+
+    out = b;
+    return CalcError::None;
+}
+
+CalcError BigDecimal::SquareRoot(const BigDecimal& a, BigDecimal& out, std::uint32_t precision)
+{
+    if (a.m_negative)
+    {
+        return CalcError::InvalidNumber;
+    }
+    if (a.IsZero())
+    {
+        out = a;
+        return CalcError::None;
+    }
+
+    // a = s · 10^(2m), 1 ≤ s < 100: порядок a может не помещаться в double
+    const std::int64_t adjusted = a.m_exponent + static_cast<std::int64_t>(a.GetDigitCount()) - 1;
+    const std::int64_t half = adjusted >= 0 ? adjusted / 2 : -((1 - adjusted) / 2);
+    BigDecimal scaled = a;
+    scaled.m_exponent -= 2 * half;
+
+    // Ньютон x ← (x + s/x) / 2 от double: число верных цифр удваивается за шаг
+    const std::uint32_t working = precision + 2;
+    BigDecimal x;
+    x.SetDouble(std::sqrt(scaled.ToDouble()), working);
+
+    BigDecimal halfOne;
+    halfOne.Parse("0.5", working);
+
+    BigDecimal quotient;
+    for (std::uint32_t digits = 15; ; digits *= 2)
+    {
+        if (IsJobCancelled())
+        {
+            return CalcError::Cancelled;
+        }
+
+        CalcError error = Divide(scaled, x, quotient, working);
+        if (error == CalcError::None)
+        {
+            error = Add(x, quotient, x, working);
+        }
+        if (error == CalcError::None)
+        {
+            error = Multiply(x, halfOne, x, working);
+        }
+        if (error != CalcError::None)
+        {
+            return error;
+        }
+
+        // Один шаг сверх нужного — запас на погрешность начального приближения
+        if (digits > working)
+        {
+            break;
+        }
+    }
+
+    // Ньютон ошибается на доли последнего знака working, но округление до precision
+    // рядом с серединой между соседями уходит не туда (двойное округление). Решает
+    // точный остаток: знак s − m², где m — середина между y и соседом; на самой
+    // середине — к чётному
+    constexpr std::uint32_t EXACT = std::numeric_limits<std::uint32_t>::max();
+    BigDecimal y = x;
+    y.Round(precision);
+
+    const auto ulpExponent = [precision](const BigDecimal& v)
+    {
+        return v.m_exponent + static_cast<std::int64_t>(v.GetDigitCount()) - static_cast<std::int64_t>(precision);
+    };
+    const auto isOdd = [&ulpExponent](const BigDecimal& v)
+    {
+        const std::int64_t position = ulpExponent(v) - v.m_exponent;
+        return position >= 0 && DigitAt(v.m_limbs, static_cast<std::size_t>(position)) % 2 == 1;
+    };
+    const auto step = [&ulpExponent](const BigDecimal& v, std::int64_t shift)
+    {
+        BigDecimal ulp;
+        ulp.SetInteger(1);
+        ulp.m_exponent = ulpExponent(v) + shift;
+        return ulp;
+    };
+
+    BigDecimal neighbour;
+    BigDecimal midpoint;
+    BigDecimal square;
+    const auto compareMidpoint = [&](int& order)
+    {
+        CalcError error = Add(y, neighbour, midpoint, EXACT);
+        if (error == CalcError::None)
+        {
+            error = Multiply(midpoint, halfOne, midpoint, EXACT);
+        }
+        if (error == CalcError::None)
+        {
+            error = Multiply(midpoint, midpoint, square, EXACT);
+        }
+        if (error == CalcError::None)
+        {
+            error = Subtract(scaled, square, square, EXACT);
+        }
+        order = square.IsZero() ? 0 : square.IsNegative() ? -1 : 1;
+        return error;
+    };
+
+    for (;;)
+    {
+        int order = 0;
+        CalcError error = Add(y, step(y, 0), neighbour, EXACT);
+        if (error == CalcError::None)
+        {
+            error = compareMidpoint(order);
+        }
+        if (error != CalcError::None)
+        {
+            return error;
+        }
+        if (order > 0 || (order == 0 && isOdd(y)))
+        {
+            y = neighbour;
+            continue;
+        }
+
+        // Ниже степени десяти шаг соседа в десять раз мельче
+        error = Subtract(y, step(y, 0), neighbour, EXACT);
+        if (error == CalcError::None && ulpExponent(neighbour) < ulpExponent(y))
+        {
+            error = Subtract(y, step(y, -1), neighbour, EXACT);
+        }
+        if (error == CalcError::None)
+        {
+            error = compareMidpoint(order);
+        }
+        if (error != CalcError::None)
+        {
+            return error;
+        }
+        if (order < 0 || (order == 0 && isOdd(y)))
+        {
+            y = neighbour;
+            continue;
+        }
+        break;
+    }
+
+    y.m_exponent += half;
+    out = std::move(y);
+    return out.Round(precision);
+}
+
+CalcError BigDecimal::Function(Operator op, const BigDecimal& a, BigDecimal& out, std::uint32_t precision)
+{
+    if (op == Operator::Sqrt)
+    {
+        return SquareRoot(a, out, precision);
+    }
+
+    const FunctionKernel function = GetOperatorInfo(op).function;
+    if (function == nullptr)
+    {
+        return CalcError::SyntaxError;
+    }
+
+    // Трансцендентные — с точностью double, а не precision
+    const double value = function(a.ToDouble());
+    if (std::isnan(value))
+    {
+        return CalcError::InvalidNumber;
+    }
+    if (std::isinf(value))
+    {
+        return CalcError::Overflow;
+    }
+
+    out.SetDouble(value, precision);
+    return CalcError::None;
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🎯 Округление
+//──────────────────────────────────────────────────────────────────────────────
+
+CalcError BigDecimal::Round(std::uint32_t precision)
+{
+    if (m_limbs.empty())
+    {
+        m_negative = false;
+        m_exponent = 0;
+        return CalcError::None;
+    }
+
+    std::size_t digits = GetDigitCount();
+    if (digits > precision)
+    {
+        // Половина — к чётному: решают отбрасываемая старшая цифра, «липкий» хвост и чётность
+        const std::size_t drop = digits - precision;
+        const unsigned roundDigit = DigitAt(m_limbs, drop - 1);
+        const bool sticky = AnyNonZeroBelow(m_limbs, drop - 1);
+
+        ShiftDigitsRight(m_limbs, drop);
+        m_exponent += static_cast<std::int64_t>(drop);
+
+        const bool odd = !m_limbs.empty() && (m_limbs[0] & 1) != 0;
+        if (roundDigit > 5 || (roundDigit == 5 && (sticky || odd)))
+        {
+            AddSmall(m_limbs, 1);
+            if (GetDigitCount() > precision)
+            {
+                ShiftDigitsRight(m_limbs, 1);
+                ++m_exponent;
+            }
+        }
+        digits = GetDigitCount();
+    }
+
+    const std::int64_t adjusted = m_exponent + static_cast<std::int64_t>(digits) - 1;
+    if (adjusted > MAX_EXPONENT)
+    {
+        return CalcError::Overflow;
+    }
+    if (adjusted < -MAX_EXPONENT)
+    {
+        m_limbs.clear();
+        m_negative = false;
+        m_exponent = 0;
+    }
+    return CalcError::None;
+}
+
+bool BigDecimal::IsInteger() const
+{
+    if (m_exponent >= 0)
+    {
+        return true;
+    }
+
+    const std::size_t fraction = static_cast<std::size_t>(-m_exponent);
+    return fraction < GetDigitCount() && !AnyNonZeroBelow(m_limbs, fraction);
+}
+
+} // namespace calc
@@ -0,0 +1,1448 @@
+#include "engine/big_integer.h"
+#include "engine/job_service.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace calc
+{
+
+namespace
+{
+
+using Limb = BigInteger::Limb;
+using Limbs = std::vector<Limb>;
+
+constexpr unsigned LIMB_BITS = 32;
+constexpr Limb DECIMAL_CHUNK = 1000000000;      // 🔢 10^9 — девять цифр на лимб
+constexpr unsigned DECIMAL_CHUNK_DIGITS = 9;
+constexpr std::size_t CONVERSION_BASECASE = 24; // 📏 Лимбов для квадратичного перевода
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🔢 Операции над модулями (лимбы по 2^32, младший первый)
+//──────────────────────────────────────────────────────────────────────────────
+
+std::size_t Significant(const Limb* v, std::size_t n)
+{
+    while (n > 0 && v[n - 1] == 0)
+    {
+        --n;
+    }
+    return n;
+}
+
+void Trim(Limbs& v)
+{
+    v.resize(Significant(v.data(), v.size()));
+}
+
+int Compare(const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    na = Significant(a, na);
+    nb = Significant(b, nb);
+    if (na != nb)
+    {
+        return na < nb ? -1 : 1;
+    }
+    for (std::size_t i = na; i-- > 0;)
+    {
+        if (a[i] != b[i])
+        {
+            return a[i] < b[i] ? -1 : 1;
+        }
+    }
+    return 0;
+}
+
+int Compare(const Limbs& a, const Limbs& b)
+{
+    return Compare(a.data(), a.size(), b.data(), b.size());
+}
+
+Limbs AddMag(const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    if (na < nb)
+    {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+
+    Limbs sum(na + 1);
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < na; ++i)
+    {
+        carry += static_cast<std::uint64_t>(a[i]) + (i < nb ? b[i] : 0);
+        sum[i] = static_cast<Limb>(carry);
+        carry >>= LIMB_BITS;
+    }
+    sum[na] = static_cast<Limb>(carry);
+    Trim(sum);
+    return sum;
+}
+
+/// a −= b при a ≥ b
+void SubInPlace(Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    std::uint64_t borrow = 0;
+    for (std::size_t i = 0; i < na && (i < nb || borrow != 0); ++i)
+    {
+        const std::uint64_t t = static_cast<std::uint64_t>(a[i]) - (i < nb ? b[i] : 0) - borrow;
+        a[i] = static_cast<Limb>(t);
+        borrow = (t >> LIMB_BITS) != 0;
+    }
+}
+
+/// a += b·B^offset, a достаточно длинный
+void AddShifted(Limbs& a, const Limbs& b, std::size_t offset)
+{
+    if (a.size() < offset + b.size() + 1)
+    {
+        a.resize(offset + b.size() + 1, 0);
+    }
+
+    std::uint64_t carry = 0;
+    std::size_t i = 0;
+    for (; i < b.size(); ++i)
+    {
+        carry += static_cast<std::uint64_t>(a[offset + i]) + b[i];
+        a[offset + i] = static_cast<Limb>(carry);
+        carry >>= LIMB_BITS;
+    }
+    for (; carry != 0; ++i)
+    {
+        if (offset + i == a.size())
+        {
+            a.push_back(0);
+        }
+        carry += a[offset + i];
+        a[offset + i] = static_cast<Limb>(carry);
+        carry >>= LIMB_BITS;
+    }
+}
+
+void MulSmall(Limbs& v, Limb factor)
+{
+    std::uint64_t carry = 0;
+    for (Limb& limb : v)
+    {
+        carry += static_cast<std::uint64_t>(limb) * factor;
+        limb = static_cast<Limb>(carry);
+        carry >>= LIMB_BITS;
+    }
+    if (carry != 0)
+    {
+        v.push_back(static_cast<Limb>(carry));
+    }
+}
+
+void AddSmall(Limbs& v, Limb value)
+{
+    std::uint64_t carry = value;
+    for (std::size_t i = 0; carry != 0; ++i)
+    {
+        if (i == v.size())
+        {
+            v.push_back(0);
+        }
+        carry += v[i];
+        v[i] = static_cast<Limb>(carry);
+        carry >>= LIMB_BITS;
+    }
+}
+
+Limb DivSmall(Limbs& v, Limb divisor)
+{
+    std::uint64_t remainder = 0;
+    for (std::size_t i = v.size(); i-- > 0;)
+    {
+        const std::uint64_t t = (remainder << LIMB_BITS) | v[i];
+        v[i] = static_cast<Limb>(t / divisor);
+        remainder = t % divisor;
+    }
+    Trim(v);
+    return static_cast<Limb>(remainder);
+}
+
+void ShiftLeftBits(Limbs& v, unsigned bits)
+{
+    if (bits == 0 || v.empty())
+    {
+        return;
+    }
+
+    Limb carry = 0;
+    for (Limb& limb : v)
+    {
+        const Limb next = limb >> (LIMB_BITS - bits);
+        limb = (limb << bits) | carry;
+        carry = next;
+    }
+    if (carry != 0)
+    {
+        v.push_back(carry);
+    }
+}
+
+void ShiftRightBits(Limbs& v, unsigned bits)
+{
+    if (bits == 0)
+    {
+        return;
+    }
+
+    for (std::size_t i = 0; i < v.size(); ++i)
+    {
+        const Limb high = i + 1 < v.size() ? v[i + 1] << (LIMB_BITS - bits) : 0;
+        v[i] = (v[i] >> bits) | high;
+    }
+    Trim(v);
+}
+
+unsigned LeadingZeros(Limb limb)
+{
+    unsigned zeros = 0;
+    for (Limb bit = Limb(1) << (LIMB_BITS - 1); bit != 0 && (limb & bit) == 0; bit >>= 1)
+    {
+        ++zeros;
+    }
+    return zeros;
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// ✖️ Умножение
+//──────────────────────────────────────────────────────────────────────────────
+
+Limbs Mul(const Limb* a, std::size_t na, const Limb* b, std::size_t nb);
+
+Limbs MulSchoolbook(const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    Limbs product(na + nb, 0);
+    for (std::size_t i = 0; i < na; ++i)
+    {
+        const std::uint64_t ai = a[i];
+        if (ai == 0)
+        {
+            continue;
+        }
+
+        std::uint64_t carry = 0;
+        for (std::size_t j = 0; j < nb; ++j)
+        {
+            carry += product[i + j] + ai * b[j];
+            product[i + j] = static_cast<Limb>(carry);
+            carry >>= LIMB_BITS;
+        }
+        product[i + nb] = static_cast<Limb>(carry);
+    }
+    Trim(product);
+    return product;
+}
+
+/// a = a1·B^m + a0: z0 = a0·b0, z2 = a1·b1, z1 = (a0 + a1)(b0 + b1) − z0 − z2
+Limbs MulKaratsuba(const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    const std::size_t m = nb / 2;
+
+    const Limbs z0 = Mul(a, m, b, m);
+    const Limbs z2 = Mul(a + m, na - m, b + m, nb - m);
+    const Limbs sumA = AddMag(a, Significant(a, m), a + m, na - m);
+    const Limbs sumB = AddMag(b, Significant(b, m), b + m, nb - m);
+    Limbs z1 = Mul(sumA.data(), sumA.size(), sumB.data(), sumB.size());
+    SubInPlace(z1.data(), z1.size(), z0.data(), z0.size());
+    SubInPlace(z1.data(), z1.size(), z2.data(), z2.size());
+    Trim(z1);
+
+    Limbs product(na + nb + 1, 0);
+    AddShifted(product, z0, 0);
+    AddShifted(product, z1, m);
+    AddShifted(product, z2, 2 * m);
+    Trim(product);
+    return product;
+}
+
+/// 🔢 Знаковое значение для интерполяции Тоома
+struct Signed
+{
+    Limbs magnitude;
+    bool negative = false;
+};
+
+Signed SignedAdd(const Signed& x, const Signed& y, bool negateY = false)
+{
+    const bool yNegative = y.negative != negateY;
+    if (x.negative == yNegative)
+    {
+        return Signed{ AddMag(x.magnitude.data(), x.magnitude.size(), y.magnitude.data(), y.magnitude.size()),
+            x.negative && !(x.magnitude.empty() && y.magnitude.empty()) };
+    }
+
+    const bool xLarger = Compare(x.magnitude, y.magnitude) >= 0;
+    Signed result{ xLarger ? x.magnitude : y.magnitude, xLarger ? x.negative : yNegative };
+    const Limbs& smaller = xLarger ? y.magnitude : x.magnitude;
+    SubInPlace(result.magnitude.data(), result.magnitude.size(), smaller.data(), smaller.size());
+    Trim(result.magnitude);
+    result.negative = result.negative && !result.magnitude.empty();
+    return result;
+}
+
+Signed SignedMul(const Signed& x, const Signed& y)
+{
+    Signed result{ Mul(x.magnitude.data(), x.magnitude.size(), y.magnitude.data(), y.magnitude.size()),
+        x.negative != y.negative };
+    result.negative = result.negative && !result.magnitude.empty();
+    return result;
+}
+
+Signed Piece(const Limb* v, std::size_t n, std::size_t from, std::size_t count)
+{
+    if (from >= n)
+    {
+        return Signed{};
+    }
+    const std::size_t end = std::min(n, from + count);
+    Signed piece{ Limbs(v + from, v + end), false };
+    Trim(piece.magnitude);
+    return piece;
+}
+
+/// Оценки в 0, 1, −1, −2, ∞ и интерполяция по схеме Бодрато
+Limbs MulToom3(const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    const std::size_t k = (na + 2) / 3;
+
+    const Signed a0 = Piece(a, na, 0, k);
+    const Signed a1 = Piece(a, na, k, k);
+    const Signed a2 = Piece(a, na, 2 * k, na);
+    const Signed b0 = Piece(b, nb, 0, k);
+    const Signed b1 = Piece(b, nb, k, k);
+    const Signed b2 = Piece(b, nb, 2 * k, nb);
+
+    const auto evaluate = [](const Signed& x0, const Signed& x1, const Signed& x2,
+        Signed& atOne, Signed& atMinusOne, Signed& atMinusTwo)
+    {
+        const Signed p = SignedAdd(x0, x2);
+        atOne = SignedAdd(p, x1);
+        atMinusOne = SignedAdd(p, x1, true);
+        atMinusTwo = SignedAdd(atMinusOne, x2);
+        ShiftLeftBits(atMinusTwo.magnitude, 1);
+        atMinusTwo = SignedAdd(atMinusTwo, x0, true);
+    };
+
+    Signed a1v, am1, am2;
+    Signed b1v, bm1, bm2;
+    evaluate(a0, a1, a2, a1v, am1, am2);
+    evaluate(b0, b1, b2, b1v, bm1, bm2);
+
+    const Signed r0 = SignedMul(a0, b0);
+    Signed r1 = SignedMul(a1v, b1v);
+    const Signed rm1 = SignedMul(am1, bm1);
+    const Signed rm2 = SignedMul(am2, bm2);
+    const Signed rinf = SignedMul(a2, b2);
+
+    Signed r3 = SignedAdd(rm2, r1, true);
+    DivSmall(r3.magnitude, 3);
+    r1 = SignedAdd(r1, rm1, true);
+    ShiftRightBits(r1.magnitude, 1);
+    Signed r2 = SignedAdd(rm1, r0, true);
+    r3 = SignedAdd(r2, r3, true);
+    ShiftRightBits(r3.magnitude, 1);
+    Signed twiceInf = rinf;
+    ShiftLeftBits(twiceInf.magnitude, 1);
+    r3 = SignedAdd(r3, twiceInf);
+    r2 = SignedAdd(SignedAdd(r2, r1), rinf, true);
+    r1 = SignedAdd(r1, r3, true);
+
+    // Коэффициенты произведения неотрицательны
+    Limbs product(na + nb + 1, 0);
+    AddShifted(product, r0.magnitude, 0);
+    AddShifted(product, r1.magnitude, k);
+    AddShifted(product, r2.magnitude, 2 * k);
+    AddShifted(product, r3.magnitude, 3 * k);
+    AddShifted(product, rinf.magnitude, 4 * k);
+    Trim(product);
+    return product;
+}
+
+/// 🌀 Число-теоретическое преобразование по простому модулю MOD = c·2^k + 1
+template <std::uint32_t MOD, std::uint32_t GENERATOR>
+struct NttField
+{
+    static std::uint32_t Mul(std::uint32_t a, std::uint32_t b)
+    {
+        return static_cast<std::uint32_t>(static_cast<std::uint64_t>(a) * b % MOD);
+    }
+
+    static std::uint32_t Pow(std::uint32_t base, std::uint64_t exponent)
+    {
+        std::uint32_t result = 1;
+        for (; exponent != 0; exponent >>= 1)
+        {
+            if (exponent & 1)
+            {
+                result = Mul(result, base);
+            }
+            base = Mul(base, base);
+        }
+        return result;
+    }
+
+    /// 🌀 Множитель с предвычисленной долей Шоупа: w·x mod MOD без деления
+    struct Twiddle
+    {
+        std::uint32_t value;
+        std::uint32_t quotient;   // ⌊value · 2^32 / MOD⌋
+    };
+
+    static Twiddle MakeTwiddle(std::uint32_t value)
+    {
+        return Twiddle{ value, static_cast<std::uint32_t>((static_cast<std::uint64_t>(value) << 32) / MOD) };
+    }
+
+    static std::uint32_t Mul(std::uint32_t x, Twiddle w)
+    {
+        const std::uint32_t estimate = static_cast<std::uint32_t>((static_cast<std::uint64_t>(x) * w.quotient) >> 32);
+        const std::uint32_t result = x * w.value - estimate * MOD;
+        return result >= MOD ? result - MOD : result;
+    }
+
+    /// Корни каждого слоя подряд: roots[half + j] = w^j, w — корень степени 2·half
+    static std::vector<Twiddle> Roots(std::size_t n, bool inverse)
+    {
+        std::vector<Twiddle> roots(n);
+        for (std::size_t half = 1; half < n; half <<= 1)
+        {
+            std::uint32_t root = Pow(GENERATOR, (MOD - 1) / (2 * half));
+            if (inverse)
+            {
+                root = Pow(root, MOD - 2);
+            }
+            std::uint32_t power = 1;
+            for (std::size_t j = 0; j < half; ++j)
+            {
+                roots[half + j] = MakeTwiddle(power);
+                power = Mul(power, root);
+            }
+        }
+        return roots;
+    }
+
+    /// Слой прямого преобразования (Джентльмен — Сэнди) на отрезке [first, last)
+    static void ForwardLayer(std::uint32_t* a, std::size_t first, std::size_t last, std::size_t half,
+        const Twiddle* layer)
+    {
+        for (std::size_t start = first; start < last; start += 2 * half)
+        {
+            for (std::size_t j = 0; j < half; ++j)
+            {
+                const std::uint32_t u = a[start + j];
+                const std::uint32_t v = a[start + j + half];
+                const std::uint32_t sum = u + v;
+                a[start + j] = sum >= MOD ? sum - MOD : sum;
+                a[start + j + half] = Mul(u >= v ? u - v : u + MOD - v, layer[j]);
+            }
+        }
+    }
+
+    /// Слой обратного преобразования (Кули — Тьюки) на отрезке [first, last)
+    static void InverseLayer(std::uint32_t* a, std::size_t first, std::size_t last, std::size_t half,
+        const Twiddle* layer)
+    {
+        for (std::size_t start = first; start < last; start += 2 * half)
+        {
+            for (std::size_t j = 0; j < half; ++j)
+            {
+                const std::uint32_t u = a[start + j];
+                const std::uint32_t v = Mul(a[start + j + half], layer[j]);
+                const std::uint32_t sum = u + v;
+                a[start + j] = sum >= MOD ? sum - MOD : sum;
+                a[start + j + half] = u >= v ? u - v : u + MOD - v;
+            }
+        }
+    }
+
+    /// Прямое даёт спектр в бит-реверсном порядке, обратное его же и принимает —
+    /// перестановка не нужна. Мелкие слои идут блоками, помещающимися в кеш
+    static void Transform(std::vector<std::uint32_t>& values, bool inverse)
+    {
+        constexpr std::size_t BLOCK = 4096;
+        const std::size_t n = values.size();
+        const std::size_t block = std::min(n, BLOCK);
+        const std::vector<Twiddle> roots = Roots(n, inverse);
+        std::uint32_t* a = values.data();
+
+        if (!inverse)
+        {
+            for (std::size_t half = n / 2; half >= block; half >>= 1)
+            {
+                ForwardLayer(a, 0, n, half, roots.data() + half);
+            }
+            for (std::size_t first = 0; first < n; first += block)
+            {
+                for (std::size_t half = block / 2; half >= 1; half >>= 1)
+                {
+                    ForwardLayer(a, first, first + block, half, roots.data() + half);
+                }
+            }
+            return;
+        }
+
+        for (std::size_t first = 0; first < n; first += block)
+        {
+            for (std::size_t half = 1; half < block; half <<= 1)
+            {
+                InverseLayer(a, first, first + block, half, roots.data() + half);
+            }
+        }
+        for (std::size_t half = block; half < n; half <<= 1)
+        {
+            InverseLayer(a, 0, n, half, roots.data() + half);
+        }
+
+        const Twiddle scale = MakeTwiddle(Pow(static_cast<std::uint32_t>(n), MOD - 2));
+        for (std::uint32_t& value : values)
+        {
+            value = Mul(value, scale);
+        }
+    }
+
+    /// Циклическая свёртка 16-битных цифр по модулю MOD
+    static std::vector<std::uint32_t> Convolve(const Limb* a, std::size_t na, const Limb* b, std::size_t nb,
+        std::size_t size)
+    {
+        const auto split = [size](const Limb* v, std::size_t n)
+        {
+            std::vector<std::uint32_t> digits(size, 0);
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                digits[2 * i] = v[i] & 0xFFFFu;
+                digits[2 * i + 1] = v[i] >> 16;
+            }
+            return digits;
+        };
+
+        std::vector<std::uint32_t> fa = split(a, na);
+        Transform(fa, false);
+        if (a == b && na == nb)
+        {
+            for (std::uint32_t& value : fa)
+            {
+                value = Mul(value, value);
+            }
+        }
+        else
+        {
+            std::vector<std::uint32_t> fb = split(b, nb);
+            Transform(fb, false);
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                fa[i] = Mul(fa[i], fb[i]);
+            }
+        }
+        Transform(fa, true);
+        return fa;
+    }
+};
+
+using NttPrime1 = NttField<998244353, 3>;    // 119·2^23 + 1
+using NttPrime2 = NttField<469762049, 3>;    // 7·2^26 + 1
+constexpr std::size_t NTT_MAX_SIZE = std::size_t(1) << 23;
+
+/// Две свёртки и китайская теорема об остатках: коэффициенты < 2^55 < p1·p2
+Limbs MulNtt(const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    std::size_t size = 1;
+    while (size < 2 * (na + nb))
+    {
+        size <<= 1;
+    }
+
+    const std::vector<std::uint32_t> r1 = NttPrime1::Convolve(a, na, b, nb, size);
+    const std::vector<std::uint32_t> r2 = NttPrime2::Convolve(a, na, b, nb, size);
+
+    constexpr std::uint64_t P1 = 998244353;
+    constexpr std::uint64_t P2 = 469762049;
+    const std::uint32_t p1Inverse = NttPrime2::Pow(static_cast<std::uint32_t>(P1 % P2), P2 - 2);
+
+    Limbs product(na + nb, 0);
+    std::uint64_t carry = 0;
+    for (std::size_t i = 0; i < 2 * (na + nb); ++i)
+    {
+        const std::uint32_t difference = static_cast<std::uint32_t>((r2[i] + P2 - r1[i] % P2) % P2);
+        const std::uint64_t coefficient = r1[i] + P1 * NttPrime2::Mul(difference, p1Inverse);
+        carry += coefficient;
+        product[i / 2] |= static_cast<Limb>(carry & 0xFFFFu) << (16 * (i & 1));
+        carry >>= 16;
+    }
+    Trim(product);
+    return product;
+}
+
+Limbs Mul(const Limb* a, std::size_t na, const Limb* b, std::size_t nb)
+{
+    na = Significant(a, na);
+    nb = Significant(b, nb);
+    if (na < nb)
+    {
+        std::swap(a, b);
+        std::swap(na, nb);
+    }
+    if (nb == 0)
+    {
+        return Limbs();
+    }
+
+    if (nb < BigInteger::KARATSUBA_THRESHOLD)
+    {
+        return MulSchoolbook(a, na, b, nb);
+    }
+
+    // Отменённая задача сворачивает рекурсию; мусор наружу не выходит —
+    // публичные операции проверяют отмену ещё раз и возвращают Cancelled
+    if (IsJobCancelled())
+    {
+        return Limbs();
+    }
+
+    if (nb >= BigInteger::NTT_THRESHOLD && 2 * (na + nb) <= NTT_MAX_SIZE)
+    {
+        return MulNtt(a, na, b, nb);
+    }
+
+    // Несбалансированные операнды — полосами по nb лимбов
+    if (na >= 2 * nb)
+    {
+        Limbs product(na + nb + 1, 0);
+        for (std::size_t offset = 0; offset < na; offset += nb)
+        {
+            AddShifted(product, Mul(a + offset, std::min(nb, na - offset), b, nb), offset);
+        }
+        Trim(product);
+        return product;
+    }
+
+    if (nb < BigInteger::TOOM3_THRESHOLD || nb <= 2 * ((na + 2) / 3))
+    {
+        return MulKaratsuba(a, na, b, nb);
+    }
+    return MulToom3(a, na, b, nb);
+}
+
+Limbs Mul(const Limbs& a, const Limbs& b)
+{
+    return Mul(a.data(), a.size(), b.data(), b.size());
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// ➗ Деление
+//──────────────────────────────────────────────────────────────────────────────
+
+/// Алгоритм D Кнута (v.size() ≥ 2)
+void DivKnuth(const Limbs& u, const Limbs& v, Limbs& q, Limbs& r)
+{
+    const std::size_t n = v.size();
+    const std::size_t m = u.size() - n;
+    const unsigned shift = LeadingZeros(v.back());
+
+    Limbs vn = v;
+    Limbs un = u;
+    ShiftLeftBits(vn, shift);
+    ShiftLeftBits(un, shift);
+    un.resize(u.size() + 1, 0);
+
+    constexpr std::uint64_t BASE = std::uint64_t(1) << LIMB_BITS;
+    q.assign(m + 1, 0);
+
+    for (std::size_t j = m + 1; j-- > 0;)
+    {
+        const std::uint64_t numerator = (static_cast<std::uint64_t>(un[j + n]) << LIMB_BITS) | un[j + n - 1];
+        std::uint64_t qhat = numerator / vn[n - 1];
+        std::uint64_t rhat = numerator % vn[n - 1];
+
+        while (qhat >= BASE || qhat * vn[n - 2] > ((rhat << LIMB_BITS) | un[j + n - 2]))
+        {
+            --qhat;
+            rhat += vn[n - 1];
+            if (rhat >= BASE)
+            {
+                break;
+            }
+        }
+
+        // un[j, j + n] −= qhat × vn
+        std::int64_t borrow = 0;
+        std::uint64_t carry = 0;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+            const std::uint64_t product = qhat * vn[i] + carry;
+            carry = product >> LIMB_BITS;
+            const std::int64_t t = static_cast<std::int64_t>(un[i + j]) - borrow
+                - static_cast<std::int64_t>(product & 0xFFFFFFFFu);
+            un[i + j] = static_cast<Limb>(t);
+            borrow = t < 0;
+        }
+        const std::int64_t top = static_cast<std::int64_t>(un[j + n]) - borrow - static_cast<std::int64_t>(carry);
+        un[j + n] = static_cast<Limb>(top);
+
+        if (top < 0)
+        {
+            // qhat на единицу больше — возвращаем делитель
+            --qhat;
+            std::uint64_t addCarry = 0;
+            for (std::size_t i = 0; i < n; ++i)
+            {
+                addCarry += static_cast<std::uint64_t>(un[i + j]) + vn[i];
+                un[i + j] = static_cast<Limb>(addCarry);
+                addCarry >>= LIMB_BITS;
+            }
+            un[j + n] = static_cast<Limb>(un[j + n] + addCarry);
+        }
+        q[j] = static_cast<Limb>(qhat);
+    }
+
+    Trim(q);
+    un.resize(n);
+    ShiftRightBits(un, shift);
+    Trim(un);
+    r.swap(un);
+}
+
+void DivMod(const Limbs& u, const Limbs& v, Limbs& q, Limbs& r);
+
+/// R ≈ B^(2n) / v: обратная величина старшей половины и один шаг Ньютона
+void ReciprocalEstimate(const Limb* v, std::size_t n, Limbs& result)
+{
+    if (n <= BigInteger::KARATSUBA_THRESHOLD)
+    {
+        Limbs power(2 * n + 1, 0);
+        power[2 * n] = 1;
+        Limbs remainder;
+        DivMod(power, Limbs(v, v + n), result, remainder);
+        return;
+    }
+
+    const std::size_t half = n / 2 + 1;
+    Limbs estimate;
+    ReciprocalEstimate(v + (n - half), half, estimate);
+
+    result.assign(n - half, 0);
+    result.insert(result.end(), estimate.begin(), estimate.end());
+
+    Limbs power(2 * n + 1, 0);
+    power[2 * n] = 1;
+    const Limbs product = Mul(v, n, result.data(), result.size());
+
+    const bool below = Compare(product, power) <= 0;
+    Limbs error = below ? power : product;
+    const Limbs& subtrahend = below ? product : power;
+    SubInPlace(error.data(), error.size(), subtrahend.data(), subtrahend.size());
+    Trim(error);
+
+    Limbs delta = Mul(result, error);
+    if (delta.size() <= 2 * n)
+    {
+        return;
+    }
+    delta.erase(delta.begin(), delta.begin() + static_cast<std::ptrdiff_t>(2 * n));
+
+    if (below)
+    {
+        result = AddMag(result.data(), result.size(), delta.data(), delta.size());
+    }
+    else if (Compare(delta, result) < 0)
+    {
+        SubInPlace(result.data(), result.size(), delta.data(), delta.size());
+        Trim(result);
+    }
+}
+
+/// Частное через обратную величину: q ≈ u·R / B^shift, затем поправка по остатку
+void DivByReciprocal(const Limbs& u, const Limbs& v, const Limbs& reciprocal, std::size_t shift,
+    Limbs& q, Limbs& r)
+{
+    q = Mul(u, reciprocal);
+    if (q.size() > shift)
+    {
+        q.erase(q.begin(), q.begin() + static_cast<std::ptrdiff_t>(shift));
+    }
+    else
+    {
+        q.clear();
+    }
+
+    // Оценка отличается от частного на единицы — правим по остатку
+    Limbs product = Mul(q, v);
+    if (IsJobCancelled())
+    {
+        return;
+    }
+
+    const Limb one = 1;
+    while (Compare(product, u) > 0)
+    {
+        SubInPlace(product.data(), product.size(), v.data(), v.size());
+        Trim(product);
+        SubInPlace(q.data(), q.size(), &one, 1);
+        Trim(q);
+    }
+
+    r = u;
+    SubInPlace(r.data(), r.size(), product.data(), product.size());
+    Trim(r);
+    while (Compare(r, v) >= 0)
+    {
+        SubInPlace(r.data(), r.size(), v.data(), v.size());
+        Trim(r);
+        AddSmall(q, 1);
+    }
+}
+
+void DivNewton(const Limbs& u, const Limbs& v, Limbs& q, Limbs& r)
+{
+    // Длинное делимое уравниваем нулевыми лимбами делителя
+    const std::size_t pad = u.size() > 2 * v.size() ? u.size() - 2 * v.size() : 0;
+    Limbs divisor(pad, 0);
+    divisor.insert(divisor.end(), v.begin(), v.end());
+    const std::size_t n = divisor.size();
+
+    Limbs reciprocal;
+    ReciprocalEstimate(divisor.data(), n, reciprocal);
+    DivByReciprocal(u, v, reciprocal, 2 * n - pad, q, r);
+}
+
+void DivMod(const Limbs& u, const Limbs& v, Limbs& q, Limbs& r)
+{
+    if (Compare(u, v) < 0)
+    {
+        q.clear();
+        r = u;
+        return;
+    }
+
+    if (v.size() == 1)
+    {
+        q = u;
+        const Limb remainder = DivSmall(q, v[0]);
+        r.clear();
+        if (remainder != 0)
+        {
+            r.push_back(remainder);
+        }
+        return;
+    }
+
+    // Ньютон окупается, только когда и частное длинное
+    if (v.size() >= BigInteger::NEWTON_THRESHOLD && u.size() - v.size() >= BigInteger::NEWTON_THRESHOLD)
+    {
+        DivNewton(u, v, q, r);
+    }
+    else
+    {
+        DivKnuth(u, v, q, r);
+    }
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🔄 Перевод между основаниями
+//──────────────────────────────────────────────────────────────────────────────
+
+/// 💾 Степени 10^(9·2^k) — общие для всех чисел одного потока
+const Limbs& DecimalPower(std::size_t k)
+{
+    thread_local std::vector<Limbs> powers;
+    if (powers.empty())
+    {
+        powers.push_back(Limbs{ DECIMAL_CHUNK });
+    }
+    while (powers.size() <= k)
+    {
+        powers.push_back(Mul(powers.back(), powers.back()));
+    }
+    return powers[k];
+}
+
+/// 💾 Обратные величины B^(2n) / 10^(9·2^k) — деление на степень без пересчёта
+const Limbs& DecimalReciprocal(std::size_t k)
+{
+    thread_local std::vector<Limbs> reciprocals;
+    if (reciprocals.size() <= k)
+    {
+        reciprocals.resize(k + 1);
+    }
+    if (reciprocals[k].empty())
+    {
+        const Limbs& power = DecimalPower(k);
+        ReciprocalEstimate(power.data(), power.size(), reciprocals[k]);
+    }
+    return reciprocals[k];
+}
+
+/// value < 10^(9·2^(k+1)) делится на 10^(9·2^k)
+void DivideByDecimalPower(const Limbs& value, std::size_t k, Limbs& q, Limbs& r)
+{
+    const Limbs& power = DecimalPower(k);
+    if (power.size() < BigInteger::NEWTON_THRESHOLD || Compare(value, power) < 0)
+    {
+        DivMod(value, power, q, r);
+        return;
+    }
+    DivByReciprocal(value, power, DecimalReciprocal(k), 2 * power.size(), q, r);
+}
+
+std::size_t DecimalPowerDigits(std::size_t k)
+{
+    return DECIMAL_CHUNK_DIGITS << k;
+}
+
+bool EmitZeros(std::size_t count, const BigInteger::DigitSink& sink)
+{
+    static constexpr char ZEROS[] = "0000000000000000000000000000000000000000000000000000000000000000";
+    static constexpr std::size_t BLOCK = sizeof(ZEROS) - 1;
+    for (; count > 0; count -= std::min(count, BLOCK))
+    {
+        if (!sink(std::string_view(ZEROS, std::min(count, BLOCK))))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/// Короткое число — делением на 10^9; width > 0 — дополнить нулями слева
+bool EmitBasecase(Limbs value, std::size_t width, const BigInteger::DigitSink& sink)
+{
+    char buffer[CONVERSION_BASECASE * 10 + 16];
+    std::size_t position = sizeof(buffer);
+
+    while (!value.empty())
+    {
+        Limb chunk = DivSmall(value, DECIMAL_CHUNK);
+        for (unsigned digit = 0; digit < DECIMAL_CHUNK_DIGITS; ++digit)
+        {
+            buffer[--position] = static_cast<char>('0' + chunk % 10);
+            chunk /= 10;
+            if (value.empty() && chunk == 0)
+            {
+                break;
+            }
+        }
+    }
+
+    const std::size_t length = sizeof(buffer) - position;
+    if (width == 0 && length == 0)
+    {
+        return sink("0");
+    }
+    if (width > length && !EmitZeros(width - length, sink))
+    {
+        return false;
+    }
+    return length == 0 || sink(std::string_view(buffer + position, length));
+}
+
+/// value < 10^(9·2^(k+1)): старшая половина, затем младшая ровно на 9·2^k цифр
+bool EmitDecimal(const Limbs& value, std::size_t k, std::size_t width, const BigInteger::DigitSink& sink)
+{
+    if (value.size() <= CONVERSION_BASECASE)
+    {
+        return EmitBasecase(value, width, sink);
+    }
+    if (IsJobCancelled())
+    {
+        return false;
+    }
+
+    const Limbs& power = DecimalPower(k);
+    if (width == 0 && Compare(value, power) < 0)
+    {
+        return EmitDecimal(value, k - 1, 0, sink);
+    }
+
+    Limbs high;
+    Limbs low;
+    DivideByDecimalPower(value, k, high, low);
+
+    const std::size_t lowDigits = DecimalPowerDigits(k);
+    return EmitDecimal(high, k - 1, width == 0 ? 0 : width - lowDigits, sink)
+        && EmitDecimal(low, k - 1, lowDigits, sink);
+}
+
+/// Разбор цифр: старшая часть × 10^(9·2^k) + младшие 9·2^k цифр
+Limbs ParseDigits(std::string_view digits)
+{
+    if (digits.size() <= CONVERSION_BASECASE * DECIMAL_CHUNK_DIGITS)
+    {
+        Limbs value;
+        std::size_t head = digits.size() % DECIMAL_CHUNK_DIGITS;
+        if (head == 0)
+        {
+            head = DECIMAL_CHUNK_DIGITS;
+        }
+
+        for (std::size_t i = 0; i < digits.size();)
+        {
+            const std::size_t end = i == 0 ? head : i + DECIMAL_CHUNK_DIGITS;
+            Limb chunk = 0;
+            for (; i < end; ++i)
+            {
+                chunk = chunk * 10 + static_cast<Limb>(digits[i] - '0');
+            }
+            MulSmall(value, DECIMAL_CHUNK);
+            AddSmall(value, chunk);
+        }
+        Trim(value);
+        return value;
+    }
+
+    std::size_t k = 0;
+    while (DecimalPowerDigits(k + 1) < digits.size())
+    {
+        ++k;
+    }
+
+    const std::size_t split = digits.size() - DecimalPowerDigits(k);
+    Limbs value = Mul(ParseDigits(digits.substr(0, split)), DecimalPower(k));
+    const Limbs low = ParseDigits(digits.substr(split));
+    AddShifted(value, low, 0);
+    Trim(value);
+    return value;
+}
+
+/// 📊 Прогресс дерева произведений: слои стоят примерно одинаково,
+///    узел добавляет долю своего диапазона в слое
+struct TreeProgress
+{
+    double done = 0.0;
+    double scale = 0.0;   // 1 / (множителей × слоёв)
+
+    void Complete(std::uint64_t lo, std::uint64_t hi)
+    {
+        done += static_cast<double>(hi - lo + 1) * scale;
+        ReportJobProgress(std::min(done, 1.0));
+    }
+};
+
+/// Произведение lo·(lo+1)·…·hi деревом — множители одного размера
+Limbs RangeProduct(std::uint64_t lo, std::uint64_t hi, TreeProgress& progress)
+{
+    if (hi - lo < 16)
+    {
+        Limbs product{ 1 };
+        for (std::uint64_t i = lo; i <= hi; ++i)
+        {
+            MulSmall(product, static_cast<Limb>(i));
+        }
+        progress.Complete(lo, hi);
+        return product;
+    }
+
+    const std::uint64_t mid = lo + (hi - lo) / 2;
+    const Limbs low = RangeProduct(lo, mid, progress);
+    const Limbs high = RangeProduct(mid + 1, hi, progress);
+    Limbs product = Mul(low, high);
+    progress.Complete(lo, hi);
+    return product;
+}
+
+} // namespace
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🔄 Преобразования
+//──────────────────────────────────────────────────────────────────────────────
+
+bool BigInteger::Parse(std::string_view text)
+{
+    bool negative = false;
+    if (!text.empty() && (text.front() == '-' || text.front() == '+'))
+    {
+        negative = text.front() == '-';
+        text.remove_prefix(1);
+    }
+
+    if (text.empty())
+    {
+        return false;
+    }
+    for (const char c : text)
+    {
+        if (c < '0' || c > '9')
+        {
+            return false;
+        }
+    }
+
+    while (text.size() > 1 && text.front() == '0')
+    {
+        text.remove_prefix(1);
+    }
+
+    m_limbs = ParseDigits(text);
+    m_negative = negative && !m_limbs.empty();
+    return true;
+}
+
+void BigInteger::SetInteger(std::int64_t value)
+{
+    m_negative = value < 0;
+    std::uint64_t magnitude = value < 0 ? 0 - static_cast<std::uint64_t>(value) : static_cast<std::uint64_t>(value);
+
+    m_limbs.clear();
+    while (magnitude != 0)
+    {
+        m_limbs.push_back(static_cast<Limb>(magnitude));
+        magnitude >>= LIMB_BITS;
+    }
+}
+
+double BigInteger::ToDouble() const
+{
+    // Три старших лимба покрывают 53 бита мантиссы
+    double value = 0.0;
+    const std::size_t used = std::min<std::size_t>(m_limbs.size(), 3);
+    for (std::size_t i = 0; i < used; ++i)
+    {
+        value = value * 4294967296.0 + m_limbs[m_limbs.size() - 1 - i];
+    }
+
+    const std::size_t dropped = m_limbs.size() - used;
+    value = dropped * LIMB_BITS > 2048 ? HUGE_VAL : std::ldexp(value, static_cast<int>(dropped * LIMB_BITS));
+    return m_negative ? -value : value;
+}
+
+bool BigInteger::ToUint64(std::uint64_t& value) const
+{
+    if (m_negative || m_limbs.size() > 2)
+    {
+        return false;
+    }
+
+    value = 0;
+    for (std::size_t i = m_limbs.size(); i-- > 0;)
+    {
+        value = (value << LIMB_BITS) | m_limbs[i];
+    }
+    return true;
+}
+
+bool BigInteger::WriteDecimal(const DigitSink& sink) const
+{
+    if (m_negative && !sink("-"))
+    {
+        return false;
+    }
+
+    // Прогресс — по выведенным цифрам от оценки их числа по длине в битах
+    const double expectedDigits = static_cast<double>(GetBitLength()) * 0.30103 + 1.0;
+    std::size_t written = 0;
+    const DigitSink counted = [&](std::string_view digits)
+    {
+        written += digits.size();
+        ReportJobProgress(std::min(static_cast<double>(written) / expectedDigits, 1.0));
+        return sink(digits);
+    };
+
+    // Наименьшее k, при котором 10^(9·2^(k+1)) заведомо больше числа
+    std::size_t k = 0;
+    while (m_limbs.size() > CONVERSION_BASECASE && DecimalPower(k).size() < m_limbs.size() / 2 + 1)
+    {
+        ++k;
+    }
+    return EmitDecimal(m_limbs, k, 0, counted) && !IsJobCancelled();
+}
+
+std::string BigInteger::ToString() const
+{
+    std::string text;
+    WriteDecimal([&text](std::string_view digits)
+    {
+        text.append(digits.data(), digits.size());
+        return true;
+    });
+    return text;
+}
+
+void BigInteger::Write(SessionWriter& writer) const
+{
+    writer.Write(m_negative);
+    writer.WriteString(std::string_view(reinterpret_cast<const char*>(m_limbs.data()),
+        m_limbs.size() * sizeof(Limb)));
+}
+
+bool BigInteger::Read(SessionReader& reader)
+{
+    bool negative = false;
+    std::string bytes;
+    if (!reader.Read(negative) || !reader.ReadString(bytes) || bytes.size() % sizeof(Limb) != 0
+        || bytes.size() * 8 > MAX_BITS)
+    {
+        return false;
+    }
+
+    Limbs limbs(bytes.size() / sizeof(Limb));
+    std::memcpy(limbs.data(), bytes.data(), bytes.size());
+
+    // Старший лимб ненулевой, у нуля нет знака — как после любой операции
+    if (!limbs.empty() && limbs.back() == 0)
+    {
+        return false;
+    }
+    m_limbs.swap(limbs);
+    m_negative = negative && !m_limbs.empty();
+    return true;
+}
+
+std::string BigInteger::LeadingDigits(std::size_t count) const
+{
+    const std::size_t digits = GetDecimalDigitCount();
+    if (digits <= count)
+    {
+        return ToString();
+    }
+
+    // Частное от деления на 10^(digits − count) короткое — алгоритм D линеен
+    BigInteger ten;
+    ten.SetInteger(10);
+    BigInteger exponent;
+    exponent.SetInteger(static_cast<std::int64_t>(digits - count));
+    BigInteger scale;
+    Power(ten, exponent, scale);
+
+    BigInteger head;
+    Divide(*this, scale, head);
+    return head.ToString();
+}
+
+std::size_t BigInteger::GetDecimalDigitCount() const
+{
+    const std::uint64_t bits = GetBitLength();
+    if (bits == 0)
+    {
+        return 1;
+    }
+
+    // 2^(bits−1) ≤ |x| < 2^bits: кандидатов не больше двух
+    static constexpr double LOG10_2 = 0.30102999566398119521;
+    const std::size_t low = static_cast<std::size_t>(std::floor(static_cast<double>(bits - 1) * LOG10_2)) + 1;
+    const std::size_t high = static_cast<std::size_t>(std::floor(static_cast<double>(bits) * LOG10_2)) + 1;
+    if (low == high)
+    {
+        return low;
+    }
+
+    BigInteger ten;
+    ten.SetInteger(10);
+    BigInteger exponent;
+    exponent.SetInteger(static_cast<std::int64_t>(low));
+    BigInteger threshold;
+    Power(ten, exponent, threshold);
+    return Compare(m_limbs, threshold.m_limbs) >= 0 ? high : low;
+}
+
+std::uint64_t BigInteger::GetBitLength() const
+{
+    if (m_limbs.empty())
+    {
+        return 0;
+    }
+    return static_cast<std::uint64_t>(m_limbs.size()) * LIMB_BITS - LeadingZeros(m_limbs.back());
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// ⚡ Арифметика
+//──────────────────────────────────────────────────────────────────────────────
+
+CalcError BigInteger::Add(const BigInteger& a, const BigInteger& b, BigInteger& out)
+{
+    const Signed sum = SignedAdd(Signed{ a.m_limbs, a.m_negative }, Signed{ b.m_limbs, b.m_negative });
+    out.m_limbs = sum.magnitude;
+    out.m_negative = sum.negative;
+    return CalcError::None;
+}
+
+CalcError BigInteger::Subtract(const BigInteger& a, const BigInteger& b, BigInteger& out)
+{
+    const Signed difference = SignedAdd(Signed{ a.m_limbs, a.m_negative }, Signed{ b.m_limbs, b.m_negative }, true);
+    out.m_limbs = difference.magnitude;
+    out.m_negative = difference.negative;
+    return CalcError::None;
+}
+
+CalcError BigInteger::Multiply(const BigInteger& a, const BigInteger& b, BigInteger& out)
+{
+    if (a.GetBitLength() + b.GetBitLength() > MAX_BITS)
+    {
+        return CalcError::Overflow;
+    }
+
+    const bool negative = a.m_negative != b.m_negative;
+    Limbs product = Mul(a.m_limbs, b.m_limbs);
+    if (IsJobCancelled())
+    {
+        return CalcError::Cancelled;
+    }
+
+    out.m_limbs.swap(product);
+    out.m_negative = negative && !out.m_limbs.empty();
+    return CalcError::None;
+}
+
+CalcError BigInteger::Divide(const BigInteger& a, const BigInteger& b, BigInteger& out)
+{
+    if (b.IsZero())
+    {
+        return CalcError::DivisionByZero;
+    }
+
+    const bool negative = a.m_negative != b.m_negative;
+    Limbs quotient;
+    Limbs remainder;
+    DivMod(a.m_limbs, b.m_limbs, quotient, remainder);
+    if (IsJobCancelled())
+    {
+        return CalcError::Cancelled;
+    }
+
+    out.m_limbs.swap(quotient);
+    out.m_negative = negative && !out.m_limbs.empty();
+    return CalcError::None;
+}
+
+CalcError BigInteger::Power(const BigInteger& a, const BigInteger& b, BigInteger& out)
+{
+    if (b.m_negative)
+    {
+        // Целое деление: 1 / a^n отлично от нуля только при |a| = 1
+        if (a.IsZero())
+        {
+            return CalcError::DivisionByZero;
+        }
+        const bool unit = a.m_limbs.size() == 1 && a.m_limbs[0] == 1;
+        const bool odd = (b.m_limbs[0] & 1) != 0;
+        out.SetInteger(unit ? (a.m_negative && odd ? -1 : 1) : 0);
+        return CalcError::None;
+    }
+
+    std::uint64_t n = 0;
+    if (!b.ToUint64(n))
+    {
+        n = UINT64_MAX;
+    }
+
+    const std::uint64_t bits = a.GetBitLength();
+    if (n == 0 || bits <= 1)
+    {
+        // 0^0 = 1, как у pow; 0^n = 0; (±1)^n = ±1
+        const std::int64_t base = a.IsZero() ? 0 : (a.m_negative ? -1 : 1);
+        out.SetInteger(n == 0 ? 1 : (base == -1 && (n & 1) == 0 ? 1 : base));
+        return CalcError::None;
+    }
+
+    if (bits > 1 && n > MAX_BITS / (bits - 1))
+    {
+        return CalcError::Overflow;
+    }
+
+    const bool negative = a.m_negative && (n & 1) != 0;
+
+    // Степень двойки — просто сдвиг
+    const std::size_t lowZeros = static_cast<std::size_t>(std::find_if(a.m_limbs.begin(), a.m_limbs.end(),
+        [](Limb limb) { return limb != 0; }) - a.m_limbs.begin());
+    const Limb top = a.m_limbs.back();
+    if (lowZeros == a.m_limbs.size() - 1 && (top & (top - 1)) == 0)
+    {
+        const std::uint64_t shift = (bits - 1) * n;
+        out.m_limbs.assign(static_cast<std::size_t>(shift / LIMB_BITS), 0);
+        out.m_limbs.push_back(Limb(1) << (shift % LIMB_BITS));
+        out.m_negative = negative;
+        return CalcError::None;
+    }
+
+    // 2^((bits−1)·n) ≤ |a|^n < 2^(bits·n): оценка сверху, чтобы не считать впустую
+    if (n > MAX_BITS / bits)
+    {
+        return CalcError::Overflow;
+    }
+
+    // Слева направо: возведение в квадрат и домножение на основание
+    const double expectedLimbs = static_cast<double>(bits) * static_cast<double>(n) / LIMB_BITS;
+    Limbs result = a.m_limbs;
+    std::uint64_t mask = std::uint64_t(1) << 63;
+    while ((mask & n) == 0)
+    {
+        mask >>= 1;
+    }
+    for (mask >>= 1; mask != 0; mask >>= 1)
+    {
+        result = Mul(result, result);
+        if (n & mask)
+        {
+            result = Mul(result, a.m_limbs);
+        }
+
+        if (IsJobCancelled())
+        {
+            return CalcError::Cancelled;
+        }
+        ReportJobProgress(std::min(static_cast<double>(result.size()) / expectedLimbs, 1.0));
+    }
+
+    out.m_limbs.swap(result);
+    out.m_negative = negative;
+    return CalcError::None;
+}
+
+CalcError BigInteger::Factorial(const BigInteger& n, BigInteger& out)
+{
+    std::uint64_t value = 0;
+    if (n.m_negative)
+    {
+        return CalcError::InvalidNumber;
+    }
+    if (!n.ToUint64(value) || value > MAX_FACTORIAL)
+    {
+        return CalcError::Overflow;
+    }
+
+    if (value < 2)
+    {
+        out.SetInteger(1);
+        return CalcError::None;
+    }
+
+    TreeProgress progress;
+    double levels = 1.0;
+    for (std::uint64_t span = value; span > 16; span /= 2)
+    {
+        levels += 1.0;
+    }
+    progress.scale = 1.0 / (static_cast<double>(value - 1) * levels);
+
+    Limbs product = RangeProduct(2, value, progress);
+    if (IsJobCancelled())
+    {
+        return CalcError::Cancelled;
+    }
+
+    out.m_limbs.swap(product);
+    out.m_negative = false;
+    return CalcError::None;
+}
+
+CalcError BigInteger::Apply(Operator op, const BigInteger& a, const BigInteger& b, BigInteger& out)
+{
+    switch (op)
+    {
+    case Operator::Add:      return Add(a, b, out);
+    case Operator::Subtract: return Subtract(a, b, out);
+    case Operator::Multiply: return Multiply(a, b, out);
+    case Operator::Divide:   return Divide(a, b, out);
+    case Operator::Power:    return Power(a, b, out);
+    default:                 break;     // ❗ Постфиксные и функции — не бинарные
+    }
+
+    out = b;
+    return CalcError::None;
+}
+
+} // namespace calc
@@ -0,0 +1,853 @@
+#include "engine/calculator.h"
+
+#include "engine/instrumentation.h"
+#include "engine/job_service.h"
+#include "engine/operators.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <system_error>
+#include <utility>
+
+namespace calc
+{
+
+void Calculator::SetOperand(double value)
+{
+    m_operand = value;
+
+    if (m_mode != NumberMode::Binary)
+    {
+        char buffer[32];
+        const std::size_t length = FormatNumber(value, buffer, sizeof(buffer), NumberFormat::Full);
+        m_operandText.assign(buffer, length);
+    }
+}
+
+bool Calculator::SetOperand(std::string_view text)
+{
+    double value = 0.0;
+    const char* end = text.data() + text.size();
+    const auto [parsed, error] = std::from_chars(text.data(), end, value);
+    if (m_mode == NumberMode::Decimal)
+    {
+        // Десятичный операнд может не помещаться в double — проверяем BigDecimal
+        BigDecimal exact;
+        if (!exact.Parse(text, m_decimal.GetPrecision()))
+        {
+            return false;
+        }
+
+        m_operand = exact.ToDouble();
+        m_operandText.assign(text.data(), text.size());
+        return true;
+    }
+
+    if (m_mode == NumberMode::Integer)
+    {
+        BigInteger exact;
+        if (!exact.Parse(text))
+        {
+            return false;
+        }
+
+        m_operand = exact.ToDouble();
+        m_operandText.assign(text.data(), text.size());
+        return true;
+    }
+
+    if (text.empty() || error != std::errc() || parsed != end)
+    {
+        return false;
+    }
+
+    m_operand = value;
+    return true;
+}
+
+void Calculator::SetNumberMode(NumberMode mode)
+{
+    m_mode = mode;
+    Clear();
+    MemoryClear();
+}
+
+void Calculator::PushOperator(Operator op)
+{
+    Token operand;
+    operand.type = TokenType::Number;
+    operand.number = m_operand;
+    AppendToken(operand);
+
+    Token symbol;
+    symbol.type = TokenType::Operator;
+    symbol.op = op;
+    AppendToken(symbol);
+}
+
+void Calculator::SetPendingOperator(Operator op)
+{
+    if (m_tokens.empty() || m_tokens.back().type != TokenType::Operator)
+    {
+        PushOperator(op);
+        return;
+    }
+
+    m_tokens.pop_back();
+    m_expressionText.resize(m_expressionText.rfind(' '));
+
+    Token symbol;
+    symbol.type = TokenType::Operator;
+    symbol.op = op;
+    AppendToken(symbol);
+}
+
+EvalResult Calculator::ApplyFunction(Operator function)
+{
+    CALC_TRACE_SCOPE("Calculator::ApplyFunction");
+    CALC_TRACE_EVALUATIONS(1);
+
+    const OperatorInfo& info = GetOperatorInfo(function);
+    if (info.form != OperatorForm::Function || m_mode == NumberMode::Integer)
+    {
+        return EvalResult{ m_operand, CalcError::SyntaxError };
+    }
+
+    if (m_mode == NumberMode::Decimal)
+    {
+        // Тот же путь, что и у выражения: √ точна, остальное — через double
+        std::string text(info.symbol);
+        text += '(';
+        text += m_operandText;
+        text += ')';
+        return EvaluateDecimal(text);
+    }
+
+    const EvalResult result = FiniteResult(info.function(m_operand));
+    if (!result.Ok())
+    {
+        return EvalResult{ m_operand, result.error };
+    }
+
+    m_operand = result.value;
+    return EvalResult{ m_operand, CalcError::None };
+}
+
+EvalResult Calculator::Equals()
+{
+    CALC_TRACE_SCOPE("Calculator::Equals");
+
+    if (m_tokens.empty())
+    {
+        return EvalResult{ m_operand, CalcError::None };
+    }
+    CALC_TRACE_EVALUATIONS(1);
+
+    Token operand;
+    operand.type = TokenType::Number;
+    operand.number = m_operand;
+
+    if (m_mode != NumberMode::Binary)
+    {
+        AppendToken(operand);
+        const EvalResult result = m_mode == NumberMode::Decimal
+            ? EvaluateDecimal(m_expressionText)
+            : EvaluateInteger(m_expressionText);
+
+        m_tokens.clear();
+        m_expressionText.clear();
+        if (!result.Ok())
+        {
+            Clear();
+        }
+        return result;
+    }
+
+    m_tokens.push_back(operand);
+    m_tokens.push_back(Token{});
+
+    m_compiledText.clear();
+    m_expression.Compile(m_tokens);
+    const EvalResult result = m_expression.Evaluate();
+
+    m_tokens.clear();
+    m_expressionText.clear();
+
+    if (!result.Ok())
+    {
+        Clear();
+        return result;
+    }
+
+    m_operand = result.value;
+    return result;
+}
+
+void Calculator::Clear()
+{
+    m_operand = 0.0;
+    m_operandText.assign(1, '0');
+    m_resultText.clear();
+    m_integerResult = BigInteger();
+    m_tokens.clear();
+    m_expressionText.clear();
+}
+
+void Calculator::MemoryRecall()
+{
+    m_operand = m_memory;
+
+    if (m_mode == NumberMode::Decimal)
+    {
+        m_resultText.clear();
+        m_decimalMemory.AppendTo(m_resultText);
+        m_operandText = m_resultText;
+    }
+    else if (m_mode == NumberMode::Integer)
+    {
+        // Как и результат, память становится ans: её цифры в текст не переводятся
+        m_integerResult = m_integerMemory;
+        m_integer.SetAnswer(m_integerResult);
+        m_operandText.assign("ans");
+    }
+}
+
+void Calculator::MemoryClear()
+{
+    m_hasMemory = false;
+    m_memory = 0.0;
+    m_decimalMemory = BigDecimal();
+    m_integerMemory = BigInteger();
+}
+
+CalcError Calculator::UpdateMemory(Operator op)
+{
+    if (m_mode == NumberMode::Decimal)
+    {
+        BigDecimal operand;
+        BigDecimal next;
+        const std::uint32_t precision = m_decimal.GetPrecision();
+        if (!operand.Parse(m_operandText, precision))
+        {
+            return CalcError::InvalidNumber;
+        }
+
+        const CalcError error = BigDecimal::Apply(op, m_decimalMemory, operand, next, precision);
+        if (error != CalcError::None)
+        {
+            return error;
+        }
+        m_decimalMemory = std::move(next);
+        m_memory = m_decimalMemory.ToDouble();
+    }
+    else if (m_mode == NumberMode::Integer)
+    {
+        BigInteger parsed;
+        if (m_operandText != "ans" && !parsed.Parse(m_operandText))
+        {
+            return CalcError::InvalidNumber;
+        }
+
+        BigInteger next;
+        const BigInteger& operand = m_operandText == "ans" ? m_integerResult : parsed;
+        const CalcError error = BigInteger::Apply(op, m_integerMemory, operand, next);
+        if (error != CalcError::None)
+        {
+            return error;
+        }
+        m_integerMemory = std::move(next);
+        m_memory = m_integerMemory.ToDouble();
+    }
+    else
+    {
+        const EvalResult result = Apply(op, m_memory, m_operand);
+        if (!result.Ok())
+        {
+            return result.error;
+        }
+        m_memory = result.value;
+    }
+
+    m_hasMemory = true;
+    return CalcError::None;
+}
+
+void Calculator::SaveState(SessionWriter& writer) const
+{
+    writer.Write(m_mode);
+    writer.Write(m_format);
+    writer.Write(m_decimal.GetPrecision());
+    writer.Write(m_operand);
+    writer.WriteString(m_operandText);
+
+    writer.Write(static_cast<std::uint32_t>(m_tokens.size()));
+    for (const Token& token : m_tokens)
+    {
+        writer.Write(token.type);
+        writer.Write(token.op);
+        writer.Write(token.number);
+    }
+    writer.WriteString(m_expressionText);
+    writer.WriteString(m_resultText);
+
+    // ans нужен, только пока на него ссылается операнд или выражение;
+    // огромный не сохраняется: перевод в десятичный текст сам по себе долгий
+    const bool usesAnswer = m_operandText == "ans" || m_expressionText.find("ans") != std::string::npos;
+    const bool keepAnswer = m_mode == NumberMode::Integer && usesAnswer
+        && m_integerResult.GetBitLength() <= MAX_SAVED_ANSWER_BITS;
+    writer.WriteString(keepAnswer ? m_integerResult.ToString() : std::string());
+
+    // Память — в записи своего режима; огромная целая теряется так же, как ans
+    std::string memoryText;
+    if (m_mode == NumberMode::Decimal)
+    {
+        m_decimalMemory.AppendTo(memoryText);
+    }
+    else if (m_mode == NumberMode::Integer && m_integerMemory.GetBitLength() <= MAX_SAVED_ANSWER_BITS)
+    {
+        memoryText = m_integerMemory.ToString();
+    }
+    writer.Write(m_hasMemory && (m_mode == NumberMode::Binary || !memoryText.empty()));
+    writer.Write(m_memory);
+    writer.WriteString(memoryText);
+
+    // Только присвоенные имена: упомянутые без значения заново появятся при компиляции
+    std::uint32_t definedCount = 0;
+    for (std::uint32_t symbol = 0; symbol < m_symbols.GetCount(); ++symbol)
+    {
+        definedCount += m_symbols.IsDefined(symbol) ? 1 : 0;
+    }
+    writer.Write(definedCount);
+    for (std::uint32_t symbol = 0; symbol < m_symbols.GetCount(); ++symbol)
+    {
+        if (m_symbols.IsDefined(symbol))
+        {
+            writer.WriteString(m_symbols.GetName(symbol));
+            writer.Write(m_symbols.GetValue(symbol));
+        }
+    }
+}
+
+bool Calculator::RestoreState(SessionReader& reader)
+{
+    Clear();
+    MemoryClear();
+    m_symbols.Clear();
+
+    NumberMode mode = NumberMode::Binary;
+    NumberFormat format = NumberFormat::Compact;
+    std::uint32_t precision = 0;
+    std::uint32_t tokenCount = 0;
+    std::uint32_t symbolCount = 0;
+    std::string answer;
+    std::string memoryText;
+    std::string name;
+
+    bool ok = reader.Read(mode) && reader.Read(format) && reader.Read(precision)
+        && reader.Read(m_operand) && reader.ReadString(m_operandText)
+        && reader.Read(tokenCount)
+        && mode <= NumberMode::Integer && format <= NumberFormat::Full;
+
+    for (std::uint32_t i = 0; ok && i < tokenCount; ++i)
+    {
+        Token token;
+        ok = reader.Read(token.type) && reader.Read(token.op) && reader.Read(token.number);
+        m_tokens.push_back(token);
+    }
+
+    ok = ok && reader.ReadString(m_expressionText) && reader.ReadString(m_resultText)
+        && reader.ReadString(answer)
+        && reader.Read(m_hasMemory) && reader.Read(m_memory) && reader.ReadString(memoryText)
+        && reader.Read(symbolCount) && symbolCount <= SymbolTable::MAX_SYMBOLS;
+    if (ok && !answer.empty())
+    {
+        ok = m_integerResult.Parse(answer);
+    }
+    if (ok && m_hasMemory && mode == NumberMode::Decimal)
+    {
+        ok = m_decimalMemory.Parse(memoryText, precision);
+    }
+    else if (ok && m_hasMemory && mode == NumberMode::Integer)
+    {
+        ok = m_integerMemory.Parse(memoryText);
+    }
+
+    for (std::uint32_t i = 0; ok && i < symbolCount; ++i)
+    {
+        double value = 0.0;
+        ok = reader.ReadString(name) && reader.Read(value);
+        const std::uint32_t symbol = ok ? m_symbols.Intern(name) : SymbolTable::NO_SYMBOL;
+        ok = symbol != SymbolTable::NO_SYMBOL;
+        if (ok)
+        {
+            m_symbols.SetValue(symbol, value);
+        }
+    }
+
+    if (!ok)
+    {
+        m_mode = NumberMode::Binary;
+        Clear();
+        MemoryClear();
+        m_symbols.Clear();
+        return false;
+    }
+
+    m_mode = mode;
+    m_format = format;
+    m_decimal.SetPrecision(precision);
+    m_compiledText.clear();
+
+    if (!answer.empty())
+    {
+        m_integer.SetAnswer(m_integerResult);
+    }
+    else if (m_mode == NumberMode::Integer)
+    {
+        // ans не сохранился — то, что на него ссылается, не досчитать
+        if (m_expressionText.find("ans") != std::string::npos)
+        {
+            m_tokens.clear();
+            m_expressionText.clear();
+        }
+        if (m_operandText == "ans")
+        {
+            m_operandText.assign(1, '0');
+            m_operand = 0.0;
+        }
+    }
+    return true;
+}
+
+EvalResult Calculator::EvaluateExpression(std::string_view text)
+{
+    if (m_mode == NumberMode::Decimal)
+    {
+        return EvaluateDecimal(text);
+    }
+
+    if (m_mode == NumberMode::Integer)
+    {
+        return EvaluateInteger(text);
+    }
+
+    bool assigned = false;
+    return EvaluateStatement(text, assigned);
+}
+
+EvalResult Calculator::EvaluatePasted(std::string_view text, PasteSummary& summary)
+{
+    CALC_TRACE_SCOPE("Calculator::EvaluatePasted");
+    CALC_TRACE_EVALUATIONS(1);
+
+    summary = PasteSummary{};
+
+    // Колонка видна по первым двум строкам: одним выражением её не разобрать ("2 3"),
+    // и мегабайтный текст не читается дважды. Колонка без единой верной строки
+    // сообщает ошибку всего текста, как одно выражение
+    if (IsColumn(text))
+    {
+        const EvalResult column = EvaluateColumn(text, summary);
+        return column.Ok() || column.error == CalcError::Cancelled ? column : EvaluatePastedExpression(text);
+    }
+
+    // Остальное — сначала как одно выражение: перевод строки для лексера всего лишь пробел
+    const EvalResult result = EvaluatePastedExpression(text);
+    if (result.error != CalcError::SyntaxError || text.find('\n') == std::string_view::npos)
+    {
+        return result;
+    }
+
+    const EvalResult column = EvaluateColumn(text, summary);
+    return column.Ok() || column.error == CalcError::Cancelled ? column : result;
+}
+
+EvalResult Calculator::EvaluatePastedExpression(std::string_view text)
+{
+    if (m_mode == NumberMode::Decimal)
+    {
+        return EvaluateDecimal(text);
+    }
+
+    if (m_mode == NumberMode::Integer)
+    {
+        return EvaluateInteger(text);
+    }
+
+    bool assigned = false;
+    const EvalResult result = EvaluateLine(text, assigned);
+    if (result.Ok())
+    {
+        m_operand = result.value;
+    }
+    return result;
+}
+
+bool Calculator::IsColumn(std::string_view text)
+{
+    const auto isNumberChar = [](char c) { return (c >= '0' && c <= '9') || c == '.'; };
+
+    const std::size_t first = text.find_first_not_of(" \t\r\n");
+    const std::size_t newline = text.find('\n', first == std::string_view::npos ? text.size() : first);
+    if (newline == std::string_view::npos)
+    {
+        return false;
+    }
+
+    const std::size_t next = text.find_first_not_of(" \t\r\n", newline);
+    if (next == std::string_view::npos)
+    {
+        return false;
+    }
+
+    const char last = text[text.find_last_not_of(" \t\r", newline - 1)];
+    return (isNumberChar(last) || last == ')') && isNumberChar(text[next]);
+}
+
+EvalResult Calculator::EvaluateColumn(std::string_view text, PasteSummary& summary)
+{
+    constexpr std::uint64_t PROGRESS_LINES = 1024;  // Строк между проверками отмены
+
+    const std::uint32_t precision = m_decimal.GetPrecision();
+    double sum = 0.0;
+    double compensation = 0.0;      // Неймайер: миллион слагаемых без накопления ошибки
+    BigDecimal decimalSum;
+    BigDecimal decimalLine;
+    BigDecimal decimalNext;
+    BigInteger integerSum;
+    BigInteger integerLine;
+    BigInteger integerNext;
+    double assignedValue = 0.0;     // Последнее присвоенное: итог вставки из одних присваиваний
+
+    std::uint64_t lineNumber = 0;
+    std::size_t position = 0;
+    while (position < text.size())
+    {
+        const std::size_t end = std::min(text.find('\n', position), text.size());
+        std::string_view line = text.substr(position, end - position);
+        position = end + 1;
+
+        if (++lineNumber % PROGRESS_LINES == 0)
+        {
+            if (IsJobCancelled())
+            {
+                return EvalResult{ 0.0, CalcError::Cancelled };
+            }
+            ReportJobProgress(static_cast<double>(position) / static_cast<double>(text.size()));
+        }
+
+        if (line.find_first_not_of(" \t\r") == std::string_view::npos)
+        {
+            continue;
+        }
+
+        CalcError error = CalcError::None;
+        bool assigned = false;
+        if (m_mode == NumberMode::Decimal)
+        {
+            error = m_decimal.Evaluate(line, decimalLine);
+            if (error == CalcError::None)
+            {
+                error = BigDecimal::Add(decimalSum, decimalLine, decimalNext, precision);
+                std::swap(decimalSum, decimalNext);
+            }
+        }
+        else if (m_mode == NumberMode::Integer)
+        {
+            error = m_integer.Evaluate(line, integerLine);
+            if (error == CalcError::None)
+            {
+                error = BigInteger::Add(integerSum, integerLine, integerNext);
+                std::swap(integerSum, integerNext);
+            }
+        }
+        else
+        {
+            const EvalResult value = EvaluateLine(line, assigned);
+            error = value.error;
+            if (assigned)
+            {
+                assignedValue = value.value;
+            }
+            else if (error == CalcError::None)
+            {
+                const double next = sum + value.value;
+                compensation += std::fabs(sum) >= std::fabs(value.value)
+                    ? (sum - next) + value.value
+                    : (value.value - next) + sum;
+                sum = next;
+            }
+        }
+
+        if (error == CalcError::Cancelled)
+        {
+            return EvalResult{ 0.0, CalcError::Cancelled };
+        }
+        if (assigned)
+        {
+            ++summary.assignmentCount;
+            continue;
+        }
+
+        ++summary.lineCount;
+        if (error != CalcError::None && ++summary.errorCount == 1)
+        {
+            summary.firstErrorLine = lineNumber;
+        }
+    }
+
+    if (summary.lineCount == 0 && summary.assignmentCount != 0)
+    {
+        m_operand = assignedValue;
+        return EvalResult{ m_operand, CalcError::None };
+    }
+    if (summary.errorCount == summary.lineCount)
+    {
+        return EvalResult{ 0.0, CalcError::SyntaxError };
+    }
+
+    // Сумма становится операндом так же, как результат EvaluateDecimal/EvaluateInteger
+    if (m_mode == NumberMode::Decimal)
+    {
+        m_resultText.clear();
+        decimalSum.AppendTo(m_resultText);
+        m_operand = decimalSum.ToDouble();
+        m_operandText = m_resultText;
+    }
+    else if (m_mode == NumberMode::Integer)
+    {
+        m_integerResult = std::move(integerSum);
+        m_integer.SetAnswer(m_integerResult);
+        m_operand = m_integerResult.ToDouble();
+        m_operandText.assign("ans");
+    }
+    else
+    {
+        m_operand = sum + compensation;
+    }
+    return EvalResult{ m_operand, CalcError::None };
+}
+
+EvalResult Calculator::EvaluateLine(std::string_view line, bool& assigned)
+{
+    assigned = false;
+
+    // Обычная строка считается при разборе; имена и присваивания — байткодом со слотами таблицы
+    const EvalResult direct = m_direct.Evaluate(line);
+    const bool named = direct.error == CalcError::UnknownVariable
+        || (direct.error == CalcError::SyntaxError && line.find('=') != std::string_view::npos);
+    return named ? EvaluateStatement(line, assigned) : direct;
+}
+
+EvalResult Calculator::EvaluateStatement(std::string_view text, bool& assigned)
+{
+    assigned = false;
+
+    std::string_view name;
+    std::string_view value = text;
+    const bool assignment = Lexer::SplitAssignment(text, name, value);
+
+    // Имена переводятся в слоты только при компиляции; повтор того же текста их не ищет.
+    // Не связанное выражение (имени ещё не было) связывается заново — имя могли присвоить
+    if (!m_expression.IsBound() || value != m_compiledText)
+    {
+        // Текст запоминается только за удачной компиляцией и связыванием:
+        // иначе повтор ошибочного текста выполнил бы прежнюю программу
+        m_compiledText.clear();
+        if (m_expression.Compile(value) != CalcError::None)
+        {
+            return EvalResult{ 0.0, m_expression.GetError() };
+        }
+        const CalcError error = m_expression.Bind(m_symbols);
+        if (error != CalcError::None)
+        {
+            return EvalResult{ 0.0, error };
+        }
+        m_compiledText.assign(value.data(), value.size());
+    }
+
+    const EvalResult result = m_expression.Evaluate(m_symbols);
+    if (!result.Ok() || !assignment)
+    {
+        return result;
+    }
+
+    // Слот заводит только удачное присваивание: чтения и ошибки таблицу не заполняют
+    const std::uint32_t target = m_symbols.Intern(name);
+    if (target == SymbolTable::NO_SYMBOL)
+    {
+        return EvalResult{ 0.0, CalcError::UnknownVariable };
+    }
+    m_symbols.SetValue(target, result.value);
+    assigned = true;
+    return result;
+}
+
+void Calculator::AppendToken(const Token& token)
+{
+    m_tokens.push_back(token);
+
+    if (!m_expressionText.empty())
+    {
+        m_expressionText += ' ';
+    }
+
+    if (token.type == TokenType::Number && m_mode != NumberMode::Binary)
+    {
+        // Отрицательный операнд в скобках: "-2 ^ 2" иначе читается как −(2²)
+        const bool negative = !m_operandText.empty() && m_operandText.front() == '-';
+        if (negative)
+        {
+            m_expressionText += '(';
+        }
+        m_expressionText += m_operandText;
+        if (negative)
+        {
+            m_expressionText += ')';
+        }
+    }
+    else if (token.type == TokenType::Number)
+    {
+        char buffer[32];
+        const std::size_t length = FormatNumber(token.number, buffer, sizeof(buffer), m_format);
+        m_expressionText.append(buffer, length);
+    }
+    else
+    {
+        m_expressionText += OperatorSymbol(token.op);
+    }
+}
+
+EvalResult Calculator::EvaluateDecimal(std::string_view text)
+{
+    const bool cacheable = m_cache
+        && ResultCache::MakeKey(text, NumberMode::Decimal, m_decimal.GetPrecision(), m_cacheKey);
+    if (cacheable && m_cache->Find(m_cacheKey, m_cached))
+    {
+        m_resultText.swap(m_cached.text);
+        m_operand = m_cached.value;
+        m_operandText = m_resultText;
+        return EvalResult{ m_operand, CalcError::None };
+    }
+
+    const CalcError error = m_decimal.Evaluate(text, m_decimalResult);
+    if (error != CalcError::None)
+    {
+        m_resultText.clear();
+        return EvalResult{ 0.0, error };
+    }
+
+    m_resultText.clear();
+    m_decimalResult.AppendTo(m_resultText);
+
+    m_operand = m_decimalResult.ToDouble();
+    m_operandText = m_resultText;
+
+    if (cacheable)
+    {
+        m_cached.value = m_operand;
+        m_cached.text = m_resultText;
+        m_cached.integer = BigInteger();
+        m_cache->Insert(m_cacheKey, std::move(m_cached));
+    }
+    return EvalResult{ m_operand, CalcError::None };
+}
+
+EvalResult Calculator::EvaluateInteger(std::string_view text)
+{
+    // ans в ключ не попадает: выражение с ним не кешируется
+    const bool cacheable = m_cache && ResultCache::MakeKey(text, NumberMode::Integer, 0, m_cacheKey);
+    if (cacheable && m_cache->Find(m_cacheKey, m_cached))
+    {
+        std::swap(m_integerResult, m_cached.integer);
+    }
+    else
+    {
+        const CalcError error = m_integer.Evaluate(text, m_integerResult);
+        if (error != CalcError::None)
+        {
+            return EvalResult{ 0.0, error };
+        }
+
+        if (cacheable)
+        {
+            m_cached.value = m_integerResult.ToDouble();
+            m_cached.text.clear();
+            m_cached.integer = m_integerResult;
+            m_cache->Insert(m_cacheKey, std::move(m_cached));
+        }
+    }
+
+    // Следующий шаг ссылается на результат по имени — без записи в текст
+    m_integer.SetAnswer(m_integerResult);
+    m_operand = m_integerResult.ToDouble();
+    m_operandText.assign("ans");
+    return EvalResult{ m_operand, CalcError::None };
+}
+
+EvalResult Calculator::Apply(Operator op, double lhs, double rhs)
+{
+    const OperatorKernel kernel = GetOperatorInfo(op).kernel;
+    if (kernel == nullptr)
+    {
+        return EvalResult{ rhs, CalcError::None };
+    }
+    return kernel(lhs, rhs);
+}
+
+Operator Calculator::ParseOperator(std::string_view symbol)
+{
+    if (symbol.size() != 1)
+    {
+        return Operator::None;
+    }
+    return OperatorFromSymbol(symbol.front());
+}
+
+const char* Calculator::OperatorSymbol(Operator op)
+{
+    return GetOperatorInfo(op).symbol;
+}
+
+std::size_t Calculator::FormatNumber(double value, char* buffer, std::size_t size, NumberFormat format)
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    // Compact — эквивалент "%.10g"; Full — кратчайшая запись с точным обратным разбором.
+    // Оба варианта без разбора форматной строки и без зависимости от локали
+    const auto [end, error] = format == NumberFormat::Full
+        ? std::to_chars(buffer, buffer + size - 1, value)
+        : std::to_chars(buffer, buffer + size - 1, value, std::chars_format::general, 10);
+    if (error != std::errc())
+    {
+        buffer[0] = '\0';
+        return 0;
+    }
+
+    *end = '\0';
+    return static_cast<std::size_t>(end - buffer);
+}
+
+const char* Calculator::ErrorMessage(CalcError error)
+{
+    switch (error)
+    {
+    case CalcError::None:                  return "";
+    case CalcError::InvalidNumber:         return "Error";
+    case CalcError::DivisionByZero:        return "Division by zero";
+    case CalcError::SyntaxError:           return "Syntax error";
+    case CalcError::UnbalancedParentheses: return "Unbalanced parentheses";
+    case CalcError::NestingTooDeep:        return "Expression too deep";
+    case CalcError::UnknownVariable:       return "Unknown variable";
+    case CalcError::Overflow:              return "Overflow";
+    case CalcError::Cancelled:             return "Cancelled";
+    }
+
+    return "Error";
+}
+
+} // namespace calc
@@ -0,0 +1,238 @@
+#include "engine/column_evaluator.h"
+#include "engine/operators.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define CALC_SIMD_X86 1
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <immintrin.h>
+#include <intrin.h>
+#endif
+#else
+#define CALC_SIMD_X86 0
+#endif
+
+namespace calc
+{
+
+namespace
+{
+
+const ColumnKernels* KernelsFor(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::Avx2: return GetAvx2Kernels();
+    case SimdLevel::Sse2: return GetSse2Kernels();
+    case SimdLevel::Scalar: break;
+    }
+    return GetScalarKernels();
+}
+
+UnaryKernel ColumnFunction(const ColumnKernels& kernels, Operator function)
+{
+    switch (function)
+    {
+    case Operator::Sqrt:  return kernels.sqrt;
+    case Operator::Exp:   return kernels.exp;
+    case Operator::Ln:    return kernels.ln;
+    case Operator::Log10: return kernels.log10;
+    case Operator::Sin:   return kernels.sin;
+    case Operator::Cos:   return kernels.cos;
+    case Operator::Tan:   return kernels.tan;
+    case Operator::Sinh:  return kernels.sinh;
+    case Operator::Cosh:  return kernels.cosh;
+    case Operator::Tanh:  return kernels.tanh;
+    case Operator::Gamma: return kernels.gamma;
+    default:              break;
+    }
+    return nullptr;     // Компилятор выдаёт Call только для функций реестра
+}
+
+bool CpuSupportsAvx2()
+{
+#if CALC_SIMD_X86 && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#elif CALC_SIMD_X86 && defined(_MSC_VER)
+    int info[4];
+    __cpuid(info, 0);
+    if (info[0] < 7)
+    {
+        return false;
+    }
+
+    // ОС должна сохранять YMM-регистры (OSXSAVE + XCR0 биты 1 и 2)
+    __cpuid(info, 1);
+    const bool osxsave = (info[2] & (1 << 27)) != 0;
+    const bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6)
+    {
+        return false;
+    }
+
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return false;
+#endif
+}
+
+} // namespace
+
+ColumnEvaluator::ColumnEvaluator()
+    : m_program(nullptr)
+    , m_kernels(nullptr)
+    , m_level(SimdLevel::Scalar)
+{
+    SetSimdLevel(DetectSimdLevel());
+}
+
+SimdLevel ColumnEvaluator::DetectSimdLevel()
+{
+    static const SimdLevel detected = []
+    {
+        if (GetAvx2Kernels() && CpuSupportsAvx2())
+        {
+            return SimdLevel::Avx2;
+        }
+        if (GetSse2Kernels())
+        {
+            return SimdLevel::Sse2;
+        }
+        return SimdLevel::Scalar;
+    }();
+
+    return detected;
+}
+
+const char* ColumnEvaluator::SimdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SimdLevel::Avx2:   return "AVX2";
+    case SimdLevel::Sse2:   return "SSE2";
+    case SimdLevel::Scalar: return "scalar";
+    }
+    return "scalar";
+}
+
+void ColumnEvaluator::SetSimdLevel(SimdLevel level)
+{
+    m_level = std::min(level, DetectSimdLevel());
+    m_kernels = KernelsFor(m_level);
+}
+
+void ColumnEvaluator::Load(const Program& program)
+{
+    m_program = &program;
+
+    const std::size_t registerCount = std::max<std::size_t>(program.registerCount, 1);
+    m_blocks.assign(registerCount * BLOCK_ROWS, 0.0);
+    m_operands.resize(registerCount);
+
+    for (std::size_t reg = 0; reg < registerCount; ++reg)
+    {
+        m_operands[reg] = m_blocks.data() + reg * BLOCK_ROWS;
+    }
+
+    for (std::size_t i = 0; i < program.constants.size(); ++i)
+    {
+        double* block = m_blocks.data() + i * BLOCK_ROWS;
+        std::fill(block, block + BLOCK_ROWS, program.constants[i]);
+    }
+}
+
+ColumnResult ColumnEvaluator::Evaluate(const double* const* columns, std::size_t rows, double* output)
+{
+    if (!m_program)
+    {
+        return ColumnResult{ CalcError::SyntaxError, 0 };
+    }
+
+    const std::uint32_t variableBase = m_program->GetVariableBase();
+    const std::uint32_t variableCount = m_program->GetVariableCount();
+    if (variableCount != 0 && !columns)
+    {
+        return ColumnResult{ CalcError::UnknownVariable, 0 };
+    }
+
+    const ColumnKernels& k = *m_kernels;
+    const double** operand = m_operands.data();
+    double* blocks = m_blocks.data();
+
+    for (std::size_t start = 0; start < rows; start += BLOCK_ROWS)
+    {
+        const std::size_t count = std::min(BLOCK_ROWS, rows - start);
+
+        for (std::uint32_t v = 0; v < variableCount; ++v)
+        {
+            operand[variableBase + v] = columns[v] + start;
+        }
+
+        std::size_t firstError = count;
+        for (const Instruction* ip = m_program->code.data(); ; ++ip)
+        {
+            double* dst = blocks + static_cast<std::size_t>(ip->dst) * BLOCK_ROWS;
+
+            switch (ip->op)
+            {
+            case OpCode::Add:
+                k.add(operand[ip->lhs], operand[ip->rhs], dst, count);
+                continue;
+
+            case OpCode::Subtract:
+                k.subtract(operand[ip->lhs], operand[ip->rhs], dst, count);
+                continue;
+
+            case OpCode::Multiply:
+                k.multiply(operand[ip->lhs], operand[ip->rhs], dst, count);
+                continue;
+
+            case OpCode::Divide:
+                firstError = std::min(firstError, k.divide(operand[ip->lhs], operand[ip->rhs], dst, count));
+                continue;
+
+            case OpCode::Power:
+                k.power(operand[ip->lhs], operand[ip->rhs], dst, count);
+                continue;
+
+            case OpCode::Negate:
+                k.negate(operand[ip->lhs], dst, count);
+                continue;
+
+            case OpCode::Call:
+                ColumnFunction(k, static_cast<Operator>(ip->rhs))(operand[ip->lhs], dst, count);
+                continue;
+
+            case OpCode::Return:
+                break;
+            }
+
+            // Строки до первой ошибки блока отдаются, как у скалярной машины по строкам:
+            // NaN и ±∞ в итоге строки — ошибка этой строки, как у VM на Return
+            const double* result = operand[ip->lhs];
+            for (std::size_t row = 0; row < firstError; ++row)
+            {
+                const CalcError error = NonFiniteError(result[row]);
+                if (error != CalcError::None)
+                {
+                    std::memcpy(output + start, result, row * sizeof(double));
+                    return ColumnResult{ error, start + row };
+                }
+            }
+            std::memcpy(output + start, result, firstError * sizeof(double));
+            if (firstError != count)
+            {
+                return ColumnResult{ CalcError::DivisionByZero, start + firstError };
+            }
+            break;
+        }
+    }
+
+    return ColumnResult{};
+}
+
+} // namespace calc
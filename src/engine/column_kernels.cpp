@@ -0,0 +1,109 @@
+#include "engine/column_kernels.h"
+#include "engine/operators.h"
+
+#include <cmath>
+
+namespace calc
+{
+
+namespace
+{
+
+void AddScalar(const double* lhs, const double* rhs, double* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = lhs[i] + rhs[i];
+    }
+}
+
+void SubtractScalar(const double* lhs, const double* rhs, double* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = lhs[i] - rhs[i];
+    }
+}
+
+void MultiplyScalar(const double* lhs, const double* rhs, double* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = lhs[i] * rhs[i];
+    }
+}
+
+std::size_t DivideScalar(const double* lhs, const double* rhs, double* out, std::size_t count)
+{
+    // out может совпадать с rhs (регистр переиспользован) — нули ищем до записи
+    const std::size_t firstZero = FindFirstZero(rhs, count);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = lhs[i] / rhs[i];
+    }
+    return firstZero;
+}
+
+void NegateScalar(const double* in, double* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = -in[i];
+    }
+}
+
+template<double (*Function)(double)>
+void MapColumns(const double* in, double* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = Function(in[i]);
+    }
+}
+
+const ColumnKernels SCALAR_KERNELS = {
+    AddScalar, SubtractScalar, MultiplyScalar, DivideScalar, PowerColumns, NegateScalar,
+    SqrtColumns, ExpColumns, LnColumns, Log10Columns, SinColumns, CosColumns, TanColumns,
+    SinhColumns, CoshColumns, TanhColumns, GammaColumns
+};
+
+} // namespace
+
+const ColumnKernels* GetScalarKernels()
+{
+    return &SCALAR_KERNELS;
+}
+
+void PowerColumns(const double* lhs, const double* rhs, double* out, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        out[i] = std::pow(lhs[i], rhs[i]);
+    }
+}
+
+void SqrtColumns(const double* in, double* out, std::size_t count) { MapColumns<kernels::Sqrt>(in, out, count); }
+void ExpColumns(const double* in, double* out, std::size_t count) { MapColumns<kernels::Exp>(in, out, count); }
+void LnColumns(const double* in, double* out, std::size_t count) { MapColumns<kernels::Ln>(in, out, count); }
+void Log10Columns(const double* in, double* out, std::size_t count) { MapColumns<kernels::Log10>(in, out, count); }
+void SinColumns(const double* in, double* out, std::size_t count) { MapColumns<kernels::Sin>(in, out, count); }
+void CosColumns(const double* in, double* out, std::size_t count) { MapColumns<kernels::Cos>(in, out, count); }
+void TanColumns(const double* in, double* out, std::size_t count) { MapColumns<kernels::Tan>(in, out, count); }
+void SinhColumns(const double* in, double* out, std::size_t count) { MapColumns<kernels::Sinh>(in, out, count); }
+void CoshColumns(const double* in, double* out, std::size_t count) { MapColumns<kernels::Cosh>(in, out, count); }
+void TanhColumns(const double* in, double* out, std::size_t count) { MapColumns<kernels::Tanh>(in, out, count); }
+void GammaColumns(const double* in, double* out, std::size_t count) { MapColumns<kernels::Gamma>(in, out, count); }
+
+std::size_t FindFirstZero(const double* values, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        if (values[i] == 0.0)
+        {
+            return i;
+        }
+    }
+    return count;
+}
+
+} // namespace calc
@@ -0,0 +1,547 @@
+#include "engine/column_kernels.h"
+
+// Собирается с -mavx2 (/arch:AVX2); вызывается только после проверки CPUID.
+// Здесь нельзя использовать inline-функции и шаблоны из std: их копии с AVX2
+// может выбрать компоновщик для остального кода.
+
+#if defined(__AVX2__)
+#define CALC_HAVE_AVX2_KERNELS 1
+#include <immintrin.h>
+#else
+#define CALC_HAVE_AVX2_KERNELS 0
+#endif
+
+namespace calc
+{
+
+#if CALC_HAVE_AVX2_KERNELS
+
+namespace
+{
+
+constexpr std::size_t WIDTH = 4;
+
+void AddAvx2(const double* lhs, const double* rhs, double* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm256_storeu_pd(out + i, _mm256_add_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+    }
+    for (; i < count; ++i)
+    {
+        out[i] = lhs[i] + rhs[i];
+    }
+}
+
+void SubtractAvx2(const double* lhs, const double* rhs, double* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm256_storeu_pd(out + i, _mm256_sub_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+    }
+    for (; i < count; ++i)
+    {
+        out[i] = lhs[i] - rhs[i];
+    }
+}
+
+void MultiplyAvx2(const double* lhs, const double* rhs, double* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm256_storeu_pd(out + i, _mm256_mul_pd(_mm256_loadu_pd(lhs + i), _mm256_loadu_pd(rhs + i)));
+    }
+    for (; i < count; ++i)
+    {
+        out[i] = lhs[i] * rhs[i];
+    }
+}
+
+std::size_t DivideAvx2(const double* lhs, const double* rhs, double* out, std::size_t count)
+{
+    // out может совпадать с rhs (регистр переиспользован) — нули проверяем до записи
+    const __m256d zero = _mm256_setzero_pd();
+    std::size_t firstZero = count;
+
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        const __m256d b = _mm256_loadu_pd(rhs + i);
+        if (_mm256_movemask_pd(_mm256_cmp_pd(b, zero, _CMP_EQ_OQ)) != 0 && firstZero == count)
+        {
+            firstZero = i + FindFirstZero(rhs + i, WIDTH);
+        }
+        _mm256_storeu_pd(out + i, _mm256_div_pd(_mm256_loadu_pd(lhs + i), b));
+    }
+    for (; i < count; ++i)
+    {
+        if (rhs[i] == 0.0 && firstZero == count)
+        {
+            firstZero = i;
+        }
+        out[i] = lhs[i] / rhs[i];
+    }
+    return firstZero;
+}
+
+void NegateAvx2(const double* in, double* out, std::size_t count)
+{
+    const __m256d signBit = _mm256_set1_pd(-0.0);
+
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm256_storeu_pd(out + i, _mm256_xor_pd(_mm256_loadu_pd(in + i), signBit));
+    }
+    for (; i < count; ++i)
+    {
+        out[i] = -in[i];
+    }
+}
+
+void SqrtAvx2(const double* in, double* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm256_storeu_pd(out + i, _mm256_sqrt_pd(_mm256_loadu_pd(in + i)));
+    }
+    SqrtColumns(in + i, out + i, count - i);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 📈 Экспонента и логарифм (схемы fdlibm без ветвлений, четыре строки сразу)
+//──────────────────────────────────────────────────────────────────────────────
+
+constexpr double LN2_HI = 6.93147180369123816490e-01;   // Старшие 32 бита ln 2: k·LN2_HI точно
+constexpr double LN2_LO = 1.90821492927058770002e-10;
+constexpr double LOG2_E = 1.44269504088896338700e+00;
+
+__m256d Abs(__m256d x)
+{
+    return _mm256_andnot_pd(_mm256_set1_pd(-0.0), x);
+}
+
+__m256d RoundToInteger(__m256d x)
+{
+    return _mm256_round_pd(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+}
+
+/// 2^k для целых k из [-1022, 1023], заданных в double
+__m256d PowerOfTwo(__m256d k)
+{
+    const __m256i exponent = _mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(k));
+    const __m256i bits = _mm256_slli_epi64(_mm256_add_epi64(exponent, _mm256_set1_epi64x(1023)), 52);
+    return _mm256_castsi256_pd(bits);
+}
+
+__m256d ExpVector(__m256d x)
+{
+    // За этими границами результат — бесконечность или ноль; NaN возвращается в конце
+    const __m256d clamped = _mm256_max_pd(_mm256_min_pd(x, _mm256_set1_pd(710.0)), _mm256_set1_pd(-746.0));
+
+    // x = k·ln2 + r, |r| ≤ ln2/2; hi − lo = r без потери точности
+    const __m256d k = RoundToInteger(_mm256_mul_pd(clamped, _mm256_set1_pd(LOG2_E)));
+    const __m256d hi = _mm256_sub_pd(clamped, _mm256_mul_pd(k, _mm256_set1_pd(LN2_HI)));
+    const __m256d lo = _mm256_mul_pd(k, _mm256_set1_pd(LN2_LO));
+    const __m256d r = _mm256_sub_pd(hi, lo);
+
+    // exp(r) = 1 − ((lo − r·c / (2 − c)) − hi), c — рациональное приближение Ремеза
+    const __m256d t = _mm256_mul_pd(r, r);
+    __m256d p = _mm256_set1_pd(4.13813679705723846039e-08);
+    p = _mm256_add_pd(_mm256_mul_pd(p, t), _mm256_set1_pd(-1.65339022054652515390e-06));
+    p = _mm256_add_pd(_mm256_mul_pd(p, t), _mm256_set1_pd(6.61375632143793436117e-05));
+    p = _mm256_add_pd(_mm256_mul_pd(p, t), _mm256_set1_pd(-2.77777777770155933842e-03));
+    p = _mm256_add_pd(_mm256_mul_pd(p, t), _mm256_set1_pd(1.66666666666666019037e-01));
+    const __m256d c = _mm256_sub_pd(r, _mm256_mul_pd(t, p));
+    const __m256d ratio = _mm256_div_pd(_mm256_mul_pd(r, c), _mm256_sub_pd(_mm256_set1_pd(2.0), c));
+    const __m256d y = _mm256_sub_pd(_mm256_set1_pd(1.0),
+        _mm256_sub_pd(_mm256_sub_pd(lo, ratio), hi));
+
+    // 2^k двумя множителями: k доходит до −1076 (денормали) и 1024 (переполнение)
+    const __m256d k1 = _mm256_floor_pd(_mm256_mul_pd(k, _mm256_set1_pd(0.5)));
+    const __m256d k2 = _mm256_sub_pd(k, k1);
+    const __m256d result = _mm256_mul_pd(_mm256_mul_pd(y, PowerOfTwo(k1)), PowerOfTwo(k2));
+
+    const __m256d nan = _mm256_cmp_pd(x, x, _CMP_UNORD_Q);
+    return _mm256_blendv_pd(result, _mm256_add_pd(x, x), nan);
+}
+
+__m256d LnVector(__m256d x)
+{
+    // Денормали — в нормальный диапазон умножением на 2^54
+    const __m256d tiny = _mm256_cmp_pd(x, _mm256_set1_pd(2.2250738585072014e-308), _CMP_LT_OQ);
+    const __m256d scaled = _mm256_blendv_pd(x, _mm256_mul_pd(x, _mm256_set1_pd(18014398509481984.0)), tiny);
+    __m256d k = _mm256_and_pd(tiny, _mm256_set1_pd(-54.0));
+
+    // x = 2^e · m, m ∈ [1, 2): порядок — из битов, через «магическое» 2^52
+    const __m256i bits = _mm256_castpd_si256(scaled);
+    const __m256i exponent = _mm256_srli_epi64(bits, 52);
+    const __m256d magic = _mm256_set1_pd(4503599627370496.0);
+    const __m256d e = _mm256_sub_pd(
+        _mm256_castsi256_pd(_mm256_or_si256(exponent, _mm256_castpd_si256(magic))), magic);
+    k = _mm256_add_pd(k, _mm256_sub_pd(e, _mm256_set1_pd(1023.0)));
+
+    const __m256i mantissa = _mm256_and_si256(bits, _mm256_set1_epi64x(0x000FFFFFFFFFFFFFll));
+    __m256d m = _mm256_castsi256_pd(_mm256_or_si256(mantissa, _mm256_set1_epi64x(0x3FF0000000000000ll)));
+
+    // m ∈ [√2/2, √2): f = m − 1 мал по модулю
+    const __m256d above = _mm256_cmp_pd(m, _mm256_set1_pd(1.41421356237309504880), _CMP_GT_OQ);
+    m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), above);
+    k = _mm256_add_pd(k, _mm256_and_pd(above, _mm256_set1_pd(1.0)));
+
+    // ln(1 + f) = f − hfsq + s·(hfsq + R(s²)), s = f / (2 + f)
+    const __m256d f = _mm256_sub_pd(m, _mm256_set1_pd(1.0));
+    const __m256d s = _mm256_div_pd(f, _mm256_add_pd(_mm256_set1_pd(2.0), f));
+    const __m256d z = _mm256_mul_pd(s, s);
+    const __m256d w = _mm256_mul_pd(z, z);
+    __m256d t1 = _mm256_set1_pd(1.531383769920937332e-01);
+    t1 = _mm256_add_pd(_mm256_mul_pd(t1, w), _mm256_set1_pd(2.222219843214978396e-01));
+    t1 = _mm256_add_pd(_mm256_mul_pd(t1, w), _mm256_set1_pd(3.999999999940941908e-01));
+    t1 = _mm256_mul_pd(t1, w);
+    __m256d t2 = _mm256_set1_pd(1.479819860511658591e-01);
+    t2 = _mm256_add_pd(_mm256_mul_pd(t2, w), _mm256_set1_pd(1.818357216161805012e-01));
+    t2 = _mm256_add_pd(_mm256_mul_pd(t2, w), _mm256_set1_pd(2.857142874366239149e-01));
+    t2 = _mm256_add_pd(_mm256_mul_pd(t2, w), _mm256_set1_pd(6.666666666666735130e-01));
+    t2 = _mm256_mul_pd(t2, z);
+    const __m256d R = _mm256_add_pd(t2, t1);
+    const __m256d hfsq = _mm256_mul_pd(_mm256_set1_pd(0.5), _mm256_mul_pd(f, f));
+
+    const __m256d tail = _mm256_add_pd(_mm256_mul_pd(s, _mm256_add_pd(hfsq, R)),
+        _mm256_mul_pd(k, _mm256_set1_pd(LN2_LO)));
+    __m256d result = _mm256_sub_pd(_mm256_mul_pd(k, _mm256_set1_pd(LN2_HI)),
+        _mm256_sub_pd(_mm256_sub_pd(hfsq, tail), f));
+
+    // Особые значения: ln 0 = −∞, ln(<0) = NaN, ln ∞ = ∞, NaN остаётся NaN
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d infinity = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FF0000000000000ll));
+    result = _mm256_blendv_pd(result, infinity, _mm256_cmp_pd(x, infinity, _CMP_EQ_OQ));
+    result = _mm256_blendv_pd(result, _mm256_sub_pd(zero, infinity), _mm256_cmp_pd(x, zero, _CMP_EQ_OQ));
+    result = _mm256_blendv_pd(result, _mm256_castsi256_pd(_mm256_set1_epi64x(0x7FF8000000000000ll)), _mm256_cmp_pd(x, zero, _CMP_LT_OQ));
+    return _mm256_blendv_pd(result, _mm256_add_pd(x, x), _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+}
+
+void ExpAvx2(const double* in, double* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm256_storeu_pd(out + i, ExpVector(_mm256_loadu_pd(in + i)));
+    }
+    ExpColumns(in + i, out + i, count - i);
+}
+
+void LnAvx2(const double* in, double* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm256_storeu_pd(out + i, LnVector(_mm256_loadu_pd(in + i)));
+    }
+    LnColumns(in + i, out + i, count - i);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 〰️ Тригонометрия: редукция Коди — Уэйта на π/2 и ядра fdlibm
+//──────────────────────────────────────────────────────────────────────────────
+
+/// За этой границей k·PIO2_1 перестаёт быть точным — такие строки считает libm
+constexpr double TRIG_LIMIT = 823549.6;
+
+struct Reduced
+{
+    __m256d hi;         // 🎯 x − k·π/2, старшая часть
+    __m256d lo;         // 🎯 младшая часть
+    __m256i quadrant;   // 🧭 k mod 4 (64-битные полосы)
+};
+
+Reduced ReduceHalfPi(__m256d x)
+{
+    // π/2 = PIO2_1 + PIO2_2 + PIO2_3 + ...: у каждой части 33 бита, k·часть точно
+    const __m256d k = RoundToInteger(_mm256_mul_pd(x, _mm256_set1_pd(6.36619772367581382433e-01)));
+
+    __m256d r = _mm256_sub_pd(x, _mm256_mul_pd(k, _mm256_set1_pd(1.57079632673412561417e+00)));
+
+    __m256d t = r;
+    __m256d w = _mm256_mul_pd(k, _mm256_set1_pd(6.07710050630396597660e-11));
+    r = _mm256_sub_pd(t, w);
+    w = _mm256_sub_pd(_mm256_mul_pd(k, _mm256_set1_pd(2.02226624879595063154e-21)),
+        _mm256_sub_pd(_mm256_sub_pd(t, r), w));
+
+    t = r;
+    const __m256d w3 = _mm256_mul_pd(k, _mm256_set1_pd(2.02226624871116645580e-21));
+    r = _mm256_sub_pd(t, w3);
+    w = _mm256_sub_pd(_mm256_mul_pd(k, _mm256_set1_pd(8.47842766036889956997e-32)),
+        _mm256_sub_pd(_mm256_sub_pd(t, r), w3));
+
+    Reduced reduced;
+    reduced.hi = _mm256_sub_pd(r, w);
+    reduced.lo = _mm256_sub_pd(_mm256_sub_pd(r, reduced.hi), w);
+    reduced.quadrant = _mm256_and_si256(_mm256_cvtepi32_epi64(_mm256_cvtpd_epi32(k)), _mm256_set1_epi64x(3));
+    return reduced;
+}
+
+/// sin(x + y) при |x| ≤ π/4, |y| ≪ |x|
+__m256d SinKernel(__m256d x, __m256d y)
+{
+    const __m256d z = _mm256_mul_pd(x, x);
+    const __m256d v = _mm256_mul_pd(z, x);
+    __m256d r = _mm256_set1_pd(1.58969099521155010221e-10);
+    r = _mm256_add_pd(_mm256_mul_pd(r, z), _mm256_set1_pd(-2.50507602534068634195e-08));
+    r = _mm256_add_pd(_mm256_mul_pd(r, z), _mm256_set1_pd(2.75573137070700676789e-06));
+    r = _mm256_add_pd(_mm256_mul_pd(r, z), _mm256_set1_pd(-1.98412698298579493134e-04));
+    r = _mm256_add_pd(_mm256_mul_pd(r, z), _mm256_set1_pd(8.33333333332248946124e-03));
+
+    // x − ((z·(y/2 − v·r) − y) − v·S1)
+    const __m256d inner = _mm256_sub_pd(
+        _mm256_mul_pd(z, _mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(0.5), y), _mm256_mul_pd(v, r))), y);
+    return _mm256_sub_pd(x, _mm256_sub_pd(inner,
+        _mm256_mul_pd(v, _mm256_set1_pd(-1.66666666666666324348e-01))));
+}
+
+/// cos(x + y) при |x| ≤ π/4, |y| ≪ |x|
+__m256d CosKernel(__m256d x, __m256d y)
+{
+    const __m256d z = _mm256_mul_pd(x, x);
+    __m256d r = _mm256_set1_pd(-1.13596475577881948265e-11);
+    r = _mm256_add_pd(_mm256_mul_pd(r, z), _mm256_set1_pd(2.08757232129817482790e-09));
+    r = _mm256_add_pd(_mm256_mul_pd(r, z), _mm256_set1_pd(-2.75573143513906633035e-07));
+    r = _mm256_add_pd(_mm256_mul_pd(r, z), _mm256_set1_pd(2.48015872894767294178e-05));
+    r = _mm256_add_pd(_mm256_mul_pd(r, z), _mm256_set1_pd(-1.38888888888741095749e-03));
+    r = _mm256_add_pd(_mm256_mul_pd(r, z), _mm256_set1_pd(4.16666666666666019037e-02));
+    r = _mm256_mul_pd(r, z);
+
+    // 1 − z/2 теряет биты при |x| > 0.3: часть qx вычитается точно отдельно
+    const __m256d ax = Abs(x);
+    const __m256i quarterBits = _mm256_sub_epi64(
+        _mm256_and_si256(_mm256_castpd_si256(ax), _mm256_set1_epi64x(static_cast<long long>(0xFFFFFFFF00000000ull))),
+        _mm256_set1_epi64x(0x0020000000000000ll));
+    __m256d qx = _mm256_castsi256_pd(quarterBits);
+    qx = _mm256_blendv_pd(qx, _mm256_set1_pd(0.28125), _mm256_cmp_pd(ax, _mm256_set1_pd(0.78125), _CMP_GT_OQ));
+    qx = _mm256_andnot_pd(_mm256_cmp_pd(ax, _mm256_set1_pd(0.3), _CMP_LT_OQ), qx);
+
+    const __m256d hz = _mm256_sub_pd(_mm256_mul_pd(_mm256_set1_pd(0.5), z), qx);
+    const __m256d a = _mm256_sub_pd(_mm256_set1_pd(1.0), qx);
+    return _mm256_sub_pd(a, _mm256_sub_pd(hz, _mm256_sub_pd(_mm256_mul_pd(z, r), _mm256_mul_pd(x, y))));
+}
+
+__m256d QuadrantMask(__m256i quadrant, long long bit)
+{
+    const __m256i flag = _mm256_set1_epi64x(bit);
+    return _mm256_castsi256_pd(_mm256_cmpeq_epi64(_mm256_and_si256(quadrant, flag), flag));
+}
+
+__m256d Negate(__m256d x, __m256d mask)
+{
+    return _mm256_xor_pd(x, _mm256_and_pd(mask, _mm256_set1_pd(-0.0)));
+}
+
+enum class Trig
+{
+    Sin,
+    Cos,
+    Tan
+};
+
+__m256d TrigVector(__m256d x, Trig kind)
+{
+    const Reduced reduced = ReduceHalfPi(x);
+    const __m256d s = SinKernel(reduced.hi, reduced.lo);
+    const __m256d c = CosKernel(reduced.hi, reduced.lo);
+    const __m256d odd = QuadrantMask(reduced.quadrant, 1);
+    const __m256d high = QuadrantMask(reduced.quadrant, 2);
+
+    // sin x = tan x = x при |x| < 2^−27: сохраняет −0 и денормали
+    const __m256d tiny = _mm256_cmp_pd(Abs(x), _mm256_set1_pd(7.450580596923828125e-09), _CMP_LT_OQ);
+
+    switch (kind)
+    {
+    case Trig::Sin:
+        return _mm256_blendv_pd(Negate(_mm256_blendv_pd(s, c, odd), high), x, tiny);
+    case Trig::Cos:
+        return Negate(_mm256_blendv_pd(c, s, odd), _mm256_xor_pd(odd, high));
+    case Trig::Tan:
+        break;
+    }
+    // tan = s/c в чётных четвертях и −c/s в нечётных
+    const __m256d tan = Negate(_mm256_div_pd(_mm256_blendv_pd(s, c, odd), _mm256_blendv_pd(c, s, odd)), odd);
+    return _mm256_blendv_pd(tan, x, tiny);
+}
+
+void TrigAvx2(const double* in, double* out, std::size_t count, Trig kind, UnaryKernel fallback)
+{
+    const __m256d limit = _mm256_set1_pd(TRIG_LIMIT);
+
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        const __m256d x = _mm256_loadu_pd(in + i);
+        _mm256_storeu_pd(out + i, TrigVector(x, kind));
+
+        // Большие аргументы (и ±∞) — libm с точной редукцией
+        const int large = _mm256_movemask_pd(_mm256_cmp_pd(Abs(x), limit, _CMP_GT_OQ));
+        for (int lane = 0; large != 0 && lane < static_cast<int>(WIDTH); ++lane)
+        {
+            if (large & (1 << lane))
+            {
+                fallback(in + i + lane, out + i + lane, 1);
+            }
+        }
+    }
+    fallback(in + i, out + i, count - i);
+}
+
+void SinAvx2(const double* in, double* out, std::size_t count)
+{
+    TrigAvx2(in, out, count, Trig::Sin, SinColumns);
+}
+
+void CosAvx2(const double* in, double* out, std::size_t count)
+{
+    TrigAvx2(in, out, count, Trig::Cos, CosColumns);
+}
+
+void TanAvx2(const double* in, double* out, std::size_t count)
+{
+    TrigAvx2(in, out, count, Trig::Tan, TanColumns);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 〰️ Гиперболические функции через ExpVector
+//──────────────────────────────────────────────────────────────────────────────
+
+/// Знак x на y
+__m256d CopySign(__m256d y, __m256d x)
+{
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    return _mm256_or_pd(_mm256_andnot_pd(sign, y), _mm256_and_pd(sign, x));
+}
+
+/// sinh на |x| < 1 рядом Тейлора до x^19 (без сокращения в e^x − e^−x)
+__m256d SinhSeries(__m256d x)
+{
+    const __m256d z = _mm256_mul_pd(x, x);
+    __m256d p = _mm256_set1_pd(1.0 / 121645100408832000.0);
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(1.0 / 355687428096000.0));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(1.0 / 1307674368000.0));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(1.0 / 6227020800.0));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(1.0 / 39916800.0));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(1.0 / 362880.0));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(1.0 / 5040.0));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(1.0 / 120.0));
+    p = _mm256_add_pd(_mm256_mul_pd(p, z), _mm256_set1_pd(1.0 / 6.0));
+    return _mm256_add_pd(x, _mm256_mul_pd(_mm256_mul_pd(x, z), p));
+}
+
+/// e^|x| / 2 без переполнения до границы double: (e^(|x|/2) / 2) · e^(|x|/2)
+__m256d HalfExpLarge(__m256d a)
+{
+    const __m256d root = ExpVector(_mm256_mul_pd(a, _mm256_set1_pd(0.5)));
+    return _mm256_mul_pd(_mm256_mul_pd(root, _mm256_set1_pd(0.5)), root);
+}
+
+constexpr double HYPERBOLIC_LARGE = 700.0;   // Дальше e^−|x| пренебрежимо, e^|x| близко к переполнению
+
+__m256d HyperbolicVector(__m256d x, bool cosine)
+{
+    const __m256d a = Abs(x);
+    const __m256d e = ExpVector(a);
+    const __m256d half = _mm256_set1_pd(0.5);
+    const __m256d inverse = _mm256_div_pd(half, e);
+    __m256d result = cosine
+        ? _mm256_add_pd(_mm256_mul_pd(half, e), inverse)
+        : _mm256_sub_pd(_mm256_mul_pd(half, e), inverse);
+
+    const __m256d large = _mm256_cmp_pd(a, _mm256_set1_pd(HYPERBOLIC_LARGE), _CMP_GT_OQ);
+    if (_mm256_movemask_pd(large) != 0)
+    {
+        result = _mm256_blendv_pd(result, HalfExpLarge(a), large);
+    }
+
+    if (!cosine)
+    {
+        const __m256d small = _mm256_cmp_pd(a, _mm256_set1_pd(1.0), _CMP_LT_OQ);
+        result = _mm256_blendv_pd(result, SinhSeries(a), small);
+        result = CopySign(result, x);
+    }
+    return _mm256_blendv_pd(result, _mm256_add_pd(x, x), _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+}
+
+__m256d TanhVector(__m256d x)
+{
+    const __m256d a = Abs(x);
+    const __m256d one = _mm256_set1_pd(1.0);
+
+    // |x| ≥ 1: 1 − 2 / (e^2|x| + 1) — вычитание из единицы без потери точности
+    const __m256d e2 = ExpVector(_mm256_add_pd(a, a));
+    __m256d result = _mm256_sub_pd(one, _mm256_div_pd(_mm256_set1_pd(2.0), _mm256_add_pd(e2, one)));
+
+    // |x| < 1: sinh / cosh по рядам, cosh = √(1 + sinh²)
+    const __m256d small = _mm256_cmp_pd(a, one, _CMP_LT_OQ);
+    if (_mm256_movemask_pd(small) != 0)
+    {
+        const __m256d sh = SinhSeries(a);
+        const __m256d ch = _mm256_sqrt_pd(_mm256_add_pd(one, _mm256_mul_pd(sh, sh)));
+        result = _mm256_blendv_pd(result, _mm256_div_pd(sh, ch), small);
+    }
+
+    result = CopySign(result, x);
+    return _mm256_blendv_pd(result, _mm256_add_pd(x, x), _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+}
+
+void SinhAvx2(const double* in, double* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm256_storeu_pd(out + i, HyperbolicVector(_mm256_loadu_pd(in + i), false));
+    }
+    SinhColumns(in + i, out + i, count - i);
+}
+
+void CoshAvx2(const double* in, double* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm256_storeu_pd(out + i, HyperbolicVector(_mm256_loadu_pd(in + i), true));
+    }
+    CoshColumns(in + i, out + i, count - i);
+}
+
+void TanhAvx2(const double* in, double* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm256_storeu_pd(out + i, TanhVector(_mm256_loadu_pd(in + i)));
+    }
+    TanhColumns(in + i, out + i, count - i);
+}
+
+const ColumnKernels AVX2_KERNELS = {
+    AddAvx2, SubtractAvx2, MultiplyAvx2, DivideAvx2, PowerColumns, NegateAvx2,
+    SqrtAvx2, ExpAvx2, LnAvx2, Log10Columns, SinAvx2, CosAvx2, TanAvx2,
+    SinhAvx2, CoshAvx2, TanhAvx2, GammaColumns
+};
+
+} // namespace
+
+const ColumnKernels* GetAvx2Kernels()
+{
+    return &AVX2_KERNELS;
+}
+
+#else
+
+const ColumnKernels* GetAvx2Kernels()
+{
+    return nullptr;
+}
+
+#endif
+
+} // namespace calc
@@ -0,0 +1,136 @@
+#include "engine/column_kernels.h"
+
+// SSE2 — базовый набор x86-64, отдельная проверка CPUID не нужна
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CALC_HAVE_SSE2_KERNELS 1
+#include <emmintrin.h>
+#else
+#define CALC_HAVE_SSE2_KERNELS 0
+#endif
+
+namespace calc
+{
+
+#if CALC_HAVE_SSE2_KERNELS
+
+namespace
+{
+
+constexpr std::size_t WIDTH = 2;
+
+void AddSse2(const double* lhs, const double* rhs, double* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm_storeu_pd(out + i, _mm_add_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+    }
+    for (; i < count; ++i)
+    {
+        out[i] = lhs[i] + rhs[i];
+    }
+}
+
+void SubtractSse2(const double* lhs, const double* rhs, double* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm_storeu_pd(out + i, _mm_sub_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+    }
+    for (; i < count; ++i)
+    {
+        out[i] = lhs[i] - rhs[i];
+    }
+}
+
+void MultiplySse2(const double* lhs, const double* rhs, double* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm_storeu_pd(out + i, _mm_mul_pd(_mm_loadu_pd(lhs + i), _mm_loadu_pd(rhs + i)));
+    }
+    for (; i < count; ++i)
+    {
+        out[i] = lhs[i] * rhs[i];
+    }
+}
+
+std::size_t DivideSse2(const double* lhs, const double* rhs, double* out, std::size_t count)
+{
+    // out может совпадать с rhs (регистр переиспользован) — нули проверяем до записи
+    const __m128d zero = _mm_setzero_pd();
+    std::size_t firstZero = count;
+
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        const __m128d b = _mm_loadu_pd(rhs + i);
+        if (_mm_movemask_pd(_mm_cmpeq_pd(b, zero)) != 0 && firstZero == count)
+        {
+            firstZero = i + FindFirstZero(rhs + i, WIDTH);
+        }
+        _mm_storeu_pd(out + i, _mm_div_pd(_mm_loadu_pd(lhs + i), b));
+    }
+    for (; i < count; ++i)
+    {
+        if (rhs[i] == 0.0 && firstZero == count)
+        {
+            firstZero = i;
+        }
+        out[i] = lhs[i] / rhs[i];
+    }
+    return firstZero;
+}
+
+void NegateSse2(const double* in, double* out, std::size_t count)
+{
+    const __m128d signBit = _mm_set1_pd(-0.0);
+
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm_storeu_pd(out + i, _mm_xor_pd(_mm_loadu_pd(in + i), signBit));
+    }
+    for (; i < count; ++i)
+    {
+        out[i] = -in[i];
+    }
+}
+
+void SqrtSse2(const double* in, double* out, std::size_t count)
+{
+    std::size_t i = 0;
+    for (; i + WIDTH <= count; i += WIDTH)
+    {
+        _mm_storeu_pd(out + i, _mm_sqrt_pd(_mm_loadu_pd(in + i)));
+    }
+    SqrtColumns(in + i, out + i, count - i);
+}
+
+// Трансцендентные функции — скалярные: 2 double в регистре не окупают приближения
+const ColumnKernels SSE2_KERNELS = {
+    AddSse2, SubtractSse2, MultiplySse2, DivideSse2, PowerColumns, NegateSse2,
+    SqrtSse2, ExpColumns, LnColumns, Log10Columns, SinColumns, CosColumns, TanColumns,
+    SinhColumns, CoshColumns, TanhColumns, GammaColumns
+};
+
+} // namespace
+
+const ColumnKernels* GetSse2Kernels()
+{
+    return &SSE2_KERNELS;
+}
+
+#else
+
+const ColumnKernels* GetSse2Kernels()
+{
+    return nullptr;
+}
+
+#endif
+
+} // namespace calc
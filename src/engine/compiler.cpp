@@ -0,0 +1,327 @@
+#include "engine/compiler.h"
+#include "engine/operators.h"
+
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace calc
+{
+
+namespace
+{
+
+bool IsCommutative(OpCode op)
+{
+    return op == OpCode::Add || op == OpCode::Multiply;
+}
+
+bool IsUnary(OpCode op)
+{
+    return op == OpCode::Negate || op == OpCode::Call;
+}
+
+struct Frame
+{
+    const Node* node;
+    bool expanded;
+};
+
+} // namespace
+
+void BytecodeCompiler::Compile(const Node* root, Program& program)
+{
+    program.Clear();
+    m_program = &program;
+
+    m_values.clear();
+    m_constantIds.clear();
+    m_variableIds.clear();
+    m_operationIds.clear();
+
+    const std::uint32_t rootValue = BuildValues(root);
+    Emit(rootValue, program);
+
+    m_program = nullptr;
+}
+
+std::uint32_t BytecodeCompiler::BuildValues(const Node* root)
+{
+    std::vector<Frame> stack;
+    std::vector<std::uint32_t> results;
+    stack.push_back(Frame{ root, false });
+
+    while (!stack.empty())
+    {
+        const Frame frame = stack.back();
+        stack.pop_back();
+        const Node* node = frame.node;
+
+        switch (node->kind)
+        {
+        case NodeKind::Number:
+            results.push_back(MakeConstant(node->value));
+            break;
+
+        case NodeKind::Variable:
+            results.push_back(MakeVariable(node));
+            break;
+
+        case NodeKind::Negate:
+            if (!frame.expanded)
+            {
+                stack.push_back(Frame{ node, true });
+                stack.push_back(Frame{ node->lhs, false });
+            }
+            else
+            {
+                const std::uint32_t operand = results.back();
+                results.back() = MakeOperation(OpCode::Negate, operand, operand);
+            }
+            break;
+
+        case NodeKind::Binary:
+            if (!frame.expanded)
+            {
+                stack.push_back(Frame{ node, true });
+                stack.push_back(Frame{ node->rhs, false });
+                stack.push_back(Frame{ node->lhs, false });
+            }
+            else
+            {
+                const std::uint32_t rhs = results.back();
+                results.pop_back();
+                const std::uint32_t lhs = results.back();
+                results.back() = MakeOperation(GetOperatorInfo(node->op).opcode, lhs, rhs);
+            }
+            break;
+
+        case NodeKind::Call:
+            if (!frame.expanded)
+            {
+                stack.push_back(Frame{ node, true });
+                stack.push_back(Frame{ node->lhs, false });
+            }
+            else
+            {
+                results.back() = MakeCall(node->op, results.back());
+            }
+            break;
+        }
+    }
+
+    return results.back();
+}
+
+std::uint32_t BytecodeCompiler::MakeConstant(double value)
+{
+    std::uint64_t bits = 0;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    const auto it = m_constantIds.find(bits);
+    if (it != m_constantIds.end())
+    {
+        return it->second;
+    }
+
+    Value constant;
+    constant.kind = ValueKind::Constant;
+    constant.constant = value;
+
+    const auto id = static_cast<std::uint32_t>(m_values.size());
+    m_values.push_back(constant);
+    m_constantIds.emplace(bits, id);
+    return id;
+}
+
+std::uint32_t BytecodeCompiler::MakeVariable(const Node* node)
+{
+    const auto it = m_variableIds.find(node->name);
+    if (it != m_variableIds.end())
+    {
+        return it->second;
+    }
+
+    std::vector<std::string>& names = m_program->variableNames;
+
+    Value variable;
+    variable.kind = ValueKind::Variable;
+    variable.slot = static_cast<std::uint32_t>(names.size());
+    names.emplace_back(node->name);
+
+    const auto id = static_cast<std::uint32_t>(m_values.size());
+    m_values.push_back(variable);
+    m_variableIds.emplace(node->name, id);
+    return id;
+}
+
+std::uint32_t BytecodeCompiler::MakeOperation(OpCode op, std::uint32_t lhs, std::uint32_t rhs)
+{
+    const Value& left = m_values[lhs];
+    const Value& right = m_values[rhs];
+
+    if (left.kind == ValueKind::Constant && right.kind == ValueKind::Constant)
+    {
+        switch (op)
+        {
+        case OpCode::Negate:
+            return MakeConstant(-left.constant);
+        case OpCode::Add:
+            return MakeConstant(left.constant + right.constant);
+        case OpCode::Subtract:
+            return MakeConstant(left.constant - right.constant);
+        case OpCode::Multiply:
+            return MakeConstant(left.constant * right.constant);
+        case OpCode::Power:
+            return MakeConstant(std::pow(left.constant, right.constant));
+        case OpCode::Divide:
+            if (right.constant != 0.0)
+            {
+                return MakeConstant(left.constant / right.constant);
+            }
+            break;
+        case OpCode::Call:
+        case OpCode::Return:
+            break;
+        }
+    }
+
+    if (IsCommutative(op) && lhs > rhs)
+    {
+        std::swap(lhs, rhs);
+    }
+
+    return InternOperation(op, lhs, rhs);
+}
+
+std::uint32_t BytecodeCompiler::MakeCall(Operator function, std::uint32_t operand)
+{
+    const Value& argument = m_values[operand];
+    if (argument.kind == ValueKind::Constant)
+    {
+        return MakeConstant(GetOperatorInfo(function).function(argument.constant));
+    }
+
+    // Вместо второго операнда — номер функции в реестре
+    return InternOperation(OpCode::Call, operand, static_cast<std::uint32_t>(function));
+}
+
+std::uint32_t BytecodeCompiler::InternOperation(OpCode op, std::uint32_t lhs, std::uint32_t rhs)
+{
+    const OperationKey key{ op, lhs, rhs };
+    const auto it = m_operationIds.find(key);
+    if (it != m_operationIds.end())
+    {
+        return it->second;
+    }
+
+    Value operation;
+    operation.kind = ValueKind::Operation;
+    operation.op = op;
+    operation.lhs = lhs;
+    operation.rhs = rhs;
+
+    const auto id = static_cast<std::uint32_t>(m_values.size());
+    m_values.push_back(operation);
+    m_operationIds.emplace(key, id);
+    return id;
+}
+
+void BytecodeCompiler::Emit(std::uint32_t rootValue, Program& program)
+{
+    const std::size_t count = m_values.size();
+
+    // Значения пронумерованы топологически: операнды всегда имеют меньший номер
+    m_useCounts.assign(count, 0);
+    m_useCounts[rootValue] = 1;
+    for (std::size_t i = count; i-- > 0;)
+    {
+        const Value& value = m_values[i];
+        if (m_useCounts[i] == 0 || value.kind != ValueKind::Operation)
+        {
+            continue;
+        }
+
+        ++m_useCounts[value.lhs];
+        if (!IsUnary(value.op))
+        {
+            ++m_useCounts[value.rhs];
+        }
+    }
+
+    m_registers.assign(count, 0);
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        Value& value = m_values[i];
+        if (m_useCounts[i] != 0 && value.kind == ValueKind::Constant)
+        {
+            value.slot = static_cast<std::uint32_t>(program.constants.size());
+            program.constants.push_back(value.constant);
+            m_registers[i] = value.slot;
+        }
+    }
+
+    const std::uint32_t variableBase = program.GetVariableBase();
+    const std::uint32_t temporaryBase = variableBase + program.GetVariableCount();
+    std::uint32_t registerCount = temporaryBase;
+    std::vector<std::uint32_t> freeRegisters;
+
+    for (std::size_t i = 0; i < count; ++i)
+    {
+        const Value& value = m_values[i];
+        if (m_useCounts[i] == 0)
+        {
+            continue;
+        }
+
+        if (value.kind == ValueKind::Variable)
+        {
+            m_registers[i] = variableBase + value.slot;
+            continue;
+        }
+
+        if (value.kind != ValueKind::Operation)
+        {
+            continue;
+        }
+
+        Instruction instruction;
+        instruction.op = value.op;
+        instruction.lhs = m_registers[value.lhs];
+        instruction.rhs = value.op == OpCode::Call ? value.rhs
+            : m_registers[value.op == OpCode::Negate ? value.lhs : value.rhs];
+
+        const std::uint32_t operands[2] = { value.lhs, value.rhs };
+        const int operandCount = IsUnary(value.op) ? 1 : 2;
+        for (int k = 0; k < operandCount; ++k)
+        {
+            const std::uint32_t operand = operands[k];
+            if (--m_useCounts[operand] == 0 && m_values[operand].kind == ValueKind::Operation)
+            {
+                freeRegisters.push_back(m_registers[operand]);
+            }
+        }
+
+        if (!freeRegisters.empty())
+        {
+            instruction.dst = freeRegisters.back();
+            freeRegisters.pop_back();
+        }
+        else
+        {
+            instruction.dst = registerCount++;
+        }
+
+        m_registers[i] = instruction.dst;
+        program.code.push_back(instruction);
+    }
+
+    Instruction ret;
+    ret.op = OpCode::Return;
+    ret.lhs = m_registers[rootValue];
+    program.code.push_back(ret);
+
+    program.registerCount = registerCount;
+}
+
+} // namespace calc
@@ -0,0 +1,56 @@
+#include "engine/decimal_evaluator.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace calc
+{
+
+DecimalEvaluator::DecimalEvaluator(std::uint32_t precision)
+    : m_lexer(std::string_view())
+    , m_precision(BigDecimal::DEFAULT_PRECISION)
+{
+    SetPrecision(precision);
+}
+
+void DecimalEvaluator::SetPrecision(std::uint32_t precision)
+{
+    m_precision = std::clamp<std::uint32_t>(precision, 1, BigDecimal::MAX_PRECISION);
+}
+
+CalcError DecimalEvaluator::Evaluate(std::string_view text, BigDecimal& result)
+{
+    m_lexer = Lexer(text);
+    BigDecimal value = Run(text);
+
+    const CalcError error = GetError();
+    if (error == CalcError::None)
+    {
+        result = std::move(value);
+    }
+    return error;
+}
+
+BigDecimal DecimalEvaluator::Number(const Token& token)
+{
+    // Литерал читается заново: значение лексера — double (1e400 там ∞)
+    BigDecimal number;
+    if (token.length == 0
+        || !number.Parse(m_text.substr(token.position, token.length), m_precision))
+    {
+        MathError(CalcError::Overflow);
+    }
+    return number;
+}
+
+CalcError DecimalEvaluator::Apply(Operator op, BigDecimal& lhs, const BigDecimal& rhs)
+{
+    return BigDecimal::Apply(op, lhs, rhs, lhs, m_precision);
+}
+
+CalcError DecimalEvaluator::Function(Operator op, BigDecimal& argument)
+{
+    return BigDecimal::Function(op, argument, argument, m_precision);
+}
+
+} // namespace calc
@@ -0,0 +1,49 @@
+#include "engine/direct_evaluator.h"
+#include "engine/calculator.h"
+#include "engine/operators.h"
+
+namespace calc
+{
+
+DirectEvaluator::DirectEvaluator()
+    : m_lexer(std::string_view())
+{
+}
+
+EvalResult DirectEvaluator::Evaluate(std::string_view text)
+{
+    m_lexer = Lexer(text);
+    const double value = Run(text);
+
+    const CalcError error = GetError();
+    if (error != CalcError::None)
+    {
+        return EvalResult{ 0.0, error };
+    }
+
+    return FiniteResult(value);
+}
+
+double DirectEvaluator::Number(const Token& token)
+{
+    if (std::isinf(token.number))
+    {
+        MathError(CalcError::Overflow);  // Литерал больше DBL_MAX
+    }
+    return token.number;
+}
+
+CalcError DirectEvaluator::Apply(Operator op, double& lhs, double rhs)
+{
+    const EvalResult result = Calculator::Apply(op, lhs, rhs);
+    lhs = result.value;
+    return result.error;
+}
+
+CalcError DirectEvaluator::Function(Operator op, double& argument)
+{
+    argument = GetOperatorInfo(op).function(argument);
+    return CalcError::None;
+}
+
+} // namespace calc
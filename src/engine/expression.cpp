@@ -0,0 +1,108 @@
+#include "engine/expression.h"
+#include "engine/parser.h"
+
+namespace calc
+{
+
+Expression::Expression()
+    : m_compiled(false)
+    , m_bound(false)
+    , m_error(CalcError::None)
+    , m_errorPosition(0)
+{
+}
+
+CalcError Expression::Compile(std::string_view text)
+{
+    // Ошибка лексера не должна оставить связанной прежнюю программу
+    m_compiled = false;
+    m_bound = false;
+    m_errorPosition = 0;
+
+    m_error = Lexer::Tokenize(text, m_tokens, &m_errorPosition);
+    if (m_error != CalcError::None)
+    {
+        return m_error;
+    }
+
+    return Compile(m_tokens, text);
+}
+
+CalcError Expression::Compile(const std::vector<Token>& tokens, std::string_view source)
+{
+    m_compiled = false;
+    m_bound = false;
+    m_arena.Reset();
+
+    Parser parser(tokens.data(), tokens.size(), m_arena, source);
+    const ParseResult result = parser.Parse();
+
+    m_error = result.error;
+    m_errorPosition = result.position;
+    if (!result.root)
+    {
+        return m_error;
+    }
+
+    m_compiler.Compile(result.root, m_program);
+    m_vm.Load(m_program);
+    m_compiled = true;
+    return m_error;
+}
+
+EvalResult Expression::Evaluate(const double* variables)
+{
+    if (!m_compiled)
+    {
+        return EvalResult{ 0.0, m_error == CalcError::None ? CalcError::SyntaxError : m_error };
+    }
+
+    return m_vm.Run(variables);
+}
+
+CalcError Expression::Bind(const SymbolTable& symbols)
+{
+    m_bound = false;
+    if (!m_compiled)
+    {
+        return m_error == CalcError::None ? CalcError::SyntaxError : m_error;
+    }
+
+    // Чтение имени его не заводит: иначе каждая опечатка занимала бы слот сеанса навсегда
+    m_symbols.clear();
+    for (const std::string& name : m_program.variableNames)
+    {
+        const std::uint32_t symbol = symbols.Find(name);
+        if (symbol == SymbolTable::NO_SYMBOL)
+        {
+            return CalcError::UnknownVariable;
+        }
+        m_symbols.push_back(symbol);
+    }
+
+    m_variables.resize(m_symbols.size());
+    m_bound = true;
+    return CalcError::None;
+}
+
+EvalResult Expression::Evaluate(const SymbolTable& symbols)
+{
+    if (!IsBound())
+    {
+        return EvalResult{ 0.0, m_compiled ? CalcError::UnknownVariable : CalcError::SyntaxError };
+    }
+
+    // Имена разрешены в Bind: здесь только чтение по номерам слотов
+    for (std::size_t i = 0; i < m_symbols.size(); ++i)
+    {
+        if (!symbols.IsDefined(m_symbols[i]))
+        {
+            return EvalResult{ 0.0, CalcError::UnknownVariable };
+        }
+        m_variables[i] = symbols.GetValue(m_symbols[i]);
+    }
+
+    return m_vm.Run(m_variables.data());
+}
+
+} // namespace calc
@@ -0,0 +1,271 @@
+#include "engine/history.h"
+
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace calc
+{
+
+namespace
+{
+
+constexpr std::size_t BLOCK_HEADER_SIZE = 8;
+
+} // namespace
+
+History::History()
+    : m_file(nullptr)
+    , m_size(0)
+{
+}
+
+void History::Attach(SessionFile& file)
+{
+    // Уже накопленное в памяти дописывается после записей из файла
+    std::vector<char*> pending = std::move(m_blocks);
+    std::vector<std::unique_ptr<char[]>> owned = std::move(m_ownedBlocks);
+    m_blocks.clear();
+    m_blockStarts.clear();
+    m_ownedBlocks.clear();
+    m_size = 0;
+    m_file = &file;
+
+    for (std::size_t i = 0; i < file.GetBlockCount(); ++i)
+    {
+        char* block = file.GetBlock(i);
+        BlockHeader header;
+        std::memcpy(&header, block, sizeof(header));
+
+        const bool fresh = header.count == 0 && header.textStart == 0;
+        const bool broken = header.textStart > BLOCK_SIZE
+            || BLOCK_HEADER_SIZE + std::size_t(header.count) * sizeof(Slot) > header.textStart;
+        if (fresh || broken)
+        {
+            // Блок добавлен, но не размечен, или повреждён — начинаем его заново
+            header.count = 0;
+            header.textStart = static_cast<std::uint32_t>(BLOCK_SIZE);
+            std::memcpy(block, &header, sizeof(header));
+            file.MarkBlockDirty(i);
+        }
+        AddBlock(block);
+    }
+
+    for (const char* block : pending)
+    {
+        BlockHeader header;
+        std::memcpy(&header, block, sizeof(header));
+        for (std::uint32_t i = 0; i < header.count; ++i)
+        {
+            Slot slot;
+            std::memcpy(&slot, block + BLOCK_HEADER_SIZE + i * sizeof(Slot), sizeof(slot));
+            Append(std::string_view(block + slot.textOffset, slot.expressionLength),
+                std::string_view(block + slot.textOffset + slot.expressionLength, slot.resultLength),
+                slot.timestamp);
+        }
+    }
+}
+
+void History::Append(std::string_view expression, std::string_view result, std::int64_t timestamp)
+{
+    expression = expression.substr(0, MAX_TEXT_LENGTH);
+    result = result.substr(0, MAX_TEXT_LENGTH);
+    const std::size_t textLength = expression.size() + result.size();
+
+    char* block = m_blocks.empty() ? nullptr : m_blocks.back();
+    BlockHeader header = {};
+    if (block)
+    {
+        std::memcpy(&header, block, sizeof(header));
+    }
+
+    const std::size_t used = BLOCK_HEADER_SIZE + std::size_t(header.count + 1) * sizeof(Slot);
+    if (!block || used + textLength > header.textStart)
+    {
+        block = NewBlock();
+        if (!block)
+        {
+            return;     // Диск заполнен: запись теряется, прежние целы
+        }
+        std::memcpy(&header, block, sizeof(header));
+    }
+
+    header.textStart -= static_cast<std::uint32_t>(textLength);
+    std::memcpy(block + header.textStart, expression.data(), expression.size());
+    std::memcpy(block + header.textStart + expression.size(), result.data(), result.size());
+
+    Slot slot;
+    slot.timestamp = timestamp;
+    slot.textOffset = header.textStart;
+    slot.expressionLength = static_cast<std::uint32_t>(expression.size());
+    slot.resultLength = static_cast<std::uint32_t>(result.size());
+    slot.reserved = 0;
+    std::memcpy(block + BLOCK_HEADER_SIZE + header.count * sizeof(Slot), &slot, sizeof(slot));
+
+    // Счётчик — последним: до этого момента запись не видна
+    ++header.count;
+    std::memcpy(block, &header, sizeof(header));
+    ++m_size;
+
+    if (m_file)
+    {
+        m_file->MarkBlockDirty(m_blocks.size() - 1);
+    }
+}
+
+HistoryEntry History::GetEntry(std::size_t index) const
+{
+    const std::size_t blockIndex = static_cast<std::size_t>(
+        std::upper_bound(m_blockStarts.begin(), m_blockStarts.end(), index) - m_blockStarts.begin()) - 1;
+    const char* block = m_blocks[blockIndex];
+
+    Slot slot;
+    std::memcpy(&slot, block + BLOCK_HEADER_SIZE + (index - m_blockStarts[blockIndex]) * sizeof(Slot), sizeof(slot));
+
+    HistoryEntry entry;
+    entry.timestamp = slot.timestamp;
+
+    // Файл мог быть испорчен снаружи — за пределы блока не читаем
+    const std::size_t textEnd = std::size_t(slot.textOffset) + slot.expressionLength + slot.resultLength;
+    if (slot.textOffset >= BLOCK_HEADER_SIZE && textEnd <= BLOCK_SIZE)
+    {
+        entry.expression = std::string_view(block + slot.textOffset, slot.expressionLength);
+        entry.result = std::string_view(block + slot.textOffset + slot.expressionLength, slot.resultLength);
+    }
+    return entry;
+}
+
+void History::Clear()
+{
+    if (m_file)
+    {
+        m_file->RemoveBlocks();
+    }
+
+    m_blocks.clear();
+    m_blockStarts.clear();
+    m_ownedBlocks.clear();
+    m_size = 0;
+}
+
+char* History::NewBlock()
+{
+    char* block = nullptr;
+    if (m_file)
+    {
+        block = m_file->AppendBlock();
+    }
+    else
+    {
+        m_ownedBlocks.push_back(std::unique_ptr<char[]>(new char[BLOCK_SIZE]));
+        block = m_ownedBlocks.back().get();
+    }
+
+    if (block)
+    {
+        const BlockHeader header = { 0, static_cast<std::uint32_t>(BLOCK_SIZE) };
+        std::memcpy(block, &header, sizeof(header));
+        AddBlock(block);
+    }
+    return block;
+}
+
+void History::AddBlock(char* block)
+{
+    BlockHeader header;
+    std::memcpy(&header, block, sizeof(header));
+
+    m_blocks.push_back(block);
+    m_blockStarts.push_back(m_size);
+    m_size += header.count;
+}
+
+HistorySearch::HistorySearch()
+    : m_candidateCursor(0)
+    , m_scanned(0)
+{
+}
+
+void HistorySearch::SetQuery(std::string_view query)
+{
+    if (query == m_query)
+    {
+        return;
+    }
+
+    // Уточнение: всё, что совпадёт с новым запросом, совпадало и с прежним
+    const bool narrowing = !m_query.empty() && query.find(m_query) != std::string_view::npos;
+    m_query.assign(query.data(), query.size());
+
+    if (narrowing)
+    {
+        // Недопроверенные кандидаты прежнего шага тоже остаются кандидатами
+        std::vector<std::uint32_t> candidates = std::move(m_matches);
+        candidates.insert(candidates.end(),
+            m_candidates.begin() + static_cast<std::ptrdiff_t>(m_candidateCursor), m_candidates.end());
+        std::sort(candidates.begin(), candidates.end());
+
+        m_candidates = std::move(candidates);
+        m_matches.clear();
+        m_candidateCursor = 0;
+        return;
+    }
+
+    m_matches.clear();
+    m_candidates.clear();
+    m_candidateCursor = 0;
+    m_scanned = 0;
+}
+
+bool HistorySearch::Advance(const History& history, std::size_t budget)
+{
+    if (m_query.empty())
+    {
+        return true;
+    }
+
+    // История могла быть очищена — всё, что за её концом, недействительно
+    if (m_scanned > history.GetSize())
+    {
+        m_matches.clear();
+        m_candidates.clear();
+        m_candidateCursor = 0;
+        m_scanned = 0;
+    }
+
+    while (budget != 0 && m_candidateCursor < m_candidates.size())
+    {
+        const std::uint32_t index = m_candidates[m_candidateCursor++];
+        if (index < history.GetSize() && Matches(history.GetEntry(index)))
+        {
+            m_matches.push_back(index);
+        }
+        --budget;
+    }
+
+    if (m_candidateCursor == m_candidates.size() && !m_candidates.empty())
+    {
+        m_candidates.clear();
+        m_candidateCursor = 0;
+    }
+
+    while (budget != 0 && m_scanned < history.GetSize())
+    {
+        if (Matches(history.GetEntry(m_scanned)))
+        {
+            m_matches.push_back(static_cast<std::uint32_t>(m_scanned));
+        }
+        ++m_scanned;
+        --budget;
+    }
+
+    return m_candidates.empty() && m_scanned == history.GetSize();
+}
+
+bool HistorySearch::Matches(const HistoryEntry& entry) const
+{
+    return entry.expression.find(m_query) != std::string_view::npos
+        || entry.result.find(m_query) != std::string_view::npos;
+}
+
+} // namespace calc
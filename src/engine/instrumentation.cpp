@@ -0,0 +1,378 @@
+#include "engine/instrumentation.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace calc
+{
+
+namespace
+{
+
+constexpr std::size_t RING_CAPACITY = 8192;     // 📏 Событий в кольце потока
+static_assert((RING_CAPACITY & (RING_CAPACITY - 1)) == 0, "RING_CAPACITY must be a power of two");
+
+enum class EventKind : std::uint32_t
+{
+    Scope,          // ⏱️ value — длительность
+    Evaluations     // 🧮 value — всего вычислено к этому моменту
+};
+
+struct TraceEvent
+{
+    const char* name;
+    std::uint64_t start;
+    std::uint64_t value;
+    EventKind kind;
+    std::uint32_t thread;
+};
+
+// Кольцо одного потока. Пишет только владелец; читатель (экспорт) копирует
+// без блокировки и отбрасывает то, что владелец мог затереть во время копирования
+class TraceRing
+{
+public:
+    explicit TraceRing(std::uint32_t thread)
+        : m_thread(thread)
+    {
+    }
+
+    void Push(const char* name, std::uint64_t start, std::uint64_t value, EventKind kind)
+    {
+        const std::uint64_t index = m_written.load(std::memory_order_relaxed);
+
+        // Сначала объявляем слот занятым: читатель, увидевший новые данные, увидит и это
+        m_claimed.store(index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        Slot& slot = m_slots[index & (RING_CAPACITY - 1)];
+        slot.name.store(name, std::memory_order_relaxed);
+        slot.start.store(start, std::memory_order_relaxed);
+        slot.value.store(value, std::memory_order_relaxed);
+        slot.kind.store(kind, std::memory_order_relaxed);
+
+        m_written.store(index + 1, std::memory_order_release);
+    }
+
+    void Snapshot(std::vector<TraceEvent>& events) const
+    {
+        const std::uint64_t written = m_written.load(std::memory_order_acquire);
+        const std::uint64_t first = written > RING_CAPACITY ? written - RING_CAPACITY : 0;
+        const std::size_t base = events.size();
+
+        for (std::uint64_t i = first; i < written; ++i)
+        {
+            const Slot& slot = m_slots[i & (RING_CAPACITY - 1)];
+            events.push_back(TraceEvent{ slot.name.load(std::memory_order_relaxed),
+                slot.start.load(std::memory_order_relaxed), slot.value.load(std::memory_order_relaxed),
+                slot.kind.load(std::memory_order_relaxed), m_thread });
+        }
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        const std::uint64_t claimed = m_claimed.load(std::memory_order_relaxed);
+        if (claimed > RING_CAPACITY && claimed - RING_CAPACITY > first)
+        {
+            const std::uint64_t torn = std::min<std::uint64_t>(claimed - RING_CAPACITY - first, written - first);
+            events.erase(events.begin() + static_cast<std::ptrdiff_t>(base),
+                events.begin() + static_cast<std::ptrdiff_t>(base + torn));
+        }
+    }
+
+    std::uint32_t GetThread() const { return m_thread; }
+
+    std::atomic<const char*> threadName{ nullptr };     // 🏷️ Имя потока-владельца
+    std::atomic<bool> owned{ true };                    // 🔒 Поток жив; false — кольцо можно отдать новому
+
+private:
+    struct Slot
+    {
+        std::atomic<const char*> name{ nullptr };
+        std::atomic<std::uint64_t> start{ 0 };
+        std::atomic<std::uint64_t> value{ 0 };
+        std::atomic<EventKind> kind{ EventKind::Scope };
+    };
+
+    std::array<Slot, RING_CAPACITY> m_slots;
+    std::atomic<std::uint64_t> m_claimed{ 0 };  // 📝 Начатых записей
+    std::atomic<std::uint64_t> m_written{ 0 };  // ✅ Законченных записей
+    const std::uint32_t m_thread;               // 🧵 Номер дорожки в экспорте
+};
+
+// Мьютекс только на регистрацию потока и экспорт; запись в кольцо его не берёт.
+// Реестр не разрушается: потоки могут писать и после выхода из main
+struct TraceRegistry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<TraceRing>> rings;
+
+    std::atomic<std::uint64_t> evaluations{ 0 };
+    std::atomic<std::uint64_t> operations{ 0 };
+    std::atomic<std::uint64_t> operationAllocations{ 0 };
+    std::atomic<std::uint64_t> pendingInput{ 0 };   // 👆 Первый неотрисованный ввод (0 — нет)
+    std::array<std::atomic<std::uint64_t>, LATENCY_BUCKETS> latency{};
+};
+
+TraceRegistry& Registry()
+{
+    static TraceRegistry* const registry = new TraceRegistry;
+    return *registry;
+}
+
+// Освобождает кольцо при завершении потока: следующий новый поток возьмёт его себе
+struct RingOwner
+{
+    TraceRing* ring = nullptr;
+
+    ~RingOwner()
+    {
+        if (ring)
+        {
+            ring->owned.store(false, std::memory_order_release);
+        }
+    }
+};
+
+thread_local RingOwner t_ring;
+
+TraceRing& CurrentRing()
+{
+    if (t_ring.ring)
+    {
+        return *t_ring.ring;
+    }
+
+    TraceRegistry& registry = Registry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    for (const auto& ring : registry.rings)
+    {
+        bool expected = false;
+        if (ring->owned.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+        {
+            ring->threadName.store(nullptr, std::memory_order_relaxed);
+            t_ring.ring = ring.get();
+            return *ring;
+        }
+    }
+
+    registry.rings.push_back(std::make_unique<TraceRing>(static_cast<std::uint32_t>(registry.rings.size() + 1)));
+    t_ring.ring = registry.rings.back().get();
+    return *t_ring.ring;
+}
+
+std::size_t LatencyBucket(std::uint64_t nanoseconds)
+{
+    std::uint64_t microseconds = nanoseconds / 1000;
+    std::size_t bucket = 0;
+    while (microseconds >= 2 && bucket + 1 < LATENCY_BUCKETS)
+    {
+        microseconds >>= 1;
+        ++bucket;
+    }
+    return bucket;
+}
+
+void WriteJsonString(std::FILE* file, const char* text)
+{
+    std::fputc('"', file);
+    for (const char* c = text ? text : ""; *c != '\0'; ++c)
+    {
+        const auto byte = static_cast<unsigned char>(*c);
+        if (byte == '"' || byte == '\\')
+        {
+            std::fputc('\\', file);
+            std::fputc(byte, file);
+        }
+        else if (byte < 0x20)
+        {
+            std::fprintf(file, "\\u%04x", byte);
+        }
+        else
+        {
+            std::fputc(byte, file);
+        }
+    }
+    std::fputc('"', file);
+}
+
+} // namespace
+
+std::uint64_t TraceNow()
+{
+    static const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+    return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - epoch).count());
+}
+
+void RecordTraceScope(const char* name, std::uint64_t start, std::uint64_t end)
+{
+    if (INSTRUMENTATION_ENABLED)
+    {
+        CurrentRing().Push(name, start, end - start, EventKind::Scope);
+    }
+}
+
+void AddTraceEvaluations(std::uint64_t count)
+{
+    if (INSTRUMENTATION_ENABLED)
+    {
+        const std::uint64_t total = Registry().evaluations.fetch_add(count, std::memory_order_relaxed) + count;
+        CurrentRing().Push("evaluations", TraceNow(), total, EventKind::Evaluations);
+    }
+}
+
+void MarkTraceInput()
+{
+    if (INSTRUMENTATION_ENABLED)
+    {
+        // Пачка вводов до одной отрисовки меряется от первого из них
+        std::uint64_t expected = 0;
+        Registry().pendingInput.compare_exchange_strong(expected, std::max<std::uint64_t>(TraceNow(), 1),
+            std::memory_order_relaxed);
+    }
+}
+
+void MarkTracePaint()
+{
+    if (!INSTRUMENTATION_ENABLED)
+    {
+        return;
+    }
+
+    TraceRegistry& registry = Registry();
+    const std::uint64_t input = registry.pendingInput.exchange(0, std::memory_order_relaxed);
+    if (input == 0)
+    {
+        return;
+    }
+
+    const std::uint64_t now = TraceNow();
+    registry.latency[LatencyBucket(now - input)].fetch_add(1, std::memory_order_relaxed);
+    RecordTraceScope("Input to paint", input, now);
+}
+
+void NameTraceThread(const char* name)
+{
+    if (INSTRUMENTATION_ENABLED)
+    {
+        CurrentRing().threadName.store(name, std::memory_order_relaxed);
+    }
+}
+
+TraceMetrics GetTraceMetrics()
+{
+    const TraceRegistry& registry = Registry();
+
+    TraceMetrics metrics;
+    for (std::size_t i = 0; i < LATENCY_BUCKETS; ++i)
+    {
+        metrics.latency[i] = registry.latency[i].load(std::memory_order_relaxed);
+    }
+    metrics.evaluations = registry.evaluations.load(std::memory_order_relaxed);
+    metrics.operations = registry.operations.load(std::memory_order_relaxed);
+    metrics.operationAllocations = registry.operationAllocations.load(std::memory_order_relaxed);
+    return metrics;
+}
+
+double GetLatencyPercentile(const TraceMetrics& metrics, double fraction)
+{
+    std::uint64_t total = 0;
+    for (const std::uint64_t count : metrics.latency)
+    {
+        total += count;
+    }
+    if (total == 0)
+    {
+        return 0.0;
+    }
+
+    const auto target = static_cast<std::uint64_t>(fraction * static_cast<double>(total - 1)) + 1;
+    std::uint64_t seen = 0;
+    std::size_t bucket = 0;
+    while (bucket + 1 < LATENCY_BUCKETS && (seen += metrics.latency[bucket]) < target)
+    {
+        ++bucket;
+    }
+    return static_cast<double>(std::uint64_t{ 2 } << bucket);
+}
+
+bool ExportChromeTrace(std::FILE* file)
+{
+    std::vector<TraceEvent> events;
+    std::vector<std::pair<std::uint32_t, const char*>> threads;
+    {
+        TraceRegistry& registry = Registry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (const auto& ring : registry.rings)
+        {
+            ring->Snapshot(events);
+            threads.emplace_back(ring->GetThread(), ring->threadName.load(std::memory_order_relaxed));
+        }
+    }
+
+    std::sort(events.begin(), events.end(), [](const TraceEvent& lhs, const TraceEvent& rhs)
+    {
+        return lhs.start < rhs.start;
+    });
+
+    // ts и dur в Chrome trace — микросекунды
+    std::fputs("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", file);
+    const char* separator = "\n";
+    for (const auto& [thread, name] : threads)
+    {
+        if (name)
+        {
+            std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":",
+                separator, static_cast<unsigned>(thread));
+            WriteJsonString(file, name);
+            std::fputs("}}", file);
+            separator = ",\n";
+        }
+    }
+
+    for (const TraceEvent& event : events)
+    {
+        std::fputs(separator, file);
+        separator = ",\n";
+
+        std::fputs("{\"name\":", file);
+        WriteJsonString(file, event.name);
+        const double start = static_cast<double>(event.start) / 1000.0;
+        if (event.kind == EventKind::Scope)
+        {
+            std::fprintf(file, ",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":1,\"tid\":%u}",
+                start, static_cast<double>(event.value) / 1000.0, static_cast<unsigned>(event.thread));
+        }
+        else
+        {
+            std::fprintf(file, ",\"ph\":\"C\",\"ts\":%.3f,\"pid\":1,\"tid\":%u,\"args\":{\"value\":%llu}}",
+                start, static_cast<unsigned>(event.thread), static_cast<unsigned long long>(event.value));
+        }
+    }
+    std::fputs("\n]}\n", file);
+
+    return std::ferror(file) == 0;
+}
+
+TraceOperation::TraceOperation(const char* name)
+    : m_scope(name)
+    , m_allocations(GetThreadAllocationCount())
+{
+}
+
+TraceOperation::~TraceOperation()
+{
+    if (INSTRUMENTATION_ENABLED)
+    {
+        TraceRegistry& registry = Registry();
+        registry.operations.fetch_add(1, std::memory_order_relaxed);
+        registry.operationAllocations.fetch_add(GetThreadAllocationCount() - m_allocations,
+            std::memory_order_relaxed);
+    }
+}
+
+} // namespace calc
@@ -0,0 +1,82 @@
+#include "engine/instrumentation.h"
+
+#include <cstdlib>
+#include <new>
+
+// Отдельная единица трансляции: замещённый operator new линкуется вместе
+// с GetThreadAllocationCount, а компилятор не видит new и free в одном месте
+
+namespace calc
+{
+
+namespace
+{
+
+// Выделения памяти текущим потоком — считает operator new ниже
+thread_local std::uint64_t t_allocations = 0;
+
+} // namespace
+
+std::uint64_t GetThreadAllocationCount()
+{
+    return t_allocations;
+}
+
+} // namespace calc
+
+#if CALC_INSTRUMENTATION
+
+//──────────────────────────────────────────────────────────────────────────────
+// 💾 Счёт выделений памяти: замещённые operator new/delete поверх malloc/free
+//──────────────────────────────────────────────────────────────────────────────
+
+void* operator new(std::size_t size)
+{
+    ++calc::t_allocations;
+    if (size == 0)
+    {
+        size = 1;
+    }
+
+    for (;;)
+    {
+        if (void* memory = std::malloc(size))
+        {
+            return memory;
+        }
+
+        const std::new_handler handler = std::get_new_handler();
+        if (!handler)
+        {
+            throw std::bad_alloc();
+        }
+        handler();
+    }
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete[](void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+#endif // CALC_INSTRUMENTATION
@@ -0,0 +1,58 @@
+#include "engine/integer_evaluator.h"
+
+#include <utility>
+
+namespace calc
+{
+
+IntegerEvaluator::IntegerEvaluator()
+    : m_lexer(std::string_view())
+    , m_hasAnswer(false)
+{
+}
+
+CalcError IntegerEvaluator::Evaluate(std::string_view text, BigInteger& result)
+{
+    m_lexer = Lexer(text);
+    BigInteger value = Run(text);
+
+    const CalcError error = GetError();
+    if (error == CalcError::None)
+    {
+        result = std::move(value);
+    }
+    return error;
+}
+
+BigInteger IntegerEvaluator::Number(const Token& token)
+{
+    // Литерал читается заново: значение лексера — double (длинный там ∞)
+    BigInteger number;
+    if (token.length == 0 || !number.Parse(m_text.substr(token.position, token.length)))
+    {
+        MathError(CalcError::InvalidNumber);  // "1.5", "2e3" — не целые литералы
+    }
+    return number;
+}
+
+BigInteger IntegerEvaluator::Identifier(const Token& token)
+{
+    if (m_hasAnswer && m_text.substr(token.position, token.length) == "ans")
+    {
+        return m_answer;
+    }
+    MathError(CalcError::UnknownVariable);
+    return BigInteger();
+}
+
+CalcError IntegerEvaluator::Apply(Operator op, BigInteger& lhs, const BigInteger& rhs)
+{
+    return BigInteger::Apply(op, lhs, rhs, lhs);
+}
+
+CalcError IntegerEvaluator::Postfix(Operator, BigInteger& operand)
+{
+    return BigInteger::Factorial(operand, operand);
+}
+
+} // namespace calc
@@ -0,0 +1,80 @@
+#include "engine/job_service.h"
+#include "engine/instrumentation.h"
+
+#include <algorithm>
+#include <utility>
+
+namespace calc
+{
+
+namespace
+{
+
+// Задача, которую выполняет текущий поток (nullptr вне JobService)
+thread_local JobContext* t_currentJob = nullptr;
+
+} // namespace
+
+bool IsJobCancelled()
+{
+    return t_currentJob && t_currentJob->IsCancelled();
+}
+
+void ReportJobProgress(double fraction)
+{
+    if (t_currentJob)
+    {
+        t_currentJob->SetProgress(fraction);
+    }
+}
+
+JobService::JobService(unsigned threadCount)
+    : m_pool(threadCount == 0 ? ThreadPool::DefaultThreadCount() : threadCount)
+{
+}
+
+JobService::~JobService()
+{
+    CancelAll();
+    m_pool.WaitIdle();
+}
+
+std::shared_ptr<JobContext> JobService::Submit(Work work)
+{
+    auto job = std::make_shared<JobContext>();
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_jobs.erase(std::remove_if(m_jobs.begin(), m_jobs.end(),
+            [](const std::weak_ptr<JobContext>& entry)
+            {
+                const std::shared_ptr<JobContext> alive = entry.lock();
+                return !alive || alive->IsFinished();
+            }), m_jobs.end());
+        m_jobs.push_back(job);
+    }
+
+    m_pool.Submit([job, work = std::move(work)]()
+    {
+        CALC_TRACE_SCOPE("JobService job");
+        t_currentJob = job.get();
+        work(*job);
+        t_currentJob = nullptr;
+        job->m_finished.store(true, std::memory_order_release);
+    });
+    return job;
+}
+
+void JobService::CancelAll()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const std::weak_ptr<JobContext>& entry : m_jobs)
+    {
+        if (const std::shared_ptr<JobContext> job = entry.lock())
+        {
+            job->Cancel();
+        }
+    }
+}
+
+} // namespace calc
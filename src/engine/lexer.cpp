@@ -0,0 +1,315 @@
+#include "engine/lexer.h"
+#include "engine/job_service.h"
+#include "engine/operators.h"
+
+#include <algorithm>
+#include <charconv>
+#include <limits>
+
+namespace calc
+{
+
+namespace
+{
+
+bool IsDigit(char c)
+{
+    return c >= '0' && c <= '9';
+}
+
+bool IsIdentifierStart(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+}
+
+bool IsIdentifierChar(char c)
+{
+    return IsIdentifierStart(c) || IsDigit(c);
+}
+
+// Литерал вне диапазона double: порядок старшей цифры ≥ 0 — переполнение, иначе исчезновение порядка
+bool IsAboveOne(std::string_view literal)
+{
+    long long magnitude = 0;
+    bool significant = false;
+    std::size_t i = 0;
+    for (; i < literal.size() && IsDigit(literal[i]); ++i)
+    {
+        magnitude += significant;
+        significant = significant || literal[i] != '0';
+    }
+    if (i < literal.size() && literal[i] == '.')
+    {
+        for (++i; i < literal.size() && IsDigit(literal[i]); ++i)
+        {
+            magnitude -= !significant;
+            significant = significant || literal[i] != '0';
+        }
+    }
+
+    if (i < literal.size() && (literal[i] == 'e' || literal[i] == 'E'))
+    {
+        ++i;
+        const bool negative = i < literal.size() && literal[i] == '-';
+        i += i < literal.size() && (literal[i] == '-' || literal[i] == '+');
+
+        // Порядок насыщается: дальше миллиарда знак суммы уже не меняется
+        long long exponent = 0;
+        for (; i < literal.size() && IsDigit(literal[i]); ++i)
+        {
+            exponent = std::min(exponent * 10 + (literal[i] - '0'), 1000000000LL);
+        }
+        magnitude += negative ? -exponent : exponent;
+    }
+    return magnitude >= 0;
+}
+
+bool IsSpace(char c)
+{
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+} // namespace
+
+Lexer::Lexer(std::string_view text)
+    : m_text(text)
+    , m_position(0)
+{
+}
+
+Token Lexer::Next()
+{
+    while (m_position < m_text.size() && IsSpace(m_text[m_position]))
+    {
+        ++m_position;
+    }
+
+    Token token;
+    token.position = static_cast<std::uint32_t>(m_position);
+
+    if (m_position >= m_text.size())
+    {
+        token.type = TokenType::End;
+        return token;
+    }
+
+    const char c = m_text[m_position];
+    if (IsDigit(c) || c == '.')
+    {
+        return LexNumber();
+    }
+
+    if (IsIdentifierStart(c))
+    {
+        return LexIdentifier();
+    }
+
+    token.type = TokenType::Operator;
+    token.length = 1;
+    ++m_position;
+
+    switch (c)
+    {
+    case '(': token.type = TokenType::LeftParen; return token;
+    case ')': token.type = TokenType::RightParen; return token;
+    default: break;
+    }
+
+    token.op = OperatorFromSymbol(c);
+    if (token.op != Operator::None)
+    {
+        return token;
+    }
+
+    // Многобайтные подписи клавиш ("×", "÷") из реестра операторов
+    std::size_t length = 0;
+    token.op = OperatorFromLabel(m_text.substr(m_position - 1), length);
+    if (token.op != Operator::None)
+    {
+        m_position += length - 1;
+        token.length = static_cast<std::uint32_t>(length);
+        return token;
+    }
+
+    token.type = TokenType::Invalid;
+    return token;
+}
+
+Token Lexer::LexNumber()
+{
+    Token token;
+    token.type = TokenType::Number;
+    token.position = static_cast<std::uint32_t>(m_position);
+
+    const std::size_t start = m_position;
+    bool hasDigits = false;
+    bool hasExponent = false;
+
+    // Мантисса и число дробных цифр для быстрого пути Клингера
+    std::uint64_t mantissa = 0;
+    int significantDigits = 0;
+    int fractionDigits = 0;
+
+    while (m_position < m_text.size() && IsDigit(m_text[m_position]))
+    {
+        mantissa = mantissa * 10 + static_cast<std::uint64_t>(m_text[m_position] - '0');
+        significantDigits += (mantissa != 0);
+        ++m_position;
+        hasDigits = true;
+    }
+
+    if (m_position < m_text.size() && m_text[m_position] == '.')
+    {
+        ++m_position;
+        while (m_position < m_text.size() && IsDigit(m_text[m_position]))
+        {
+            mantissa = mantissa * 10 + static_cast<std::uint64_t>(m_text[m_position] - '0');
+            significantDigits += (mantissa != 0);
+            ++fractionDigits;
+            ++m_position;
+            hasDigits = true;
+        }
+    }
+
+    if (hasDigits && m_position < m_text.size()
+        && (m_text[m_position] == 'e' || m_text[m_position] == 'E'))
+    {
+        std::size_t exponent = m_position + 1;
+        if (exponent < m_text.size() && (m_text[exponent] == '+' || m_text[exponent] == '-'))
+        {
+            ++exponent;
+        }
+
+        if (exponent < m_text.size() && IsDigit(m_text[exponent]))
+        {
+            hasExponent = true;
+            m_position = exponent;
+            while (m_position < m_text.size() && IsDigit(m_text[m_position]))
+            {
+                ++m_position;
+            }
+        }
+    }
+
+    if (!hasDigits)
+    {
+        token.type = TokenType::Invalid;
+        return token;
+    }
+
+    token.length = static_cast<std::uint32_t>(m_position - start);
+
+    // Не более 15 значащих цифр и 10^k ≤ 10^22: оба операнда точны,
+    // единственное деление даёт корректно округлённый результат
+    if (!hasExponent && significantDigits <= 15 && fractionDigits <= 22)
+    {
+        static constexpr double POWERS_OF_TEN[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+        token.number = static_cast<double>(mantissa) / POWERS_OF_TEN[fractionDigits];
+        return token;
+    }
+
+    const char* first = m_text.data() + start;
+    const char* last = m_text.data() + m_position;
+    const auto [end, error] = std::from_chars(first, last, token.number);
+    if (error == std::errc::result_out_of_range && end == last)
+    {
+        // Запись верна, значение — нет: ∞ вычислители отвергают как Overflow,
+        // исчезающе малое округляется к нулю, как у strtod
+        token.number = IsAboveOne(std::string_view(first, token.length))
+            ? std::numeric_limits<double>::infinity() : 0.0;
+    }
+    else if (error != std::errc() || end != last)
+    {
+        token.type = TokenType::Invalid;
+    }
+
+    return token;
+}
+
+Token Lexer::LexIdentifier()
+{
+    Token token;
+    token.type = TokenType::Identifier;
+    token.position = static_cast<std::uint32_t>(m_position);
+
+    while (m_position < m_text.size() && IsIdentifierChar(m_text[m_position]))
+    {
+        ++m_position;
+    }
+
+    token.length = static_cast<std::uint32_t>(m_position - token.position);
+
+    // Имя функции из реестра — оператор, а не переменная
+    token.op = FunctionFromName(m_text.substr(token.position, token.length));
+    if (token.op != Operator::None)
+    {
+        token.type = TokenType::Operator;
+    }
+    return token;
+}
+
+CalcError Lexer::Tokenize(std::string_view text, std::vector<Token>& tokens,
+    std::size_t* errorPosition)
+{
+    Lexer lexer(text);
+    tokens.clear();
+
+    for (;;)
+    {
+        const Token token = lexer.Next();
+        if (token.type == TokenType::Invalid)
+        {
+            if (errorPosition)
+            {
+                *errorPosition = token.position;
+            }
+            return CalcError::SyntaxError;
+        }
+
+        tokens.push_back(token);
+        if (token.type == TokenType::End)
+        {
+            return CalcError::None;
+        }
+
+        // Мегабайтная вставка с именами идёт через токены: отмена и прогресс по пути
+        if (tokens.size() % PROGRESS_TOKENS == 0)
+        {
+            if (IsJobCancelled())
+            {
+                if (errorPosition)
+                {
+                    *errorPosition = token.position;
+                }
+                return CalcError::Cancelled;
+            }
+            ReportJobProgress(static_cast<double>(token.position) / static_cast<double>(text.size()));
+        }
+    }
+}
+
+bool Lexer::SplitAssignment(std::string_view text, std::string_view& name, std::string_view& value)
+{
+    const std::size_t equals = text.find('=');
+    if (equals == std::string_view::npos)
+    {
+        return false;
+    }
+
+    // Слева — ровно одно имя (не функция и не число)
+    Lexer lexer(text.substr(0, equals));
+    const Token target = lexer.Next();
+    if (target.type != TokenType::Identifier || lexer.Next().type != TokenType::End)
+    {
+        return false;
+    }
+
+    name = text.substr(target.position, target.length);
+    value = text.substr(equals + 1);
+    return true;
+}
+
+} // namespace calc
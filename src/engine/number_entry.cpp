@@ -0,0 +1,363 @@
+#include "engine/number_entry.h"
+#include "engine/calculator.h"
+
+#include <charconv>
+#include <cmath>
+#include <system_error>
+
+namespace calc
+{
+
+NumberEntry::NumberEntry()
+    : m_digits{}
+    , m_exponent{}
+    , m_digitCount(0)
+    , m_pointPosition(NO_POINT)
+    , m_exponentLength(0)
+    , m_stage(Stage::Integer)
+    , m_negative(false)
+    , m_exponentNegative(false)
+    , m_value(0.0)
+    , m_format(NumberFormat::Compact)
+{
+    Clear();
+}
+
+void NumberEntry::Clear()
+{
+    m_digits[0] = '0';
+    m_digitCount = 1;
+    m_pointPosition = NO_POINT;
+    m_exponentLength = 0;
+    m_stage = Stage::Integer;
+    m_negative = false;
+    m_exponentNegative = false;
+    m_value = 0.0;
+}
+
+bool NumberEntry::AppendDigit(char digit)
+{
+    if (digit < '0' || digit > '9' || !Materialize())
+    {
+        return false;
+    }
+
+    if (m_stage == Stage::Exponent)
+    {
+        if (m_exponentLength == 1 && m_exponent[0] == '0')
+        {
+            m_exponentLength = 0;
+        }
+        if (m_exponentLength >= MAX_EXPONENT_DIGITS)
+        {
+            return false;
+        }
+        m_exponent[m_exponentLength++] = digit;
+        return true;
+    }
+
+    // Ведущий ноль заменяется, а не дописывается
+    if (IsZero())
+    {
+        m_digits[0] = digit;
+        return true;
+    }
+
+    if (m_digitCount >= MAX_MANTISSA_DIGITS)
+    {
+        return false;
+    }
+
+    m_digits[m_digitCount++] = digit;
+    return true;
+}
+
+bool NumberEntry::AppendDecimalPoint()
+{
+    if (!Materialize() || m_stage != Stage::Integer)
+    {
+        return false;
+    }
+
+    m_pointPosition = m_digitCount;
+    m_stage = Stage::Fraction;
+    return true;
+}
+
+bool NumberEntry::BeginExponent()
+{
+    if (!Materialize() || m_stage == Stage::Exponent)
+    {
+        return false;
+    }
+
+    m_stage = Stage::Exponent;
+    m_exponentNegative = false;
+    m_exponentLength = 0;
+    return true;
+}
+
+bool NumberEntry::ToggleExponentSign()
+{
+    if (m_stage != Stage::Exponent)
+    {
+        return false;
+    }
+
+    m_exponentNegative = !m_exponentNegative;
+    return true;
+}
+
+bool NumberEntry::Backspace()
+{
+    if (!Materialize())
+    {
+        Clear();
+        return true;
+    }
+
+    if (m_stage == Stage::Exponent)
+    {
+        if (m_exponentLength != 0)
+        {
+            --m_exponentLength;
+        }
+        else if (m_exponentNegative)
+        {
+            m_exponentNegative = false;
+        }
+        else
+        {
+            m_stage = MantissaStage();
+        }
+        return true;
+    }
+
+    if (m_digitCount + (HasDecimalPoint() ? 1 : 0) <= 1)
+    {
+        Clear();
+        return true;
+    }
+
+    // Последний символ мантиссы — точка или цифра
+    if (m_pointPosition == m_digitCount)
+    {
+        m_pointPosition = NO_POINT;
+        m_stage = Stage::Integer;
+    }
+    else
+    {
+        --m_digitCount;
+    }
+
+    if (IsZero())
+    {
+        m_negative = false;
+    }
+    return true;
+}
+
+void NumberEntry::SetValue(double value)
+{
+    Clear();
+    m_stage = Stage::Value;
+    m_value = value;
+}
+
+bool NumberEntry::GetValue(double& value) const
+{
+    if (m_stage == Stage::Value)
+    {
+        value = m_value;
+        return true;
+    }
+
+    char buffer[MAX_TEXT_LENGTH];
+    const std::size_t length = GetText(buffer, sizeof(buffer));
+
+    double parsed = 0.0;
+    const auto [end, error] = std::from_chars(buffer, buffer + length, parsed);
+    if (error != std::errc() || end != buffer + length)
+    {
+        return false;
+    }
+
+    value = parsed;
+    return true;
+}
+
+bool NumberEntry::Assign(std::string_view text)
+{
+    const char* p = text.data();
+    const char* end = text.data() + text.size();
+
+    Clear();
+
+    // Лимит — длина текста: у "0.0000001…" ведущие нули не значащие
+    if (text.size() >= MAX_TEXT_LENGTH)
+    {
+        return false;
+    }
+
+    if (p != end && *p == '-')
+    {
+        m_negative = true;
+        ++p;
+    }
+
+    m_digitCount = 0;
+    for (; p != end && *p != 'e' && *p != 'E'; ++p)
+    {
+        if (*p == '.' && !HasDecimalPoint())
+        {
+            m_pointPosition = m_digitCount;
+        }
+        else if (*p >= '0' && *p <= '9')
+        {
+            m_digits[m_digitCount++] = *p;
+        }
+        else
+        {
+            Clear();
+            return false;
+        }
+    }
+    m_stage = MantissaStage();
+
+    if (p != end)
+    {
+        m_stage = Stage::Exponent;
+        for (++p; p != end; ++p)
+        {
+            if (*p == '-')
+            {
+                m_exponentNegative = true;
+            }
+            else if (*p >= '0' && *p <= '9' && m_exponentLength < MAX_EXPONENT_DIGITS)
+            {
+                m_exponent[m_exponentLength++] = *p;
+            }
+            else if (*p != '+')
+            {
+                Clear();
+                return false;
+            }
+        }
+    }
+
+    if (m_digitCount == 0)
+    {
+        Clear();
+        return false;
+    }
+
+    return true;
+}
+
+std::size_t NumberEntry::GetText(char* buffer, std::size_t size) const
+{
+    if (m_stage == Stage::Value)
+    {
+        return Calculator::FormatNumber(m_value, buffer, size, NumberFormat::Full);
+    }
+
+    std::size_t length = WriteText(buffer, size);
+
+    // Незаконченный порядок ("1e", "1e-") считается нулевым
+    if (m_stage == Stage::Exponent && m_exponentLength == 0)
+    {
+        length -= m_exponentNegative ? 2 : 1;
+        buffer[length] = '\0';
+    }
+    return length;
+}
+
+std::size_t NumberEntry::Format(char* buffer, std::size_t size) const
+{
+    if (m_stage == Stage::Value)
+    {
+        return Calculator::FormatNumber(m_value, buffer, size, m_format);
+    }
+
+    return WriteText(buffer, size);
+}
+
+bool NumberEntry::Materialize()
+{
+    if (m_stage != Stage::Value)
+    {
+        return true;
+    }
+
+    // Редактировать результат можно только в том виде, в каком он на дисплее
+    char buffer[MAX_TEXT_LENGTH];
+    const std::size_t length = Calculator::FormatNumber(m_value, buffer, sizeof(buffer), m_format);
+    if (!std::isfinite(m_value) || length == 0)
+    {
+        return false;
+    }
+
+    return Assign(std::string_view(buffer, length));
+}
+
+bool NumberEntry::IsZero() const
+{
+    return m_digitCount == 1 && m_digits[0] == '0' && !HasDecimalPoint();
+}
+
+NumberEntry::Stage NumberEntry::MantissaStage() const
+{
+    return HasDecimalPoint() ? Stage::Fraction : Stage::Integer;
+}
+
+std::size_t NumberEntry::WriteText(char* buffer, std::size_t size) const
+{
+    if (size == 0)
+    {
+        return 0;
+    }
+
+    std::size_t length = 0;
+    const auto put = [&](char c)
+    {
+        if (length + 1 < size)
+        {
+            buffer[length++] = c;
+        }
+    };
+
+    if (m_negative)
+    {
+        put('-');
+    }
+    for (std::size_t i = 0; i < m_digitCount; ++i)
+    {
+        if (i == m_pointPosition)
+        {
+            put('.');
+        }
+        put(m_digits[i]);
+    }
+    if (m_pointPosition == m_digitCount)
+    {
+        put('.');
+    }
+
+    if (m_stage == Stage::Exponent)
+    {
+        put('e');
+        if (m_exponentNegative)
+        {
+            put('-');
+        }
+        for (std::size_t i = 0; i < m_exponentLength; ++i)
+        {
+            put(m_exponent[i]);
+        }
+    }
+
+    buffer[length] = '\0';
+    return length;
+}
+
+} // namespace calc
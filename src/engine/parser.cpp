@@ -0,0 +1,82 @@
+#include "engine/parser.h"
+
+#include <cmath>
+
+namespace calc
+{
+
+Parser::Parser(const Token* tokens, std::size_t count, Arena& arena, std::string_view source)
+    : m_tokens(tokens)
+    , m_source(source)
+    , m_count(count)
+    , m_index(0)
+    , m_arena(arena)
+{
+}
+
+ParseResult Parser::Parse()
+{
+    if (m_count == 0 || m_tokens[m_count - 1].type != TokenType::End)
+    {
+        return ParseResult{ nullptr, CalcError::SyntaxError, 0 };
+    }
+
+    const Node* root = Run(m_source);
+    const CalcError error = GetError();
+    if (error != CalcError::None)
+    {
+        return ParseResult{ nullptr, error, GetErrorPosition() };
+    }
+
+    return ParseResult{ root, CalcError::None, 0 };
+}
+
+Token Parser::NextToken()
+{
+    const Token& token = m_tokens[m_index];
+    if (token.type != TokenType::End)
+    {
+        ++m_index;
+    }
+    return token;
+}
+
+const Node* Parser::Number(const Token& token)
+{
+    if (std::isinf(token.number))
+    {
+        return Fail(CalcError::Overflow, token.position);  // Литерал больше DBL_MAX
+    }
+    return m_arena.Make<Node>(NodeKind::Number, Operator::None, token.number,
+        std::string_view(), nullptr, nullptr);
+}
+
+const Node* Parser::Identifier(const Token& token)
+{
+    if (token.position + token.length > m_source.size())
+    {
+        return Fail(CalcError::SyntaxError, token.position);
+    }
+    return m_arena.Make<Node>(NodeKind::Variable, Operator::None, 0.0,
+        m_source.substr(token.position, token.length), nullptr, nullptr);
+}
+
+CalcError Parser::Apply(Operator op, const Node*& lhs, const Node* rhs)
+{
+    lhs = m_arena.Make<Node>(NodeKind::Binary, op, 0.0, std::string_view(), lhs, rhs);
+    return CalcError::None;
+}
+
+CalcError Parser::Function(Operator op, const Node*& argument)
+{
+    argument = m_arena.Make<Node>(NodeKind::Call, op, 0.0, std::string_view(), argument, nullptr);
+    return CalcError::None;
+}
+
+void Parser::Negate(const Node*& operand)
+{
+    operand = m_arena.Make<Node>(NodeKind::Negate, Operator::None, 0.0,
+        std::string_view(), operand, nullptr);
+}
+
+} // namespace calc
@@ -0,0 +1,281 @@
+#include "engine/result_cache.h"
+#include "engine/lexer.h"
+#include "engine/session_file.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <utility>
+
+namespace calc
+{
+
+namespace
+{
+
+constexpr std::uint32_t FILE_MAGIC = 0x48434352u;   // "RCCH"
+
+} // namespace
+
+ResultCache::ResultCache(std::size_t capacity, std::size_t byteBudget)
+    : m_entries(std::max<std::size_t>(capacity, 2))
+    , m_byteBudget(byteBudget)
+{
+    m_index.reserve(m_entries.size());
+}
+
+bool ResultCache::MakeKey(std::string_view text, NumberMode mode, std::uint32_t precision, std::string& key)
+{
+    key.clear();
+    key.push_back(static_cast<char>(mode));
+    key.append(reinterpret_cast<const char*>(&precision), sizeof(precision));
+
+    // Пробелы, переносы и запись функций (√ или sqrt) в ключ не попадают — только лексемы
+    Lexer lexer(text);
+    for (;;)
+    {
+        const Token token = lexer.Next();
+        if (token.type == TokenType::End)
+        {
+            return true;
+        }
+        if (token.type == TokenType::Identifier || token.type == TokenType::Invalid)
+        {
+            return false;
+        }
+
+        key.push_back(static_cast<char>(token.type));
+        if (token.type == TokenType::Operator)
+        {
+            key.push_back(static_cast<char>(token.op));
+        }
+        else if (token.type == TokenType::Number)
+        {
+            // Текст, а не double: в десятичном и целом режимах важна каждая цифра
+            key.append(text.data() + token.position, token.length);
+            key.push_back(' ');
+        }
+
+        if (key.size() > MAX_KEY_LENGTH)
+        {
+            return false;
+        }
+    }
+}
+
+bool ResultCache::Find(std::string_view key, CachedResult& result)
+{
+    const std::uint64_t hash = Hash(key);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    const auto found = m_index.find(hash);
+    if (found == m_index.end() || m_entries[found->second].key != key)
+    {
+        ++m_misses;
+        return false;
+    }
+
+    Entry& entry = m_entries[found->second];
+    entry.referenced = true;
+    result = entry.result;
+    ++m_hits;
+    return true;
+}
+
+void ResultCache::Insert(std::string_view key, CachedResult result)
+{
+    const std::uint64_t hash = Hash(key);
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    InsertLocked(key, hash, std::move(result));
+}
+
+void ResultCache::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (Entry& entry : m_entries)
+    {
+        entry = Entry{};
+    }
+    m_index.clear();
+    m_hand = 0;
+    m_count = 0;
+    m_bytes = 0;
+    m_hits = 0;
+    m_misses = 0;
+}
+
+ResultCacheStats ResultCache::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ResultCacheStats stats;
+    stats.hits = m_hits;
+    stats.misses = m_misses;
+    stats.entries = m_count;
+    stats.bytes = m_bytes;
+    return stats;
+}
+
+bool ResultCache::Save(const std::string& path) const
+{
+    SessionWriter writer;
+    writer.Write(FILE_MAGIC);
+    writer.Write(FILE_VERSION);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        writer.Write(static_cast<std::uint32_t>(m_count));
+        for (const Entry& entry : m_entries)
+        {
+            if (!entry.used)
+            {
+                continue;
+            }
+            writer.WriteString(entry.key);
+            writer.Write(entry.result.value);
+            writer.WriteString(entry.result.text);
+            entry.result.integer.Write(writer);
+        }
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file)
+    {
+        return false;
+    }
+
+    const std::string& data = writer.GetData();
+    const bool written = std::fwrite(data.data(), 1, data.size(), file) == data.size();
+    const bool closed = std::fclose(file) == 0;
+    return written && closed;
+}
+
+bool ResultCache::Load(const std::string& path)
+{
+    Clear();
+
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    if (!file)
+    {
+        return false;
+    }
+
+    std::string data;
+    char buffer[65536];
+    std::size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) != 0)
+    {
+        data.append(buffer, read);
+    }
+    std::fclose(file);
+
+    SessionReader reader(data);
+    std::uint32_t magic = 0;
+    std::uint32_t version = 0;
+    std::uint32_t count = 0;
+    if (!reader.Read(magic) || !reader.Read(version) || !reader.Read(count)
+        || magic != FILE_MAGIC || version != FILE_VERSION)
+    {
+        return false;
+    }
+
+    std::string key;
+    CachedResult result;
+    for (std::uint32_t i = 0; i < count; ++i)
+    {
+        if (!reader.ReadString(key) || !reader.Read(result.value) || !reader.ReadString(result.text)
+            || !result.integer.Read(reader))
+        {
+            Clear();
+            return false;
+        }
+        Insert(key, std::move(result));
+    }
+    return true;
+}
+
+std::uint64_t ResultCache::Hash(std::string_view key)
+{
+    // FNV-1a, 64 бита: ключи короткие, коллизию всё равно отсекает сверка ключа
+    std::uint64_t hash = 14695981039346656037ull;
+    for (const char c : key)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+void ResultCache::InsertLocked(std::string_view key, std::uint64_t hash, CachedResult&& result)
+{
+    const std::size_t bytes = sizeof(Entry) + key.size() + result.text.size()
+        + static_cast<std::size_t>(result.integer.GetBitLength() / 8);
+    if (bytes > m_byteBudget / 4)
+    {
+        return;
+    }
+
+    // Тот же хеш — та же ячейка: при коллизии новая запись заменяет старую
+    const auto found = m_index.find(hash);
+    const std::size_t slot = found != m_index.end() ? found->second : TakeSlot(m_entries.size());
+    if (m_entries[slot].used)
+    {
+        Release(slot);
+    }
+
+    Entry& entry = m_entries[slot];
+    entry.key.assign(key.data(), key.size());
+    entry.hash = hash;
+    entry.result = std::move(result);
+    entry.bytes = bytes;
+    entry.used = true;
+    entry.referenced = false;
+    m_index.emplace(hash, static_cast<std::uint32_t>(slot));
+    ++m_count;
+    m_bytes += bytes;
+
+    while (m_bytes > m_byteBudget)
+    {
+        TakeSlot(slot);
+    }
+}
+
+std::size_t ResultCache::TakeSlot(std::size_t keep)
+{
+    // Стрелка снимает биты обращения; запись без бита — жертва
+    for (;;)
+    {
+        const std::size_t slot = m_hand;
+        m_hand = (m_hand + 1) % m_entries.size();
+
+        Entry& entry = m_entries[slot];
+        if (slot == keep)
+        {
+            continue;
+        }
+        if (!entry.used)
+        {
+            return slot;
+        }
+        if (entry.referenced)
+        {
+            entry.referenced = false;
+            continue;
+        }
+
+        Release(slot);
+        return slot;
+    }
+}
+
+void ResultCache::Release(std::size_t slot)
+{
+    Entry& entry = m_entries[slot];
+    m_index.erase(entry.hash);
+    m_bytes -= entry.bytes;
+    --m_count;
+
+    // Память огромного результата отдаётся сразу, а не при следующей записи в ячейку
+    entry = Entry{};
+}
+
+} // namespace calc
@@ -0,0 +1,445 @@
+#include "engine/session_file.h"
+
+#include <algorithm>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace calc
+{
+
+namespace
+{
+
+constexpr char MAGIC[8] = { 'C', 'A', 'L', 'C', 'S', 'E', 'S', 'S' };
+constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+// Начало файла
+struct FileHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;        // Файл с другим порядком байт не читается
+    std::uint64_t headerSize;
+    std::uint64_t blockSize;
+};
+
+// Начало слота состояния сеанса; данные идут сразу за ним
+struct SlotHeader
+{
+    std::uint64_t sequence;         // 0 — слот ни разу не записан
+    std::uint32_t length;
+    std::uint32_t checksum;
+};
+
+static_assert(sizeof(SlotHeader) == SessionFile::SESSION_SLOT_SIZE - SessionFile::SESSION_CAPACITY,
+    "Slot header must match SESSION_CAPACITY");
+static_assert(SessionFile::SESSION_SLOT_OFFSET + 2 * SessionFile::SESSION_SLOT_SIZE <= SessionFile::HEADER_SIZE,
+    "Both session slots must fit in the header");
+
+// FNV-1a: оборванная запись слота не должна сойти за целую
+std::uint32_t Checksum(const char* data, std::size_t length)
+{
+    std::uint32_t hash = 2166136261u;
+    for (std::size_t i = 0; i < length; ++i)
+    {
+        hash ^= static_cast<unsigned char>(data[i]);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+// Слот записан целиком: есть поколение и сходится контрольная сумма
+bool ReadSlot(const char* base, SlotHeader& header)
+{
+    std::memcpy(&header, base, sizeof(header));
+    return header.sequence != 0 && header.length <= SessionFile::SESSION_CAPACITY
+        && Checksum(base + sizeof(SlotHeader), header.length) == header.checksum;
+}
+
+} // namespace
+
+SessionFile::~SessionFile()
+{
+    Close();
+}
+
+SessionFile::OpenStatus SessionFile::Open(const std::string& path)
+{
+    Close();
+
+    std::uint64_t size = 0;
+
+#ifdef _WIN32
+    // Без совместного доступа: второй экземпляр получит ERROR_SHARING_VIOLATION
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ | GENERIC_WRITE, 0, nullptr,
+        OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        return GetLastError() == ERROR_SHARING_VIOLATION ? OpenStatus::Locked : OpenStatus::Failed;
+    }
+    m_file = file;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize))
+    {
+        Close();
+        return OpenStatus::Failed;
+    }
+    size = static_cast<std::uint64_t>(fileSize.QuadPart);
+#else
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (m_fd < 0)
+    {
+        return OpenStatus::Failed;
+    }
+
+    if (::flock(m_fd, LOCK_EX | LOCK_NB) != 0)
+    {
+        Close();
+        return OpenStatus::Locked;
+    }
+
+    struct stat info;
+    if (::fstat(m_fd, &info) != 0)
+    {
+        Close();
+        return OpenStatus::Failed;
+    }
+    size = static_cast<std::uint64_t>(info.st_size);
+#endif
+
+    bool valid = size >= HEADER_SIZE;
+    if (valid)
+    {
+        m_header = MapRange(0, HEADER_SIZE);
+        if (!m_header)
+        {
+            Close();
+            return OpenStatus::Failed;
+        }
+
+        FileHeader header;
+        std::memcpy(&header, m_header, sizeof(header));
+        valid = std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) == 0;
+
+        if (valid && (header.version > VERSION || header.byteOrder != BYTE_ORDER_MARK
+            || header.headerSize != HEADER_SIZE || header.blockSize != BLOCK_SIZE))
+        {
+            // Файл записан другой сборкой — не портим его
+            Close();
+            return OpenStatus::Incompatible;
+        }
+    }
+
+    if (!valid)
+    {
+        // Пустой или не наш файл — начинаем заново
+        if (m_header)
+        {
+            Unmap(m_header, HEADER_SIZE);
+            m_header = nullptr;
+        }
+        if (!Resize(HEADER_SIZE) || !(m_header = MapRange(0, HEADER_SIZE)))
+        {
+            Close();
+            return OpenStatus::Failed;
+        }
+        InitializeHeader();
+        m_dirtyFrom = 0;
+        return Flush() ? OpenStatus::Created : OpenStatus::Failed;
+    }
+
+    // Хвост неполного блока — след оборванного роста файла, он не нужен
+    const std::size_t blockCount = static_cast<std::size_t>((size - HEADER_SIZE) / BLOCK_SIZE);
+    if ((size - HEADER_SIZE) % BLOCK_SIZE != 0 && !Resize(HEADER_SIZE + blockCount * BLOCK_SIZE))
+    {
+        Close();
+        return OpenStatus::Failed;
+    }
+
+    m_blocks.reserve(blockCount);
+    for (std::size_t i = 0; i < blockCount; ++i)
+    {
+        char* block = MapRange(HEADER_SIZE + i * BLOCK_SIZE, BLOCK_SIZE);
+        if (!block)
+        {
+            Close();
+            return OpenStatus::Failed;
+        }
+        m_blocks.push_back(block);
+    }
+
+    m_dirtyFrom = m_blocks.size();
+    m_headerDirty = false;
+    return OpenStatus::Opened;
+}
+
+void SessionFile::Close()
+{
+    if (m_header)
+    {
+        Flush();
+    }
+
+    for (char* block : m_blocks)
+    {
+        Unmap(block, BLOCK_SIZE);
+    }
+    m_blocks.clear();
+
+    if (m_header)
+    {
+        Unmap(m_header, HEADER_SIZE);
+        m_header = nullptr;
+    }
+
+#ifdef _WIN32
+    if (m_file)
+    {
+        CloseHandle(static_cast<HANDLE>(m_file));
+        m_file = nullptr;
+    }
+#else
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);  // Блокировка снимается вместе с дескриптором
+        m_fd = -1;
+    }
+#endif
+
+    m_dirtyFrom = 0;
+    m_headerDirty = false;
+}
+
+char* SessionFile::AppendBlock()
+{
+    if (!m_header)
+    {
+        return nullptr;
+    }
+
+    const std::size_t offset = HEADER_SIZE + m_blocks.size() * BLOCK_SIZE;
+    if (!Resize(offset + BLOCK_SIZE))
+    {
+        return nullptr;
+    }
+
+    char* block = MapRange(offset, BLOCK_SIZE);
+    if (!block)
+    {
+        Resize(offset);
+        return nullptr;
+    }
+
+    m_blocks.push_back(block);
+    m_dirtyFrom = std::min(m_dirtyFrom, m_blocks.size() - 1);
+    return block;
+}
+
+void SessionFile::MarkBlockDirty(std::size_t index)
+{
+    m_dirtyFrom = std::min(m_dirtyFrom, index);
+}
+
+bool SessionFile::RemoveBlocks()
+{
+    if (!m_header)
+    {
+        return false;
+    }
+
+    for (char* block : m_blocks)
+    {
+        Unmap(block, BLOCK_SIZE);
+    }
+    m_blocks.clear();
+    m_dirtyFrom = 0;
+    return Resize(HEADER_SIZE);
+}
+
+std::string_view SessionFile::ReadSession() const
+{
+    const int slot = FindIntactSlot();
+    if (slot < 0)
+    {
+        return std::string_view();
+    }
+
+    const char* base = m_header + SESSION_SLOT_OFFSET + static_cast<std::size_t>(slot) * SESSION_SLOT_SIZE;
+    SlotHeader header;
+    std::memcpy(&header, base, sizeof(header));
+    return std::string_view(base + sizeof(SlotHeader), header.length);
+}
+
+bool SessionFile::WriteSession(std::string_view state)
+{
+    if (!m_header || state.size() > SESSION_CAPACITY)
+    {
+        return false;
+    }
+
+    SlotHeader slots[2];
+    std::memcpy(&slots[0], m_header + SESSION_SLOT_OFFSET, sizeof(SlotHeader));
+    std::memcpy(&slots[1], m_header + SESSION_SLOT_OFFSET + SESSION_SLOT_SIZE, sizeof(SlotHeader));
+
+    // Пишем мимо последнего целого слота (а не мимо большего номера: слот с ним
+    // мог оборваться) — оборванная запись оставит прежнее состояние
+    const std::size_t target = FindIntactSlot() == 0 ? 1 : 0;
+    char* base = m_header + SESSION_SLOT_OFFSET + target * SESSION_SLOT_SIZE;
+
+    SlotHeader header;
+    header.sequence = std::max(slots[0].sequence, slots[1].sequence) + 1;
+    header.length = static_cast<std::uint32_t>(state.size());
+    header.checksum = Checksum(state.data(), state.size());
+
+    std::memcpy(base + sizeof(SlotHeader), state.data(), state.size());
+    std::memcpy(base, &header, sizeof(header));
+    m_headerDirty = true;
+    return true;
+}
+
+int SessionFile::FindIntactSlot() const
+{
+    if (!m_header)
+    {
+        return -1;
+    }
+
+    int best = -1;
+    std::uint64_t bestSequence = 0;
+    for (int slot = 0; slot < 2; ++slot)
+    {
+        SlotHeader header;
+        if (ReadSlot(m_header + SESSION_SLOT_OFFSET + static_cast<std::size_t>(slot) * SESSION_SLOT_SIZE, header)
+            && header.sequence > bestSequence)
+        {
+            best = slot;
+            bestSequence = header.sequence;
+        }
+    }
+    return best;
+}
+
+bool SessionFile::Flush()
+{
+    if (!m_header)
+    {
+        return false;
+    }
+
+    bool ok = true;
+    if (m_headerDirty)
+    {
+        ok = FlushRange(m_header, HEADER_SIZE) && ok;
+    }
+    for (std::size_t i = m_dirtyFrom; i < m_blocks.size(); ++i)
+    {
+        ok = FlushRange(m_blocks[i], BLOCK_SIZE) && ok;
+    }
+
+#ifdef _WIN32
+    ok = FlushFileBuffers(static_cast<HANDLE>(m_file)) != 0 && ok;
+#else
+    ok = ::fsync(m_fd) == 0 && ok;  // Размер файла — метаданные, msync их не касается
+#endif
+
+    if (ok)
+    {
+        m_headerDirty = false;
+        m_dirtyFrom = m_blocks.size();
+    }
+    return ok;
+}
+
+void SessionFile::InitializeHeader()
+{
+    std::memset(m_header, 0, HEADER_SIZE);
+
+    FileHeader header;
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.headerSize = HEADER_SIZE;
+    header.blockSize = BLOCK_SIZE;
+    std::memcpy(m_header, &header, sizeof(header));
+    m_headerDirty = true;
+}
+
+#ifdef _WIN32
+
+bool SessionFile::Resize(std::size_t size)
+{
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(size);
+    return SetFilePointerEx(static_cast<HANDLE>(m_file), position, nullptr, FILE_BEGIN)
+        && SetEndOfFile(static_cast<HANDLE>(m_file));
+}
+
+char* SessionFile::MapRange(std::size_t offset, std::size_t size)
+{
+    // Отображение на весь текущий размер; вид держит его сам, HANDLE можно закрыть
+    const std::uint64_t end = static_cast<std::uint64_t>(offset) + size;
+    HANDLE mapping = CreateFileMappingA(static_cast<HANDLE>(m_file), nullptr, PAGE_READWRITE,
+        static_cast<DWORD>(end >> 32), static_cast<DWORD>(end & 0xFFFFFFFFu), nullptr);
+    if (!mapping)
+    {
+        return nullptr;
+    }
+
+    const std::uint64_t start = offset;
+    void* view = MapViewOfFile(mapping, FILE_MAP_WRITE,
+        static_cast<DWORD>(start >> 32), static_cast<DWORD>(start & 0xFFFFFFFFu), size);
+    CloseHandle(mapping);
+    return static_cast<char*>(view);
+}
+
+void SessionFile::Unmap(char* view, std::size_t)
+{
+    UnmapViewOfFile(view);
+}
+
+bool SessionFile::FlushRange(char* view, std::size_t size)
+{
+    return FlushViewOfFile(view, size) != 0;
+}
+
+#else
+
+bool SessionFile::Resize(std::size_t size)
+{
+    return ::ftruncate(m_fd, static_cast<off_t>(size)) == 0;
+}
+
+char* SessionFile::MapRange(std::size_t offset, std::size_t size)
+{
+    void* view = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, static_cast<off_t>(offset));
+    return view == MAP_FAILED ? nullptr : static_cast<char*>(view);
+}
+
+void SessionFile::Unmap(char* view, std::size_t size)
+{
+    ::munmap(view, size);
+}
+
+bool SessionFile::FlushRange(char* view, std::size_t size)
+{
+    return ::msync(view, size, MS_SYNC) == 0;
+}
+
+#endif
+
+} // namespace calc
@@ -0,0 +1,108 @@
+#include "engine/symbol_table.h"
+
+namespace calc
+{
+
+namespace
+{
+
+constexpr std::size_t INITIAL_CELLS = 16;
+
+} // namespace
+
+SymbolTable::SymbolTable(std::size_t capacity)
+    : m_capacity(capacity)
+{
+    Clear();
+}
+
+std::uint32_t SymbolTable::Intern(std::string_view name)
+{
+    const std::uint32_t hash = Hash(name);
+    std::size_t cell = Probe(name, hash);
+    if (m_cells[cell] != 0)
+    {
+        return m_cells[cell] - 1;
+    }
+
+    if (name.empty() || name.size() > MAX_NAME_LENGTH || m_values.size() >= m_capacity)
+    {
+        return NO_SYMBOL;
+    }
+
+    // Заполнение держится не выше половины: цепочки пробирования короткие
+    if (2 * (m_values.size() + 1) > m_cells.size())
+    {
+        Grow();
+        cell = Probe(name, hash);
+    }
+
+    const auto symbol = static_cast<std::uint32_t>(m_values.size());
+    m_cells[cell] = symbol + 1;
+    m_hashes.push_back(hash);
+    m_names.append(name.data(), name.size());
+    m_nameOffsets.push_back(static_cast<std::uint32_t>(m_names.size()));
+    m_values.push_back(0.0);
+    m_defined.push_back(0);
+    return symbol;
+}
+
+std::uint32_t SymbolTable::Find(std::string_view name) const
+{
+    const std::size_t cell = Probe(name, Hash(name));
+    return m_cells[cell] != 0 ? m_cells[cell] - 1 : NO_SYMBOL;
+}
+
+void SymbolTable::Clear()
+{
+    m_cells.assign(INITIAL_CELLS, 0);
+    m_hashes.clear();
+    m_nameOffsets.assign(1, 0);
+    m_names.clear();
+    m_values.clear();
+    m_defined.clear();
+}
+
+std::uint32_t SymbolTable::Hash(std::string_view name)
+{
+    // FNV-1a: имена короткие, важнее простота, чем скорость на длинных строках
+    std::uint32_t hash = 2166136261u;
+    for (const char c : name)
+    {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+std::size_t SymbolTable::Probe(std::string_view name, std::uint32_t hash) const
+{
+    const std::size_t mask = m_cells.size() - 1;
+    for (std::size_t cell = hash & mask;; cell = (cell + 1) & mask)
+    {
+        const std::uint32_t entry = m_cells[cell];
+        if (entry == 0 || (m_hashes[entry - 1] == hash && GetName(entry - 1) == name))
+        {
+            return cell;
+        }
+    }
+}
+
+void SymbolTable::Grow()
+{
+    m_cells.assign(2 * m_cells.size(), 0);
+
+    // Слоты не меняются: переезжают только ячейки
+    const std::size_t mask = m_cells.size() - 1;
+    for (std::uint32_t symbol = 0; symbol < m_hashes.size(); ++symbol)
+    {
+        std::size_t cell = m_hashes[symbol] & mask;
+        while (m_cells[cell] != 0)
+        {
+            cell = (cell + 1) & mask;
+        }
+        m_cells[cell] = symbol + 1;
+    }
+}
+
+} // namespace calc
@@ -0,0 +1,172 @@
+#include "engine/thread_pool.h"
+#include "engine/instrumentation.h"
+
+#include <utility>
+
+namespace calc
+{
+
+namespace
+{
+
+// Пул и индекс очереди текущего рабочего потока (nullptr вне пула)
+thread_local const ThreadPool* t_currentPool = nullptr;
+thread_local unsigned t_workerIndex = 0;
+
+} // namespace
+
+ThreadPool::ThreadPool(unsigned threadCount)
+    : m_pending(0)
+    , m_nextQueue(0)
+    , m_stopping(false)
+{
+    if (threadCount == 0)
+    {
+        threadCount = DefaultThreadCount();
+    }
+
+    m_queues.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i)
+    {
+        m_queues.push_back(std::make_unique<WorkerQueue>());
+    }
+
+    m_threads.reserve(threadCount);
+    for (unsigned i = 0; i < threadCount; ++i)
+    {
+        m_threads.emplace_back(&ThreadPool::WorkerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool()
+{
+    WaitIdle();
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+        m_stopping = true;
+    }
+    m_wake.notify_all();
+
+    for (std::thread& thread : m_threads)
+    {
+        thread.join();
+    }
+}
+
+unsigned ThreadPool::DefaultThreadCount()
+{
+    const unsigned count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : count;
+}
+
+void ThreadPool::Submit(Task task)
+{
+    const unsigned index = t_currentPool == this
+        ? t_workerIndex
+        : m_nextQueue.fetch_add(1, std::memory_order_relaxed) % m_queues.size();
+
+    m_pending.fetch_add(1, std::memory_order_acq_rel);
+    {
+        std::lock_guard<std::mutex> lock(m_queues[index]->mutex);
+        m_queues[index]->tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_wakeMutex);
+    }
+    m_wake.notify_one();
+}
+
+void ThreadPool::WaitIdle()
+{
+    std::unique_lock<std::mutex> lock(m_wakeMutex);
+    m_idle.wait(lock, [this] { return m_pending.load(std::memory_order_acquire) == 0; });
+}
+
+void ThreadPool::WorkerLoop(unsigned index)
+{
+    t_currentPool = this;
+    t_workerIndex = index;
+    NameTraceThread("ThreadPool worker");
+
+    for (;;)
+    {
+        Task task;
+        if (TryPopLocal(index, task) || TrySteal(index, task))
+        {
+            task();
+
+            if (m_pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                std::lock_guard<std::mutex> lock(m_wakeMutex);
+                m_idle.notify_all();
+            }
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_wakeMutex);
+        if (m_stopping)
+        {
+            return;
+        }
+
+        // Задачи могли появиться между попыткой кражи и захватом мьютекса:
+        // Submit() берёт m_wakeMutex перед notify, поэтому пробуждение не теряется
+        m_wake.wait(lock, [this, index]
+        {
+            if (m_stopping)
+            {
+                return true;
+            }
+
+            for (const auto& queue : m_queues)
+            {
+                std::lock_guard<std::mutex> queueLock(queue->mutex);
+                if (!queue->tasks.empty())
+                {
+                    return true;
+                }
+            }
+            return false;
+        });
+
+        if (m_stopping && m_pending.load(std::memory_order_acquire) == 0)
+        {
+            return;
+        }
+    }
+}
+
+bool ThreadPool::TryPopLocal(unsigned index, Task& task)
+{
+    WorkerQueue& queue = *m_queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty())
+    {
+        return false;
+    }
+
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    return true;
+}
+
+bool ThreadPool::TrySteal(unsigned index, Task& task)
+{
+    const std::size_t count = m_queues.size();
+    for (std::size_t offset = 1; offset < count; ++offset)
+    {
+        WorkerQueue& queue = *m_queues[(index + offset) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (!queue.tasks.empty())
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+            return true;
+        }
+    }
+    return false;
+}
+
+} // namespace calc
@@ -0,0 +1,114 @@
+#include "engine/vm.h"
+#include "engine/operators.h"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define CALC_VM_COMPUTED_GOTO 1
+#else
+#define CALC_VM_COMPUTED_GOTO 0
+#endif
+
+namespace calc
+{
+
+void VirtualMachine::Load(const Program& program)
+{
+    m_program = &program;
+    m_registers.assign(std::max<std::size_t>(program.registerCount, 1), 0.0);
+    std::copy(program.constants.begin(), program.constants.end(), m_registers.begin());
+}
+
+#if CALC_VM_COMPUTED_GOTO
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpedantic"
+#endif
+
+EvalResult VirtualMachine::Run(const double* variables)
+{
+    if (!m_program)
+    {
+        return EvalResult{ 0.0, CalcError::SyntaxError };
+    }
+
+    const std::uint32_t variableCount = m_program->GetVariableCount();
+    if (variableCount != 0)
+    {
+        if (!variables)
+        {
+            return EvalResult{ 0.0, CalcError::UnknownVariable };
+        }
+        std::copy(variables, variables + variableCount,
+            m_registers.begin() + m_program->GetVariableBase());
+    }
+
+    double* r = m_registers.data();
+    const Instruction* ip = m_program->code.data();
+
+#if CALC_VM_COMPUTED_GOTO
+    // Порядок меток совпадает с порядком OpCode
+    static void* const DISPATCH[] = {
+        &&Add, &&Subtract, &&Multiply, &&Divide, &&Power, &&Negate, &&Call, &&Return
+    };
+#define VM_CASE(name) name:
+#define VM_NEXT() ++ip; goto *DISPATCH[static_cast<unsigned>(ip->op)]
+    goto *DISPATCH[static_cast<unsigned>(ip->op)];
+#else
+#define VM_CASE(name) case OpCode::name:
+#define VM_NEXT() ++ip; continue
+    for (;;)
+    {
+        switch (ip->op)
+        {
+#endif
+
+    VM_CASE(Add)
+        r[ip->dst] = r[ip->lhs] + r[ip->rhs];
+        VM_NEXT();
+
+    VM_CASE(Subtract)
+        r[ip->dst] = r[ip->lhs] - r[ip->rhs];
+        VM_NEXT();
+
+    VM_CASE(Multiply)
+        r[ip->dst] = r[ip->lhs] * r[ip->rhs];
+        VM_NEXT();
+
+    VM_CASE(Divide)
+        if (r[ip->rhs] == 0.0)
+        {
+            return EvalResult{ 0.0, CalcError::DivisionByZero };
+        }
+        r[ip->dst] = r[ip->lhs] / r[ip->rhs];
+        VM_NEXT();
+
+    VM_CASE(Power)
+        r[ip->dst] = std::pow(r[ip->lhs], r[ip->rhs]);
+        VM_NEXT();
+
+    VM_CASE(Negate)
+        r[ip->dst] = -r[ip->lhs];
+        VM_NEXT();
+
+    VM_CASE(Call)
+        r[ip->dst] = OPERATORS[ip->rhs].function(r[ip->lhs]);
+        VM_NEXT();
+
+    VM_CASE(Return)
+        return FiniteResult(r[ip->lhs]);
+
+#if !CALC_VM_COMPUTED_GOTO
+        }
+    }
+#endif
+
+#undef VM_CASE
+#undef VM_NEXT
+}
+
+#if CALC_VM_COMPUTED_GOTO
+#pragma GCC diagnostic pop
+#endif
+
+} // namespace calc
@@ -0,0 +1,469 @@
+#include "engine/worksheet.h"
+#include "engine/instrumentation.h"
+#include "engine/parser.h"
+#include "engine/thread_pool.h"
+
+#include <algorithm>
+
+namespace calc
+{
+
+Worksheet::Worksheet(unsigned threadCount)
+    : m_symbols(MAX_NAMES)
+    , m_threadCount(threadCount == 0 ? ThreadPool::DefaultThreadCount() : threadCount)
+    , m_workers(m_threadCount)
+{
+}
+
+Worksheet::~Worksheet() = default;
+
+void Worksheet::SetLine(std::size_t line, std::string_view text)
+{
+    Cell& cell = m_cells[m_order[line]];
+    if (cell.text == text)
+    {
+        return;
+    }
+
+    cell.text.assign(text.data(), text.size());
+    Compile(cell);
+    m_pendingEdits = true;
+}
+
+void Worksheet::InsertLine(std::size_t line, std::string_view text)
+{
+    const std::uint32_t cell = NewCell(text);
+    m_order.insert(m_order.begin() + static_cast<std::ptrdiff_t>(line), cell);
+    m_pendingEdits = true;
+}
+
+void Worksheet::RemoveLine(std::size_t line)
+{
+    const std::uint32_t id = m_order[line];
+    Cell& cell = m_cells[id];
+    cell.text.clear();
+    cell.program.Clear();
+    cell.symbols.clear();
+    cell.inputs.clear();
+    cell.name = SymbolTable::NO_SYMBOL;
+    cell.error = CalcError::None;
+    cell.result = EvalResult{};
+
+    // Зависимые ещё ссылаются на ячейку: в оборот она вернётся после Relink
+    m_releasedCells.push_back(id);
+    m_order.erase(m_order.begin() + static_cast<std::ptrdiff_t>(line));
+    m_pendingEdits = true;
+}
+
+void Worksheet::SetText(std::string_view text)
+{
+    std::vector<std::string_view> lines;
+    while (!text.empty())
+    {
+        const std::size_t end = text.find('\n');
+        std::string_view line = text.substr(0, end);
+        if (!line.empty() && line.back() == '\r')
+        {
+            line.remove_suffix(1);
+        }
+        lines.push_back(line);
+        text.remove_prefix(end == std::string_view::npos ? text.size() : end + 1);
+    }
+
+    // Перечитанный файл обычно отличается от листа немногими строками в середине
+    const std::size_t oldCount = m_order.size();
+    const std::size_t newCount = lines.size();
+    std::size_t prefix = 0;
+    while (prefix < oldCount && prefix < newCount && GetLine(prefix) == lines[prefix])
+    {
+        ++prefix;
+    }
+    std::size_t suffix = 0;
+    while (suffix < oldCount - prefix && suffix < newCount - prefix
+        && GetLine(oldCount - 1 - suffix) == lines[newCount - 1 - suffix])
+    {
+        ++suffix;
+    }
+
+    const std::size_t oldMiddle = oldCount - prefix - suffix;
+    const std::size_t newMiddle = newCount - prefix - suffix;
+    const std::size_t common = std::min(oldMiddle, newMiddle);
+    for (std::size_t i = 0; i < common; ++i)
+    {
+        SetLine(prefix + i, lines[prefix + i]);
+    }
+    for (std::size_t i = common; i < newMiddle; ++i)
+    {
+        InsertLine(prefix + i, lines[prefix + i]);
+    }
+    for (std::size_t i = common; i < oldMiddle; ++i)
+    {
+        RemoveLine(prefix + common);
+    }
+}
+
+void Worksheet::Clear()
+{
+    m_cells.clear();
+    m_order.clear();
+    m_freeCells.clear();
+    m_releasedCells.clear();
+    m_symbols.Clear();
+    m_stats = WorksheetStats{};
+    m_pendingEdits = false;
+}
+
+const WorksheetStats& Worksheet::Recalculate()
+{
+    CALC_TRACE_SCOPE("Worksheet::Recalculate");
+
+    m_stats = WorksheetStats{};
+    if (!m_pendingEdits)
+    {
+        return m_stats;
+    }
+    m_pendingEdits = false;
+
+    Relink();
+    if (m_dirtyCells.empty())
+    {
+        return m_stats;
+    }
+    CALC_TRACE_EVALUATIONS(m_dirtyCells.size());
+
+    // Мелкую правку пул только замедлит: будить потоки дороже, чем посчитать
+    const unsigned threads = m_dirtyCells.size() >= PARALLEL_MIN_CELLS ? m_threadCount : 1;
+    m_stats.recomputed = m_dirtyCells.size();
+    m_stats.components = Partition(threads);
+    m_stats.threads = static_cast<unsigned>(std::min<std::size_t>(threads, m_stats.components));
+
+    if (m_stats.threads <= 1)
+    {
+        m_stats.threads = 1;
+        for (const std::uint32_t id : m_dirtyCells)
+        {
+            Evaluate(m_cells[id], m_workers[0]);
+        }
+        return m_stats;
+    }
+
+    if (!m_pool)
+    {
+        m_pool = std::make_unique<ThreadPool>(m_threadCount);
+    }
+
+    // Группы не делят грязных ячеек: чистые входы только читаются
+    for (unsigned group = 0; group < m_stats.threads; ++group)
+    {
+        m_pool->Submit([this, group]
+        {
+            Worker& worker = m_workers[group];
+            for (const std::uint32_t id : worker.cells)
+            {
+                Evaluate(m_cells[id], worker);
+            }
+        });
+    }
+    m_pool->WaitIdle();
+    return m_stats;
+}
+
+std::string_view Worksheet::GetName(std::size_t line) const
+{
+    const std::uint32_t name = m_cells[m_order[line]].name;
+    return name != SymbolTable::NO_SYMBOL ? m_symbols.GetName(name) : std::string_view();
+}
+
+bool Worksheet::IsBlank(std::size_t line) const
+{
+    const Cell& cell = m_cells[m_order[line]];
+    return cell.program.code.empty() && cell.error == CalcError::None;
+}
+
+void Worksheet::WriteText(std::string& text) const
+{
+    text.clear();
+    for (const std::uint32_t id : m_order)
+    {
+        text += m_cells[id].text;
+        text += '\n';
+    }
+}
+
+std::uint32_t Worksheet::NewCell(std::string_view text)
+{
+    std::uint32_t id;
+    if (!m_freeCells.empty())
+    {
+        id = m_freeCells.back();
+        m_freeCells.pop_back();
+    }
+    else
+    {
+        id = static_cast<std::uint32_t>(m_cells.size());
+        m_cells.emplace_back();
+    }
+
+    Cell& cell = m_cells[id];
+    cell.text.assign(text.data(), text.size());
+    Compile(cell);
+    return id;
+}
+
+void Worksheet::Compile(Cell& cell)
+{
+    cell.program.Clear();
+    cell.symbols.clear();
+    cell.inputs.clear();
+    cell.name = SymbolTable::NO_SYMBOL;
+    cell.error = CalcError::None;
+    cell.dirty = true;
+
+    std::string_view name;
+    std::string_view formula = cell.text;
+    if (Lexer::SplitAssignment(cell.text, name, formula))
+    {
+        cell.name = InternName(name);
+        if (cell.name == SymbolTable::NO_SYMBOL)
+        {
+            cell.error = CalcError::UnknownVariable;
+            return;
+        }
+    }
+
+    cell.error = Lexer::Tokenize(formula, m_tokens);
+    if (cell.error != CalcError::None)
+    {
+        return;
+    }
+
+    // Пустая строка — разделитель; "имя =" без выражения — ошибка
+    if (m_tokens.size() == 1)
+    {
+        if (cell.name != SymbolTable::NO_SYMBOL)
+        {
+            cell.error = CalcError::SyntaxError;
+        }
+        return;
+    }
+
+    m_arena.Reset();
+    Parser parser(m_tokens.data(), m_tokens.size(), m_arena, formula);
+    const ParseResult parsed = parser.Parse();
+    if (!parsed.root || parsed.error != CalcError::None)
+    {
+        cell.error = parsed.error != CalcError::None ? parsed.error : CalcError::SyntaxError;
+        return;
+    }
+
+    m_compiler.Compile(parsed.root, cell.program);
+    cell.symbols.reserve(cell.program.variableNames.size());
+    for (const std::string& variable : cell.program.variableNames)
+    {
+        cell.symbols.push_back(InternName(variable));
+    }
+}
+
+std::uint32_t Worksheet::InternName(std::string_view name)
+{
+    std::uint32_t symbol = m_symbols.Intern(name);
+    if (symbol == SymbolTable::NO_SYMBOL && m_symbols.GetCount() >= m_symbols.GetCapacity())
+    {
+        // Набор по буквам оставляет имена-огрызки ("t", "to", "tot"...)
+        CompactSymbols();
+        symbol = m_symbols.Intern(name);
+    }
+    return symbol;
+}
+
+void Worksheet::CompactSymbols()
+{
+    const SymbolTable previous = std::move(m_symbols);
+    m_symbols = SymbolTable(MAX_NAMES);
+
+    auto remap = [&](std::uint32_t& symbol)
+    {
+        if (symbol != SymbolTable::NO_SYMBOL)
+        {
+            symbol = m_symbols.Intern(previous.GetName(symbol));
+        }
+    };
+
+    for (Cell& cell : m_cells)
+    {
+        remap(cell.name);
+        for (std::uint32_t& symbol : cell.symbols)
+        {
+            remap(symbol);
+        }
+    }
+}
+
+void Worksheet::Relink()
+{
+    // Ссылки только вверх: один проход в порядке строк и связывает, и разносит грязь
+    m_definers.assign(m_symbols.GetCount(), NO_CELL);
+    m_dirtyCells.clear();
+
+    for (const std::uint32_t id : m_order)
+    {
+        Cell& cell = m_cells[id];
+        if (cell.inputs.size() != cell.symbols.size())
+        {
+            cell.inputs.assign(cell.symbols.size(), NO_CELL);
+            cell.dirty = true;
+        }
+
+        for (std::size_t i = 0; i < cell.symbols.size(); ++i)
+        {
+            const std::uint32_t symbol = cell.symbols[i];
+            const std::uint32_t source = symbol != SymbolTable::NO_SYMBOL ? m_definers[symbol] : NO_CELL;
+            if (cell.inputs[i] != source)
+            {
+                cell.inputs[i] = source;
+                cell.dirty = true;
+            }
+            else if (source != NO_CELL && m_cells[source].dirty)
+            {
+                cell.dirty = true;
+            }
+        }
+
+        if (cell.dirty)
+        {
+            m_dirtyCells.push_back(id);
+        }
+        if (cell.name != SymbolTable::NO_SYMBOL)
+        {
+            m_definers[cell.name] = id;
+        }
+    }
+
+    m_freeCells.insert(m_freeCells.end(), m_releasedCells.begin(), m_releasedCells.end());
+    m_releasedCells.clear();
+}
+
+std::size_t Worksheet::Partition(unsigned threads)
+{
+    // Подграф — связная компонента грязных ячеек по рёбрам "вход → строка"
+    m_parents.resize(m_cells.size());
+    m_sizes.resize(m_cells.size());
+    m_groupOf.resize(m_cells.size());
+    for (const std::uint32_t id : m_dirtyCells)
+    {
+        m_parents[id] = id;
+        m_sizes[id] = 1;
+    }
+
+    for (const std::uint32_t id : m_dirtyCells)
+    {
+        for (const std::uint32_t input : m_cells[id].inputs)
+        {
+            if (input == NO_CELL || !m_cells[input].dirty)
+            {
+                continue;
+            }
+
+            std::uint32_t a = FindRoot(id);
+            std::uint32_t b = FindRoot(input);
+            if (a != b)
+            {
+                if (m_sizes[a] < m_sizes[b])
+                {
+                    std::swap(a, b);
+                }
+                m_parents[b] = a;
+                m_sizes[a] += m_sizes[b];
+            }
+        }
+    }
+
+    m_roots.clear();
+    for (const std::uint32_t id : m_dirtyCells)
+    {
+        if (FindRoot(id) == id)
+        {
+            m_roots.push_back(id);
+        }
+    }
+
+    const std::size_t groups = std::min<std::size_t>(threads, m_roots.size());
+    if (groups <= 1)
+    {
+        return m_roots.size();
+    }
+
+    // Крупные подграфы первыми, каждый — в наименее загруженную группу
+    std::sort(m_roots.begin(), m_roots.end(), [this](std::uint32_t a, std::uint32_t b)
+    {
+        return m_sizes[a] > m_sizes[b];
+    });
+
+    std::vector<std::size_t> loads(groups, 0);
+    for (const std::uint32_t root : m_roots)
+    {
+        const auto lightest = static_cast<std::uint32_t>(
+            std::min_element(loads.begin(), loads.end()) - loads.begin());
+        m_groupOf[root] = lightest;
+        loads[lightest] += m_sizes[root];
+    }
+
+    for (std::size_t group = 0; group < groups; ++group)
+    {
+        m_workers[group].cells.clear();
+    }
+    for (const std::uint32_t id : m_dirtyCells)
+    {
+        m_workers[m_groupOf[FindRoot(id)]].cells.push_back(id);
+    }
+    return m_roots.size();
+}
+
+std::uint32_t Worksheet::FindRoot(std::uint32_t cell)
+{
+    while (m_parents[cell] != cell)
+    {
+        m_parents[cell] = m_parents[m_parents[cell]];
+        cell = m_parents[cell];
+    }
+    return cell;
+}
+
+void Worksheet::Evaluate(Cell& cell, Worker& worker)
+{
+    cell.dirty = false;
+    if (cell.error != CalcError::None)
+    {
+        cell.result = EvalResult{ 0.0, cell.error };
+        return;
+    }
+    if (cell.program.code.empty())
+    {
+        cell.result = EvalResult{};
+        return;
+    }
+
+    // Входы уже посчитаны: они выше и либо чисты, либо в той же группе
+    worker.values.resize(cell.inputs.size());
+    for (std::size_t i = 0; i < cell.inputs.size(); ++i)
+    {
+        if (cell.inputs[i] == NO_CELL)
+        {
+            cell.result = EvalResult{ 0.0, CalcError::UnknownVariable };
+            return;
+        }
+
+        const EvalResult& input = m_cells[cell.inputs[i]].result;
+        if (!input.Ok())
+        {
+            cell.result = EvalResult{ 0.0, input.error };
+            return;
+        }
+        worker.values[i] = input.value;
+    }
+
+    worker.vm.Load(cell.program);
+    cell.result = worker.vm.Run(worker.values.data());
+}
+
+} // namespace calc
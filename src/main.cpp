@@ -1,5 +1,45 @@
 #include "wx/wx.h"
 #include <core/app.h>
+#include <engine/batch.h>
 
 
-wxIMPLEMENT_APP(CalculatorApp);
+wxIMPLEMENT_APP_NO_MAIN(CalculatorApp);
+
+#if defined(__WXMSW__)
+
+int WINAPI WinMain(HINSTANCE instance, HINSTANCE previousInstance, LPSTR commandLine, int showCommand)
+{
+    calc::BatchOptions options;
+    if (calc::BatchRunner::ParseArguments(__argc, __argv, options))
+    {
+        if (AttachConsole(ATTACH_PARENT_PROCESS))
+        {
+            if (_fileno(stdout) < 0)
+            {
+                freopen("CONOUT$", "w", stdout);
+            }
+            if (_fileno(stderr) < 0)
+            {
+                freopen("CONOUT$", "w", stderr);
+            }
+        }
+        return calc::BatchRunner::Run(options);
+    }
+
+    return wxEntry(instance, previousInstance, commandLine, showCommand);
+}
+
+#else
+
+int main(int argc, char** argv)
+{
+    calc::BatchOptions options;
+    if (calc::BatchRunner::ParseArguments(argc, argv, options))
+    {
+        return calc::BatchRunner::Run(options);
+    }
+
+    return wxEntry(argc, argv);
+}
+
+#endif
@@ -1,6 +1,10 @@
 ﻿#include "ui/button_panel.h"
+#include <wx/dcclient.h>
+#include <wx/dcmemory.h>
 #include <algorithm>
 
+#include "engine/instrumentation.h"
+
 wxDEFINE_EVENT(EVT_CALC_NUMBER, wxCommandEvent);
 wxDEFINE_EVENT(EVT_CALC_OPERATOR, wxCommandEvent);
 wxDEFINE_EVENT(EVT_CALC_EQUALS, wxCommandEvent);
@@ -8,11 +12,17 @@ wxDEFINE_EVENT(EVT_CALC_CLEAR, wxCommandEvent);
 wxDEFINE_EVENT(EVT_CALC_CLEAR_ENTRY, wxCommandEvent);
 wxDEFINE_EVENT(EVT_CALC_DECIMAL, wxCommandEvent);
 wxDEFINE_EVENT(EVT_CALC_BACKSPACE, wxCommandEvent);
+wxDEFINE_EVENT(EVT_CALC_EXPONENT, wxCommandEvent);
+wxDEFINE_EVENT(EVT_CALC_FUNCTION, wxCommandEvent);
+wxDEFINE_EVENT(EVT_CALC_MEMORY, wxCommandEvent);
 
 ButtonPanel::ButtonPanel(wxWindow* parent, wxWindowID id, const wxPoint& pos, const wxSize& size)
     : wxPanel(parent, id, pos, size)
 {
-    SetBackgroundColour(wxColour(50, 50, 50));
+    // Фон рисует OnPaint вместе с клавишами — стирание только мигало бы
+    SetBackgroundStyle(wxBG_STYLE_PAINT);
+    SetBackgroundColour(COLOR_BACKGROUND);
+    SetCanFocus(false);
     InitializeComponents();
 }
 
@@ -21,277 +31,584 @@ void ButtonPanel::InitializeComponents()
     CreateButtons();
     SetupLayout();
     BindEvents();
+    SetInitialSize();
+}
+
+constexpr ButtonPanel::KeySpec ButtonPanel::RegistryKey(calc::Operator op)
+{
+    const calc::OperatorInfo& info = calc::GetOperatorInfo(op);
+    const KeyKind kind = info.form == calc::OperatorForm::Function ? KeyKind::Function : KeyKind::Operator;
+    return KeySpec{ info.label, info.symbol, kind, op };
 }
 
 void ButtonPanel::CreateButtons()
 {
-    for (int i = 0; i <= 9; ++i) 
+    static constexpr calc::Operator NONE = calc::Operator::None;
+
+    // Построчно, как на экране (под страницей функций)
+    static constexpr KeySpec KEYS[KEY_COUNT - PAGE_KEYS] =
     {
-        ButtonInfo info{ wxString::Format("%d", i), wxString::Format("%d", i), COLOR_NUMBER };
-        m_numberButtons[i] = CreateStyledButton(info);
-        m_buttonValues[m_numberButtons[i]->GetId()] = info.value;
+        { "MC", "MC", KeyKind::Memory, NONE, MemoryOp::Clear },
+        { "MR", "MR", KeyKind::Memory, NONE, MemoryOp::Recall },
+        { "M+", "M+", KeyKind::Memory, NONE, MemoryOp::Add },
+        { "M-", "M-", KeyKind::Memory, NONE, MemoryOp::Subtract },
+        { "CE", "clear_entry", KeyKind::ClearEntry, NONE },
+        { "C", "clear", KeyKind::Clear, NONE },
+        { "<-", "backspace", KeyKind::Backspace, NONE },
+        RegistryKey(calc::Operator::Divide),
+        { "7", "7", KeyKind::Digit, NONE },
+        { "8", "8", KeyKind::Digit, NONE },
+        { "9", "9", KeyKind::Digit, NONE },
+        RegistryKey(calc::Operator::Multiply),
+        { "4", "4", KeyKind::Digit, NONE },
+        { "5", "5", KeyKind::Digit, NONE },
+        { "6", "6", KeyKind::Digit, NONE },
+        RegistryKey(calc::Operator::Subtract),
+        { "1", "1", KeyKind::Digit, NONE },
+        { "2", "2", KeyKind::Digit, NONE },
+        { "3", "3", KeyKind::Digit, NONE },
+        RegistryKey(calc::Operator::Add),
+        { "0", "0", KeyKind::Digit, NONE },
+        { "EXP", "exponent", KeyKind::Exponent, NONE },
+        { ".", ".", KeyKind::Decimal, NONE },
+        { "=", "equals", KeyKind::Equals, NONE }
+    };
+
+    for (int i = PAGE_KEYS; i < KEY_COUNT; ++i)
+    {
+        AssignKey(i, KEYS[i - PAGE_KEYS]);
     }
+    ShowPage(0);
+}
 
-    const std::array<std::pair<wxString, wxString>, 4> operators = 
-    { {
-        {"+", "+"}, {"-", "-"}, {"×", "*"}, {"÷", "/"}
-    } };
+void ButtonPanel::AssignKey(int index, const KeySpec& spec)
+{
+    ButtonInfo& button = m_buttons[index];
+    button.label = wxString::FromUTF8(spec.label);
+    button.value = spec.value;
+    button.kind = spec.kind;
+    // Подсветка ожидающего ^ переживает смену страницы
+    button.highlighted = button.highlighted && button.op == spec.op;
+    button.op = spec.op;
+    button.memory = spec.memory;
+    button.enabled = spec.kind != KeyKind::Function || m_functionsEnabled;
+}
 
-    for (const auto& [label, value] : operators) 
-    {
-        ButtonInfo info{ label, value, COLOR_OPERATOR, COLOR_OPERATOR_HIGHLIGHT, true };
-        m_operatorButtons[label] = CreateStyledButton(info);
-        m_buttonValues[m_operatorButtons[label]->GetId()] = info.value;
-    }
+void ButtonPanel::ShowPage(int page)
+{
+    static constexpr calc::Operator NONE = calc::Operator::None;
 
-    const std::array<std::tuple<wxString, wxString, wxColour>, 5> functions = { {
-        {"C", "clear", COLOR_CLEAR},
-        {"CE", "clear_entry", COLOR_FUNCTION},
-        {"<-", "backspace", COLOR_FUNCTION},
-        {".", ".", COLOR_NUMBER},
-        {"=", "equals", COLOR_EQUALS}
-    } };
+    // Вторая страница меняет тригонометрию на гиперболические, ln — на log
+    static constexpr KeySpec PAGES[PAGE_COUNT][PAGE_KEYS] =
+    {
+        {
+            { "2nd", "page", KeyKind::Page, NONE },
+            RegistryKey(calc::Operator::Sqrt),
+            RegistryKey(calc::Operator::Power),
+            RegistryKey(calc::Operator::Ln),
+            RegistryKey(calc::Operator::Sin),
+            RegistryKey(calc::Operator::Cos),
+            RegistryKey(calc::Operator::Tan),
+            RegistryKey(calc::Operator::Exp)
+        },
+        {
+            { "1st", "page", KeyKind::Page, NONE },
+            RegistryKey(calc::Operator::Sqrt),
+            RegistryKey(calc::Operator::Power),
+            RegistryKey(calc::Operator::Log10),
+            RegistryKey(calc::Operator::Sinh),
+            RegistryKey(calc::Operator::Cosh),
+            RegistryKey(calc::Operator::Tanh),
+            RegistryKey(calc::Operator::Gamma)
+        }
+    };
 
-    for (const auto& [label, value, color] : functions)
+    m_page = page;
+    for (int i = 0; i < PAGE_KEYS; ++i)
     {
-        ButtonInfo info{ label, value, color };
-        m_functionButtons[label] = CreateStyledButton(info);
-        m_buttonValues[m_functionButtons[label]->GetId()] = info.value;
+        AssignKey(i, PAGES[page][i]);
     }
-}
-
-std::unique_ptr<wxButton> ButtonPanel::CreateStyledButton(const ButtonInfo& info)
-{
-    auto button = std::make_unique<wxButton>(
-        this,
-        wxID_ANY,
-        info.label,
-        wxDefaultPosition,
-        wxSize(BUTTON_WIDTH, BUTTON_HEIGHT)
-    );
 
-    StyleButton(button.get(), info.normalColor);
-    return button;
+    if (m_backBuffer.IsOk())
+    {
+        RemeasureLabels();
+    }
 }
 
-void ButtonPanel::StyleButton(wxButton* button, const wxColour& bgColor)
+void ButtonPanel::SetupLayout()
 {
-    if (!button) return;
+    const wxSize client = GetClientSize();
+    if (client == m_layoutSize && m_backBuffer.IsOk())
+    {
+        return;
+    }
+    m_layoutSize = client;
 
-    button->SetBackgroundColour(bgColor);
+    m_sizeClass = ChooseSizeClass(client.GetHeight());
+    const SizeClassStyle& style = SIZE_CLASSES[m_sizeClass];
+    const SizeClassMetrics& metrics = GetSizeClassMetrics(m_sizeClass);
 
-    const bool isDark = (bgColor.Red() + bgColor.Green() + bgColor.Blue()) < 400;
-    button->SetForegroundColour(isDark ? COLOR_TEXT_WHITE : COLOR_TEXT);
+    const int cellWidth = std::max((client.GetWidth() - 2 * style.margin
+        - (GRID_COLUMNS - 1) * style.spacing) / GRID_COLUMNS, 0);
+    const int cellHeight = std::max((client.GetHeight() - 2 * style.margin
+        - (GRID_ROWS - 1) * style.spacing) / GRID_ROWS, 0);
 
-    wxFont font = button->GetFont();
-    font.SetPointSize(14);
-    font.SetWeight(wxFONTWEIGHT_SEMIBOLD);
-    button->SetFont(font);
+    for (int i = 0; i < KEY_COUNT; ++i)
+    {
+        const int row = i / GRID_COLUMNS;
+        const int column = i % GRID_COLUMNS;
+
+        ButtonInfo& button = m_buttons[i];
+        button.rect = wxRect(
+            style.margin + column * (cellWidth + style.spacing),
+            style.margin + row * (cellHeight + style.spacing),
+            cellWidth,
+            cellHeight);
+
+        // Подпись центрируется по заранее измеренному размеру — OnPaint текст не меряет
+        const wxSize& label = metrics.labelSizes[i];
+        button.labelOrigin = wxPoint(
+            button.rect.x + (cellWidth - label.GetWidth()) / 2,
+            button.rect.y + (cellHeight - label.GetHeight()) / 2);
+    }
 
-    button->SetCanFocus(false);
+    // Новые прямоугольники — буфер рисуется заново при ближайшем OnPaint
+    if (client.GetWidth() > 0 && client.GetHeight() > 0
+        && (!m_backBuffer.IsOk() || m_backBuffer.GetLogicalSize() != client))
+    {
+        m_backBuffer.CreateWithLogicalSize(client, GetContentScaleFactor());
+    }
+    m_bufferValid = false;
 }
 
-void ButtonPanel::SetupLayout()
+int ButtonPanel::ChooseSizeClass(int clientHeight)
 {
-    m_mainSizer = std::make_unique<wxGridSizer>(5, 4, BUTTON_SPACING, BUTTON_SPACING);
+    // Высота клавиши при отступах обычного класса
+    const int buttonHeight = (clientHeight - 2 * PANEL_MARGIN
+        - (GRID_ROWS - 1) * BUTTON_SPACING) / GRID_ROWS;
 
-    m_mainSizer->Add(m_functionButtons["CE"].get(), 0, wxEXPAND);
-    m_mainSizer->Add(m_functionButtons["C"].get(), 0, wxEXPAND);
-    m_mainSizer->Add(m_functionButtons["<-"].get(), 0, wxEXPAND);
-    m_mainSizer->Add(m_operatorButtons["÷"].get(), 0, wxEXPAND);
+    int sizeClass = SIZE_COMPACT;
+    while (sizeClass + 1 < SIZE_CLASS_COUNT
+        && buttonHeight >= SIZE_CLASSES[sizeClass + 1].minButtonHeight)
+    {
+        ++sizeClass;
+    }
+    return sizeClass;
+}
 
-    m_mainSizer->Add(m_numberButtons[7].get(), 0, wxEXPAND);
-    m_mainSizer->Add(m_numberButtons[8].get(), 0, wxEXPAND);
-    m_mainSizer->Add(m_numberButtons[9].get(), 0, wxEXPAND);
-    m_mainSizer->Add(m_operatorButtons["×"].get(), 0, wxEXPAND);
+const ButtonPanel::SizeClassMetrics& ButtonPanel::GetSizeClassMetrics(int sizeClass)
+{
+    SizeClassMetrics& metrics = m_metrics[sizeClass];
+    if (metrics.measured)
+    {
+        return metrics;
+    }
 
-    m_mainSizer->Add(m_numberButtons[4].get(), 0, wxEXPAND);
-    m_mainSizer->Add(m_numberButtons[5].get(), 0, wxEXPAND);
-    m_mainSizer->Add(m_numberButtons[6].get(), 0, wxEXPAND);
-    m_mainSizer->Add(m_operatorButtons["-"].get(), 0, wxEXPAND);
+    metrics.font = GetFont();
+    metrics.font.SetPointSize(SIZE_CLASSES[sizeClass].fontPoints);
+    metrics.font.SetWeight(wxFONTWEIGHT_SEMIBOLD);
 
-    m_mainSizer->Add(m_numberButtons[1].get(), 0, wxEXPAND);
-    m_mainSizer->Add(m_numberButtons[2].get(), 0, wxEXPAND);
-    m_mainSizer->Add(m_numberButtons[3].get(), 0, wxEXPAND);
-    m_mainSizer->Add(m_operatorButtons["+"].get(), 0, wxEXPAND);
+    for (int i = 0; i < KEY_COUNT; ++i)
+    {
+        int width = 0;
+        int height = 0;
+        GetTextExtent(m_buttons[i].label, &width, &height, nullptr, nullptr, &metrics.font);
+        metrics.labelSizes[i] = wxSize(width, height);
+    }
 
-    m_mainSizer->Add(m_numberButtons[0].get(), 0, wxEXPAND);
-    m_mainSizer->Add(new wxPanel(this), 0, wxEXPAND);
-    m_mainSizer->Add(m_functionButtons["."].get(), 0, wxEXPAND);
-    m_mainSizer->Add(m_functionButtons["="].get(), 0, wxEXPAND);
+    metrics.measured = true;
+    return metrics;
+}
 
-    auto* outerSizer = new wxBoxSizer(wxVERTICAL);
-    outerSizer->Add(m_mainSizer.get(), 1, wxEXPAND | wxALL, PANEL_MARGIN);
+void ButtonPanel::BindEvents()
+{
+    Bind(wxEVT_PAINT, &ButtonPanel::OnPaint, this);
+    Bind(wxEVT_LEFT_DOWN, &ButtonPanel::OnMouseDown, this);
+    Bind(wxEVT_LEFT_DCLICK, &ButtonPanel::OnMouseDown, this);
+    Bind(wxEVT_LEFT_UP, &ButtonPanel::OnMouseUp, this);
+    Bind(wxEVT_MOTION, &ButtonPanel::OnMouseMove, this);
+    Bind(wxEVT_LEAVE_WINDOW, &ButtonPanel::OnMouseLeave, this);
+    Bind(wxEVT_MOUSE_CAPTURE_LOST, &ButtonPanel::OnCaptureLost, this);
+    Bind(wxEVT_SIZE, &ButtonPanel::OnSize, this);
+    Bind(wxEVT_DPI_CHANGED, &ButtonPanel::OnDpiChanged, this);
+}
 
-    SetSizer(outerSizer);
+wxSize ButtonPanel::DoGetBestClientSize() const
+{
+    return wxSize(
+        GRID_COLUMNS * BUTTON_WIDTH + (GRID_COLUMNS - 1) * BUTTON_SPACING + 2 * PANEL_MARGIN,
+        GRID_ROWS * BUTTON_HEIGHT + (GRID_ROWS - 1) * BUTTON_SPACING + 2 * PANEL_MARGIN);
 }
 
-void ButtonPanel::BindEvents()
+void ButtonPanel::OnPaint(wxPaintEvent& event)
 {
-    for (const auto& button : m_numberButtons) 
+    wxPaintDC dc(this);
+    if (!m_backBuffer.IsOk())
     {
-        if (button) 
-        {
-            button->Bind(wxEVT_COMMAND_BUTTON_CLICKED,
-                &ButtonPanel::OnNumberClick, this);
-        }
+        return;
     }
 
-    for (const auto& [label, button] : m_operatorButtons) 
+    wxMemoryDC buffer(m_backBuffer);
+    if (!m_bufferValid)
     {
-        if (button) 
+        RenderAll(buffer);
+    }
+    else
+    {
+        for (int i = 0; m_dirtyButtons != 0; ++i)
         {
-            button->Bind(wxEVT_COMMAND_BUTTON_CLICKED,
-                &ButtonPanel::OnOperatorClick, this);
+            if (m_dirtyButtons & (1u << i))
+            {
+                RenderButton(buffer, i);
+                m_dirtyButtons &= ~(1u << i);
+            }
         }
     }
 
-    if (m_functionButtons["C"]) 
+    // На экран — только то, что система просит обновить
+    for (wxRegionIterator it(GetUpdateRegion()); it; ++it)
     {
-        m_functionButtons["C"]->Bind(wxEVT_COMMAND_BUTTON_CLICKED,
-            &ButtonPanel::OnClearClick, this);
+        const wxRect rect = it.GetRect();
+        dc.Blit(rect.GetPosition(), rect.GetSize(), &buffer, rect.GetPosition());
     }
+}
 
-    if (m_functionButtons["CE"]) 
+void ButtonPanel::RenderAll(wxDC& dc)
+{
+    dc.SetBackground(wxBrush(COLOR_BACKGROUND));
+    dc.Clear();
+
+    for (int i = 0; i < KEY_COUNT; ++i)
     {
-        m_functionButtons["CE"]->Bind(wxEVT_COMMAND_BUTTON_CLICKED,
-            &ButtonPanel::OnClearEntryClick, this);
+        RenderButton(dc, i);
     }
 
-    if (m_functionButtons["<-"]) 
+    m_dirtyButtons = 0;
+    m_bufferValid = true;
+}
+
+void ButtonPanel::RenderButton(wxDC& dc, int index)
+{
+    const ButtonInfo& button = m_buttons[index];
+
+    // Скруглённые углы — поверх фона, иначе останутся следы прежнего цвета
+    dc.SetPen(*wxTRANSPARENT_PEN);
+    dc.SetBrush(wxBrush(COLOR_BACKGROUND));
+    dc.DrawRectangle(button.rect);
+
+    const wxColour color = GetButtonColor(index);
+    dc.SetBrush(wxBrush(color));
+    dc.DrawRoundedRectangle(button.rect, SIZE_CLASSES[m_sizeClass].radius);
+
+    const bool isDark = (color.Red() + color.Green() + color.Blue()) < 400;
+    dc.SetTextForeground(!button.enabled ? COLOR_TEXT_DISABLED
+        : isDark ? COLOR_TEXT_WHITE : COLOR_TEXT);
+    dc.SetFont(m_metrics[m_sizeClass].font);
+    dc.DrawText(button.label, button.labelOrigin);
+}
+
+void ButtonPanel::InvalidateButton(int index)
+{
+    if (index == NO_KEY)
+    {
+        return;
+    }
+
+    m_dirtyButtons |= 1u << index;
+    RefreshRect(m_buttons[index].rect, false);
+}
+
+wxColour ButtonPanel::GetButtonColor(int index) const
+{
+    const ButtonInfo& button = m_buttons[index];
+
+    wxColour color;
+    switch (button.kind)
     {
-        m_functionButtons["<-"]->Bind(wxEVT_COMMAND_BUTTON_CLICKED,
-            &ButtonPanel::OnBackspaceClick, this);
+    case KeyKind::Operator:
+        color = button.highlighted ? COLOR_OPERATOR_HIGHLIGHT : COLOR_OPERATOR;
+        break;
+    case KeyKind::Equals:
+        color = COLOR_EQUALS;
+        break;
+    case KeyKind::Clear:
+        color = COLOR_CLEAR;
+        break;
+    case KeyKind::ClearEntry:
+    case KeyKind::Backspace:
+    case KeyKind::Exponent:
+    case KeyKind::Function:
+    case KeyKind::Memory:
+    case KeyKind::Page:
+        color = COLOR_FUNCTION;
+        break;
+    case KeyKind::Digit:
+    case KeyKind::Decimal:
+        color = COLOR_NUMBER;
+        break;
     }
 
-    if (m_functionButtons["."]) 
+    if (!button.enabled)
     {
-        m_functionButtons["."]->Bind(wxEVT_COMMAND_BUTTON_CLICKED,
-            &ButtonPanel::OnDecimalClick, this);
+        return color;
     }
 
-    if (m_functionButtons["="]) 
+    if (index == m_pressedButton && index == m_hotButton)
     {
-        m_functionButtons["="]->Bind(wxEVT_COMMAND_BUTTON_CLICKED,
-            &ButtonPanel::OnEqualsClick, this);
+        return color.ChangeLightness(80);
     }
 
-    Bind(wxEVT_SIZE, &ButtonPanel::OnSize, this);
+    if (index == m_hotButton && m_pressedButton == NO_KEY)
+    {
+        return color.ChangeLightness(110);
+    }
+
+    return color;
 }
 
-void ButtonPanel::OnNumberClick(wxCommandEvent& event)
+void ButtonPanel::OnMouseDown(wxMouseEvent& event)
 {
-    const auto it = m_buttonValues.find(event.GetId());
-    if (it != m_buttonValues.end()) 
+    const int index = HitTest(event.GetPosition());
+    if (index == NO_KEY || !m_buttons[index].enabled)
     {
-        SendCustomEvent(EVT_CALC_NUMBER, it->second);
+        return;
     }
+
+    m_pressedButton = index;
+    m_hotButton = index;
+    if (!HasCapture())
+    {
+        CaptureMouse();
+    }
+    InvalidateButton(index);
 }
 
-void ButtonPanel::OnOperatorClick(wxCommandEvent& event)
+void ButtonPanel::OnMouseUp(wxMouseEvent& event)
 {
-    const auto it = m_buttonValues.find(event.GetId());
-    if (it != m_buttonValues.end()) 
+    if (m_pressedButton == NO_KEY)
     {
-        ClearHighlights();
+        return;
+    }
 
-        for (const auto& [label, button] : m_operatorButtons) 
-        {
-            if (button && button->GetId() == event.GetId()) 
-            {
-                HighlightOperator(label, true);
-                break;
-            }
-        }
+    const int pressed = m_pressedButton;
+    m_pressedButton = NO_KEY;
+    if (HasCapture())
+    {
+        ReleaseMouse();
+    }
+    InvalidateButton(pressed);
 
-        SendCustomEvent(EVT_CALC_OPERATOR, it->second);
+    // Как у обычной кнопки: срабатывает, только если отпустили над ней же
+    if (HitTest(event.GetPosition()) == pressed)
+    {
+        ActivateButton(pressed);
     }
 }
 
-void ButtonPanel::OnEqualsClick(wxCommandEvent& event)
+void ButtonPanel::OnMouseMove(wxMouseEvent& event)
 {
-    ClearHighlights();
-    SendCustomEvent(EVT_CALC_EQUALS);
+    SetHotButton(HitTest(event.GetPosition()));
 }
 
-void ButtonPanel::OnClearClick(wxCommandEvent& event)
+void ButtonPanel::OnMouseLeave(wxMouseEvent& event)
 {
-    ClearHighlights();
-    SendCustomEvent(EVT_CALC_CLEAR);
+    SetHotButton(NO_KEY);
 }
 
-void ButtonPanel::OnClearEntryClick(wxCommandEvent& event)
+void ButtonPanel::OnCaptureLost(wxMouseCaptureLostEvent& event)
 {
-    SendCustomEvent(EVT_CALC_CLEAR_ENTRY);
+    const int pressed = m_pressedButton;
+    m_pressedButton = NO_KEY;
+    InvalidateButton(pressed);
 }
 
-void ButtonPanel::OnDecimalClick(wxCommandEvent& event)
+void ButtonPanel::SetHotButton(int index)
 {
-    SendCustomEvent(EVT_CALC_DECIMAL, ".");
+    if (index == m_hotButton)
+    {
+        return;
+    }
+
+    const int previous = m_hotButton;
+    m_hotButton = index;
+    InvalidateButton(previous);
+    InvalidateButton(index);
 }
 
-void ButtonPanel::OnBackspaceClick(wxCommandEvent& event)
+int ButtonPanel::HitTest(const wxPoint& point) const
 {
-    SendCustomEvent(EVT_CALC_BACKSPACE);
+    for (int i = 0; i < KEY_COUNT; ++i)
+    {
+        if (m_buttons[i].rect.Contains(point))
+        {
+            return i;
+        }
+    }
+    return NO_KEY;
+}
+
+void ButtonPanel::ActivateButton(int index)
+{
+    const ButtonInfo& button = m_buttons[index];
+
+    switch (button.kind)
+    {
+    case KeyKind::Digit:
+        SendCustomEvent(EVT_CALC_NUMBER, button.value);
+        break;
+    case KeyKind::Operator:
+        ClearHighlights();
+        HighlightOperator(button.op, true);
+        SendOperatorEvent(EVT_CALC_OPERATOR, button.op);
+        break;
+    case KeyKind::Function:
+        // Функция меняет операнд — ожидающий оператор остаётся подсвеченным
+        SendOperatorEvent(EVT_CALC_FUNCTION, button.op);
+        break;
+    case KeyKind::Memory:
+        SendMemoryEvent(button.memory);
+        break;
+    case KeyKind::Page:
+        ShowPage((m_page + 1) % PAGE_COUNT);
+        break;
+    case KeyKind::Equals:
+        ClearHighlights();
+        SendCustomEvent(EVT_CALC_EQUALS);
+        break;
+    case KeyKind::Clear:
+        ClearHighlights();
+        SendCustomEvent(EVT_CALC_CLEAR);
+        break;
+    case KeyKind::ClearEntry:
+        SendCustomEvent(EVT_CALC_CLEAR_ENTRY);
+        break;
+    case KeyKind::Decimal:
+        SendCustomEvent(EVT_CALC_DECIMAL, ".");
+        break;
+    case KeyKind::Backspace:
+        SendCustomEvent(EVT_CALC_BACKSPACE);
+        break;
+    case KeyKind::Exponent:
+        SendCustomEvent(EVT_CALC_EXPONENT);
+        break;
+    }
 }
 
 void ButtonPanel::SendCustomEvent(wxEventType eventType, const wxString& data)
 {
+    CALC_TRACE_INPUT();
+    CALC_TRACE_SCOPE("ButtonPanel::SendCustomEvent");
+
     wxCommandEvent evt(eventType, GetId());
     evt.SetEventObject(this);
     evt.SetString(data);
     GetEventHandler()->ProcessEvent(evt);
 }
 
+void ButtonPanel::SendOperatorEvent(wxEventType eventType, calc::Operator op)
+{
+    CALC_TRACE_INPUT();
+    CALC_TRACE_SCOPE("ButtonPanel::SendOperatorEvent");
+
+    wxCommandEvent evt(eventType, GetId());
+    evt.SetEventObject(this);
+    evt.SetInt(static_cast<int>(op));
+    GetEventHandler()->ProcessEvent(evt);
+}
+
+void ButtonPanel::SendMemoryEvent(MemoryOp op)
+{
+    CALC_TRACE_INPUT();
+    CALC_TRACE_SCOPE("ButtonPanel::SendMemoryEvent");
+
+    wxCommandEvent evt(EVT_CALC_MEMORY, GetId());
+    evt.SetEventObject(this);
+    evt.SetInt(static_cast<int>(op));
+    GetEventHandler()->ProcessEvent(evt);
+}
+
 void ButtonPanel::SetButtonEnabled(const wxString& label, bool enabled)
 {
-    for (const auto& button : m_numberButtons) 
+    for (int i = 0; i < KEY_COUNT; ++i)
     {
-        if (button && button->GetLabel() == label) 
+        if (m_buttons[i].label == label)
         {
-            button->Enable(enabled);
+            if (m_buttons[i].enabled != enabled)
+            {
+                m_buttons[i].enabled = enabled;
+                InvalidateButton(i);
+            }
             return;
         }
     }
+}
 
-    auto opIt = m_operatorButtons.find(label);
-    if (opIt != m_operatorButtons.end() && opIt->second) 
-    {
-        opIt->second->Enable(enabled);
-        return;
-    }
-
-    auto funcIt = m_functionButtons.find(label);
-    if (funcIt != m_functionButtons.end() && funcIt->second) 
+void ButtonPanel::HighlightOperator(calc::Operator op, bool highlight)
+{
+    for (int i = 0; i < KEY_COUNT; ++i)
     {
-        funcIt->second->Enable(enabled);
+        ButtonInfo& button = m_buttons[i];
+        if (button.kind == KeyKind::Operator && button.op == op)
+        {
+            if (button.highlighted != highlight)
+            {
+                button.highlighted = highlight;
+                InvalidateButton(i);
+            }
+            return;
+        }
     }
 }
 
-void ButtonPanel::HighlightOperator(const wxString& op, bool highlight)
+void ButtonPanel::ClearHighlights()
 {
-    auto it = m_operatorButtons.find(op);
-    if (it != m_operatorButtons.end() && it->second) 
+    // Перерисовывается только реально подсвеченная клавиша
+    for (int i = 0; i < KEY_COUNT; ++i)
     {
-        const wxColour color = highlight ? COLOR_OPERATOR_HIGHLIGHT : COLOR_OPERATOR;
-        StyleButton(it->second.get(), color);
-        it->second->Refresh();
+        if (m_buttons[i].highlighted)
+        {
+            m_buttons[i].highlighted = false;
+            InvalidateButton(i);
+        }
     }
 }
 
-void ButtonPanel::ClearHighlights()
+void ButtonPanel::SetFunctionsEnabled(bool enabled)
 {
-    for (const auto& [label, button] : m_operatorButtons) {
-        if (button) 
+    m_functionsEnabled = enabled;
+    for (int i = 0; i < PAGE_KEYS; ++i)
+    {
+        ButtonInfo& button = m_buttons[i];
+        if (button.kind == KeyKind::Function && button.enabled != enabled)
         {
-            StyleButton(button.get(), COLOR_OPERATOR);
-            button->Refresh();
+            button.enabled = enabled;
+            InvalidateButton(i);
         }
     }
 }
 
 void ButtonPanel::OnSize(wxSizeEvent& event)
 {
-    Layout();
+    // Дочерних окон нет — Layout() не нужен, достаточно пересчитать клавиши
+    SetupLayout();
+    Refresh(false);
+    event.Skip();
+}
+
+void ButtonPanel::OnDpiChanged(wxDPIChangedEvent& event)
+{
+    RemeasureLabels();
     event.Skip();
-}
\ No newline at end of file
+}
+
+void ButtonPanel::RemeasureLabels()
+{
+    for (SizeClassMetrics& metrics : m_metrics)
+    {
+        metrics.measured = false;
+    }
+    m_layoutSize = wxSize();
+
+    SetupLayout();
+    Refresh(false);
+}
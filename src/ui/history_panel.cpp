@@ -0,0 +1,152 @@
+﻿#include "ui/history_panel.h"
+
+#include <ctime>
+
+wxDEFINE_EVENT(EVT_CALC_HISTORY_RECALL, wxCommandEvent);
+
+HistoryPanel::HistoryList::HistoryList(HistoryPanel* owner)
+    : wxListCtrl(owner, wxID_ANY, wxDefaultPosition, wxDefaultSize,
+        wxLC_REPORT | wxLC_VIRTUAL | wxLC_SINGLE_SEL)
+    , m_owner(owner)
+{
+    AppendColumn("Time", wxLIST_FORMAT_LEFT, 130);
+    AppendColumn("Expression", wxLIST_FORMAT_LEFT, 160);
+    AppendColumn("Result", wxLIST_FORMAT_RIGHT, 120);
+}
+
+wxString HistoryPanel::HistoryList::OnGetItemText(long item, long column) const
+{
+    return m_owner->GetCellText(item, column);
+}
+
+HistoryPanel::HistoryPanel(wxWindow* parent, const calc::History& history)
+    : wxPanel(parent, wxID_ANY)
+    , m_history(history)
+    , m_searchDone(true)
+    , m_searchBox(nullptr)
+    , m_summary(nullptr)
+    , m_list(nullptr)
+{
+    m_searchBox = new wxTextCtrl(this, wxID_ANY);
+    m_searchBox->SetHint("Search history");
+    m_summary = new wxStaticText(this, wxID_ANY, wxEmptyString);
+    m_list = new HistoryList(this);
+
+    auto* sizer = new wxBoxSizer(wxVERTICAL);
+    sizer->Add(m_searchBox, 0, wxEXPAND | wxBOTTOM, 5);
+    sizer->Add(m_list, 1, wxEXPAND);
+    sizer->Add(m_summary, 0, wxEXPAND | wxTOP, 5);
+    SetSizer(sizer);
+
+    m_searchBox->Bind(wxEVT_TEXT, &HistoryPanel::OnSearchText, this);
+    m_list->Bind(wxEVT_LIST_ITEM_ACTIVATED, &HistoryPanel::OnItemActivated, this);
+    Bind(wxEVT_IDLE, &HistoryPanel::OnIdle, this);
+
+    UpdateRowCount();
+}
+
+void HistoryPanel::SyncWithHistory()
+{
+    // Новые записи поиск досмотрит в ближайшем idle
+    if (m_search.IsActive())
+    {
+        m_searchDone = false;
+        return;
+    }
+
+    UpdateRowCount();
+}
+
+std::size_t HistoryPanel::GetRowCount() const
+{
+    return m_search.IsActive() ? m_search.GetMatchCount() : m_history.GetSize();
+}
+
+std::size_t HistoryPanel::GetEntryIndex(long row) const
+{
+    // Строка 0 — самая новая запись
+    const std::size_t reversed = GetRowCount() - 1 - static_cast<std::size_t>(row);
+    return m_search.IsActive() ? m_search.GetMatch(reversed) : reversed;
+}
+
+wxString HistoryPanel::GetCellText(long row, long column) const
+{
+    if (row < 0 || static_cast<std::size_t>(row) >= GetRowCount())
+    {
+        return wxEmptyString;
+    }
+
+    const calc::HistoryEntry entry = m_history.GetEntry(GetEntryIndex(row));
+    switch (column)
+    {
+    case COLUMN_TIME:
+    {
+        const std::time_t time = static_cast<std::time_t>(entry.timestamp);
+        char buffer[32];
+        const std::tm* local = std::localtime(&time);
+        const std::size_t length = local ? std::strftime(buffer, sizeof(buffer), "%Y-%m-%d %H:%M:%S", local) : 0;
+        return wxString::FromAscii(buffer, length);
+    }
+    case COLUMN_EXPRESSION:
+        return wxString::FromUTF8(entry.expression.data(), entry.expression.size());
+    case COLUMN_RESULT:
+        return wxString::FromUTF8(entry.result.data(), entry.result.size());
+    }
+    return wxEmptyString;
+}
+
+void HistoryPanel::UpdateRowCount()
+{
+    const std::size_t rows = GetRowCount();
+    m_list->SetItemCount(static_cast<long>(rows));
+    m_list->Refresh();
+
+    if (!m_search.IsActive())
+    {
+        m_summary->SetLabel(wxString::Format("%zu entries", rows));
+        return;
+    }
+
+    m_summary->SetLabel(m_searchDone
+        ? wxString::Format("%zu matches", rows)
+        : wxString::Format("%zu matches, searching...", rows));
+}
+
+void HistoryPanel::OnSearchText(wxCommandEvent& event)
+{
+    m_search.SetQuery(m_searchBox->GetValue().ToStdString(wxConvUTF8));
+    m_searchDone = !m_search.IsActive();
+    UpdateRowCount();
+}
+
+void HistoryPanel::OnIdle(wxIdleEvent& event)
+{
+    if (m_searchDone)
+    {
+        return;
+    }
+
+    m_searchDone = m_search.Advance(m_history, SEARCH_BUDGET);
+    UpdateRowCount();
+
+    if (!m_searchDone)
+    {
+        event.RequestMore();
+    }
+}
+
+void HistoryPanel::OnItemActivated(wxListEvent& event)
+{
+    const long row = event.GetIndex();
+    if (row < 0 || static_cast<std::size_t>(row) >= GetRowCount())
+    {
+        return;
+    }
+
+    const calc::HistoryEntry entry = m_history.GetEntry(GetEntryIndex(row));
+
+    wxCommandEvent recall(EVT_CALC_HISTORY_RECALL, GetId());
+    recall.SetEventObject(this);
+    recall.SetString(wxString::FromUTF8(entry.result.data(), entry.result.size()));
+    GetEventHandler()->ProcessEvent(recall);
+}
@@ -1,25 +1,105 @@
 #include "ui/main_window.h"
+#include "ui/metrics_overlay.h"
+#include <wx/clipbrd.h>
+#include <wx/dataobj.h>
+#include <wx/filedlg.h>
+#include <wx/filename.h>
 #include <wx/msgdlg.h>
 #include <wx/menu.h>
+#include <wx/stdpaths.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <utility>
+
+wxDEFINE_EVENT(EVT_CALC_JOB_DONE, wxThreadEvent);
+
+namespace
+{
+
+//       std::string    wxString
+class ClipboardText : public wxDataObjectSimple
+{
+public:
+    explicit ClipboardText(std::string& text)
+        : wxDataObjectSimple(wxDF_TEXT)
+        , m_text(text)
+    {
+    }
+
+    size_t GetDataSize() const override { return 0; }
+    bool GetDataHere(void*) const override { return false; }
+
+    bool SetData(size_t length, const void* data) override
+    {
+        const char* bytes = static_cast<const char*>(data);
+        while (length != 0 && bytes[length - 1] == '\0')
+        {
+            --length;   // CF_TEXT    
+        }
+        m_text.assign(bytes, length);
+        return true;
+    }
+
+private:
+    std::string& m_text;
+};
+
+} // namespace
 
 MainWindow::MainWindow(wxWindow* parent, wxWindowID id, const wxString& title,
     const wxPoint& pos, const wxSize& size)
-    : wxFrame(parent, id, title, pos, size)
+    : wxFrame()
+    , m_startupBegin(std::chrono::steady_clock::now())
+    , m_startupMarks{}
+    , m_startupMarkCount(0)
+    , m_historyPanel(nullptr)
+    , m_metricsOverlay(nullptr)
+    , m_worksheetPanel(nullptr)
+    , m_bodySizer(nullptr)
     , m_display(nullptr)
     , m_mainPanel(nullptr)
     , m_statusLabel(nullptr)
+    , m_displayText("0")
+    , m_statusText("Ready")
     , m_isDarkTheme(false)
     , m_isFullscreen(false)
+    , m_layoutTimer(this, ID_LAYOUT_TIMER)
+    , m_pendingResizes(0)
+    , m_measureLayout(false)
+    , m_displayPointSize(DISPLAY_MAX_POINTS)
+    , m_displaySampleWidths{}
+    , m_displayFitsText(false)
     , m_waitingForOperand(true)
-    , m_hasDecimal(false)
+    , m_sessionTimer(this, ID_SESSION_TIMER)
+    , m_typeaheadTimer(this, ID_TYPEAHEAD_TIMER)
+    , m_keepResultCache(false)
+    , m_progressTimer(this, ID_PROGRESS_TIMER)
 {
+    //  :       
+    Create(parent, id, title, pos, size);
+    MarkStartupPhase("Create");
+
     SetMinSize(wxSize(MIN_WIDTH, MIN_HEIGHT));
+    m_calculator.SetResultCache(&m_resultCache);
 
-    CreateMenuBar();
     CreateUI();
+    MarkStartupPhase("CreateUI");
     SetupLayout();
+    MarkStartupPhase("SetupLayout");
     SetupEventHandlers();
-    ApplyModernStyle();
+    MarkStartupPhase("SetupEventHandlers");
+    OpenSession();
+    MarkStartupPhase("OpenSession");
+    PerformLayout();
+    MarkStartupPhase("PerformLayout");
+
+    //            OnFirstIdle
+    Bind(wxEVT_IDLE, &MainWindow::OnFirstIdle, this);
 
     Centre();
 
@@ -39,12 +119,22 @@ void MainWindow::CreateUI()
         wxTE_RIGHT | wxTE_READONLY | wxBORDER_NONE);
 
     wxFont displayFont = m_display->GetFont();
-    displayFont.SetPointSize(24);
+    displayFont.SetPointSize(DISPLAY_MAX_POINTS);
     displayFont.SetWeight(wxFONTWEIGHT_LIGHT);
     m_display->SetFont(displayFont);
     m_display->SetBackgroundColour(wxColour(50, 50, 50));
     m_display->SetForegroundColour(wxColour(255, 255, 255));
 
+    //     (    )
+    m_display->Bind(wxEVT_CHAR, &MainWindow::OnChar, this);
+
+    //     " - "
+    if (calc::INSTRUMENTATION_ENABLED)
+    {
+        calc::NameTraceThread("UI");
+        m_display->Bind(wxEVT_PAINT, &MainWindow::OnDisplayPaint, this);
+    }
+
     m_buttonPanel = std::make_unique<ButtonPanel>(m_mainPanel);
 
     m_statusLabel = new wxStaticText(m_mainPanel, wxID_ANY, "Ready",
@@ -59,7 +149,9 @@ void MainWindow::SetupLayout()
 
     mainSizer->Add(m_display, 0, wxEXPAND | wxALL, 10);
 
-    mainSizer->Add(m_buttonPanel.get(), 1, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 10);
+    m_bodySizer = new wxBoxSizer(wxHORIZONTAL);
+    m_bodySizer->Add(m_buttonPanel.get(), 1, wxEXPAND);
+    mainSizer->Add(m_bodySizer, 1, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 10);
 
     mainSizer->Add(m_statusLabel, 0, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 5);
 
@@ -79,234 +171,1603 @@ void MainWindow::SetupEventHandlers()
     Bind(EVT_CALC_CLEAR_ENTRY, &MainWindow::OnClearEntry, this);
     Bind(EVT_CALC_DECIMAL, &MainWindow::OnDecimal, this);
     Bind(EVT_CALC_BACKSPACE, &MainWindow::OnBackspace, this);
+    Bind(EVT_CALC_EXPONENT, &MainWindow::OnExponent, this);
+    Bind(EVT_CALC_FUNCTION, &MainWindow::OnFunction, this);
+    Bind(EVT_CALC_MEMORY, &MainWindow::OnMemory, this);
 
     Bind(wxEVT_CLOSE_WINDOW, &MainWindow::OnClose, this);
-    Bind(wxEVT_KEY_DOWN, &MainWindow::OnKeyDown, this);
+    Bind(wxEVT_TIMER, &MainWindow::OnTypeaheadTimer, this, ID_TYPEAHEAD_TIMER);
     Bind(wxEVT_SIZE, &MainWindow::OnSize, this);
 
     Bind(wxEVT_MENU, &MainWindow::OnAbout, this, ID_ABOUT);
     Bind(wxEVT_MENU, &MainWindow::OnExit, this, ID_EXIT);
     Bind(wxEVT_MENU, &MainWindow::OnThemeToggle, this, ID_THEME_TOGGLE);
     Bind(wxEVT_MENU, &MainWindow::OnFullScreen, this, ID_FULLSCREEN);
+    Bind(wxEVT_MENU, &MainWindow::OnFullPrecisionToggle, this, ID_FULL_PRECISION);
+    Bind(wxEVT_MENU, &MainWindow::OnDecimalModeToggle, this, ID_DECIMAL_MODE);
+    Bind(wxEVT_MENU, &MainWindow::OnIntegerModeToggle, this, ID_INTEGER_MODE);
+    Bind(wxEVT_MENU, &MainWindow::OnSaveResult, this, ID_SAVE_RESULT);
+    Bind(wxEVT_MENU, &MainWindow::OnCancelJob, this, ID_CANCEL_JOB);
+    Bind(wxEVT_MENU, &MainWindow::OnPaste, this, ID_PASTE);
+
+    Bind(EVT_CALC_JOB_DONE, &MainWindow::OnJobDone, this);
+    Bind(wxEVT_TIMER, &MainWindow::OnProgressTimer, this, ID_PROGRESS_TIMER);
+    Bind(wxEVT_TIMER, &MainWindow::OnLayoutTimer, this, ID_LAYOUT_TIMER);
+    Bind(wxEVT_MENU, &MainWindow::OnLayoutTimingToggle, this, ID_LAYOUT_TIMING);
+    Bind(wxEVT_DPI_CHANGED, &MainWindow::OnDpiChanged, this);
+    Bind(wxEVT_MENU, &MainWindow::OnHistoryToggle, this, ID_HISTORY);
+    Bind(EVT_CALC_HISTORY_RECALL, &MainWindow::OnHistoryRecall, this);
+    Bind(wxEVT_MENU, &MainWindow::OnWorksheetToggle, this, ID_WORKSHEET);
+    Bind(wxEVT_MENU, &MainWindow::OnResultCacheToggle, this, ID_RESULT_CACHE);
+    Bind(wxEVT_TIMER, &MainWindow::OnSessionTimer, this, ID_SESSION_TIMER);
+    Bind(wxEVT_MENU, &MainWindow::OnMetricsToggle, this, ID_METRICS);
+    Bind(wxEVT_MENU, &MainWindow::OnExportTrace, this, ID_EXPORT_TRACE);
 }
 
 void MainWindow::OnNumber(wxCommandEvent& event)
 {
-    wxString number = event.GetString();
+    CALC_TRACE_OPERATION("MainWindow::OnNumber");
 
-    if (m_waitingForOperand) 
+    if (RejectWhileBusy())
     {
-        m_currentNumber = number;
-        m_waitingForOperand = false;
-        m_hasDecimal = false;
+        return;
     }
-    else 
+
+    //         -  wxString  
+    char status[STATUS_MESSAGE_LENGTH] = "Number input: ";
+    std::size_t length = std::strlen(status);
+    for (const wxUniChar digit : event.GetString())
     {
-        if (m_currentNumber == "0") 
+        const char c = static_cast<char>(digit.GetValue());
+        InputDigit(c);
+        if (length + 1 < sizeof(status))
         {
-            m_currentNumber = number;
-        }
-        else 
-        {
-            m_currentNumber += number;
+            status[length++] = c;
         }
     }
+    status[length] = '\0';
 
-    UpdateDisplay(m_currentNumber);
-    SetStatusMessage("Number input: " + number);
+    ShowEntry();
+    SetStatusMessage(status);
 }
 
 void MainWindow::OnOperator(wxCommandEvent& event)
 {
-    wxString op = event.GetString();
+    CALC_TRACE_OPERATION("MainWindow::OnOperator");
 
-    if (!m_waitingForOperand) 
+    if (RejectWhileBusy())
     {
- 
-        if (!m_currentOperator.IsEmpty() && !m_previousNumber.IsEmpty()) 
-        {
-            OnEquals(event);  
-        }
-        else 
+        return;
+    }
+
+    if (!InputOperator(static_cast<calc::Operator>(event.GetInt())))
+    {
+        return;
+    }
+
+    ShowEntry();
+    SetStatusMessage(m_calculator.GetExpressionText().c_str());
+}
+
+void MainWindow::OnFunction(wxCommandEvent& event)
+{
+    CALC_TRACE_OPERATION("MainWindow::OnFunction");
+
+    if (RejectWhileBusy())
+    {
+        return;
+    }
+
+    const auto function = static_cast<calc::Operator>(event.GetInt());
+    if (!InputFunction(function))
+    {
+        return;
+    }
+
+    ShowEntry();
+    char status[STATUS_MESSAGE_LENGTH];
+    std::snprintf(status, sizeof(status), "%s(x)", calc::GetOperatorInfo(function).symbol);
+    SetStatusMessage(status);
+}
+
+void MainWindow::OnMemory(wxCommandEvent& event)
+{
+    CALC_TRACE_OPERATION("MainWindow::OnMemory");
+
+    if (RejectWhileBusy())
+    {
+        return;
+    }
+
+    const auto op = static_cast<MemoryOp>(event.GetInt());
+    switch (op)
+    {
+    case MemoryOp::Clear:
+        m_calculator.MemoryClear();
+        SetStatusMessage("Memory cleared");
+        return;
+
+    case MemoryOp::Recall:
+    {
+        //    ,  :   -  
+        m_calculator.MemoryRecall();
+        JobOutcome outcome;
+        outcome.result.value = m_calculator.GetOperand();
+        if (m_calculator.GetNumberMode() == calc::NumberMode::Integer)
         {
-            m_previousNumber = m_currentNumber;
+            FormatIntegerResult(m_calculator.GetIntegerResult(), outcome);
         }
+        ShowResult(outcome);
+        m_waitingForOperand = true;
+        SetStatusMessage(m_calculator.HasMemory() ? "Memory recalled" : "Memory is empty");
+        return;
     }
 
-    m_currentOperator = op;
+    case MemoryOp::Add:
+    case MemoryOp::Subtract:
+        break;
+    }
+
+    if (!CommitOperand())
+    {
+        return;
+    }
+
+    const calc::CalcError error = op == MemoryOp::Add ? m_calculator.MemoryAdd() : m_calculator.MemorySubtract();
+    if (error != calc::CalcError::None)
+    {
+        SetDisplayError(calc::Calculator::ErrorMessage(error));
+        return;
+    }
     m_waitingForOperand = true;
 
-    SetStatusMessage("Operator: " + op);
+    char memory[32];
+    calc::Calculator::FormatNumber(m_calculator.GetMemory(), memory, sizeof(memory), m_entry.GetFormat());
+    char status[STATUS_MESSAGE_LENGTH];
+    std::snprintf(status, sizeof(status), "Memory: %s", memory);
+    SetStatusMessage(status);
 }
 
 void MainWindow::OnEquals(wxCommandEvent& event)
 {
-    if (m_currentOperator.IsEmpty() || m_previousNumber.IsEmpty()) {
+    CALC_TRACE_OPERATION("MainWindow::OnEquals");
+
+    if (RejectWhileBusy())
+    {
         return;
     }
 
-    double prev = 0.0, curr = 0.0, result = 0.0;
+    Evaluate();
+}
 
-    if (!m_previousNumber.ToDouble(&prev) || !m_currentNumber.ToDouble(&curr)) {
-        SetDisplayError("Error");
-        return;
+void MainWindow::InputDigit(char digit)
+{
+    if (m_waitingForOperand)
+    {
+        m_entry.Clear();
+        m_waitingForOperand = false;
     }
 
-    if (m_currentOperator == "+") 
+    m_entry.AppendDigit(digit);
+}
+
+void MainWindow::InputDecimal()
+{
+    if (m_waitingForOperand)
     {
-        result = prev + curr;
+        m_entry.Clear();
+        m_waitingForOperand = false;
     }
-    else if (m_currentOperator == "-") 
+
+    m_entry.AppendDecimalPoint();
+}
+
+void MainWindow::InputExponent()
+{
+    if (m_waitingForOperand)
     {
-        result = prev - curr;
+        m_entry.Clear();
+        m_entry.AppendDigit('1');
+        m_waitingForOperand = false;
     }
-    else if (m_currentOperator == "*") 
+
+    m_entry.BeginExponent();
+}
+
+bool MainWindow::InputOperator(calc::Operator op)
+{
+    // "-"   EXP   ,   
+    if (!m_waitingForOperand && op == calc::Operator::Subtract
+        && m_entry.HasExponent() && m_entry.ToggleExponentSign())
     {
-        result = prev * curr;
+        return true;
     }
-    else if (m_currentOperator == "/") 
+
+    if (m_waitingForOperand && m_calculator.HasPendingOperator())
     {
-        if (curr == 0.0) {
-            SetDisplayError("Division by zero");
-            return;
-        }
-        result = prev / curr;
+        m_calculator.SetPendingOperator(op);
     }
+    else
+    {
+        if (!CommitOperand())
+        {
+            return false;
+        }
 
-    m_currentNumber = wxString::Format("%.10g", result);
-    UpdateDisplay(m_currentNumber);
+        m_calculator.PushOperator(op);
+    }
 
-    m_previousNumber.Clear();
-    m_currentOperator.Clear();
     m_waitingForOperand = true;
-
-    SetStatusMessage("Calculation completed");
+    return true;
 }
 
-void MainWindow::OnClear(wxCommandEvent& event)
+bool MainWindow::InputFunction(calc::Operator function)
 {
-    m_currentNumber = "0";
-    m_previousNumber.Clear();
-    m_currentOperator.Clear();
-    m_waitingForOperand = true;
-    m_hasDecimal = false;
+    if (!CommitOperand())
+    {
+        return false;
+    }
 
-    UpdateDisplay(m_currentNumber);
-    SetStatusMessage("Cleared");
-}
+    //         
+    const calc::EvalResult result = m_calculator.ApplyFunction(function);
+    if (!result.Ok())
+    {
+        SetDisplayError(calc::Calculator::ErrorMessage(result.error));
+        return false;
+    }
 
-void MainWindow::OnClearEntry(wxCommandEvent& event)
-{
-    m_currentNumber = "0";
-    m_hasDecimal = false;
-    UpdateDisplay(m_currentNumber);
-    SetStatusMessage("Entry cleared");
+    const bool exact = m_calculator.GetNumberMode() == calc::NumberMode::Decimal
+        && m_entry.Assign(m_calculator.GetResultText());
+    if (!exact)
+    {
+        m_entry.SetValue(result.value);
+    }
+
+    m_waitingForOperand = true;
+    return true;
 }
 
-void MainWindow::OnDecimal(wxCommandEvent& event)
+bool MainWindow::Evaluate()
 {
-    if (m_waitingForOperand) 
+    if (!m_calculator.HasPendingOperator())
     {
-        m_currentNumber = "0.";
-        m_waitingForOperand = false;
-        m_hasDecimal = true;
+        return true;
+    }
+
+    if (!CommitOperand())
+    {
+        return false;
+    }
+
+    //      ,   :    
+    //           
+    std::string expression = m_calculator.GetExpressionText();
+    expression += ' ';
+    if (m_calculator.GetNumberMode() == calc::NumberMode::Integer && m_entry.HasValue())
+    {
+        //            
+        expression += m_display->GetValue().utf8_str();
     }
-    else if (!m_hasDecimal) 
+    else
     {
-        m_currentNumber += ".";
-        m_hasDecimal = true;
+        char buffer[calc::NumberEntry::MAX_TEXT_LENGTH];
+        expression.append(buffer, m_entry.Format(buffer, sizeof(buffer)));
     }
 
-    UpdateDisplay(m_currentNumber);
+    //  EVT_CALC_JOB_DONE   :   RejectWhileBusy
+    const bool integer = m_calculator.GetNumberMode() == calc::NumberMode::Integer;
+    StartJob("Calculating", [this, integer, expression = std::move(expression)]()
+    {
+        JobOutcome outcome;
+        outcome.expression = expression;
+        outcome.result = m_calculator.Equals();
+        outcome.hasResult = outcome.result.Ok();
+
+        if (outcome.hasResult && integer)
+        {
+            FormatIntegerResult(m_calculator.GetIntegerResult(), outcome);
+        }
+        else if (outcome.hasResult)
+        {
+            outcome.status = "Calculation completed";
+        }
+        return outcome;
+    });
+    return true;
 }
 
-void MainWindow::OnBackspace(wxCommandEvent& event)
+bool MainWindow::CommitOperand()
 {
-    if (m_currentNumber.Length() > 1) {
-        if (m_currentNumber.Last() == '.') 
+    const calc::NumberMode mode = m_calculator.GetNumberMode();
+
+    //         ans     
+    if (mode == calc::NumberMode::Integer && m_entry.HasValue())
+    {
+        return true;
+    }
+
+    if (mode != calc::NumberMode::Binary)
+    {
+        char buffer[calc::NumberEntry::MAX_TEXT_LENGTH];
+        const std::size_t length = m_entry.GetText(buffer, sizeof(buffer));
+        if (!m_calculator.SetOperand(std::string_view(buffer, length)))
         {
-            m_hasDecimal = false;
+            SetDisplayError(calc::Calculator::ErrorMessage(calc::CalcError::InvalidNumber));
+            return false;
         }
-        m_currentNumber = m_currentNumber.Left(m_currentNumber.Length() - 1);
+        return true;
     }
-    else 
+
+    double value = 0.0;
+    if (!m_entry.GetValue(value))
     {
-        m_currentNumber = "0";
-        m_hasDecimal = false;
+        SetDisplayError(calc::Calculator::ErrorMessage(calc::CalcError::InvalidNumber));
+        return false;
     }
 
-    UpdateDisplay(m_currentNumber);
+    m_calculator.SetOperand(value);
+    return true;
 }
 
-void MainWindow::UpdateDisplay(const wxString& value)
+void MainWindow::ShowResult(const JobOutcome& outcome)
 {
-    if (m_display) 
+    const calc::NumberMode mode = m_calculator.GetNumberMode();
+
+    if (mode == calc::NumberMode::Integer && !outcome.integerExact)
+    {
+        //   :       
+        m_entry.SetValue(outcome.result.value);
+        UpdateDisplay(wxString::FromAscii(outcome.integerText.c_str()));
+        return;
+    }
+
+    const bool exact = mode == calc::NumberMode::Integer
+        ? m_entry.Assign(outcome.integerText)
+        : mode == calc::NumberMode::Decimal && m_entry.Assign(m_calculator.GetResultText());
+    if (!exact)
     {
-        m_display->SetValue(value);
+        m_entry.SetValue(outcome.result.value);
     }
+    ShowEntry();
 }
 
-void MainWindow::SetStatusMessage(const wxString& message)
+void MainWindow::FormatIntegerResult(const calc::BigInteger& value, JobOutcome& outcome)
 {
-    if (m_statusLabel) 
+    const std::size_t digits = value.GetDecimalDigitCount();
+    outcome.status = "Calculation completed: " + std::to_string(digits) + " digits";
+
+    //      
+    if (digits <= calc::NumberEntry::MAX_MANTISSA_DIGITS)
     {
-        m_statusLabel->SetLabel(message);
+        outcome.integerText = value.ToString();
+        outcome.integerExact = true;
+        return;
     }
+
+    //      ;    Save Result As
+    std::string text = value.LeadingDigits(DISPLAY_DIGITS);
+    text.insert(value.IsNegative() ? 2 : 1, 1, '.');
+    text += "e+";
+    text += std::to_string(digits - 1);
+    outcome.integerText = std::move(text);
 }
 
-void MainWindow::SetDisplayError(const wxString& errorMsg)
+void MainWindow::ShowEntry()
 {
-    UpdateDisplay(errorMsg);
-    SetStatusMessage("Error occurred");
+    char buffer[calc::NumberEntry::MAX_TEXT_LENGTH];
+    const std::size_t length = m_entry.Format(buffer, sizeof(buffer));
+
+    //    m_displayText   ;     
+    if (AssignAscii(m_displayText, std::string_view(buffer, length)))
+    {
+        UpdateDisplay(m_displayText);
+    }
+}
+
+void MainWindow::OnClear(wxCommandEvent& event)
+{
+    CALC_TRACE_OPERATION("MainWindow::OnClear");
+
+    // C       ,  Esc
+    if (m_job)
+    {
+        OnCancelJob(event);
+        return;
+    }
 
-    m_currentNumber = "0";
-    m_previousNumber.Clear();
-    m_currentOperator.Clear();
+    m_entry.Clear();
+    m_calculator.Clear();
     m_waitingForOperand = true;
-    m_hasDecimal = false;
+
+    ShowEntry();
+    SetStatusMessage("Cleared");
 }
 
-void MainWindow::OnExit(wxCommandEvent& event)
+void MainWindow::OnClearEntry(wxCommandEvent& event)
 {
-    Close(true);
+    CALC_TRACE_OPERATION("MainWindow::OnClearEntry");
+
+    if (RejectWhileBusy())
+    {
+        return;
+    }
+
+    m_entry.Clear();
+    ShowEntry();
+    SetStatusMessage("Entry cleared");
 }
 
-void MainWindow::OnAbout(wxCommandEvent& event)
+void MainWindow::OnDecimal(wxCommandEvent& event)
 {
-    wxMessageBox("Modern Calculator\nBuilt with wxWidgets and C++",
-        "About Calculator", wxOK | wxICON_INFORMATION);
+    CALC_TRACE_OPERATION("MainWindow::OnDecimal");
+
+    if (RejectWhileBusy())
+    {
+        return;
+    }
+
+    InputDecimal();
+    ShowEntry();
 }
 
-void MainWindow::OnClose(wxCloseEvent& event)
+void MainWindow::OnExponent(wxCommandEvent& event)
 {
-    Destroy();
+    CALC_TRACE_OPERATION("MainWindow::OnExponent");
+
+    if (RejectWhileBusy())
+    {
+        return;
+    }
+
+    InputExponent();
+    ShowEntry();
 }
 
-void MainWindow::OnSize(wxSizeEvent& event)
+void MainWindow::OnBackspace(wxCommandEvent& event)
 {
-    Layout();
-    event.Skip();
+    CALC_TRACE_OPERATION("MainWindow::OnBackspace");
+
+    if (RejectWhileBusy())
+    {
+        return;
+    }
+
+    m_entry.Backspace();
+    ShowEntry();
 }
 
-void MainWindow::CreateMenuBar() 
-{ /*      */ 
+void MainWindow::OnFullPrecisionToggle(wxCommandEvent& event)
+{
+    if (RejectWhileBusy())
+    {
+        GetMenuBar()->Check(ID_FULL_PRECISION, !event.IsChecked());
+        return;
+    }
+
+    const calc::NumberFormat format = event.IsChecked()
+        ? calc::NumberFormat::Full
+        : calc::NumberFormat::Compact;
+
+    m_entry.SetFormat(format);
+    m_calculator.SetNumberFormat(format);
 
+    ShowEntry();
+    SetStatusMessage(event.IsChecked() ? "Full precision" : "10 significant digits");
 }
 
+void MainWindow::OnDecimalModeToggle(wxCommandEvent& event)
+{
+    if (RejectWhileBusy())
+    {
+        GetMenuBar()->Check(ID_DECIMAL_MODE, !event.IsChecked());
+        return;
+    }
+
+    GetMenuBar()->Check(ID_INTEGER_MODE, false);
+    m_calculator.SetNumberMode(event.IsChecked()
+        ? calc::NumberMode::Decimal
+        : calc::NumberMode::Binary);
+    m_buttonPanel->SetFunctionsEnabled(true);
 
-void MainWindow::OnThemeToggle(wxCommandEvent& event) 
-{ /*   */ 
+    m_entry.Clear();
+    m_waitingForOperand = true;
 
+    ShowEntry();
+    SetStatusMessage(event.IsChecked()
+        ? wxString::Format("Decimal mode: %u digits", m_calculator.GetDecimalPrecision())
+        : wxString("Binary floating point"));
 }
 
-void MainWindow::OnFullScreen(wxCommandEvent& event) 
-{ /*   */ 
+void MainWindow::OnIntegerModeToggle(wxCommandEvent& event)
+{
+    if (RejectWhileBusy())
+    {
+        GetMenuBar()->Check(ID_INTEGER_MODE, !event.IsChecked());
+        return;
+    }
+
+    GetMenuBar()->Check(ID_DECIMAL_MODE, false);
+    m_calculator.SetNumberMode(event.IsChecked()
+        ? calc::NumberMode::Integer
+        : calc::NumberMode::Binary);
+    m_buttonPanel->SetFunctionsEnabled(!event.IsChecked());
+
+    m_entry.Clear();
+    m_waitingForOperand = true;
 
+    ShowEntry();
+    SetStatusMessage(event.IsChecked()
+        ? wxString("Integer mode: exact results of any length")
+        : wxString("Binary floating point"));
 }
 
-void MainWindow::OnKeyDown(wxKeyEvent& event) 
-{ /*   */ 
+void MainWindow::OnSaveResult(wxCommandEvent& event)
+{
+    if (RejectWhileBusy())
+    {
+        return;
+    }
+
+    if (m_calculator.GetNumberMode() != calc::NumberMode::Integer)
+    {
+        SetStatusMessage("Save Result As is available in integer mode");
+        return;
+    }
+
+    wxFileDialog dialog(this, "Save Result As", wxEmptyString, "result.txt",
+        "Text files (*.txt)|*.txt|All files (*.*)|*.*", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+    if (dialog.ShowModal() != wxID_OK)
+    {
+        return;
+    }
+
+    std::FILE* file = wxFopen(dialog.GetPath(), "wb");
+    if (!file)
+    {
+        SetStatusMessage("Cannot open " + dialog.GetPath());
+        return;
+    }
+
+    //             
+    const std::string path(dialog.GetPath().utf8_str());
+    StartJob("Saving", [this, file, path]()
+    {
+        const calc::BigInteger& value = m_calculator.GetIntegerResult();
+        const bool written = value.WriteDecimal([file](std::string_view digits)
+        {
+            return std::fwrite(digits.data(), 1, digits.size(), file) == digits.size();
+        });
+        const bool closed = std::fclose(file) == 0;
+
+        JobOutcome outcome;
+        if (calc::IsJobCancelled())
+        {
+            outcome.status = "Save cancelled: " + path + " is incomplete";
+        }
+        else if (written && closed)
+        {
+            outcome.status = "Saved " + std::to_string(value.GetDecimalDigitCount()) + " digits";
+        }
+        else
+        {
+            outcome.status = "Cannot write " + path;
+        }
+        return outcome;
+    });
+}
+
+void MainWindow::OnPaste(wxCommandEvent& event)
+{
+    //  Ctrl+V       
+    if (m_worksheetPanel && m_worksheetPanel->IsShown() && m_worksheetPanel->PasteIntoEditor())
+    {
+        return;
+    }
+
+    PasteClipboard();
+}
 
+void MainWindow::PasteClipboard()
+{
+    CALC_TRACE_OPERATION("MainWindow::PasteClipboard");
+
+    //     
+    DrainTypeahead();
+    if (RejectWhileBusy())
+    {
+        return;
+    }
+
+    //   :      ,   
+    std::string text;
+    {
+        wxClipboardLocker locker;
+        ClipboardText data(text);
+        if (!locker || !wxTheClipboard->IsSupported(wxDF_TEXT) || !wxTheClipboard->GetData(data))
+        {
+            SetStatusMessage("The clipboard holds no text");
+            return;
+        }
+    }
+
+    if (text.find_first_not_of(" \t\r\n") == std::string::npos)
+    {
+        SetStatusMessage("The clipboard text is empty");
+        return;
+    }
+
+    const bool integer = m_calculator.GetNumberMode() == calc::NumberMode::Integer;
+    StartJob("Evaluating pasted text", [this, integer, text = std::move(text)]()
+    {
+        JobOutcome outcome;
+        calc::PasteSummary summary;
+        outcome.result = m_calculator.EvaluatePasted(text, summary);
+        outcome.hasResult = outcome.result.Ok();
+        if (!outcome.hasResult)
+        {
+            return outcome;
+        }
+
+        if (integer)
+        {
+            FormatIntegerResult(m_calculator.GetIntegerResult(), outcome);
+        }
+
+        if (summary.lineCount != 0)
+        {
+            outcome.expression = "Sum of " + std::to_string(summary.lineCount) + " pasted lines";
+            outcome.status = outcome.expression;
+            if (summary.errorCount != 0)
+            {
+                outcome.status += "; " + std::to_string(summary.errorCount)
+                    + " skipped, first at line " + std::to_string(summary.firstErrorLine);
+            }
+            if (summary.assignmentCount != 0)
+            {
+                outcome.status += "; " + std::to_string(summary.assignmentCount) + " assignments";
+            }
+            return outcome;
+        }
+
+        //        
+        outcome.expression = text.substr(0, PASTE_PREVIEW_LENGTH);
+        for (char& c : outcome.expression)
+        {
+            if (c == '\n' || c == '\r' || c == '\t')
+            {
+                c = ' ';
+            }
+        }
+        if (text.size() > PASTE_PREVIEW_LENGTH)
+        {
+            outcome.expression += "...";
+        }
+        outcome.status = summary.assignmentCount != 0
+            ? "Assigned " + std::to_string(summary.assignmentCount) + " variables"
+            : "Pasted expression: " + std::to_string(text.size()) + " characters";
+        return outcome;
+    });
+}
+
+void MainWindow::StartJob(const wxString& activity, JobWork work)
+{
+    m_jobActivity = activity;
+
+    //     UI       
+    m_job = m_jobs.Submit([this, work = std::move(work)](calc::JobContext&)
+    {
+        auto* done = new wxThreadEvent(EVT_CALC_JOB_DONE);
+        done->SetPayload(work());
+        wxQueueEvent(this, done);
+    });
+
+    m_progressTimer.Start(PROGRESS_INTERVAL_MS);
+    SetStatusMessage(activity + "... (Esc to cancel)");
+}
+
+void MainWindow::OnJobDone(wxThreadEvent& event)
+{
+    CALC_TRACE_OPERATION("MainWindow::OnJobDone");
+
+    m_progressTimer.Stop();
+    m_job.reset();
+
+    //            
+    if (!m_typeahead.IsEmpty())
+    {
+        m_typeaheadTimer.StartOnce(TYPEAHEAD_INTERVAL_MS);
+    }
+
+    const JobOutcome outcome = event.GetPayload<JobOutcome>();
+    if (!outcome.result.Ok())
+    {
+        SetDisplayError(calc::Calculator::ErrorMessage(outcome.result.error));
+        return;
+    }
+
+    if (outcome.hasResult)
+    {
+        ShowResult(outcome);
+        m_waitingForOperand = true;
+
+        m_history.Append(outcome.expression, m_display->GetValue().utf8_str().data(),
+            static_cast<std::int64_t>(std::time(nullptr)));
+        if (m_historyPanel)
+        {
+            m_historyPanel->SyncWithHistory();
+        }
+    }
+
+    //   -      (   )
+    wxString status = wxString::FromUTF8(outcome.status);
+    const calc::ResultCacheStats cache = m_resultCache.GetStats();
+    if (cache.GetLookups() != m_reportedCache.GetLookups())
+    {
+        const bool hit = cache.hits != m_reportedCache.hits;
+        m_reportedCache = cache;
+        status += wxString::Format(" (%sresult cache hit rate %.0f%%: %llu of %llu)",
+            hit ? "from cache; " : "", cache.GetHitRate() * 100.0,
+            static_cast<unsigned long long>(cache.hits), static_cast<unsigned long long>(cache.GetLookups()));
+    }
+    SetStatusMessage(status);
+}
+
+void MainWindow::OnProgressTimer(wxTimerEvent& event)
+{
+    if (m_job)
+    {
+        SetStatusMessage(wxString::Format("%s... %d%% (Esc to cancel)",
+            m_jobActivity, static_cast<int>(m_job->GetProgress() * 100.0)));
+    }
+}
+
+void MainWindow::OnCancelJob(wxCommandEvent& event)
+{
+    if (m_job)
+    {
+        m_job->Cancel();
+        SetStatusMessage(m_jobActivity + ": cancelling...");
+    }
+}
+
+bool MainWindow::RejectWhileBusy()
+{
+    if (!m_job)
+    {
+        return false;
+    }
+
+    SetStatusMessage("Busy: press Esc to cancel");
+    return true;
+}
+
+void MainWindow::UpdateDisplay(const wxString& value)
+{
+    CALC_TRACE_SCOPE("MainWindow::UpdateDisplay");
+
+    if (&value != &m_displayText)
+    {
+        m_displayText = value;
+    }
+
+    if (m_display) 
+    {
+        m_display->SetValue(m_displayText);
+
+        //       -    
+        if (m_displayText.length() > DISPLAY_SAMPLE_LENGTH || m_displayFitsText)
+        {
+            FitDisplayFont();
+        }
+    }
+}
+
+void MainWindow::SetStatusMessage(const wxString& message)
+{
+    CALC_TRACE_SCOPE("MainWindow::SetStatusMessage");
+
+    if (m_statusLabel && message != m_statusText)
+    {
+        m_statusText = message;
+        m_statusLabel->SetLabel(m_statusText);
+    }
+}
+
+void MainWindow::SetStatusMessage(const char* message)
+{
+    CALC_TRACE_SCOPE("MainWindow::SetStatusMessage");
+
+    if (m_statusLabel && AssignAscii(m_statusText, message))
+    {
+        m_statusLabel->SetLabel(m_statusText);
+    }
+}
+
+bool MainWindow::AssignAscii(wxString& target, std::string_view text)
+{
+    if (target.length() == text.size())
+    {
+        std::size_t same = 0;
+        while (same < text.size() && target[same].GetValue() == static_cast<unsigned char>(text[same]))
+        {
+            ++same;
+        }
+        if (same == text.size())
+        {
+            return false;
+        }
+    }
+
+    // clear()  :       
+    target.clear();
+    for (const char c : text)
+    {
+        target += static_cast<wchar_t>(static_cast<unsigned char>(c));
+    }
+    return true;
+}
+
+void MainWindow::SetDisplayError(const wxString& errorMsg)
+{
+    UpdateDisplay(errorMsg);
+    SetStatusMessage("Error occurred");
+
+    m_entry.Clear();
+    m_calculator.Clear();
+    m_waitingForOperand = true;
+}
+
+void MainWindow::OnExit(wxCommandEvent& event)
+{
+    Close(true);
+}
+
+void MainWindow::OnAbout(wxCommandEvent& event)
+{
+    wxMessageBox("Modern Calculator\nBuilt with wxWidgets and C++",
+        "About Calculator", wxOK | wxICON_INFORMATION);
+}
+
+void MainWindow::OnClose(wxCloseEvent& event)
+{
+    m_sessionTimer.Stop();
+    SaveSession();
+    if (m_keepResultCache)
+    {
+        m_resultCache.Save(GetResultCachePath().ToStdString());
+    }
+
+    //  m_jobs    ,   
+    m_progressTimer.Stop();
+    m_jobs.CancelAll();
+    Destroy();
+}
+
+void MainWindow::OnSize(wxSizeEvent& event)
+{
+    //  Skip:     PerformLayout  
+    ++m_pendingResizes;
+    if (!m_layoutTimer.IsRunning())
+    {
+        m_layoutTimer.StartOnce(LAYOUT_INTERVAL_MS);
+    }
+}
+
+void MainWindow::OnLayoutTimer(wxTimerEvent& event)
+{
+    PerformLayout();
+}
+
+void MainWindow::PerformLayout()
+{
+    const auto start = std::chrono::steady_clock::now();
+
+    Layout();
+    FitDisplayFont();
+
+    const std::chrono::duration<double, std::milli> elapsed =
+        std::chrono::steady_clock::now() - start;
+
+    if (m_measureLayout && m_pendingResizes > 0)
+    {
+        SetStatusMessage(wxString::Format("Layout: %.2f ms for %d resize events",
+            elapsed.count(), m_pendingResizes));
+    }
+    m_pendingResizes = 0;
+}
+
+void MainWindow::FitDisplayFont()
+{
+    if (!m_display)
+    {
+        return;
+    }
+
+    //   ,      .   
+    //    ( ) -      
+    const int available = m_display->GetClientSize().GetWidth();
+    const bool fitText = m_displayText.length() > DISPLAY_SAMPLE_LENGTH;
+    m_displayFitsText = fitText;
+
+    int candidate = DISPLAY_MAX_POINTS;
+    if (fitText)
+    {
+        //       (    ):
+        //     - 
+        const std::size_t length = m_displayText.length();
+        while (candidate > DISPLAY_MIN_POINTS
+            && static_cast<std::size_t>(GetDisplaySampleWidth(candidate)) * length * 10
+                > static_cast<std::size_t>(std::max(available, 0)) * DISPLAY_SAMPLE_LENGTH * 11)
+        {
+            --candidate;
+        }
+    }
+
+    int pointSize = DISPLAY_MIN_POINTS;
+    for (; candidate > DISPLAY_MIN_POINTS; --candidate)
+    {
+        const int width = fitText ? GetDisplayTextWidth(candidate) : GetDisplaySampleWidth(candidate);
+        if (width <= available)
+        {
+            pointSize = candidate;
+            break;
+        }
+    }
+
+    if (pointSize == m_displayPointSize)
+    {
+        return;
+    }
+
+    m_displayPointSize = pointSize;
+    wxFont font = m_display->GetFont();
+    font.SetPointSize(pointSize);
+    m_display->SetFont(font);
+}
+
+int MainWindow::GetDisplaySampleWidth(int pointSize)
+{
+    int& width = m_displaySampleWidths[pointSize - DISPLAY_MIN_POINTS];
+    if (width == 0)
+    {
+        wxFont font = m_display->GetFont();
+        font.SetPointSize(pointSize);
+
+        int height = 0;
+        m_display->GetTextExtent(DISPLAY_SAMPLE, &width, &height, nullptr, nullptr, &font);
+    }
+    return width;
+}
+
+int MainWindow::GetDisplayTextWidth(int pointSize)
+{
+    wxFont font = m_display->GetFont();
+    font.SetPointSize(pointSize);
+
+    int width = 0;
+    int height = 0;
+    m_display->GetTextExtent(m_displayText, &width, &height, nullptr, nullptr, &font);
+    return width;
+}
+
+void MainWindow::OnDpiChanged(wxDPIChangedEvent& event)
+{
+    m_displaySampleWidths.fill(0);
+    event.Skip();
+}
+
+void MainWindow::OnHistoryToggle(wxCommandEvent& event)
+{
+    ShowHistory(event.IsChecked());
+}
+
+void MainWindow::ShowHistory(bool show)
+{
+    //          
+    if (show && !m_historyPanel)
+    {
+        m_historyPanel = new HistoryPanel(m_mainPanel, m_history);
+        m_bodySizer->Add(m_historyPanel, 1, wxEXPAND | wxLEFT, 10);
+    }
+
+    if (!m_historyPanel)
+    {
+        return;
+    }
+
+    m_bodySizer->Show(m_historyPanel, show);
+
+    //       
+    const wxSize client = GetClientSize();
+    if (show && client.GetWidth() < 2 * MIN_WIDTH)
+    {
+        SetClientSize(wxSize(2 * MIN_WIDTH, client.GetHeight()));
+    }
+    PerformLayout();
+}
+
+void MainWindow::OnWorksheetToggle(wxCommandEvent& event)
+{
+    ShowWorksheet(event.IsChecked());
+}
+
+void MainWindow::ShowWorksheet(bool show)
+{
+    if (show && !m_worksheetPanel)
+    {
+        m_worksheetPanel = new WorksheetPanel(m_mainPanel);
+        m_bodySizer->Add(m_worksheetPanel, 1, wxEXPAND | wxLEFT, 10);
+    }
+
+    if (!m_worksheetPanel)
+    {
+        return;
+    }
+
+    m_bodySizer->Show(m_worksheetPanel, show);
+
+    //    -  
+    const int panels = 2 + (m_historyPanel != nullptr && m_historyPanel->IsShown() ? 1 : 0);
+    const wxSize client = GetClientSize();
+    if (show && client.GetWidth() < panels * MIN_WIDTH)
+    {
+        SetClientSize(wxSize(panels * MIN_WIDTH, client.GetHeight()));
+    }
+    PerformLayout();
+}
+
+void MainWindow::OnHistoryRecall(wxCommandEvent& event)
+{
+    CALC_TRACE_OPERATION("MainWindow::OnHistoryRecall");
+
+    if (RejectWhileBusy())
+    {
+        return;
+    }
+
+    //         NumberEntry  
+    if (!m_entry.Assign(event.GetString().ToStdString()))
+    {
+        SetStatusMessage("This result cannot be recalled");
+        return;
+    }
+
+    m_waitingForOperand = false;
+    ShowEntry();
+    SetStatusMessage("Recalled " + event.GetString());
+}
+
+void MainWindow::OpenSession()
+{
+    const wxString directory = wxStandardPaths::Get().GetUserDataDir();
+    if (!wxFileName::DirExists(directory))
+    {
+        wxFileName::Mkdir(directory, wxS_DIR_DEFAULT, wxPATH_MKDIR_FULL);
+    }
+
+    const wxString path = wxFileName(directory, "session.bin").GetFullPath();
+    switch (m_session.Open(path.ToStdString()))
+    {
+    case calc::SessionFile::OpenStatus::Opened:
+    case calc::SessionFile::OpenStatus::Created:
+        break;
+
+    case calc::SessionFile::OpenStatus::Locked:
+        SetStatusMessage("History is not saved: another Calculator window is using it");
+        return;
+
+    case calc::SessionFile::OpenStatus::Incompatible:
+        SetStatusMessage("History is not saved: the session file is from a newer version");
+        return;
+
+    case calc::SessionFile::OpenStatus::Failed:
+        SetStatusMessage("History is not saved: cannot open " + path);
+        return;
+    }
+
+    //   :   ,   
+    m_history.Attach(m_session);
+
+    const std::string_view state = m_session.ReadSession();
+    if (!state.empty() && !RestoreSession(state))
+    {
+        SetStatusMessage("Previous session could not be restored");
+    }
+    else if (!m_history.IsEmpty())
+    {
+        SetStatusMessage(wxString::Format("Restored %lu history entries",
+            static_cast<unsigned long>(m_history.GetSize())));
+    }
+
+    m_savedSession.assign(state.data(), state.size());
+    m_sessionTimer.Start(SESSION_INTERVAL_MS);
+}
+
+wxString MainWindow::GetResultCachePath() const
+{
+    return wxFileName(wxStandardPaths::Get().GetUserDataDir(), "results.cache").GetFullPath();
+}
+
+void MainWindow::OnResultCacheToggle(wxCommandEvent& event)
+{
+    m_keepResultCache = event.IsChecked();
+
+    //        
+    const wxString path = GetResultCachePath();
+    if (!m_keepResultCache && wxFileName::FileExists(path))
+    {
+        wxRemoveFile(path);
+    }
+
+    const calc::ResultCacheStats cache = m_resultCache.GetStats();
+    SetStatusMessage(wxString::Format("%s: %zu results, %.1f MB",
+        m_keepResultCache ? "Result cache is kept between sessions" : "Result cache is kept for this session only",
+        cache.entries, cache.bytes / (1024.0 * 1024.0)));
+}
+
+void MainWindow::SaveSession()
+{
+    if (!m_session.IsOpen())
+    {
+        return;
+    }
+
+    //   ,        
+    if (!m_job)
+    {
+        calc::SessionWriter writer;
+        writer.Write(SESSION_STATE_VERSION);
+        m_calculator.SaveState(writer);
+
+        const bool hasValue = m_entry.HasValue();
+        writer.Write(hasValue);
+        if (hasValue)
+        {
+            double value = 0.0;
+            m_entry.GetValue(value);
+            writer.Write(value);
+        }
+        else
+        {
+            char buffer[calc::NumberEntry::MAX_TEXT_LENGTH];
+            const std::size_t length = m_entry.GetText(buffer, sizeof(buffer));
+            writer.WriteString(std::string_view(buffer, length));
+        }
+
+        //    :     m_entry  
+        writer.WriteString(m_display->GetValue().utf8_str().data());
+        writer.Write(m_waitingForOperand);
+        writer.Write(m_entry.GetFormat() == calc::NumberFormat::Full);
+        writer.Write(m_historyPanel != nullptr && m_historyPanel->IsShown());
+        writer.Write(m_keepResultCache);
+
+        if (writer.GetData() != m_savedSession && m_session.WriteSession(writer.GetData()))
+        {
+            m_savedSession = writer.GetData();
+        }
+    }
+
+    if (m_session.IsDirty())
+    {
+        m_session.Flush();
+    }
+}
+
+bool MainWindow::RestoreSession(std::string_view state)
+{
+    calc::SessionReader reader(state);
+
+    std::uint32_t version = 0;
+    if (!reader.Read(version) || version != SESSION_STATE_VERSION || !m_calculator.RestoreState(reader))
+    {
+        return false;
+    }
+
+    bool hasValue = false;
+    double value = 0.0;
+    std::string entryText;
+    std::string display;
+    bool waitingForOperand = true;
+    bool fullPrecision = false;
+    bool showHistory = false;
+    bool keepResultCache = false;
+
+    const bool ok = reader.Read(hasValue)
+        && (hasValue ? reader.Read(value) : reader.ReadString(entryText))
+        && reader.ReadString(display)
+        && reader.Read(waitingForOperand)
+        && reader.Read(fullPrecision)
+        && reader.Read(showHistory)
+        && reader.Read(keepResultCache);
+    if (!ok)
+    {
+        m_calculator.SetNumberMode(calc::NumberMode::Binary);
+        m_calculator.SetNumberFormat(calc::NumberFormat::Compact);
+        return false;
+    }
+
+    m_entry.SetFormat(fullPrecision ? calc::NumberFormat::Full : calc::NumberFormat::Compact);
+    m_waitingForOperand = waitingForOperand;
+    m_keepResultCache = keepResultCache;
+
+    const bool answerLost = hasValue && m_calculator.GetNumberMode() == calc::NumberMode::Integer
+        && !m_calculator.IsOperandAnswer();
+    if (answerLost || (!hasValue && !m_entry.Assign(entryText)))
+    {
+        // ans            
+        m_entry.Clear();
+        m_waitingForOperand = true;
+        ShowEntry();
+    }
+    else
+    {
+        if (hasValue)
+        {
+            m_entry.SetValue(value);
+        }
+        UpdateDisplay(wxString::FromUTF8(display.c_str()));
+    }
+
+    if (showHistory)
+    {
+        ShowHistory(true);
+    }
+    m_buttonPanel->SetFunctionsEnabled(m_calculator.GetNumberMode() != calc::NumberMode::Integer);
+    SyncMenuChecks();
+
+    if (m_calculator.HasPendingOperator())
+    {
+        SetStatusMessage(wxString::FromUTF8(m_calculator.GetExpressionText()));
+    }
+    return true;
+}
+
+void MainWindow::OnSessionTimer(wxTimerEvent& event)
+{
+    SaveSession();
+}
+
+void MainWindow::OnFirstIdle(wxIdleEvent& event)
+{
+    Unbind(wxEVT_IDLE, &MainWindow::OnFirstIdle, this);
+
+    //        
+    const std::chrono::steady_clock::time_point firstFrame = std::chrono::steady_clock::now();
+    MarkStartupPhase("First frame");
+
+    CreateMenuBar();
+    MarkStartupPhase("CreateMenuBar");
+
+    //       -     
+    if (m_keepResultCache)
+    {
+        m_resultCache.Load(GetResultCachePath().ToStdString());
+        MarkStartupPhase("LoadResultCache");
+    }
+    ApplyModernStyle();
+    MarkStartupPhase("ApplyModernStyle");
+
+    ReportStartup(firstFrame);
+    event.Skip();
+}
+
+void MainWindow::MarkStartupPhase(const char* phase)
+{
+    if (m_startupMarkCount < m_startupMarks.size())
+    {
+        m_startupMarks[m_startupMarkCount++] = StartupMark{ phase, std::chrono::steady_clock::now() };
+    }
+}
+
+void MainWindow::ReportStartup(std::chrono::steady_clock::time_point firstFrame)
+{
+    if (!std::getenv("CALC_TRACE_STARTUP"))
+    {
+        return;
+    }
+
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    std::chrono::steady_clock::time_point previous = m_startupBegin;
+    for (std::size_t i = 0; i < m_startupMarkCount; ++i)
+    {
+        const StartupMark& mark = m_startupMarks[i];
+        std::fprintf(stderr, "startup: %-20s %8.2f ms  (at %8.2f ms)\n", mark.phase,
+            Milliseconds(mark.time - previous).count(), Milliseconds(mark.time - m_startupBegin).count());
+        previous = mark.time;
+    }
+
+    SetStatusMessage(wxString::Format("Startup: first frame in %.1f ms",
+        Milliseconds(firstFrame - m_startupBegin).count()));
+}
+
+void MainWindow::OnLayoutTimingToggle(wxCommandEvent& event)
+{
+    m_measureLayout = event.IsChecked();
+    SetStatusMessage(m_measureLayout
+        ? "Layout timing: resize the window"
+        : "Layout timing off");
+}
+
+void MainWindow::OnMetricsToggle(wxCommandEvent& event)
+{
+    //       -    
+    if (event.IsChecked() && !m_metricsOverlay)
+    {
+        m_metricsOverlay = new MetricsOverlay(m_mainPanel);
+        m_mainPanel->GetSizer()->Insert(1, m_metricsOverlay, 0, wxEXPAND | wxLEFT | wxRIGHT | wxBOTTOM, 10);
+    }
+
+    if (!m_metricsOverlay)
+    {
+        return;
+    }
+
+    m_metricsOverlay->Show(event.IsChecked());
+    PerformLayout();
+}
+
+void MainWindow::OnExportTrace(wxCommandEvent& event)
+{
+    wxFileDialog dialog(this, "Export Trace", wxEmptyString, "calc_trace.json",
+        "Chrome trace (*.json)|*.json|All files (*.*)|*.*", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+    if (dialog.ShowModal() != wxID_OK)
+    {
+        return;
+    }
+
+    std::FILE* file = wxFopen(dialog.GetPath(), "wb");
+    if (!file)
+    {
+        SetStatusMessage("Cannot open " + dialog.GetPath());
+        return;
+    }
+
+    const bool written = calc::ExportChromeTrace(file);
+    const bool closed = std::fclose(file) == 0;
+    SetStatusMessage(written && closed
+        ? wxString("Trace exported: open it in chrome://tracing or Perfetto")
+        : "Cannot write " + dialog.GetPath());
+}
+
+void MainWindow::OnDisplayPaint(wxPaintEvent& event)
+{
+    CALC_TRACE_PAINT();
+    event.Skip();
+}
+
+void MainWindow::CreateMenuBar()
+{
+    auto* fileMenu = new wxMenu();
+    fileMenu->Append(ID_SAVE_RESULT, "&Save Result As...\tCtrl+S",
+        "Write every digit of the integer result to a file");
+    fileMenu->Append(ID_CANCEL_JOB, "&Cancel Calculation\tEsc",
+        "Stop the running calculation or save");
+    if (calc::INSTRUMENTATION_ENABLED)
+    {
+        fileMenu->Append(ID_EXPORT_TRACE, "Export &Trace...",
+            "Write the recorded trace scopes as Chrome trace JSON (chrome://tracing, Perfetto)");
+    }
+    fileMenu->AppendSeparator();
+    fileMenu->Append(ID_EXIT, "E&xit");
+
+    auto* editMenu = new wxMenu();
+    editMenu->Append(ID_PASTE, "&Paste\tCtrl+V",
+        "Evaluate the expression on the clipboard, or sum a column of numbers");
+
+    auto* viewMenu = new wxMenu();
+    viewMenu->AppendCheckItem(ID_FULL_PRECISION, "&Full precision",
+        "Show results with every significant digit instead of 10");
+    viewMenu->AppendCheckItem(ID_DECIMAL_MODE, "&Decimal mode",
+        "Exact decimal arithmetic with 34 significant digits (0.1 + 0.2 = 0.3)");
+    viewMenu->AppendCheckItem(ID_INTEGER_MODE, "&Integer mode",
+        "Exact integers of any length: powers and factorials without overflow");
+    viewMenu->AppendSeparator();
+    viewMenu->AppendCheckItem(ID_HISTORY, "&History\tCtrl+H",
+        "Show every calculation of this session with search");
+    viewMenu->AppendCheckItem(ID_WORKSHEET, "&Worksheet\tCtrl+W",
+        "Named formulas that reference lines above; an edit recalculates only its dependents");
+    viewMenu->AppendCheckItem(ID_RESULT_CACHE, "&Keep result cache",
+        "Save decimal and integer results on exit and reuse them in the next session");
+    viewMenu->AppendCheckItem(ID_LAYOUT_TIMING, "&Layout timing",
+        "Show in the status bar how long each layout takes and how many resize events it covered");
+    if (calc::INSTRUMENTATION_ENABLED)
+    {
+        viewMenu->AppendCheckItem(ID_METRICS, "&Metrics overlay\tCtrl+M",
+            "Show input-to-paint latency, evaluations per second and allocations per operation");
+    }
+
+    auto* helpMenu = new wxMenu();
+    helpMenu->Append(ID_ABOUT, "&About");
+
+    auto* menuBar = new wxMenuBar();
+    menuBar->Append(fileMenu, "&File");
+    menuBar->Append(editMenu, "&Edit");
+    menuBar->Append(viewMenu, "&View");
+    menuBar->Append(helpMenu, "&Help");
+    SetMenuBar(menuBar);
+
+    //            
+    SyncMenuChecks();
+}
+
+void MainWindow::SyncMenuChecks()
+{
+    wxMenuBar* menuBar = GetMenuBar();
+    if (!menuBar)
+    {
+        return;
+    }
+
+    const calc::NumberMode mode = m_calculator.GetNumberMode();
+    menuBar->Check(ID_FULL_PRECISION, m_entry.GetFormat() == calc::NumberFormat::Full);
+    menuBar->Check(ID_DECIMAL_MODE, mode == calc::NumberMode::Decimal);
+    menuBar->Check(ID_INTEGER_MODE, mode == calc::NumberMode::Integer);
+    menuBar->Check(ID_HISTORY, m_historyPanel != nullptr && m_historyPanel->IsShown());
+    menuBar->Check(ID_WORKSHEET, m_worksheetPanel != nullptr && m_worksheetPanel->IsShown());
+    menuBar->Check(ID_RESULT_CACHE, m_keepResultCache);
+    menuBar->Check(ID_LAYOUT_TIMING, m_measureLayout);
+    if (calc::INSTRUMENTATION_ENABLED)
+    {
+        menuBar->Check(ID_METRICS, m_metricsOverlay != nullptr && m_metricsOverlay->IsShown());
+    }
+}
+
+
+void MainWindow::OnThemeToggle(wxCommandEvent& event) 
+{ /*   */ 
+
+}
+
+void MainWindow::OnFullScreen(wxCommandEvent& event) 
+{ /*   */ 
+
+}
+
+void MainWindow::OnChar(wxKeyEvent& event)
+{
+    //    Ctrl+V      
+    const int code = event.GetKeyCode();
+    if (code == WXK_CONTROL_V || (event.ControlDown() && (code == 'V' || code == 'v')))
+    {
+        PasteClipboard();
+        return;
+    }
+
+    const char key = TranslateKey(event);
+    if (key == 0)
+    {
+        event.Skip();   // Tab, Ctrl+C      
+        return;
+    }
+
+    //   :       
+    if (!m_typeahead.Push(key))
+    {
+        SetStatusMessage("Typing faster than the calculator: keys dropped");
+        return;
+    }
+
+    CALC_TRACE_INPUT();
+    if (!m_job && !m_typeaheadTimer.IsRunning())
+    {
+        m_typeaheadTimer.StartOnce(TYPEAHEAD_INTERVAL_MS);
+    }
+}
+
+void MainWindow::OnTypeaheadTimer(wxTimerEvent& event)
+{
+    CALC_TRACE_OPERATION("MainWindow::OnTypeaheadTimer");
+
+    DrainTypeahead();
+}
+
+char MainWindow::TranslateKey(const wxKeyEvent& event)
+{
+    if (event.HasModifiers())
+    {
+        return 0;
+    }
+
+    switch (event.GetKeyCode())
+    {
+    case WXK_RETURN:
+    case WXK_NUMPAD_ENTER:
+        return '=';
+    case WXK_BACK:
+        return KEY_BACKSPACE;
+    case WXK_DELETE:
+        return KEY_CLEAR_ENTRY;
+    default:
+        break;
+    }
+
+    const unsigned code = static_cast<unsigned>(event.GetUnicodeKey().GetValue());
+    if (code >= '0' && code <= '9')
+    {
+        return static_cast<char>(code);
+    }
+
+    switch (code)
+    {
+    case '.': case ',':
+        return '.';
+    case 'e': case 'E':
+        return 'e';
+    case '=':
+        return '=';
+    default:
+        //     
+        return code < 0x80 && calc::OperatorFromKey(static_cast<char>(code)) != calc::Operator::None
+            ? static_cast<char>(code) : 0;
+    }
+}
+
+void MainWindow::DrainTypeahead()
+{
+    //        ,    wxString  
+    std::size_t applied = 0;
+    char key = 0;
+    while (!m_job && m_typeahead.Pop(key))
+    {
+        ++applied;
+        if (!ApplyKey(key))
+        {
+            //           
+            m_typeahead.Clear();
+            return;
+        }
+    }
+
+    if (applied == 0)
+    {
+        return;
+    }
+
+    ShowEntry();
+    if (m_job)
+    {
+        return;
+    }
+
+    if (m_calculator.HasPendingOperator())
+    {
+        SetStatusMessage(m_calculator.GetExpressionText().c_str());
+        return;
+    }
+
+    char status[STATUS_MESSAGE_LENGTH];
+    std::snprintf(status, sizeof(status), "Keyboard input: %lu keys", static_cast<unsigned long>(applied));
+    SetStatusMessage(status);
+}
+
+bool MainWindow::ApplyKey(char key)
+{
+    if (key >= '0' && key <= '9')
+    {
+        InputDigit(key);
+        return true;
+    }
+
+    switch (key)
+    {
+    case '.':
+        InputDecimal();
+        return true;
+    case 'e':
+        InputExponent();
+        return true;
+    case '=':
+        return Evaluate();
+    case KEY_BACKSPACE:
+        m_entry.Backspace();
+        return true;
+    case KEY_CLEAR_ENTRY:
+        m_entry.Clear();
+        return true;
+    default:
+        return InputOperator(calc::OperatorFromKey(key));
+    }
 }
 
 void MainWindow::ApplyModernStyle() 
@@ -0,0 +1,121 @@
+﻿#include "ui/metrics_overlay.h"
+#include <wx/dcbuffer.h>
+
+#include <algorithm>
+
+MetricsOverlay::MetricsOverlay(wxWindow* parent)
+    : wxWindow(parent, wxID_ANY, wxDefaultPosition, wxSize(-1, OVERLAY_HEIGHT), wxBORDER_NONE)
+    , m_timer(this)
+    , m_metrics(calc::GetTraceMetrics())
+    , m_evaluationRate(0.0)
+    , m_sampleTime(std::chrono::steady_clock::now())
+{
+    SetBackgroundStyle(wxBG_STYLE_PAINT);
+    SetMinSize(wxSize(-1, OVERLAY_HEIGHT));
+
+    Bind(wxEVT_PAINT, &MetricsOverlay::OnPaint, this);
+    Bind(wxEVT_TIMER, &MetricsOverlay::OnTimer, this);
+}
+
+bool MetricsOverlay::Show(bool show)
+{
+    if (show)
+    {
+        Sample();
+        m_timer.Start(REFRESH_INTERVAL_MS);
+    }
+    else
+    {
+        m_timer.Stop();
+    }
+    return wxWindow::Show(show);
+}
+
+void MetricsOverlay::Sample()
+{
+    const std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+    const calc::TraceMetrics metrics = calc::GetTraceMetrics();
+
+    const std::chrono::duration<double> elapsed = now - m_sampleTime;
+    if (elapsed.count() > 0.0)
+    {
+        m_evaluationRate = static_cast<double>(metrics.evaluations - m_metrics.evaluations) / elapsed.count();
+    }
+
+    m_metrics = metrics;
+    m_sampleTime = now;
+}
+
+void MetricsOverlay::OnTimer(wxTimerEvent& event)
+{
+    Sample();
+    Refresh(false);
+}
+
+wxString MetricsOverlay::FormatMicroseconds(double microseconds)
+{
+    return microseconds < 1000.0
+        ? wxString::Format("%.0f us", microseconds)
+        : wxString::Format("%.0f ms", microseconds / 1000.0);
+}
+
+void MetricsOverlay::OnPaint(wxPaintEvent& event)
+{
+    wxAutoBufferedPaintDC dc(this);
+    dc.SetBackground(wxBrush(COLOR_BACKGROUND));
+    dc.Clear();
+
+    wxFont font = GetFont();
+    font.SetPointSize(8);
+    dc.SetFont(font);
+    dc.SetTextForeground(COLOR_TEXT);
+
+    std::uint64_t paints = 0;
+    std::uint64_t tallest = 0;
+    for (const std::uint64_t count : m_metrics.latency)
+    {
+        paints += count;
+        tallest = std::max(tallest, count);
+    }
+
+    const double allocationsPerOperation = m_metrics.operations == 0 ? 0.0
+        : static_cast<double>(m_metrics.operationAllocations) / static_cast<double>(m_metrics.operations);
+
+    const int lineHeight = dc.GetCharHeight();
+    dc.DrawText(wxString::Format("Input to paint: p50 <= %s, p99 <= %s (%llu paints)",
+        FormatMicroseconds(calc::GetLatencyPercentile(m_metrics, 0.5)),
+        FormatMicroseconds(calc::GetLatencyPercentile(m_metrics, 0.99)),
+        static_cast<unsigned long long>(paints)), MARGIN, MARGIN);
+    dc.DrawText(wxString::Format("Evaluations/s: %.0f    Allocations/op: %.1f (%llu ops)",
+        m_evaluationRate, allocationsPerOperation,
+        static_cast<unsigned long long>(m_metrics.operations)), MARGIN, MARGIN + lineHeight);
+
+    // Гистограмма: корзина i — задержки до 2^(i+1) мкс, подписи под первой, 1 мс и последней
+    const wxSize client = GetClientSize();
+    const int top = MARGIN + 2 * lineHeight + MARGIN;
+    const int bottom = client.GetHeight() - MARGIN - lineHeight;
+    const int slot = (client.GetWidth() - 2 * MARGIN) / static_cast<int>(calc::LATENCY_BUCKETS);
+    if (bottom <= top || slot < 2)
+    {
+        return;
+    }
+
+    dc.SetPen(*wxTRANSPARENT_PEN);
+    dc.SetBrush(wxBrush(COLOR_BAR));
+    for (std::size_t i = 0; i < calc::LATENCY_BUCKETS; ++i)
+    {
+        const int x = MARGIN + static_cast<int>(i) * slot;
+        const std::uint64_t count = m_metrics.latency[i];
+        if (count != 0)
+        {
+            const int height = std::max(1, static_cast<int>(static_cast<double>(bottom - top)
+                * static_cast<double>(count) / static_cast<double>(tallest)));
+            dc.DrawRectangle(wxRect(x + 1, bottom - height, slot - 2, height));
+        }
+    }
+
+    dc.DrawText("<2 us", MARGIN, bottom);
+    dc.DrawText("1 ms", MARGIN + 10 * slot, bottom);
+    const wxString last = "33 ms+";
+    dc.DrawText(last, MARGIN + 16 * slot - dc.GetTextExtent(last).GetWidth(), bottom);
+}
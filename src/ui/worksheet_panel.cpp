@@ -0,0 +1,241 @@
+﻿#include "ui/worksheet_panel.h"
+#include "engine/calculator.h"
+#include <wx/filedlg.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+WorksheetPanel::WorksheetList::WorksheetList(WorksheetPanel* owner)
+    : wxListCtrl(owner, wxID_ANY, wxDefaultPosition, wxDefaultSize,
+        wxLC_REPORT | wxLC_VIRTUAL | wxLC_SINGLE_SEL)
+    , m_owner(owner)
+{
+    AppendColumn("#", wxLIST_FORMAT_RIGHT, 50);
+    AppendColumn("Formula", wxLIST_FORMAT_LEFT, 240);
+    AppendColumn("Value", wxLIST_FORMAT_RIGHT, 120);
+}
+
+wxString WorksheetPanel::WorksheetList::OnGetItemText(long item, long column) const
+{
+    return m_owner->GetCellText(item, column);
+}
+
+WorksheetPanel::WorksheetPanel(wxWindow* parent)
+    : wxPanel(parent, wxID_ANY)
+    , m_line(0)
+    , m_editor(nullptr)
+    , m_list(nullptr)
+    , m_summary(nullptr)
+{
+    m_editor = new wxTextCtrl(this, wxID_ANY, wxEmptyString, wxDefaultPosition, wxDefaultSize,
+        wxTE_PROCESS_ENTER);
+    m_editor->SetHint("name = expression");
+    m_list = new WorksheetList(this);
+    m_summary = new wxStaticText(this, wxID_ANY, wxEmptyString);
+
+    auto* openButton = new wxButton(this, wxID_OPEN, "Open...");
+    auto* saveButton = new wxButton(this, wxID_SAVE, "Save...");
+    auto* buttons = new wxBoxSizer(wxHORIZONTAL);
+    buttons->Add(m_summary, 1, wxALIGN_CENTER_VERTICAL);
+    buttons->Add(openButton, 0, wxLEFT, 5);
+    buttons->Add(saveButton, 0, wxLEFT, 5);
+
+    auto* sizer = new wxBoxSizer(wxVERTICAL);
+    sizer->Add(m_editor, 0, wxEXPAND | wxBOTTOM, 5);
+    sizer->Add(m_list, 1, wxEXPAND);
+    sizer->Add(buttons, 0, wxEXPAND | wxTOP, 5);
+    SetSizer(sizer);
+
+    m_editor->Bind(wxEVT_TEXT, &WorksheetPanel::OnEditorText, this);
+    m_editor->Bind(wxEVT_TEXT_ENTER, &WorksheetPanel::OnEditorEnter, this);
+    m_list->Bind(wxEVT_LIST_ITEM_SELECTED, &WorksheetPanel::OnItemSelected, this);
+    m_list->Bind(wxEVT_LIST_KEY_DOWN, &WorksheetPanel::OnListKey, this);
+    openButton->Bind(wxEVT_BUTTON, &WorksheetPanel::OnOpen, this);
+    saveButton->Bind(wxEVT_BUTTON, &WorksheetPanel::OnSave, this);
+
+    // В листе всегда есть строка, которую правит строка правки
+    m_worksheet.InsertLine(0, std::string_view());
+    Recalculate();
+    SelectLine(0);
+}
+
+bool WorksheetPanel::PasteIntoEditor()
+{
+    if (FindFocus() != m_editor)
+    {
+        return false;
+    }
+
+    m_editor->Paste();
+    return true;
+}
+
+wxString WorksheetPanel::GetCellText(long row, long column) const
+{
+    if (row < 0 || static_cast<std::size_t>(row) >= m_worksheet.GetLineCount())
+    {
+        return wxEmptyString;
+    }
+
+    const auto line = static_cast<std::size_t>(row);
+    switch (column)
+    {
+    case COLUMN_LINE:
+        return wxString::Format("%zu", line + 1);
+    case COLUMN_FORMULA:
+    {
+        const std::string& text = m_worksheet.GetLine(line);
+        return wxString::FromUTF8(text.data(), text.size());
+    }
+    case COLUMN_VALUE:
+    {
+        if (m_worksheet.IsBlank(line))
+        {
+            return wxEmptyString;
+        }
+
+        const calc::EvalResult& result = m_worksheet.GetResult(line);
+        if (!result.Ok())
+        {
+            return calc::Calculator::ErrorMessage(result.error);
+        }
+
+        char buffer[32];
+        const std::size_t length = calc::Calculator::FormatNumber(result.value, buffer, sizeof(buffer));
+        return wxString::FromAscii(buffer, length);
+    }
+    }
+    return wxEmptyString;
+}
+
+void WorksheetPanel::SelectLine(std::size_t line)
+{
+    m_line = line;
+    const std::string& text = m_worksheet.GetLine(line);
+
+    // ChangeValue не шлёт wxEVT_TEXT: выбор строки — не правка
+    m_editor->ChangeValue(wxString::FromUTF8(text.data(), text.size()));
+    m_list->SetItemState(static_cast<long>(line), wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED,
+        wxLIST_STATE_SELECTED | wxLIST_STATE_FOCUSED);
+    m_list->EnsureVisible(static_cast<long>(line));
+}
+
+void WorksheetPanel::Recalculate()
+{
+    const auto start = std::chrono::steady_clock::now();
+    const calc::WorksheetStats& stats = m_worksheet.Recalculate();
+    const std::chrono::duration<double, std::milli> elapsed = std::chrono::steady_clock::now() - start;
+
+    // Виртуальный список перерисовывает только видимые строки
+    m_list->SetItemCount(static_cast<long>(m_worksheet.GetLineCount()));
+    m_list->Refresh();
+
+    m_summary->SetLabel(wxString::Format("%zu lines, %zu recalculated in %.2f ms (%u threads)",
+        m_worksheet.GetLineCount(), stats.recomputed, elapsed.count(), stats.threads));
+}
+
+void WorksheetPanel::OnEditorText(wxCommandEvent& event)
+{
+    m_worksheet.SetLine(m_line, std::string(m_editor->GetValue().utf8_str()));
+    Recalculate();
+}
+
+void WorksheetPanel::OnEditorEnter(wxCommandEvent& event)
+{
+    m_worksheet.InsertLine(m_line + 1, std::string_view());
+    Recalculate();
+    SelectLine(m_line + 1);
+}
+
+void WorksheetPanel::OnItemSelected(wxListEvent& event)
+{
+    // Выделение из SelectLine приходит сюда же — строка уже в строке правки
+    const long row = event.GetIndex();
+    if (row >= 0 && static_cast<std::size_t>(row) < m_worksheet.GetLineCount()
+        && static_cast<std::size_t>(row) != m_line)
+    {
+        SelectLine(static_cast<std::size_t>(row));
+    }
+}
+
+void WorksheetPanel::OnListKey(wxListEvent& event)
+{
+    if (event.GetKeyCode() != WXK_DELETE)
+    {
+        event.Skip();
+        return;
+    }
+
+    if (m_worksheet.GetLineCount() == 1)
+    {
+        m_worksheet.SetLine(0, std::string_view());
+    }
+    else
+    {
+        m_worksheet.RemoveLine(m_line);
+    }
+    Recalculate();
+    SelectLine(std::min(m_line, m_worksheet.GetLineCount() - 1));
+}
+
+void WorksheetPanel::OnOpen(wxCommandEvent& event)
+{
+    wxFileDialog dialog(this, "Open Worksheet", wxEmptyString, wxEmptyString,
+        "Text files (*.txt)|*.txt|All files (*.*)|*.*", wxFD_OPEN | wxFD_FILE_MUST_EXIST);
+    if (dialog.ShowModal() != wxID_OK)
+    {
+        return;
+    }
+
+    std::FILE* file = wxFopen(dialog.GetPath(), "rb");
+    if (!file)
+    {
+        m_summary->SetLabel("Cannot open " + dialog.GetPath());
+        return;
+    }
+
+    std::string text;
+    char buffer[65536];
+    std::size_t read;
+    while ((read = std::fread(buffer, 1, sizeof(buffer), file)) != 0)
+    {
+        text.append(buffer, read);
+    }
+    std::fclose(file);
+
+    // Совпавшие с открытым листом строки не перекомпилируются и не пересчитываются
+    m_worksheet.SetText(text);
+    if (m_worksheet.GetLineCount() == 0)
+    {
+        m_worksheet.InsertLine(0, std::string_view());
+    }
+    Recalculate();
+    SelectLine(0);
+}
+
+void WorksheetPanel::OnSave(wxCommandEvent& event)
+{
+    wxFileDialog dialog(this, "Save Worksheet", wxEmptyString, "worksheet.txt",
+        "Text files (*.txt)|*.txt|All files (*.*)|*.*", wxFD_SAVE | wxFD_OVERWRITE_PROMPT);
+    if (dialog.ShowModal() != wxID_OK)
+    {
+        return;
+    }
+
+    std::FILE* file = wxFopen(dialog.GetPath(), "wb");
+    if (!file)
+    {
+        m_summary->SetLabel("Cannot open " + dialog.GetPath());
+        return;
+    }
+
+    std::string text;
+    m_worksheet.WriteText(text);
+    const bool written = std::fwrite(text.data(), 1, text.size(), file) == text.size();
+    const bool closed = std::fclose(file) == 0;
+    m_summary->SetLabel(written && closed
+        ? wxString::Format("Saved %zu lines", m_worksheet.GetLineCount())
+        : "Cannot write " + dialog.GetPath());
+}
@@ -0,0 +1,224 @@
+#include "engine/batch.h"
+#include "engine/mapped_file.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                          🧪 ПАКЕТНЫЙ РЕЖИМ                                ║
+ ║       Разбор командной строки, выбор mmap или потока, строки куска        ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+
+namespace
+{
+
+bool Parse(std::vector<std::string> arguments, calc::BatchOptions& options)
+{
+    arguments.insert(arguments.begin(), "Calculator");
+    std::vector<char*> argv;
+    for (std::string& argument : arguments)
+    {
+        argv.push_back(argument.data());
+    }
+    return calc::BatchRunner::ParseArguments(static_cast<int>(argv.size()), argv.data(), options);
+}
+
+std::string WriteTempFile(const char* name, const std::string& content)
+{
+    const std::string path = ::testing::TempDir() + name;
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    std::fwrite(content.data(), 1, content.size(), file);
+    std::fclose(file);
+    return path;
+}
+
+std::string EvaluateLines(const std::string& lines, calc::NumberMode mode = calc::NumberMode::Binary)
+{
+    calc::BatchEvaluators evaluators;
+    std::string output;
+    std::uint64_t lineCount = 0;
+    std::uint64_t errorCount = 0;
+    calc::BatchRunner::EvaluateLines(evaluators, lines, calc::NumberFormat::Compact, mode,
+        output, lineCount, errorCount);
+    return output;
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🔍 Командная строка
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(BatchArguments, WithoutBatchTheCommandLineBelongsToGui)
+{
+    calc::BatchOptions options;
+    EXPECT_FALSE(Parse({ "--some-toolkit-option" }, options));
+}
+
+TEST(BatchArguments, AllOptions)
+{
+    calc::BatchOptions options;
+    ASSERT_TRUE(Parse({ "--batch", "in.txt", "--threads", "4", "--full-precision", "--decimal",
+        "--precision", "50", "--result-cache", "results.cache" }, options));
+    EXPECT_TRUE(options.invalidArgument.empty());
+    EXPECT_EQ(options.inputPath, "in.txt");
+    EXPECT_EQ(options.threads, 4u);
+    EXPECT_EQ(options.format, calc::NumberFormat::Full);
+    EXPECT_EQ(options.mode, calc::NumberMode::Decimal);
+    EXPECT_EQ(options.precision, 50u);
+    EXPECT_EQ(options.cachePath, "results.cache");
+
+    // FILE — в любом месте после --batch
+    calc::BatchOptions trailing;
+    ASSERT_TRUE(Parse({ "--batch", "--decimal", "in.txt", "--threads", "2" }, trailing));
+    EXPECT_TRUE(trailing.invalidArgument.empty());
+    EXPECT_EQ(trailing.inputPath, "in.txt");
+    EXPECT_EQ(trailing.mode, calc::NumberMode::Decimal);
+    EXPECT_EQ(trailing.threads, 2u);
+
+    calc::BatchOptions last;
+    ASSERT_TRUE(Parse({ "--batch", "--integer", "-" }, last));
+    EXPECT_TRUE(last.invalidArgument.empty());
+    EXPECT_EQ(last.inputPath, "-");
+}
+
+TEST(BatchArguments, SecondFileIsRejected)
+{
+    calc::BatchOptions options;
+    ASSERT_TRUE(Parse({ "--batch", "in.txt", "--decimal", "other.txt" }, options));
+    EXPECT_EQ(options.invalidArgument, "other.txt");
+    EXPECT_EQ(options.inputPath, "in.txt");
+
+    calc::BatchOptions before;
+    ASSERT_TRUE(Parse({ "in.txt", "--batch" }, before));
+    EXPECT_EQ(before.invalidArgument, "in.txt");
+}
+
+TEST(BatchArguments, StdinWhenNoFile)
+{
+    calc::BatchOptions options;
+    ASSERT_TRUE(Parse({ "--batch", "--integer" }, options));
+    EXPECT_TRUE(options.inputPath.empty());
+    EXPECT_EQ(options.mode, calc::NumberMode::Integer);
+}
+
+TEST(BatchArguments, UnknownOptionIsRejected)
+{
+    calc::BatchOptions options;
+    ASSERT_TRUE(Parse({ "--batch", "--cache", "x" }, options));
+    EXPECT_EQ(options.invalidArgument, "--cache");
+    EXPECT_TRUE(options.cachePath.empty());
+    EXPECT_EQ(calc::BatchRunner::Run(options), 2);
+}
+
+TEST(BatchArguments, BadValuesAreRejected)
+{
+    calc::BatchOptions threads;
+    ASSERT_TRUE(Parse({ "--batch", "--threads", "four" }, threads));
+    EXPECT_EQ(threads.invalidArgument, "--threads four");
+
+    calc::BatchOptions precision;
+    ASSERT_TRUE(Parse({ "--batch", "--decimal", "--precision", "0" }, precision));
+    EXPECT_EQ(precision.invalidArgument, "--precision 0");
+
+    calc::BatchOptions missing;
+    ASSERT_TRUE(Parse({ "--batch", "--result-cache" }, missing));
+    EXPECT_EQ(missing.invalidArgument, "--result-cache");
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🗺️ Вход: обычный файл отображается, остальное читается потоком
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(BatchInput, RegularFileIsMapped)
+{
+    const std::string path = WriteTempFile("calc_batch_regular.txt", "1+2\n");
+    calc::MappedFile mapped;
+    ASSERT_TRUE(mapped.Open(path));
+    EXPECT_EQ(mapped.GetView(), "1+2\n");
+    mapped.Close();
+    std::remove(path.c_str());
+}
+
+TEST(BatchInput, EmptyRegularFileIsOpen)
+{
+    const std::string path = WriteTempFile("calc_batch_empty.txt", "");
+    calc::MappedFile mapped;
+    ASSERT_TRUE(mapped.Open(path));
+    EXPECT_TRUE(mapped.IsOpen());
+    EXPECT_TRUE(mapped.GetView().empty());
+    std::remove(path.c_str());
+}
+
+TEST(BatchInput, MissingFileIsNotMapped)
+{
+    calc::MappedFile mapped;
+    EXPECT_FALSE(mapped.Open(::testing::TempDir() + "calc_batch_missing.txt"));
+    EXPECT_FALSE(mapped.IsOpen());
+}
+
+#ifndef _WIN32
+TEST(BatchInput, FifoIsNotMapped)
+{
+    // Без писателя open() у FIFO ждал бы вечно: Open должен отказаться раньше
+    const std::string path = ::testing::TempDir() + "calc_batch_fifo";
+    ::unlink(path.c_str());
+    ASSERT_EQ(::mkfifo(path.c_str(), 0600), 0);
+
+    calc::MappedFile mapped;
+    EXPECT_FALSE(mapped.Open(path));
+    EXPECT_FALSE(mapped.IsOpen());
+    ::unlink(path.c_str());
+}
+
+TEST(BatchInput, PipeIsNotMapped)
+{
+    int fds[2];
+    ASSERT_EQ(::pipe(fds), 0);
+    ASSERT_EQ(::write(fds[1], "1+2\n", 4), 4);
+
+    calc::MappedFile mapped;
+    EXPECT_FALSE(mapped.Open("/dev/fd/" + std::to_string(fds[0])));
+    ::close(fds[0]);
+    ::close(fds[1]);
+}
+#endif
+
+//──────────────────────────────────────────────────────────────────────────────
+// 📝 Строки
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(BatchLines, OneResultPerLineInOrder)
+{
+    EXPECT_EQ(EvaluateLines("1+2\n\n2^10\r\n1/0\n(1\n"),
+        "3\n\n1024\nError: Division by zero\nError: Unbalanced parentheses\n");
+}
+
+TEST(BatchLines, NonFiniteResultsAreErrors)
+{
+    EXPECT_EQ(EvaluateLines("sqrt(-1)\nln(0)\ngamma(-1)\n0^-1\n1e308*10\n(-8)^(1/3)\n"),
+        "Error: Error\nError: Overflow\nError: Error\n"
+        "Error: Overflow\nError: Overflow\nError: Error\n");
+}
+
+TEST(BatchLines, LastLineWithoutNewline)
+{
+    EXPECT_EQ(EvaluateLines("2*3"), "6\n");
+}
+
+TEST(BatchLines, DecimalAndIntegerModes)
+{
+    EXPECT_EQ(EvaluateLines("0.1+0.2\n", calc::NumberMode::Decimal), "0.3\n");
+    EXPECT_EQ(EvaluateLines("2^100\n", calc::NumberMode::Integer), "1267650600228229401496703205376\n");
+}
+
+} // namespace
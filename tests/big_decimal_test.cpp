@@ -0,0 +1,334 @@
+#include "engine/big_decimal.h"
+
+#include "reference_arithmetic.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <iterator>
+#include <random>
+#include <string>
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                          🧪 BIGDECIMAL                                    ║
+ ║       Случайные операнды по обе стороны порогов Карацубы и Ньютона        ║
+ ║       против школьного умножения; деление и корень — по точному остатку   ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+
+namespace
+{
+
+using calc::BigDecimal;
+using calc::CalcError;
+
+constexpr std::uint32_t EXACT = BigDecimal::MAX_PRECISION;
+constexpr std::size_t LIMB_DIGITS = BigDecimal::BASE_DIGITS;
+
+struct Operand
+{
+    reference::Decimal exact;
+    BigDecimal value;
+};
+
+Operand MakeOperand(std::mt19937_64& random, std::size_t digits, std::int64_t maxExponent)
+{
+    Operand operand;
+    const bool negative = random() % 2 == 1;
+    const std::int64_t exponent = static_cast<std::int64_t>(random() % (2 * maxExponent + 1)) - maxExponent;
+
+    std::string text = negative ? "-" : "";
+    text += reference::RandomDigits(random, digits);
+    text += "e" + std::to_string(exponent);
+
+    EXPECT_TRUE(operand.value.Parse(text, EXACT));
+    operand.exact = reference::ParseDecimal(text);
+    return operand;
+}
+
+reference::Decimal Exact(const BigDecimal& value)
+{
+    return reference::ParseDecimal(value.ToString());
+}
+
+reference::Decimal ReferenceProduct(const reference::Decimal& a, const reference::Decimal& b)
+{
+    return reference::Normalize(a.negative != b.negative, reference::Multiply(a.digits, b.digits),
+        a.exponent + b.exponent);
+}
+
+BigDecimal Abs(BigDecimal value)
+{
+    if (value.IsNegative())
+    {
+        value.Negate();
+    }
+    return value;
+}
+
+/// ➗ |a − q·b| ≤ ½·ulp(q)·|b| — q правильно округлено до precision цифр
+void ExpectCorrectlyRounded(const Operand& a, const Operand& b, const BigDecimal& q, std::uint32_t precision)
+{
+    const reference::Decimal quotient = Exact(q);
+    ASSERT_LE(quotient.digits.size(), precision);
+
+    BigDecimal product;
+    ASSERT_EQ(BigDecimal::Multiply(q, b.value, product, EXACT), CalcError::None);
+    BigDecimal error;
+    ASSERT_EQ(BigDecimal::Subtract(a.value, product, error, EXACT), CalcError::None);
+
+    BigDecimal two;
+    two.SetInteger(2);
+    BigDecimal twiceError;
+    ASSERT_EQ(BigDecimal::Multiply(Abs(error), two, twiceError, EXACT), CalcError::None);
+
+    const std::int64_t leading = quotient.exponent + static_cast<std::int64_t>(quotient.digits.size()) - 1;
+    BigDecimal ulp;
+    ASSERT_TRUE(ulp.Parse("1e" + std::to_string(leading - static_cast<std::int64_t>(precision) + 1), EXACT));
+    BigDecimal bound;
+    ASSERT_EQ(BigDecimal::Multiply(ulp, Abs(b.value), bound, EXACT), CalcError::None);
+
+    BigDecimal slack;
+    ASSERT_EQ(BigDecimal::Subtract(bound, twiceError, slack, EXACT), CalcError::None);
+    EXPECT_FALSE(slack.IsNegative()) << "precision " << precision << ", divisor digits " << b.exact.digits.size();
+}
+
+/// √ (y − ½·ulp⁻)² ≤ a ≤ (y + ½·ulp)² — y правильно округлённый корень
+///   (ulp⁻ — шаг к соседу снизу: у степени десяти он в десять раз мельче)
+void ExpectCorrectlyRoundedRoot(const BigDecimal& a, const BigDecimal& y, std::uint32_t precision)
+{
+    const reference::Decimal root = Exact(y);
+    ASSERT_LE(root.digits.size(), precision);
+
+    const std::int64_t leading = root.exponent + static_cast<std::int64_t>(root.digits.size()) - 1;
+    const std::int64_t ulp = leading - static_cast<std::int64_t>(precision) + 1;
+    const std::int64_t ulpBelow = root.digits == "1" ? ulp - 1 : ulp;
+
+    BigDecimal halfUp;
+    BigDecimal halfDown;
+    ASSERT_TRUE(halfUp.Parse("5e" + std::to_string(ulp - 1), EXACT));
+    ASSERT_TRUE(halfDown.Parse("5e" + std::to_string(ulpBelow - 1), EXACT));
+
+    BigDecimal upper;
+    BigDecimal lower;
+    ASSERT_EQ(BigDecimal::Add(y, halfUp, upper, EXACT), CalcError::None);
+    ASSERT_EQ(BigDecimal::Subtract(y, halfDown, lower, EXACT), CalcError::None);
+    ASSERT_EQ(BigDecimal::Multiply(upper, upper, upper, EXACT), CalcError::None);
+    ASSERT_EQ(BigDecimal::Multiply(lower, lower, lower, EXACT), CalcError::None);
+
+    BigDecimal slack;
+    ASSERT_EQ(BigDecimal::Subtract(upper, a, slack, EXACT), CalcError::None);
+    EXPECT_FALSE(slack.IsNegative()) << "root too small, precision " << precision;
+    ASSERT_EQ(BigDecimal::Subtract(a, lower, slack, EXACT), CalcError::None);
+    EXPECT_FALSE(slack.IsNegative()) << "root too large, precision " << precision;
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// ✖️ Умножение: школьное ↔ Карацуба
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(BigDecimalMultiply, ExactAcrossKaratsubaThreshold)
+{
+    std::mt19937_64 random(8);
+    const std::size_t limbs[] = { 1, 2, BigDecimal::KARATSUBA_THRESHOLD - 1, BigDecimal::KARATSUBA_THRESHOLD,
+        BigDecimal::KARATSUBA_THRESHOLD + 1, 2 * BigDecimal::KARATSUBA_THRESHOLD + 3, 300 };
+
+    for (const std::size_t la : limbs)
+    {
+        for (const std::size_t lb : limbs)
+        {
+            const Operand a = MakeOperand(random, la * LIMB_DIGITS - random() % LIMB_DIGITS, 40);
+            const Operand b = MakeOperand(random, lb * LIMB_DIGITS - random() % LIMB_DIGITS, 40);
+
+            BigDecimal product;
+            ASSERT_EQ(BigDecimal::Multiply(a.value, b.value, product, EXACT), CalcError::None);
+            EXPECT_EQ(Exact(product), ReferenceProduct(a.exact, b.exact)) << la << " x " << lb << " limbs";
+        }
+    }
+}
+
+TEST(BigDecimalMultiply, RoundsHalfEven)
+{
+    std::mt19937_64 random(80);
+    for (int trial = 0; trial < 300; ++trial)
+    {
+        const std::size_t digits = 1 + random() % (3 * BigDecimal::KARATSUBA_THRESHOLD * LIMB_DIGITS);
+        const Operand a = MakeOperand(random, digits, 20);
+        const Operand b = MakeOperand(random, 1 + random() % digits, 20);
+        const std::uint32_t precision = static_cast<std::uint32_t>(1 + random() % (digits + 5));
+
+        BigDecimal product;
+        ASSERT_EQ(BigDecimal::Multiply(a.value, b.value, product, precision), CalcError::None);
+        EXPECT_EQ(Exact(product), reference::Round(ReferenceProduct(a.exact, b.exact), precision))
+            << "trial " << trial << ", precision " << precision;
+    }
+}
+
+TEST(BigDecimalMultiply, HalfwayCasesRoundToEven)
+{
+    BigDecimal a;
+    BigDecimal b;
+    BigDecimal product;
+    ASSERT_TRUE(a.Parse("125", 34));
+    ASSERT_TRUE(b.Parse("1", 34));
+    ASSERT_EQ(BigDecimal::Multiply(a, b, product, 2), CalcError::None);
+    EXPECT_EQ(product.ToString(), "120");
+
+    ASSERT_TRUE(a.Parse("135", 34));
+    ASSERT_EQ(BigDecimal::Multiply(a, b, product, 2), CalcError::None);
+    EXPECT_EQ(product.ToString(), "140");
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// ➗ Деление: алгоритм D ↔ Ньютон
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(BigDecimalDivide, CorrectlyRoundedBelowNewtonThreshold)
+{
+    std::mt19937_64 random(88);
+    const std::uint32_t precisions[] = { 1, 2, 9, 34, 100, 1000 };
+    for (int trial = 0; trial < 120; ++trial)
+    {
+        const Operand a = MakeOperand(random, 1 + random() % 2000, 30);
+        const Operand b = MakeOperand(random, 1 + random() % 2000, 30);
+        const std::uint32_t precision = precisions[trial % std::size(precisions)];
+
+        BigDecimal quotient;
+        ASSERT_EQ(BigDecimal::Divide(a.value, b.value, quotient, precision), CalcError::None);
+        ExpectCorrectlyRounded(a, b, quotient, precision);
+    }
+}
+
+TEST(BigDecimalDivide, CorrectlyRoundedAboveNewtonThreshold)
+{
+    std::mt19937_64 random(888);
+    const std::size_t divisorDigits = BigDecimal::NEWTON_THRESHOLD * LIMB_DIGITS;
+    const std::uint32_t precisions[] = { 34, 5000 };
+    for (int trial = 0; trial < 4; ++trial)
+    {
+        const Operand a = MakeOperand(random, divisorDigits + random() % 2000, 10);
+        const Operand b = MakeOperand(random, divisorDigits + random() % 500, 10);
+        const std::uint32_t precision = precisions[trial % std::size(precisions)];
+
+        BigDecimal quotient;
+        ASSERT_EQ(BigDecimal::Divide(a.value, b.value, quotient, precision), CalcError::None);
+        ExpectCorrectlyRounded(a, b, quotient, precision);
+    }
+}
+
+TEST(BigDecimalDivide, ExactQuotientsStayExact)
+{
+    std::mt19937_64 random(8888);
+    for (int trial = 0; trial < 40; ++trial)
+    {
+        const Operand q = MakeOperand(random, 1 + random() % 300, 10);
+        const Operand b = MakeOperand(random, 1 + random() % (BigDecimal::KARATSUBA_THRESHOLD * LIMB_DIGITS * 2), 10);
+
+        BigDecimal a;
+        ASSERT_EQ(BigDecimal::Multiply(q.value, b.value, a, EXACT), CalcError::None);
+        BigDecimal quotient;
+        ASSERT_EQ(BigDecimal::Divide(a, b.value, quotient, 400), CalcError::None);
+        EXPECT_EQ(Exact(quotient), q.exact) << "trial " << trial;
+    }
+}
+
+TEST(BigDecimalDivide, ByZero)
+{
+    BigDecimal one;
+    one.SetInteger(1);
+    BigDecimal zero;
+    BigDecimal out;
+    EXPECT_EQ(BigDecimal::Divide(one, zero, out, 34), CalcError::DivisionByZero);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// √ Корень: Ньютон и точная проверка середины
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(BigDecimalSquareRoot, CorrectlyRounded)
+{
+    std::mt19937_64 random(8888);
+    for (int trial = 0; trial < 300; ++trial)
+    {
+        const Operand a = MakeOperand(random, 1 + random() % 60, 40);
+        const std::uint32_t precision = trial % 50 == 0 ? 1000 : static_cast<std::uint32_t>(1 + random() % 60);
+
+        BigDecimal root;
+        ASSERT_EQ(BigDecimal::SquareRoot(Abs(a.value), root, precision), CalcError::None);
+        ExpectCorrectlyRoundedRoot(Abs(a.value), root, precision);
+    }
+}
+
+TEST(BigDecimalSquareRoot, NoDoubleRounding)
+{
+    const struct { const char* value; std::uint32_t precision; const char* root; } cases[] = {
+        { "0.3576", 34, "0.5979966555090421239403723053051815" },
+        { "9e5", 1, "900" },
+        { "99.9", 2, "10" },
+        { "0.81", 1, "0.9" },
+        { "2.25", 1, "2" },     // 1.5 — середина: к чётному
+        { "6.25", 1, "2" }      // 2.5 — тоже к чётному
+    };
+    for (const auto& c : cases)
+    {
+        BigDecimal a;
+        BigDecimal root;
+        ASSERT_TRUE(a.Parse(c.value, EXACT));
+        ASSERT_EQ(BigDecimal::SquareRoot(a, root, c.precision), CalcError::None);
+        EXPECT_EQ(Exact(root), reference::ParseDecimal(c.root)) << c.value << " at " << c.precision;
+    }
+}
+
+TEST(BigDecimalSquareRoot, PerfectSquaresAreExact)
+{
+    std::mt19937_64 random(88888);
+    for (int trial = 0; trial < 40; ++trial)
+    {
+        const Operand q = MakeOperand(random, 1 + random() % 40, 20);
+        BigDecimal square;
+        ASSERT_EQ(BigDecimal::Multiply(q.value, q.value, square, EXACT), CalcError::None);
+
+        BigDecimal root;
+        ASSERT_EQ(BigDecimal::SquareRoot(square, root, 40), CalcError::None);
+        EXPECT_EQ(Exact(root), Exact(Abs(q.value))) << "trial " << trial;
+    }
+
+    BigDecimal minusOne;
+    minusOne.SetInteger(-1);
+    BigDecimal root;
+    EXPECT_EQ(BigDecimal::SquareRoot(minusOne, root, 34), CalcError::InvalidNumber);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🔄 Запись и разбор
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(BigDecimalText, ParseRoundsAndPrintsBack)
+{
+    std::mt19937_64 random(8);
+    for (int trial = 0; trial < 200; ++trial)
+    {
+        const std::string digits = reference::RandomDigits(random, 1 + random() % 400);
+        const std::int64_t exponent = static_cast<std::int64_t>(random() % 121) - 60;
+        const std::string text = digits + "e" + std::to_string(exponent);
+        const std::uint32_t precision = static_cast<std::uint32_t>(1 + random() % 450);
+
+        BigDecimal value;
+        ASSERT_TRUE(value.Parse(text, precision));
+        EXPECT_EQ(Exact(value), reference::Round(reference::ParseDecimal(text), precision)) << text;
+    }
+}
+
+TEST(BigDecimalText, DecimalFractionsAreExact)
+{
+    BigDecimal a;
+    BigDecimal b;
+    BigDecimal sum;
+    ASSERT_TRUE(a.Parse("0.1", 34));
+    ASSERT_TRUE(b.Parse("0.2", 34));
+    ASSERT_EQ(BigDecimal::Add(a, b, sum, 34), CalcError::None);
+    EXPECT_EQ(sum.ToString(), "0.3");
+}
+
+} // namespace
@@ -0,0 +1,266 @@
+#include "engine/big_integer.h"
+
+#include "reference_arithmetic.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <utility>
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                          🧪 BIGINTEGER                                    ║
+ ║       Случайные операнды по обе стороны порогов Карацубы, Тоома-3,        ║
+ ║       NTT и Ньютона; умножение и перевод основания — против школьного     ║
+ ║       умножения строк, деление — по остатку                               ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+
+namespace
+{
+
+using calc::BigInteger;
+using calc::CalcError;
+
+/// 📏 Десятичных цифр в limbs двоичных лимбах (32·log10(2) ≈ 9.63)
+std::size_t DigitsForLimbs(std::size_t limbs)
+{
+    return limbs * 963 / 100;
+}
+
+struct Operand
+{
+    bool negative = false;
+    std::string digits;
+    BigInteger value;
+};
+
+Operand MakeOperand(std::mt19937_64& random, std::size_t digits)
+{
+    Operand operand;
+    operand.negative = random() % 2 == 1;
+    operand.digits = reference::RandomDigits(random, digits);
+    EXPECT_TRUE(operand.value.Parse((operand.negative ? "-" : "") + operand.digits));
+    return operand;
+}
+
+std::string Signed(bool negative, const std::string& digits)
+{
+    return negative && digits != "0" ? "-" + digits : digits;
+}
+
+BigInteger Abs(BigInteger value)
+{
+    if (value.IsNegative())
+    {
+        value.Negate();
+    }
+    return value;
+}
+
+void ExpectProduct(const Operand& a, const Operand& b)
+{
+    BigInteger product;
+    ASSERT_EQ(BigInteger::Multiply(a.value, b.value, product), CalcError::None);
+    EXPECT_EQ(product.ToString(), Signed(a.negative != b.negative, reference::Multiply(a.digits, b.digits)))
+        << a.digits.size() << " x " << b.digits.size() << " digits";
+}
+
+/// ➗ a = q·b + r, |r| < |b|, знак r — как у a (деление с отбрасыванием дроби)
+void ExpectQuotient(const BigInteger& a, const BigInteger& b)
+{
+    BigInteger q;
+    ASSERT_EQ(BigInteger::Divide(a, b, q), CalcError::None);
+
+    BigInteger product;
+    ASSERT_EQ(BigInteger::Multiply(q, b, product), CalcError::None);
+    BigInteger r;
+    ASSERT_EQ(BigInteger::Subtract(a, product, r), CalcError::None);
+    EXPECT_TRUE(r.IsZero() || r.IsNegative() == a.IsNegative());
+
+    BigInteger slack;
+    ASSERT_EQ(BigInteger::Subtract(Abs(b), Abs(r), slack), CalcError::None);
+    EXPECT_FALSE(slack.IsNegative() || slack.IsZero())
+        << a.GetDecimalDigitCount() << " / " << b.GetDecimalDigitCount() << " digits";
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// ✖️ Умножение: школьное → Карацуба → Тоом-3 → NTT
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(BigIntegerMultiply, BalancedAcrossThresholds)
+{
+    std::mt19937_64 random(9);
+    const std::size_t limbs[] = {
+        1, 2,
+        BigInteger::KARATSUBA_THRESHOLD - 1, BigInteger::KARATSUBA_THRESHOLD + 1,
+        BigInteger::TOOM3_THRESHOLD - 1, BigInteger::TOOM3_THRESHOLD + 1, 3 * BigInteger::TOOM3_THRESHOLD,
+        BigInteger::NTT_THRESHOLD - 1, BigInteger::NTT_THRESHOLD + 1
+    };
+
+    for (const std::size_t size : limbs)
+    {
+        const Operand a = MakeOperand(random, DigitsForLimbs(size) + random() % 9);
+        const Operand b = MakeOperand(random, DigitsForLimbs(size) + random() % 9);
+        ExpectProduct(a, b);
+        ExpectProduct(a, a);
+    }
+}
+
+TEST(BigIntegerMultiply, UnbalancedAcrossThresholds)
+{
+    std::mt19937_64 random(99);
+    const std::pair<std::size_t, std::size_t> limbs[] = {
+        { BigInteger::KARATSUBA_THRESHOLD + 1, 3 },
+        { 5 * BigInteger::KARATSUBA_THRESHOLD, BigInteger::KARATSUBA_THRESHOLD + 1 },
+        { 4 * BigInteger::TOOM3_THRESHOLD, BigInteger::TOOM3_THRESHOLD + 1 },
+        { 2 * BigInteger::TOOM3_THRESHOLD, 2 * BigInteger::TOOM3_THRESHOLD / 3 + 1 },
+        { 3 * BigInteger::NTT_THRESHOLD, BigInteger::NTT_THRESHOLD + 1 },
+        { BigInteger::NTT_THRESHOLD + 1, 7 }
+    };
+
+    for (const auto& [la, lb] : limbs)
+    {
+        const Operand a = MakeOperand(random, DigitsForLimbs(la));
+        const Operand b = MakeOperand(random, DigitsForLimbs(lb));
+        ExpectProduct(a, b);
+        ExpectProduct(b, a);
+    }
+}
+
+TEST(BigIntegerMultiply, RandomSizes)
+{
+    std::mt19937_64 random(999);
+    for (int trial = 0; trial < 60; ++trial)
+    {
+        const Operand a = MakeOperand(random, 1 + random() % DigitsForLimbs(4 * BigInteger::TOOM3_THRESHOLD));
+        const Operand b = MakeOperand(random, 1 + random() % DigitsForLimbs(4 * BigInteger::TOOM3_THRESHOLD));
+        ExpectProduct(a, b);
+    }
+}
+
+TEST(BigIntegerMultiply, FactorialAndPowerMatchRepeatedMultiplication)
+{
+    // n! и 7^n — деревом произведений и квадратами; эталон — умножение на малое
+    constexpr std::int64_t N = 3000;
+    BigInteger expected;
+    expected.SetInteger(1);
+    BigInteger factor;
+    for (std::int64_t i = 2; i <= N; ++i)
+    {
+        factor.SetInteger(i);
+        ASSERT_EQ(BigInteger::Multiply(expected, factor, expected), CalcError::None);
+    }
+
+    BigInteger n;
+    n.SetInteger(N);
+    BigInteger factorial;
+    ASSERT_EQ(BigInteger::Factorial(n, factorial), CalcError::None);
+    EXPECT_EQ(factorial.ToString(), expected.ToString());
+
+    BigInteger seven;
+    seven.SetInteger(7);
+    expected.SetInteger(1);
+    for (std::int64_t i = 0; i < 20000; ++i)
+    {
+        ASSERT_EQ(BigInteger::Multiply(expected, seven, expected), CalcError::None);
+    }
+    BigInteger exponent;
+    exponent.SetInteger(20000);
+    BigInteger power;
+    ASSERT_EQ(BigInteger::Power(seven, exponent, power), CalcError::None);
+    EXPECT_EQ(power.ToString(), expected.ToString());
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// ➗ Деление: алгоритм D ↔ Ньютон
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(BigIntegerDivide, AcrossNewtonThreshold)
+{
+    std::mt19937_64 random(9999);
+    const std::pair<std::size_t, std::size_t> limbs[] = {
+        { 3, 1 }, { 50, 49 }, { 500, 120 },
+        { 2 * BigInteger::NEWTON_THRESHOLD - 1, BigInteger::NEWTON_THRESHOLD - 1 },
+        { 2 * BigInteger::NEWTON_THRESHOLD + 1, BigInteger::NEWTON_THRESHOLD + 1 },
+        { 5 * BigInteger::NEWTON_THRESHOLD, BigInteger::NEWTON_THRESHOLD + 7 },
+        { 4 * BigInteger::NEWTON_THRESHOLD, 2 * BigInteger::NEWTON_THRESHOLD }
+    };
+
+    for (const auto& [la, lb] : limbs)
+    {
+        const Operand a = MakeOperand(random, DigitsForLimbs(la));
+        const Operand b = MakeOperand(random, DigitsForLimbs(lb));
+        ExpectQuotient(a.value, b.value);
+    }
+}
+
+TEST(BigIntegerDivide, ExactProductsDivideBack)
+{
+    std::mt19937_64 random(99999);
+    for (const std::size_t lb : { std::size_t(1), BigInteger::NEWTON_THRESHOLD + 3 })
+    {
+        const Operand q = MakeOperand(random, DigitsForLimbs(BigInteger::NEWTON_THRESHOLD + 11));
+        const Operand b = MakeOperand(random, DigitsForLimbs(lb));
+
+        BigInteger a;
+        ASSERT_EQ(BigInteger::Multiply(q.value, b.value, a), CalcError::None);
+        BigInteger quotient;
+        ASSERT_EQ(BigInteger::Divide(a, b.value, quotient), CalcError::None);
+        EXPECT_EQ(quotient.ToString(), q.value.ToString());
+    }
+}
+
+TEST(BigIntegerDivide, TruncatesTowardZero)
+{
+    const std::pair<std::int64_t, std::int64_t> cases[] = { { 7, 2 }, { -7, 2 }, { 7, -2 }, { -7, -2 }, { 1, 3 } };
+    for (const auto& [x, y] : cases)
+    {
+        BigInteger a;
+        BigInteger b;
+        BigInteger q;
+        a.SetInteger(x);
+        b.SetInteger(y);
+        ASSERT_EQ(BigInteger::Divide(a, b, q), CalcError::None);
+        EXPECT_EQ(q.ToString(), std::to_string(x / y)) << x << " / " << y;
+    }
+
+    BigInteger zero;
+    BigInteger one;
+    one.SetInteger(1);
+    BigInteger q;
+    EXPECT_EQ(BigInteger::Divide(one, zero, q), CalcError::DivisionByZero);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🔄 Перевод основания
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(BigIntegerText, ParseAndPrintRoundTrip)
+{
+    std::mt19937_64 random(9);
+    const std::size_t digits[] = { 1, 9, 10, 19, 20, 100, 1000, 10000, 100000 };
+    for (const std::size_t count : digits)
+    {
+        const Operand a = MakeOperand(random, count);
+        EXPECT_EQ(a.value.ToString(), Signed(a.negative, a.digits)) << count << " digits";
+        EXPECT_EQ(a.value.GetDecimalDigitCount(), count);
+        EXPECT_EQ(a.value.LeadingDigits(20), Signed(a.negative, a.digits.substr(0, 20)));
+    }
+}
+
+TEST(BigIntegerText, PowersOfTenKeepTheirZeros)
+{
+    // Границы кусков при переводе по степеням 10^(9·2^k): внутренние нули не теряются
+    for (const std::size_t zeros : { 8, 9, 17, 18, 36, 72, 1151, 1152, 4608 })
+    {
+        const std::string text = "1" + std::string(zeros, '0') + "1";
+        BigInteger value;
+        ASSERT_TRUE(value.Parse(text));
+        EXPECT_EQ(value.ToString(), text);
+    }
+}
+
+} // namespace
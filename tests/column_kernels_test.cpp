@@ -0,0 +1,244 @@
+#include "engine/column_evaluator.h"
+#include "engine/column_kernels.h"
+#include "engine/expression.h"
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <random>
+#include <string_view>
+#include <vector>
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                        🧪 ЯДРА ПОКОЛОНОЧНЫХ ОПЕРАЦИЙ                      ║
+ ║       Границы ULP из column_kernels.h для Scalar, SSE2 и AVX2 против      ║
+ ║       long double; особые значения — как у libm; NaN и ±∞ в итоге строки  ║
+ ║       ColumnEvaluator — ошибка этой строки                                ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+
+namespace
+{
+
+using calc::ColumnKernels;
+using calc::UnaryKernel;
+
+constexpr std::size_t POINTS = 100003;  // Нечётно: хвост мимо векторной ширины тоже проверяется
+
+struct FunctionCase
+{
+    const char* name;
+    UnaryKernel ColumnKernels::* kernel;
+    long double (*reference)(long double);
+    double (*libm)(double);
+    double low;             // 📏 Диапазон аргументов: равномерно или,
+    double high;            //    если low > 0 и high/low > 1000, — по порядку
+    double scalarUlp;       // 🎯 Граница Scalar и SSE2 (функции SSE2 — скалярные)
+    double avx2Ulp;         // 🎯 Граница AVX2
+};
+
+const FunctionCase CASES[] = {
+    { "sqrt",  &ColumnKernels::sqrt,  sqrtl,  std::sqrt,  1e-300, 1e300, 0.5, 0.5 },
+    { "exp",   &ColumnKernels::exp,   expl,   std::exp,   -745.0, 709.0, 0.6, 0.9 },
+    { "exp",   &ColumnKernels::exp,   expl,   std::exp,   -1.0,   1.0,   0.6, 0.9 },
+    { "ln",    &ColumnKernels::ln,    logl,   std::log,   1e-300, 1e300, 0.6, 0.9 },
+    { "ln",    &ColumnKernels::ln,    logl,   std::log,   0.5,    2.0,   0.6, 0.9 },
+    { "log10", &ColumnKernels::log10, log10l, std::log10, 1e-300, 1e300, 2.0, 2.0 },
+    { "sin",   &ColumnKernels::sin,   sinl,   std::sin,   -4.0,   4.0,   0.6, 2.0 },
+    { "sin",   &ColumnKernels::sin,   sinl,   std::sin,   1.0,    1e6,   0.6, 2.0 },
+    { "sin",   &ColumnKernels::sin,   sinl,   std::sin,   1e6,    1e300, 0.6, 2.0 },
+    { "cos",   &ColumnKernels::cos,   cosl,   std::cos,   -4.0,   4.0,   0.6, 2.0 },
+    { "cos",   &ColumnKernels::cos,   cosl,   std::cos,   1.0,    1e6,   0.6, 2.0 },
+    { "cos",   &ColumnKernels::cos,   cosl,   std::cos,   1e6,    1e300, 0.6, 2.0 },
+    { "tan",   &ColumnKernels::tan,   tanl,   std::tan,   -1.5,   1.5,   0.6, 3.0 },
+    { "tan",   &ColumnKernels::tan,   tanl,   std::tan,   1.0,    1e6,   0.6, 3.0 },
+    { "sinh",  &ColumnKernels::sinh,  sinhl,  std::sinh,  -710.0, 710.0, 2.0, 3.0 },
+    { "sinh",  &ColumnKernels::sinh,  sinhl,  std::sinh,  -2.0,   2.0,   2.0, 3.0 },
+    { "cosh",  &ColumnKernels::cosh,  coshl,  std::cosh,  -710.0, 710.0, 2.0, 3.0 },
+    { "cosh",  &ColumnKernels::cosh,  coshl,  std::cosh,  -2.0,   2.0,   2.0, 3.0 },
+    { "tanh",  &ColumnKernels::tanh,  tanhl,  std::tanh,  -20.0,  20.0,  2.5, 3.0 },
+    { "tanh",  &ColumnKernels::tanh,  tanhl,  std::tanh,  -1.0,   1.0,   2.5, 3.0 },
+    { "gamma", &ColumnKernels::gamma, tgammal, std::tgamma, 0.01, 171.0, 6.5, 6.5 }
+};
+
+/// 📏 Ошибка в единицах последнего разряда double около точного значения
+double UlpError(double value, long double exact)
+{
+    const int exponent = std::max(std::ilogb(static_cast<double>(exact)), std::numeric_limits<double>::min_exponent - 1);
+    const long double ulp = std::ldexp(1.0L, exponent - std::numeric_limits<double>::digits + 1);
+    return static_cast<double>(std::fabs(static_cast<long double>(value) - exact) / ulp);
+}
+
+std::vector<double> Arguments(const FunctionCase& function, std::mt19937_64& random)
+{
+    std::vector<double> values(POINTS);
+    const bool logarithmic = function.low > 0.0 && function.high / function.low > 1000.0;
+    std::uniform_real_distribution<double> uniform(logarithmic ? std::log(function.low) : function.low,
+        logarithmic ? std::log(function.high) : function.high);
+    for (double& value : values)
+    {
+        value = logarithmic ? std::exp(uniform(random)) : uniform(random);
+    }
+    return values;
+}
+
+/// 🎯 Все точки диапазона — в пределах границы; сдвиг на один элемент — невыровненный вход
+void ExpectWithinBound(const ColumnKernels& kernels, bool avx2, const char* set)
+{
+    std::mt19937_64 random(19);
+    for (const FunctionCase& function : CASES)
+    {
+        const std::vector<double> in = Arguments(function, random);
+        std::vector<double> out(in.size() + 1);
+        (kernels.*function.kernel)(in.data() + 1, out.data() + 1, in.size() - 1);
+
+        const double bound = avx2 ? function.avx2Ulp : function.scalarUlp;
+        double worst = 0.0;
+        double worstArgument = 0.0;
+        for (std::size_t i = 1; i < in.size(); ++i)
+        {
+            const double error = UlpError(out[i], function.reference(in[i]));
+            if (!(error <= worst))
+            {
+                worst = error;
+                worstArgument = in[i];
+            }
+        }
+        EXPECT_LE(worst, bound) << set << ' ' << function.name << " on [" << function.low << ", "
+            << function.high << "], worst at " << worstArgument;
+    }
+}
+
+/// 🔣 NaN, ±∞, ±0, денормали и границы переполнения — ровно как libm (знак нуля тоже)
+void ExpectSpecialValues(const ColumnKernels& kernels, const char* set)
+{
+    const double infinity = std::numeric_limits<double>::infinity();
+    const std::vector<double> specials = {
+        std::numeric_limits<double>::quiet_NaN(), infinity, -infinity, 0.0, -0.0,
+        std::numeric_limits<double>::denorm_min(), -std::numeric_limits<double>::denorm_min(),
+        std::numeric_limits<double>::min(), std::numeric_limits<double>::max(), -std::numeric_limits<double>::max(),
+        -1.0, 1.0, 709.8, 710.0, -745.2, -746.0, 1e-10, -1e-10
+    };
+
+    for (const FunctionCase& function : CASES)
+    {
+        std::vector<double> out(specials.size());
+        (kernels.*function.kernel)(specials.data(), out.data(), specials.size());
+        for (std::size_t i = 0; i < specials.size(); ++i)
+        {
+            const double expected = function.libm(specials[i]);
+            if (std::isnan(expected) || std::isinf(expected) || expected == 0.0)
+            {
+                EXPECT_TRUE(std::isnan(expected) ? std::isnan(out[i])
+                    : out[i] == expected && std::signbit(out[i]) == std::signbit(expected))
+                    << set << ' ' << function.name << '(' << specials[i] << ") = " << out[i]
+                    << ", libm " << expected;
+            }
+        }
+    }
+}
+
+bool LongDoubleIsWider()
+{
+    return std::numeric_limits<long double>::digits > std::numeric_limits<double>::digits;
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🎯 Точность функций
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(ColumnKernelAccuracy, Scalar)
+{
+    if (!LongDoubleIsWider())
+    {
+        GTEST_SKIP() << "long double is not wider than double";
+    }
+    ExpectWithinBound(*calc::GetScalarKernels(), false, "Scalar");
+}
+
+TEST(ColumnKernelAccuracy, Sse2)
+{
+    if (!LongDoubleIsWider() || !calc::GetSse2Kernels())
+    {
+        GTEST_SKIP() << "SSE2 kernels are not built";
+    }
+    ExpectWithinBound(*calc::GetSse2Kernels(), false, "SSE2");
+}
+
+TEST(ColumnKernelAccuracy, Avx2)
+{
+    if (!LongDoubleIsWider() || calc::ColumnEvaluator::DetectSimdLevel() != calc::SimdLevel::Avx2)
+    {
+        GTEST_SKIP() << "AVX2 kernels are not built or not supported";
+    }
+    ExpectWithinBound(*calc::GetAvx2Kernels(), true, "AVX2");
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🔣 Особые значения
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(ColumnKernelSpecialValues, AllSets)
+{
+    ExpectSpecialValues(*calc::GetScalarKernels(), "Scalar");
+    if (calc::GetSse2Kernels())
+    {
+        ExpectSpecialValues(*calc::GetSse2Kernels(), "SSE2");
+    }
+    if (calc::ColumnEvaluator::DetectSimdLevel() == calc::SimdLevel::Avx2)
+    {
+        ExpectSpecialValues(*calc::GetAvx2Kernels(), "AVX2");
+    }
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🚫 Ошибки строк ColumnEvaluator
+//──────────────────────────────────────────────────────────────────────────────
+
+/// 📊 f(x) по колонке на каждом уровне SIMD: первая ошибка и посчитанные до неё строки
+void ExpectFirstError(std::string_view text, const std::vector<double>& column,
+    calc::CalcError error, std::size_t errorRow)
+{
+    calc::Expression expression;
+    ASSERT_EQ(expression.Compile(text), calc::CalcError::None);
+
+    for (const calc::SimdLevel level : { calc::SimdLevel::Scalar, calc::SimdLevel::Sse2, calc::SimdLevel::Avx2 })
+    {
+        calc::ColumnEvaluator evaluator;
+        evaluator.SetSimdLevel(level);
+        evaluator.Load(expression.GetProgram());
+
+        const double* columns[] = { column.data() };
+        std::vector<double> output(column.size(), std::numeric_limits<double>::quiet_NaN());
+        const calc::ColumnResult result = evaluator.Evaluate(columns, column.size(), output.data());
+        EXPECT_EQ(result.error, error) << text << ' ' << calc::ColumnEvaluator::SimdLevelName(level);
+        EXPECT_EQ(result.errorRow, errorRow) << text << ' ' << calc::ColumnEvaluator::SimdLevelName(level);
+        for (std::size_t row = 0; row < errorRow; ++row)
+        {
+            EXPECT_TRUE(std::isfinite(output[row])) << text << " row " << row;
+        }
+    }
+}
+
+TEST(ColumnEvaluatorErrors, NonFiniteRowsAreErrors)
+{
+    // Ошибка во втором блоке: первый блок целиком отдан
+    std::vector<double> column(calc::ColumnEvaluator::BLOCK_ROWS + 10, 4.0);
+    column[calc::ColumnEvaluator::BLOCK_ROWS + 3] = -1.0;
+    ExpectFirstError("sqrt(x)", column, calc::CalcError::InvalidNumber, calc::ColumnEvaluator::BLOCK_ROWS + 3);
+
+    column[calc::ColumnEvaluator::BLOCK_ROWS + 3] = 0.0;
+    ExpectFirstError("ln(x)", column, calc::CalcError::Overflow, calc::ColumnEvaluator::BLOCK_ROWS + 3);
+    ExpectFirstError("x*1e308*10", column, calc::CalcError::Overflow, 0);
+
+    // Деление на ноль — по-прежнему своей ошибкой, и раньше неё строк с NaN нет
+    column[5] = -1.0;
+    ExpectFirstError("1/x + sqrt(x)", column, calc::CalcError::InvalidNumber, 5);
+    ExpectFirstError("1/x", column, calc::CalcError::DivisionByZero, calc::ColumnEvaluator::BLOCK_ROWS + 3);
+}
+
+} // namespace
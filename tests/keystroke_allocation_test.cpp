@@ -0,0 +1,148 @@
+#include "engine/calculator.h"
+#include "engine/instrumentation.h"
+#include "engine/number_entry.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                          🧪 НАЖАТИЕ КЛАВИШИ БЕЗ КУЧИ                      ║
+ ║       Путь ядра за MainWindow::OnNumber / OnOperator / SetStatusMessage   ║
+ ║       после первого прогона не выделяет память: operator new замещён      ║
+ ║       в этом тесте (CALC_INSTRUMENTATION для цели)                        ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+
+namespace
+{
+
+constexpr std::size_t STATUS_MESSAGE_LENGTH = 128;  // Как MainWindow::STATUS_MESSAGE_LENGTH
+
+/// ⌨️ Окно калькулятора без окна: ввод, дисплей и статус — как в обработчиках MainWindow
+class Keyboard
+{
+public:
+    /// 🔢 OnNumber: цифры в ввод, "Number input: ..." в стековый буфер, показ ввода
+    void Number(std::string_view digits)
+    {
+        char status[STATUS_MESSAGE_LENGTH] = "Number input: ";
+        std::size_t length = std::strlen(status);
+        for (const char digit : digits)
+        {
+            if (m_waitingForOperand)
+            {
+                m_entry.Clear();
+                m_waitingForOperand = false;
+            }
+            m_entry.AppendDigit(digit);
+            if (length + 1 < sizeof(status))
+            {
+                status[length++] = digit;
+            }
+        }
+        status[length] = '\0';
+
+        ShowEntry();
+        m_statusLength = length;
+    }
+
+    /// ➕ OnOperator: операнд и оператор в выражение, текст выражения — в статус
+    void Operator(calc::Operator op)
+    {
+        if (m_waitingForOperand && m_calculator.HasPendingOperator())
+        {
+            m_calculator.SetPendingOperator(op);
+        }
+        else
+        {
+            double value = 0.0;
+            ASSERT_TRUE(m_entry.GetValue(value));
+            m_calculator.SetOperand(value);
+            m_calculator.PushOperator(op);
+        }
+        m_waitingForOperand = true;
+
+        ShowEntry();
+        m_statusLength = m_calculator.GetExpressionText().size();
+    }
+
+    /// ✏️ Правка ввода: точка, порядок, знак порядка, ⌫
+    void Edit()
+    {
+        m_entry.AppendDecimalPoint();
+        m_entry.AppendDigit('5');
+        m_entry.BeginExponent();
+        m_entry.AppendDigit('7');
+        m_entry.ToggleExponentSign();
+        m_entry.Backspace();
+        ShowEntry();
+    }
+
+    void Clear()
+    {
+        m_calculator.Clear();
+        m_entry.Clear();
+        m_waitingForOperand = false;
+    }
+
+    std::size_t GetStatusLength() const { return m_statusLength; }
+
+private:
+    void ShowEntry()
+    {
+        m_displayLength = m_entry.Format(m_display, sizeof(m_display));
+    }
+
+    calc::Calculator m_calculator;
+    calc::NumberEntry m_entry;
+    bool m_waitingForOperand = false;
+    char m_display[calc::NumberEntry::MAX_TEXT_LENGTH] = {};
+    std::size_t m_displayLength = 0;
+    std::size_t m_statusLength = 0;
+};
+
+void Type(Keyboard& keyboard)
+{
+    keyboard.Clear();
+    keyboard.Number("31415926");
+    keyboard.Edit();
+    keyboard.Operator(calc::Operator::Add);
+    keyboard.Operator(calc::Operator::Multiply);
+    keyboard.Number("2718");
+    keyboard.Operator(calc::Operator::Subtract);
+    keyboard.Number("1");
+    keyboard.Operator(calc::Operator::Divide);
+}
+
+TEST(KeystrokeAllocation, CounterSeesAllocations)
+{
+    // Без замещённого operator new проверка ниже прошла бы впустую
+    const std::uint64_t before = calc::GetThreadAllocationCount();
+    const auto probe = std::make_unique<int>(1);
+    EXPECT_GT(calc::GetThreadAllocationCount(), before);
+}
+
+TEST(KeystrokeAllocation, TypingDoesNotAllocate)
+{
+    Keyboard keyboard;
+
+    // Первый прогон заводит ёмкость выражения — дальше она переиспользуется
+    Type(keyboard);
+
+    const std::uint64_t before = calc::GetThreadAllocationCount();
+    for (int round = 0; round < 100; ++round)
+    {
+        Type(keyboard);
+    }
+    const std::uint64_t allocations = calc::GetThreadAllocationCount() - before;
+
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_GT(keyboard.GetStatusLength(), 0u);
+}
+
+} // namespace
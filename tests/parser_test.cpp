@@ -0,0 +1,395 @@
+#include "engine/arena.h"
+#include "engine/calculator.h"
+#include "engine/expression.h"
+#include "engine/job_service.h"
+#include "engine/lexer.h"
+#include "engine/parser.h"
+#include "engine/symbol_table.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <future>
+#include <iterator>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                     🧪 ЛЕКСЕР, ПАРСЕР И ВЫЧИСЛЕНИЕ                        ║
+ ║       Приоритеты и ассоциативность, коды ошибок и их позиции,             ║
+ ║       вставка выражением и колонкой                                       ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+
+namespace
+{
+
+using calc::CalcError;
+using calc::NodeKind;
+using calc::Operator;
+using calc::TokenType;
+
+calc::EvalResult Evaluate(std::string_view text)
+{
+    calc::Calculator calculator;
+    return calculator.EvaluateExpression(text);
+}
+
+struct ParsedText
+{
+    std::vector<calc::Token> tokens;
+    calc::Arena arena;
+    calc::ParseResult result;
+};
+
+void Parse(std::string_view text, ParsedText& parsed)
+{
+    ASSERT_EQ(calc::Lexer::Tokenize(text, parsed.tokens), CalcError::None);
+    calc::Parser parser(parsed.tokens.data(), parsed.tokens.size(), parsed.arena, text);
+    parsed.result = parser.Parse();
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🔤 Лексер
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(Lexer, SplitsNumbersOperatorsAndNames)
+{
+    std::vector<calc::Token> tokens;
+    ASSERT_EQ(calc::Lexer::Tokenize(" 12.5*(rate - 3e2) ", tokens), CalcError::None);
+
+    const TokenType expected[] = {
+        TokenType::Number, TokenType::Operator, TokenType::LeftParen, TokenType::Identifier,
+        TokenType::Operator, TokenType::Number, TokenType::RightParen, TokenType::End
+    };
+    ASSERT_EQ(tokens.size(), std::size(expected));
+    for (std::size_t i = 0; i < tokens.size(); ++i)
+    {
+        EXPECT_EQ(tokens[i].type, expected[i]) << "token " << i;
+    }
+
+    EXPECT_EQ(tokens[0].number, 12.5);
+    EXPECT_EQ(tokens[1].op, Operator::Multiply);
+    EXPECT_EQ(tokens[3].position, 7u);
+    EXPECT_EQ(tokens[3].length, 4u);
+    EXPECT_EQ(tokens[5].number, 300.0);
+}
+
+TEST(Lexer, FunctionNamesAreOperators)
+{
+    std::vector<calc::Token> tokens;
+    ASSERT_EQ(calc::Lexer::Tokenize("sqrt(x)", tokens), CalcError::None);
+    EXPECT_EQ(tokens[0].type, TokenType::Operator);
+    EXPECT_EQ(tokens[0].op, Operator::Sqrt);
+    EXPECT_EQ(tokens[2].type, TokenType::Identifier);
+}
+
+TEST(Lexer, DecimalLiteralsAreCorrectlyRounded)
+{
+    std::vector<calc::Token> tokens;
+    ASSERT_EQ(calc::Lexer::Tokenize("0.1 123456789012345678 1.7976931348623157e308", tokens), CalcError::None);
+    EXPECT_EQ(tokens[0].number, 0.1);
+    EXPECT_EQ(tokens[1].number, 123456789012345678.0);
+    EXPECT_EQ(tokens[2].number, 1.7976931348623157e308);
+}
+
+TEST(Lexer, OutOfRangeLiteralsAreNumbers)
+{
+    // Переполнение — ∞, исчезновение порядка — 0 (или денормаль), как у strtod
+    std::vector<calc::Token> tokens;
+    ASSERT_EQ(calc::Lexer::Tokenize("1e400 1e-400 0.0001e-320 4.9e-324 123e307 0.01e311 1e-99999999999", tokens),
+        CalcError::None);
+    EXPECT_EQ(tokens[0].type, TokenType::Number);
+    EXPECT_TRUE(std::isinf(tokens[0].number));
+    EXPECT_EQ(tokens[1].number, 0.0);
+    EXPECT_EQ(tokens[2].number, 0.0);
+    EXPECT_EQ(tokens[3].number, std::numeric_limits<double>::denorm_min());
+    EXPECT_TRUE(std::isinf(tokens[4].number));
+    EXPECT_TRUE(std::isinf(tokens[5].number));
+    EXPECT_EQ(tokens[6].number, 0.0);
+}
+
+TEST(Lexer, InvalidCharacterReportsPosition)
+{
+    std::vector<calc::Token> tokens;
+    std::size_t position = 0;
+    EXPECT_EQ(calc::Lexer::Tokenize("1 + 2 # 3", tokens, &position), CalcError::SyntaxError);
+    EXPECT_EQ(position, 6u);
+}
+
+TEST(Lexer, SplitAssignment)
+{
+    std::string_view name;
+    std::string_view value;
+    ASSERT_TRUE(calc::Lexer::SplitAssignment(" rate = 0.5 * 2", name, value));
+    EXPECT_EQ(name, "rate");
+    EXPECT_EQ(value, " 0.5 * 2");
+
+    EXPECT_FALSE(calc::Lexer::SplitAssignment("1 + 2", name, value));
+    EXPECT_FALSE(calc::Lexer::SplitAssignment("a b = 2", name, value));
+    EXPECT_FALSE(calc::Lexer::SplitAssignment("2 = 2", name, value));
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🧩 Парсер
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(Parser, PowerIsRightAssociative)
+{
+    ParsedText parsed;
+    Parse("2^3^2", parsed);
+    ASSERT_EQ(parsed.result.error, CalcError::None);
+
+    const calc::Node* root = parsed.result.root;
+    ASSERT_EQ(root->kind, NodeKind::Binary);
+    EXPECT_EQ(root->op, Operator::Power);
+    EXPECT_EQ(root->lhs->kind, NodeKind::Number);
+    ASSERT_EQ(root->rhs->kind, NodeKind::Binary);
+    EXPECT_EQ(root->rhs->op, Operator::Power);
+}
+
+TEST(Parser, UnaryMinusBindsLooserThanPower)
+{
+    ParsedText parsed;
+    Parse("-2^2", parsed);
+    ASSERT_EQ(parsed.result.error, CalcError::None);
+
+    const calc::Node* root = parsed.result.root;
+    ASSERT_EQ(root->kind, NodeKind::Negate);
+    ASSERT_EQ(root->lhs->kind, NodeKind::Binary);
+    EXPECT_EQ(root->lhs->op, Operator::Power);
+}
+
+TEST(Parser, SubtractionIsLeftAssociative)
+{
+    ParsedText parsed;
+    Parse("10-4-3", parsed);
+    ASSERT_EQ(parsed.result.error, CalcError::None);
+
+    const calc::Node* root = parsed.result.root;
+    ASSERT_EQ(root->kind, NodeKind::Binary);
+    EXPECT_EQ(root->op, Operator::Subtract);
+    EXPECT_EQ(root->lhs->kind, NodeKind::Binary);
+    EXPECT_EQ(root->rhs->kind, NodeKind::Number);
+}
+
+TEST(Parser, VariablesReferenceSourceText)
+{
+    ParsedText parsed;
+    Parse("principal * 2", parsed);
+    ASSERT_EQ(parsed.result.error, CalcError::None);
+    ASSERT_EQ(parsed.result.root->lhs->kind, NodeKind::Variable);
+    EXPECT_EQ(parsed.result.root->lhs->name, "principal");
+}
+
+TEST(Parser, NestingLimit)
+{
+    const std::string deep = std::string(calc::Parser::MAX_DEPTH + 1, '(') + "1"
+        + std::string(calc::Parser::MAX_DEPTH + 1, ')');
+    ParsedText parsed;
+    Parse(deep, parsed);
+    EXPECT_EQ(parsed.result.error, CalcError::NestingTooDeep);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🟰 Вычисление
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(Evaluate, Precedence)
+{
+    EXPECT_EQ(Evaluate("2^3^2").value, 512.0);
+    EXPECT_EQ(Evaluate("-2^2").value, -4.0);
+    EXPECT_EQ(Evaluate("(-2)^2").value, 4.0);
+    EXPECT_EQ(Evaluate("2+3*4").value, 14.0);
+    EXPECT_EQ(Evaluate("(2+3)*4").value, 20.0);
+    EXPECT_EQ(Evaluate("10-4-3").value, 3.0);
+    EXPECT_EQ(Evaluate("100/10/5").value, 2.0);
+    EXPECT_EQ(Evaluate("2^-1").value, 0.5);
+    EXPECT_EQ(Evaluate("((2))").value, 2.0);
+}
+
+TEST(Evaluate, UnbalancedParentheses)
+{
+    EXPECT_EQ(Evaluate("(1+2").error, CalcError::UnbalancedParentheses);
+    EXPECT_EQ(Evaluate("1+2)").error, CalcError::UnbalancedParentheses);
+    EXPECT_EQ(Evaluate("((1)").error, CalcError::UnbalancedParentheses);
+}
+
+TEST(Evaluate, DivisionByZero)
+{
+    EXPECT_EQ(Evaluate("1/0").error, CalcError::DivisionByZero);
+    EXPECT_EQ(Evaluate("1/(2-2)").error, CalcError::DivisionByZero);
+}
+
+TEST(Evaluate, NonFiniteResultsAreErrors)
+{
+    // NaN — вне области определения, ±∞ — переполнение; в выражение они не попадают
+    EXPECT_EQ(Evaluate("sqrt(-1)").error, CalcError::InvalidNumber);
+    EXPECT_EQ(Evaluate("gamma(-1)").error, CalcError::InvalidNumber);
+    EXPECT_EQ(Evaluate("(-8)^(1/3)").error, CalcError::InvalidNumber);
+    EXPECT_EQ(Evaluate("ln(0)").error, CalcError::Overflow);
+    EXPECT_EQ(Evaluate("0^-1").error, CalcError::Overflow);
+    EXPECT_EQ(Evaluate("1e308*10").error, CalcError::Overflow);
+    EXPECT_EQ(Evaluate("1/(1e308*10)").value, 0.0);
+
+    calc::Calculator calculator;
+    EXPECT_EQ(calculator.EvaluateExpression("x = sqrt(-1)").error, CalcError::InvalidNumber);
+    EXPECT_EQ(calculator.EvaluateExpression("x").error, CalcError::UnknownVariable);
+}
+
+TEST(Evaluate, OutOfRangeLiterals)
+{
+    EXPECT_EQ(Evaluate("1e400").error, CalcError::Overflow);
+    EXPECT_EQ(Evaluate("1/1e400").error, CalcError::Overflow);
+    EXPECT_EQ(Evaluate("-1e400 + 1").error, CalcError::Overflow);
+    EXPECT_EQ(Evaluate("1e-400").value, 0.0);
+    EXPECT_TRUE(Evaluate("1e-400 + 2").Ok());
+    EXPECT_EQ(Evaluate("1e-400 + 2").value, 2.0);
+
+    // Вставка идёт через DirectEvaluator — тот же ответ
+    calc::Calculator calculator;
+    calc::PasteSummary summary;
+    EXPECT_EQ(calculator.EvaluatePasted("1e400", summary).error, CalcError::Overflow);
+    EXPECT_EQ(calculator.EvaluatePasted("1e-400*3", summary).value, 0.0);
+
+    // Десятичный и целый режимы читают литерал сами
+    calculator.SetNumberMode(calc::NumberMode::Decimal);
+    EXPECT_TRUE(calculator.EvaluateExpression("1e400 / 1e399").Ok());
+    EXPECT_EQ(calculator.EvaluateExpression("1e400 / 1e399").value, 10.0);
+    calculator.SetNumberMode(calc::NumberMode::Integer);
+    EXPECT_TRUE(calculator.EvaluateExpression(std::string(400, '9') + " - " + std::string(399, '9')).Ok());
+}
+
+TEST(Evaluate, UnknownVariable)
+{
+    EXPECT_EQ(Evaluate("x+1").error, CalcError::UnknownVariable);
+}
+
+TEST(Evaluate, ReadingNamesDoesNotFillTheSessionTable)
+{
+    // Имя заводит только присваивание: вставка сотен подписей не съедает слоты
+    calc::Calculator calculator;
+    for (std::size_t i = 0; i < calc::SymbolTable::MAX_SYMBOLS + 44; ++i)
+    {
+        EXPECT_EQ(calculator.EvaluateExpression("label" + std::to_string(i)).error, CalcError::UnknownVariable);
+        EXPECT_EQ(calculator.EvaluateExpression("other" + std::to_string(i) + " = missing").error,
+            CalcError::UnknownVariable);
+    }
+
+    EXPECT_EQ(calculator.EvaluateExpression("y = 7").value, 7.0);
+    EXPECT_EQ(calculator.EvaluateExpression("y * 2").value, 14.0);
+}
+
+TEST(Evaluate, NameResolvesOnceAssigned)
+{
+    calc::Calculator calculator;
+    EXPECT_EQ(calculator.EvaluateExpression("rate * 2").error, CalcError::UnknownVariable);
+    EXPECT_EQ(calculator.EvaluateExpression("rate * 2").error, CalcError::UnknownVariable);
+    EXPECT_EQ(calculator.EvaluateExpression("rate = 0.5").value, 0.5);
+    EXPECT_EQ(calculator.EvaluateExpression("rate * 2").value, 1.0);
+    EXPECT_EQ(calculator.EvaluateExpression("rate = rate + 1").value, 1.5);
+}
+
+TEST(Evaluate, RepeatedInvalidTextDoesNotReuseThePreviousProgram)
+{
+    // Верный текст, затем ошибочный дважды: второй раз — та же ошибка, не прежний ответ
+    calc::Calculator calculator;
+    EXPECT_EQ(calculator.EvaluateExpression("1+2").value, 3.0);
+    EXPECT_EQ(calculator.EvaluateExpression("1+$").error, CalcError::SyntaxError);
+    EXPECT_EQ(calculator.EvaluateExpression("1+$").error, CalcError::SyntaxError);
+
+    EXPECT_EQ(calculator.EvaluateExpression("x = 4").value, 4.0);
+    EXPECT_EQ(calculator.EvaluateExpression("x*2").value, 8.0);
+    EXPECT_EQ(calculator.EvaluateExpression("x*#").error, CalcError::SyntaxError);
+    EXPECT_EQ(calculator.EvaluateExpression("x*#").error, CalcError::SyntaxError);
+    EXPECT_EQ(calculator.EvaluateExpression("x*2").value, 8.0);
+}
+
+TEST(Evaluate, SyntaxErrors)
+{
+    EXPECT_EQ(Evaluate("").error, CalcError::SyntaxError);
+    EXPECT_EQ(Evaluate("2*").error, CalcError::SyntaxError);
+    EXPECT_EQ(Evaluate("2 3").error, CalcError::SyntaxError);
+}
+
+TEST(Evaluate, SyntaxErrorPosition)
+{
+    calc::Expression expression;
+    EXPECT_EQ(expression.Compile("1+*2"), CalcError::SyntaxError);
+    EXPECT_EQ(expression.GetErrorPosition(), 2u);
+}
+
+TEST(Evaluate, CompiledExpressionTakesVariables)
+{
+    calc::Expression expression;
+    ASSERT_EQ(expression.Compile("x * x + 1"), CalcError::None);
+
+    const double three = 3.0;
+    EXPECT_EQ(expression.Evaluate(&three).value, 10.0);
+    const double four = 4.0;
+    EXPECT_EQ(expression.Evaluate(&four).value, 17.0);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 📋 Вставка
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(Paste, ColumnIsSummed)
+{
+    calc::Calculator calculator;
+    calc::PasteSummary summary;
+    const calc::EvalResult result = calculator.EvaluatePasted("1.5\n2\r\n\n  3 \n1/0\n", summary);
+    ASSERT_EQ(result.error, CalcError::None);
+    EXPECT_EQ(result.value, 6.5);
+    EXPECT_EQ(summary.lineCount, 4u);
+    EXPECT_EQ(summary.errorCount, 1u);
+    EXPECT_EQ(summary.firstErrorLine, 5u);
+}
+
+TEST(Paste, ExpressionMaySpanLines)
+{
+    calc::Calculator calculator;
+    calc::PasteSummary summary;
+    EXPECT_EQ(calculator.EvaluatePasted("(1 +\n2) *\n3", summary).value, 9.0);
+    EXPECT_EQ(calculator.EvaluatePasted("10\n-4", summary).value, 6.0);
+    EXPECT_EQ(summary.lineCount, 0u);
+}
+
+TEST(Paste, ColumnWithoutValidLinesReportsTheTextError)
+{
+    calc::Calculator calculator;
+    calc::PasteSummary summary;
+    EXPECT_EQ(calculator.EvaluatePasted("(1\n2)", summary).error, CalcError::UnbalancedParentheses);
+}
+
+TEST(Paste, LongExpressionIsCancellable)
+{
+    std::string chain = "1";
+    for (int i = 0; i < 100000; ++i)
+    {
+        chain += "+\n1";
+    }
+
+    for (const calc::NumberMode mode : { calc::NumberMode::Binary, calc::NumberMode::Decimal, calc::NumberMode::Integer })
+    {
+        calc::Calculator calculator;
+        calculator.SetNumberMode(mode);
+        calc::PasteSummary summary;
+        EXPECT_EQ(calculator.EvaluatePasted(chain, summary).value, 100001.0);
+
+        // Отмена запрошена до начала: первая же проверка в цепочке прерывает разбор
+        calc::JobService jobs;
+        std::promise<calc::EvalResult> done;
+        jobs.Submit([&](calc::JobContext& job)
+        {
+            job.Cancel();
+            done.set_value(calculator.EvaluatePasted(chain, summary));
+        });
+        EXPECT_EQ(done.get_future().get().error, CalcError::Cancelled);
+    }
+}
+
+} // namespace
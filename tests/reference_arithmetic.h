@@ -0,0 +1,178 @@
+#ifndef REFERENCE_ARITHMETIC_H
+#define REFERENCE_ARITHMETIC_H
+
+#include <cstddef>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                      📐 ЭТАЛОННАЯ АРИФМЕТИКА ТЕСТОВ                       ║
+ ║       Школьное умножение и округление над строками цифр — медленно,       ║
+ ║       но без порогов: сверка Карацубы, Тоома-3, NTT и перевода основания  ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+namespace reference
+{
+
+/// 🎲 n случайных цифр без ведущего нуля
+inline std::string RandomDigits(std::mt19937_64& random, std::size_t count)
+{
+    std::string digits(count, '0');
+    for (char& digit : digits)
+    {
+        digit = static_cast<char>('0' + random() % 10);
+    }
+    digits[0] = static_cast<char>('1' + random() % 9);
+    return digits;
+}
+
+/// ✖️ Произведение неотрицательных целых в десятичной записи (основание 10^9 внутри)
+inline std::string Multiply(std::string_view a, std::string_view b)
+{
+    constexpr std::uint64_t BASE = 1000000000;
+
+    const auto toLimbs = [](std::string_view digits)
+    {
+        std::vector<std::uint64_t> limbs;
+        for (std::size_t end = digits.size(); end > 0; end = end > 9 ? end - 9 : 0)
+        {
+            const std::size_t begin = end > 9 ? end - 9 : 0;
+            std::uint64_t limb = 0;
+            for (std::size_t i = begin; i < end; ++i)
+            {
+                limb = limb * 10 + static_cast<std::uint64_t>(digits[i] - '0');
+            }
+            limbs.push_back(limb);
+        }
+        return limbs;
+    };
+
+    const std::vector<std::uint64_t> x = toLimbs(a);
+    const std::vector<std::uint64_t> y = toLimbs(b);
+    std::vector<std::uint64_t> product(x.size() + y.size(), 0);
+    for (std::size_t i = 0; i < x.size(); ++i)
+    {
+        std::uint64_t carry = 0;
+        for (std::size_t j = 0; j < y.size(); ++j)
+        {
+            const std::uint64_t current = product[i + j] + x[i] * y[j] + carry;
+            product[i + j] = current % BASE;
+            carry = current / BASE;
+        }
+        product[i + y.size()] += carry;
+    }
+
+    while (product.size() > 1 && product.back() == 0)
+    {
+        product.pop_back();
+    }
+
+    std::string result = std::to_string(product.back());
+    for (std::size_t i = product.size() - 1; i-- > 0;)
+    {
+        const std::string limb = std::to_string(product[i]);
+        result.append(9 - limb.size(), '0').append(limb);
+    }
+    return result;
+}
+
+/// 🔢 Десятичное число как "цифры" × 10^exponent без ведущих и хвостовых нулей
+struct Decimal
+{
+    bool negative = false;
+    std::string digits;         // "0" у нуля
+    std::int64_t exponent = 0;
+
+    bool operator==(const Decimal& other) const
+    {
+        return negative == other.negative && digits == other.digits && exponent == other.exponent;
+    }
+};
+
+inline Decimal Normalize(bool negative, std::string digits, std::int64_t exponent)
+{
+    const std::size_t first = digits.find_first_not_of('0');
+    if (first == std::string::npos)
+    {
+        return Decimal{ false, "0", 0 };
+    }
+    digits.erase(0, first);
+
+    const std::size_t last = digits.find_last_not_of('0');
+    exponent += static_cast<std::int64_t>(digits.size() - last - 1);
+    digits.erase(last + 1);
+    return Decimal{ negative, digits, exponent };
+}
+
+/// 📥 Разбор записи "[-]цифры[.цифры][e±цифры]" (вывод BigDecimal::ToString)
+inline Decimal ParseDecimal(std::string_view text)
+{
+    bool negative = false;
+    if (!text.empty() && text[0] == '-')
+    {
+        negative = true;
+        text.remove_prefix(1);
+    }
+
+    std::int64_t exponent = 0;
+    const std::size_t e = text.find_first_of("eE");
+    if (e != std::string_view::npos)
+    {
+        exponent = std::stoll(std::string(text.substr(e + 1)));
+        text = text.substr(0, e);
+    }
+
+    std::string digits;
+    const std::size_t point = text.find('.');
+    if (point != std::string_view::npos)
+    {
+        exponent -= static_cast<std::int64_t>(text.size() - point - 1);
+        digits.append(text.substr(0, point)).append(text.substr(point + 1));
+    }
+    else
+    {
+        digits.assign(text);
+    }
+    return Normalize(negative, digits, exponent);
+}
+
+/// 🎯 Округление до precision значащих цифр, половина — к чётному
+inline Decimal Round(Decimal value, std::size_t precision)
+{
+    if (value.digits.size() <= precision)
+    {
+        return value;
+    }
+
+    const std::string rest = value.digits.substr(precision);
+    std::string kept = value.digits.substr(0, precision);
+    value.exponent += static_cast<std::int64_t>(rest.size());
+
+    const bool aboveHalf = rest[0] > '5' || (rest[0] == '5' && rest.find_first_not_of('0', 1) != std::string::npos);
+    const bool half = rest[0] == '5' && !aboveHalf;
+    if (aboveHalf || (half && (kept.back() - '0') % 2 == 1))
+    {
+        std::size_t i = kept.size();
+        while (i > 0 && kept[i - 1] == '9')
+        {
+            kept[--i] = '0';
+        }
+        if (i == 0)
+        {
+            kept.insert(kept.begin(), '1');
+        }
+        else
+        {
+            ++kept[i - 1];
+        }
+    }
+    return Normalize(value.negative, kept, value.exponent);
+}
+
+} // namespace reference
+
+#endif // REFERENCE_ARITHMETIC_H
@@ -0,0 +1,266 @@
+#include "engine/result_cache.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <string>
+#include <utility>
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                          🧪 КЕШ РЕЗУЛЬТАТОВ                               ║
+ ║       Канонический ключ, вытеснение CLOCK по записям и байтам,            ║
+ ║       общий хеш, сохранение и загрузка файла                              ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+
+namespace
+{
+
+using calc::CachedResult;
+using calc::NumberMode;
+using calc::ResultCache;
+
+std::string Key(std::string_view text, NumberMode mode = NumberMode::Binary, std::uint32_t precision = 0)
+{
+    std::string key;
+    EXPECT_TRUE(ResultCache::MakeKey(text, mode, precision, key)) << text;
+    return key;
+}
+
+CachedResult Value(double value, std::string text = std::string())
+{
+    CachedResult result;
+    result.value = value;
+    result.text = std::move(text);
+    return result;
+}
+
+bool Contains(ResultCache& cache, const std::string& key)
+{
+    CachedResult result;
+    return cache.Find(key, result);
+}
+
+std::string ReadFile(const std::string& path)
+{
+    std::string data;
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    char buffer[4096];
+    std::size_t read;
+    while (file && (read = std::fread(buffer, 1, sizeof(buffer), file)) != 0)
+    {
+        data.append(buffer, read);
+    }
+    if (file)
+    {
+        std::fclose(file);
+    }
+    return data;
+}
+
+void WriteFile(const std::string& path, const std::string& data)
+{
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite(data.data(), 1, data.size(), file);
+    std::fclose(file);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🔑 Ключ
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(ResultCacheKey, WhitespaceAndFunctionSpellingDoNotMatter)
+{
+    EXPECT_EQ(Key("1+2*3"), Key("  1 +\t2\n* 3 "));
+    EXPECT_EQ(Key("sqrt(2)"), Key("\xE2\x88\x9A(2)"));
+    EXPECT_EQ(Key("sqrt(2)"), Key("sqrt (2)"));
+
+    EXPECT_NE(Key("1+2"), Key("2+1"));
+    EXPECT_NE(Key("12+3"), Key("1+23"));
+    EXPECT_NE(Key("1.0"), Key("1"));  // В десятичном режиме это разные записи
+}
+
+TEST(ResultCacheKey, NamesAndInvalidTextAreNotCached)
+{
+    std::string key;
+    EXPECT_FALSE(ResultCache::MakeKey("x + 1", NumberMode::Binary, 0, key));
+    EXPECT_FALSE(ResultCache::MakeKey("ans * 2", NumberMode::Integer, 0, key));
+    EXPECT_FALSE(ResultCache::MakeKey("1 $ 2", NumberMode::Binary, 0, key));
+    EXPECT_FALSE(ResultCache::MakeKey(std::string(ResultCache::MAX_KEY_LENGTH, '1'), NumberMode::Binary, 0, key));
+}
+
+TEST(ResultCacheKey, ModeAndPrecisionAreSeparateEntries)
+{
+    const std::string binary = Key("1/3");
+    const std::string decimal34 = Key("1/3", NumberMode::Decimal, 34);
+    const std::string decimal50 = Key("1/3", NumberMode::Decimal, 50);
+    EXPECT_NE(binary, decimal34);
+    EXPECT_NE(decimal34, decimal50);
+
+    ResultCache cache;
+    cache.Insert(binary, Value(1.0 / 3.0));
+    cache.Insert(decimal34, Value(1.0 / 3.0, "0." + std::string(34, '3')));
+    cache.Insert(decimal50, Value(1.0 / 3.0, "0." + std::string(50, '3')));
+
+    CachedResult result;
+    ASSERT_TRUE(cache.Find(decimal34, result));
+    EXPECT_EQ(result.text.size(), 36u);
+    ASSERT_TRUE(cache.Find(decimal50, result));
+    EXPECT_EQ(result.text.size(), 52u);
+    ASSERT_TRUE(cache.Find(binary, result));
+    EXPECT_TRUE(result.text.empty());
+    EXPECT_EQ(cache.GetStats().entries, 3u);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🕐 Вытеснение
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(ResultCacheEviction, ClockSparesReferencedEntries)
+{
+    ResultCache cache(4);
+    for (int i = 0; i < 4; ++i)
+    {
+        cache.Insert("k" + std::to_string(i), Value(i));
+    }
+    EXPECT_TRUE(Contains(cache, "k0"));
+
+    // Стрелка снимает бит с k0 и вытесняет k1, затем k2
+    cache.Insert("k4", Value(4));
+    EXPECT_FALSE(Contains(cache, "k1"));
+    cache.Insert("k5", Value(5));
+    EXPECT_FALSE(Contains(cache, "k2"));
+
+    EXPECT_TRUE(Contains(cache, "k0"));
+    EXPECT_TRUE(Contains(cache, "k3"));
+    EXPECT_TRUE(Contains(cache, "k4"));
+    EXPECT_TRUE(Contains(cache, "k5"));
+
+    const calc::ResultCacheStats stats = cache.GetStats();
+    EXPECT_EQ(stats.entries, 4u);
+    EXPECT_EQ(stats.hits, 5u);
+    EXPECT_EQ(stats.misses, 2u);
+}
+
+TEST(ResultCacheEviction, ByteBudget)
+{
+    // Размер записи с накладными расходами — из статистики
+    std::size_t entryBytes = 0;
+    {
+        ResultCache probe;
+        probe.Insert("k0", Value(0.0, std::string(1000, '7')));
+        entryBytes = probe.GetStats().bytes;
+        ASSERT_GT(entryBytes, 1000u);
+    }
+
+    // Бюджет на четыре с половиной записи: пятая вытесняет одну
+    ResultCache cache(64, 4 * entryBytes + entryBytes / 2);
+    for (int i = 0; i < 5; ++i)
+    {
+        cache.Insert("k" + std::to_string(i), Value(i, std::string(1000, '7')));
+    }
+    EXPECT_EQ(cache.GetStats().entries, 4u);
+    EXPECT_LE(cache.GetStats().bytes, 4 * entryBytes + entryBytes / 2);
+    EXPECT_FALSE(Contains(cache, "k0"));
+    EXPECT_TRUE(Contains(cache, "k4"));
+
+    // Больше четверти бюджета не кешируется и ничего не вытесняет
+    cache.Insert("huge", Value(0.0, std::string(2 * entryBytes, '7')));
+    EXPECT_FALSE(Contains(cache, "huge"));
+    EXPECT_EQ(cache.GetStats().entries, 4u);
+}
+
+TEST(ResultCacheEviction, SharedHashReplacesTheOlderEntry)
+{
+    // Разные ключи с одним 64-битным FNV-1a (найдены ро-методом Полларда, хеш 3ff74e522de530b1):
+    // запись одна, другой ключ — промах
+    const std::string first = "c5bde799c2362419";
+    const std::string second = "a1a9a9bf38687075";
+
+    ResultCache cache;
+    cache.Insert(first, Value(1.0));
+    cache.Insert(second, Value(2.0));
+    EXPECT_EQ(cache.GetStats().entries, 1u);
+    EXPECT_FALSE(Contains(cache, first));
+
+    CachedResult result;
+    ASSERT_TRUE(cache.Find(second, result));
+    EXPECT_EQ(result.value, 2.0);
+
+    cache.Insert(first, Value(3.0));
+    EXPECT_EQ(cache.GetStats().entries, 1u);
+    EXPECT_FALSE(Contains(cache, second));
+    ASSERT_TRUE(cache.Find(first, result));
+    EXPECT_EQ(result.value, 3.0);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 💽 Файл
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(ResultCacheFile, SaveAndLoadRoundTrip)
+{
+    CachedResult integer;
+    integer.value = 1.0e60;
+    ASSERT_TRUE(integer.integer.Parse("-123456789012345678901234567890123456789012345678901234567890"));
+
+    ResultCache cache;
+    cache.Insert(Key("2^0.5"), Value(1.4142135623730951));
+    cache.Insert(Key("1/3", NumberMode::Decimal, 34), Value(1.0 / 3.0, "0." + std::string(34, '3')));
+    cache.Insert(Key("-(10^60)+1", NumberMode::Integer), std::move(integer));
+
+    const std::string path = ::testing::TempDir() + "result_cache_test.bin";
+    ASSERT_TRUE(cache.Save(path));
+
+    ResultCache loaded;
+    ASSERT_TRUE(loaded.Load(path));
+    EXPECT_EQ(loaded.GetStats().entries, 3u);
+
+    CachedResult result;
+    ASSERT_TRUE(loaded.Find(Key("2^0.5"), result));
+    EXPECT_EQ(result.value, 1.4142135623730951);
+    ASSERT_TRUE(loaded.Find(Key("1/3", NumberMode::Decimal, 34), result));
+    EXPECT_EQ(result.text, "0." + std::string(34, '3'));
+    ASSERT_TRUE(loaded.Find(Key("-(10^60)+1", NumberMode::Integer), result));
+    EXPECT_EQ(result.integer.ToString(), "-123456789012345678901234567890123456789012345678901234567890");
+    EXPECT_EQ(result.value, 1.0e60);
+
+    std::remove(path.c_str());
+}
+
+TEST(ResultCacheFile, TruncatedOrForeignFileLeavesTheCacheEmpty)
+{
+    ResultCache cache;
+    cache.Insert(Key("1+1"), Value(2.0));
+    cache.Insert(Key("0.1+0.2", NumberMode::Decimal, 34), Value(0.3, "0.3"));
+
+    const std::string path = ::testing::TempDir() + "result_cache_truncated.bin";
+    ASSERT_TRUE(cache.Save(path));
+    const std::string data = ReadFile(path);
+    ASSERT_GT(data.size(), 12u);
+
+    ResultCache loaded;
+    loaded.Insert(Key("7"), Value(7.0));
+    WriteFile(path, data.substr(0, data.size() - 2));
+    EXPECT_FALSE(loaded.Load(path));
+    EXPECT_EQ(loaded.GetStats().entries, 0u);
+
+    // Чужой магический номер и другая версия
+    std::string foreign = data;
+    foreign[0] ^= 0x55;
+    WriteFile(path, foreign);
+    EXPECT_FALSE(loaded.Load(path));
+
+    std::string newer = data;
+    newer[4] = static_cast<char>(ResultCache::FILE_VERSION + 1);
+    WriteFile(path, newer);
+    EXPECT_FALSE(loaded.Load(path));
+    EXPECT_EQ(loaded.GetStats().entries, 0u);
+
+    std::remove(path.c_str());
+    EXPECT_FALSE(loaded.Load(path));
+}
+
+} // namespace
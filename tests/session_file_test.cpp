@@ -0,0 +1,214 @@
+#include "engine/session_file.h"
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                            🧪 ФАЙЛ СЕАНСА                                 ║
+ ║       Два слота состояния с контрольной суммой, обрезка оборванного       ║
+ ║       блока истории, файл новой версии и занятый файл                     ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+
+namespace
+{
+
+using calc::SessionFile;
+using OpenStatus = calc::SessionFile::OpenStatus;
+
+constexpr std::size_t VERSION_OFFSET = 8;      // 🏷️ За 8 байтами сигнатуры
+constexpr std::size_t SLOT_HEADER_SIZE = SessionFile::SESSION_SLOT_SIZE - SessionFile::SESSION_CAPACITY;
+
+std::string TempPath(const char* name)
+{
+    const std::string path = ::testing::TempDir() + name;
+    std::remove(path.c_str());
+    return path;
+}
+
+std::string ReadFile(const std::string& path)
+{
+    std::string data;
+    std::FILE* file = std::fopen(path.c_str(), "rb");
+    char buffer[65536];
+    std::size_t read;
+    while (file && (read = std::fread(buffer, 1, sizeof(buffer), file)) != 0)
+    {
+        data.append(buffer, read);
+    }
+    if (file)
+    {
+        std::fclose(file);
+    }
+    return data;
+}
+
+void WriteFile(const std::string& path, const std::string& data)
+{
+    std::FILE* file = std::fopen(path.c_str(), "wb");
+    ASSERT_NE(file, nullptr);
+    std::fwrite(data.data(), 1, data.size(), file);
+    std::fclose(file);
+}
+
+/// ✏️ Байт данных слота портится так, как его оставила бы оборванная запись
+void CorruptSlot(const std::string& path, std::size_t slot)
+{
+    std::string data = ReadFile(path);
+    data[SessionFile::SESSION_SLOT_OFFSET + slot * SessionFile::SESSION_SLOT_SIZE + SLOT_HEADER_SIZE] ^= 0x5A;
+    WriteFile(path, data);
+}
+
+/// 📝 Файл с двумя состояниями: "first" в слоте 0, "second" в слоте 1
+std::string WriteTwoStates(const char* name)
+{
+    const std::string path = TempPath(name);
+    SessionFile file;
+    EXPECT_EQ(file.Open(path), OpenStatus::Created);
+    EXPECT_TRUE(file.ReadSession().empty());
+    EXPECT_TRUE(file.WriteSession("first"));
+    EXPECT_TRUE(file.WriteSession("second"));
+    EXPECT_EQ(file.ReadSession(), "second");
+    file.Close();
+    return path;
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🧩 Слоты состояния
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(SessionFileSlots, LatestStateSurvivesReopen)
+{
+    const std::string path = WriteTwoStates("session_latest.bin");
+
+    SessionFile file;
+    ASSERT_EQ(file.Open(path), OpenStatus::Opened);
+    EXPECT_EQ(file.ReadSession(), "second");
+    EXPECT_FALSE(file.WriteSession(std::string(SessionFile::SESSION_CAPACITY + 1, 'x')));
+    EXPECT_EQ(file.ReadSession(), "second");
+    file.Close();
+    std::remove(path.c_str());
+}
+
+TEST(SessionFileSlots, CorruptNewerSlotFallsBackToTheOther)
+{
+    const std::string path = WriteTwoStates("session_newer.bin");
+    CorruptSlot(path, 1);
+
+    SessionFile file;
+    ASSERT_EQ(file.Open(path), OpenStatus::Opened);
+    EXPECT_EQ(file.ReadSession(), "first");
+
+    // Следующая запись идёт в испорченный слот: целый "first" остаётся запасным
+    EXPECT_TRUE(file.WriteSession("third"));
+    file.Close();
+    CorruptSlot(path, 1);
+
+    ASSERT_EQ(file.Open(path), OpenStatus::Opened);
+    EXPECT_EQ(file.ReadSession(), "first");
+    file.Close();
+    std::remove(path.c_str());
+}
+
+TEST(SessionFileSlots, CorruptOlderSlotKeepsTheNewer)
+{
+    const std::string path = WriteTwoStates("session_older.bin");
+    CorruptSlot(path, 0);
+
+    SessionFile file;
+    ASSERT_EQ(file.Open(path), OpenStatus::Opened);
+    EXPECT_EQ(file.ReadSession(), "second");
+    file.Close();
+
+    CorruptSlot(path, 1);
+    ASSERT_EQ(file.Open(path), OpenStatus::Opened);
+    EXPECT_TRUE(file.ReadSession().empty());
+    file.Close();
+    std::remove(path.c_str());
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 📜 Блоки истории
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(SessionFileBlocks, HalfWrittenLastBlockIsDropped)
+{
+    const std::string path = TempPath("session_blocks.bin");
+    {
+        SessionFile file;
+        ASSERT_EQ(file.Open(path), OpenStatus::Created);
+        char* block = file.AppendBlock();
+        ASSERT_NE(block, nullptr);
+        std::memcpy(block, "history", 7);
+        file.MarkBlockDirty(0);
+        ASSERT_NE(file.AppendBlock(), nullptr);
+        EXPECT_TRUE(file.WriteSession("state"));
+    }
+
+    // Рост файла оборвался на середине второго блока
+    const std::string data = ReadFile(path);
+    ASSERT_EQ(data.size(), SessionFile::HEADER_SIZE + 2 * SessionFile::BLOCK_SIZE);
+    WriteFile(path, data.substr(0, SessionFile::HEADER_SIZE + SessionFile::BLOCK_SIZE + SessionFile::BLOCK_SIZE / 2));
+
+    SessionFile file;
+    ASSERT_EQ(file.Open(path), OpenStatus::Opened);
+    ASSERT_EQ(file.GetBlockCount(), 1u);
+    EXPECT_EQ(std::memcmp(file.GetBlock(0), "history", 7), 0);
+    EXPECT_EQ(file.ReadSession(), "state");
+    file.Close();
+
+    EXPECT_EQ(ReadFile(path).size(), SessionFile::HEADER_SIZE + SessionFile::BLOCK_SIZE);
+    std::remove(path.c_str());
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🏷️ Чужие файлы
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(SessionFileOpen, NewerVersionIsLeftUntouched)
+{
+    const std::string path = WriteTwoStates("session_newer_version.bin");
+    std::string data = ReadFile(path);
+    const std::uint32_t newer = SessionFile::VERSION + 1;
+    std::memcpy(&data[VERSION_OFFSET], &newer, sizeof(newer));
+    WriteFile(path, data);
+
+    SessionFile file;
+    EXPECT_EQ(file.Open(path), OpenStatus::Incompatible);
+    EXPECT_FALSE(file.IsOpen());
+    EXPECT_EQ(ReadFile(path), data);
+    std::remove(path.c_str());
+}
+
+TEST(SessionFileOpen, ForeignFileIsReplaced)
+{
+    const std::string path = TempPath("session_foreign.bin");
+    WriteFile(path, std::string(SessionFile::HEADER_SIZE, 'z'));
+
+    SessionFile file;
+    EXPECT_EQ(file.Open(path), OpenStatus::Created);
+    EXPECT_TRUE(file.ReadSession().empty());
+    EXPECT_EQ(file.GetBlockCount(), 0u);
+    file.Close();
+    std::remove(path.c_str());
+}
+
+TEST(SessionFileOpen, SecondOpenIsLocked)
+{
+    const std::string path = TempPath("session_locked.bin");
+
+    SessionFile first;
+    ASSERT_EQ(first.Open(path), OpenStatus::Created);
+    SessionFile second;
+    EXPECT_EQ(second.Open(path), OpenStatus::Locked);
+    first.Close();
+    EXPECT_EQ(second.Open(path), OpenStatus::Opened);
+    second.Close();
+    std::remove(path.c_str());
+}
+
+} // namespace
@@ -0,0 +1,299 @@
+#include "engine/worksheet.h"
+
+#include <gtest/gtest.h>
+
+#include <cstddef>
+#include <string>
+
+/*
+ ╔═══════════════════════════════════════════════════════════════════════════╗
+ ║                            🧪 ЛИСТ ФОРМУЛ                                 ║
+ ║       Грязь и её распространение, связи после вставки и удаления,         ║
+ ║       правка всего текста, сжатие имён, подграфы параллельного пересчёта  ║
+ ╚═══════════════════════════════════════════════════════════════════════════╝
+*/
+
+namespace
+{
+
+using calc::CalcError;
+using calc::Worksheet;
+
+constexpr std::size_t CHAINS = 8;                // 🧩 Независимых цепочек в большом листе
+constexpr std::size_t CHAIN_LENGTH = 80;         // 📏 Строк в цепочке (всего больше PARALLEL_MIN_CELLS)
+
+std::string ChainName(std::size_t chain, std::size_t row)
+{
+    return "k" + std::to_string(chain) + "_" + std::to_string(row);
+}
+
+/// 📋 Цепочки вперемешку по строкам: k{c}_{r} = k{c}_{r-1} + 1, голова — номер цепочки
+std::string ChainText()
+{
+    std::string text;
+    for (std::size_t row = 0; row < CHAIN_LENGTH; ++row)
+    {
+        for (std::size_t chain = 0; chain < CHAINS; ++chain)
+        {
+            text += ChainName(chain, row) + " = ";
+            text += row == 0 ? std::to_string(chain) : ChainName(chain, row - 1) + " + 1";
+            text += '\n';
+        }
+    }
+    return text;
+}
+
+double Value(const Worksheet& sheet, std::size_t line)
+{
+    const calc::EvalResult& result = sheet.GetResult(line);
+    EXPECT_TRUE(result.Ok()) << sheet.GetLine(line);
+    return result.value;
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// ✏️ Грязь и пересчёт
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(WorksheetRecalculate, ChainedDependencies)
+{
+    Worksheet sheet(1);
+    sheet.SetText("a = 1\nb = a + 1\nc = 10\nd = c * 2\ne = b + d\n");
+    EXPECT_EQ(sheet.GetLineCount(), 5u);
+    EXPECT_EQ(sheet.GetName(4), "e");
+
+    const calc::WorksheetStats& stats = sheet.Recalculate();
+    EXPECT_EQ(stats.recomputed, 5u);
+    EXPECT_EQ(stats.components, 1u);
+    EXPECT_EQ(Value(sheet, 4), 22.0);
+}
+
+TEST(WorksheetRecalculate, OnlyDirtyLinesAndDependentsAreRecomputed)
+{
+    Worksheet sheet(1);
+    sheet.SetText("a = 1\nb = a + 1\nc = 10\nd = c * 2\n");
+    EXPECT_EQ(sheet.Recalculate().components, 2u);
+
+    sheet.SetLine(0, "a = 10");
+    EXPECT_TRUE(sheet.HasPendingEdits());
+    const calc::WorksheetStats& stats = sheet.Recalculate();
+    EXPECT_EQ(stats.recomputed, 2u);
+    EXPECT_EQ(stats.components, 1u);
+    EXPECT_EQ(Value(sheet, 1), 11.0);
+    EXPECT_EQ(Value(sheet, 3), 20.0);
+
+    // Тот же текст — не правка
+    sheet.SetLine(2, "c = 10");
+    EXPECT_FALSE(sheet.HasPendingEdits());
+    EXPECT_EQ(sheet.Recalculate().recomputed, 0u);
+}
+
+TEST(WorksheetRecalculate, RedefinedNameIsReadFromTheNearestLineAbove)
+{
+    Worksheet sheet(1);
+    sheet.SetText("x = 1\ny = x * 10\nx = 2\nz = x * 10\n");
+    sheet.Recalculate();
+    EXPECT_EQ(Value(sheet, 1), 10.0);
+    EXPECT_EQ(Value(sheet, 3), 20.0);
+}
+
+TEST(WorksheetRecalculate, ErrorsPassToDependents)
+{
+    Worksheet sheet(1);
+    sheet.SetText("a = 1/0\nb = a + 1\nc = 2 +\nd = c\ne = later\nlater = 1\n\n");
+    sheet.Recalculate();
+    EXPECT_EQ(sheet.GetResult(0).error, CalcError::DivisionByZero);
+    EXPECT_EQ(sheet.GetResult(1).error, CalcError::DivisionByZero);
+    EXPECT_EQ(sheet.GetResult(2).error, CalcError::SyntaxError);
+    EXPECT_EQ(sheet.GetResult(3).error, CalcError::SyntaxError);
+    EXPECT_EQ(sheet.GetResult(4).error, CalcError::UnknownVariable);
+    EXPECT_TRUE(sheet.IsBlank(6));
+    EXPECT_TRUE(sheet.GetResult(6).Ok());
+
+    sheet.SetLine(0, "a = 4");
+    EXPECT_EQ(sheet.Recalculate().recomputed, 2u);
+    EXPECT_EQ(Value(sheet, 1), 5.0);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🔗 Вставка и удаление строк
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(WorksheetLines, RemovedDefinitionRelinksToTheLineAbove)
+{
+    Worksheet sheet(1);
+    sheet.SetText("x = 1\nx = 2\ny = x * 10\n");
+    sheet.Recalculate();
+    EXPECT_EQ(Value(sheet, 2), 20.0);
+
+    sheet.RemoveLine(1);
+    EXPECT_EQ(sheet.Recalculate().recomputed, 1u);
+    EXPECT_EQ(Value(sheet, 1), 10.0);
+
+    sheet.RemoveLine(0);
+    sheet.Recalculate();
+    EXPECT_EQ(sheet.GetResult(0).error, CalcError::UnknownVariable);
+
+    sheet.InsertLine(0, "x = 7");
+    EXPECT_EQ(sheet.Recalculate().recomputed, 2u);
+    EXPECT_EQ(Value(sheet, 1), 70.0);
+}
+
+TEST(WorksheetLines, InsertedDefinitionShadowsTheOneAbove)
+{
+    Worksheet sheet(1);
+    sheet.SetText("x = 1\nunrelated = 3\ny = x + 1\n");
+    sheet.Recalculate();
+
+    sheet.InsertLine(2, "x = 5");
+    EXPECT_EQ(sheet.Recalculate().recomputed, 2u);
+    EXPECT_EQ(Value(sheet, 3), 6.0);
+}
+
+TEST(WorksheetLines, RemovedCellIsNotReusedBeforeRelink)
+{
+    // Новая строка до пересчёта не должна занять ячейку, на которую ещё ссылается y
+    Worksheet sheet(1);
+    sheet.SetText("x = 1\ny = x + 1\n");
+    sheet.Recalculate();
+
+    sheet.RemoveLine(0);
+    sheet.InsertLine(0, "z = 5");
+    sheet.Recalculate();
+    EXPECT_EQ(Value(sheet, 0), 5.0);
+    EXPECT_EQ(sheet.GetResult(1).error, CalcError::UnknownVariable);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 📋 Весь текст
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(WorksheetText, ChangedMiddleLeavesPrefixAndSuffixAlone)
+{
+    Worksheet sheet(1);
+    sheet.SetText("a = 1\nb = a + 1\nc = 10\nd = c * 2\ne = b + d\n");
+    sheet.Recalculate();
+
+    // c и зависящие от неё d, e
+    sheet.SetText("a = 1\nb = a + 1\nc = 100\nd = c * 2\ne = b + d\n");
+    EXPECT_EQ(sheet.Recalculate().recomputed, 3u);
+    EXPECT_EQ(Value(sheet, 4), 202.0);
+
+    // Вставка в середину: новая строка и e, читающая новое b
+    sheet.SetText("a = 1\nb = a + 1\nb = 5\nc = 100\nd = c * 2\ne = b + d\n");
+    EXPECT_EQ(sheet.GetLineCount(), 6u);
+    EXPECT_EQ(sheet.Recalculate().recomputed, 2u);
+    EXPECT_EQ(Value(sheet, 5), 205.0);
+
+    // Удаление из середины: e снова читает b со второй строки
+    sheet.SetText("a = 1\nb = a + 1\nc = 100\nd = c * 2\ne = b + d\n");
+    EXPECT_EQ(sheet.GetLineCount(), 5u);
+    EXPECT_EQ(sheet.Recalculate().recomputed, 1u);
+    EXPECT_EQ(Value(sheet, 4), 202.0);
+}
+
+TEST(WorksheetText, CrLfAndWriteText)
+{
+    Worksheet sheet(1);
+    sheet.SetText("x = 2\r\ny = x ^ 3\r\n");
+    EXPECT_EQ(sheet.GetLine(0), "x = 2");
+    sheet.Recalculate();
+    EXPECT_EQ(Value(sheet, 1), 8.0);
+
+    std::string text;
+    sheet.WriteText(text);
+    EXPECT_EQ(text, "x = 2\ny = x ^ 3\n");
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🗜️ Сжатие таблицы имён
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(WorksheetNames, FullTableIsCompactedToLiveNames)
+{
+    Worksheet sheet(1);
+    sheet.SetText("a = 2\nb = a * 3\n\nc = b + 1\n");
+    sheet.Recalculate();
+
+    // Набор по буквам: каждая правка заводит новое имя, старые больше никто не держит
+    for (std::size_t i = 0; i < Worksheet::MAX_NAMES + 100; ++i)
+    {
+        sheet.SetLine(2, "t" + std::to_string(i) + " = 1");
+    }
+    EXPECT_EQ(sheet.GetName(2), "t" + std::to_string(Worksheet::MAX_NAMES + 99));
+
+    sheet.SetLine(2, "z = c * 2");
+    sheet.Recalculate();
+    EXPECT_EQ(sheet.GetName(0), "a");
+    EXPECT_EQ(sheet.GetName(1), "b");
+    EXPECT_EQ(sheet.GetName(3), "c");
+    EXPECT_EQ(sheet.GetResult(2).error, CalcError::UnknownVariable);
+    EXPECT_EQ(Value(sheet, 3), 7.0);
+
+    sheet.SetLine(0, "a = 3");
+    sheet.Recalculate();
+    EXPECT_EQ(Value(sheet, 3), 10.0);
+}
+
+//──────────────────────────────────────────────────────────────────────────────
+// 🧵 Подграфы и параллельный пересчёт
+//──────────────────────────────────────────────────────────────────────────────
+
+TEST(WorksheetParallel, IndependentChainsAreSplitAcrossThreads)
+{
+    static_assert(CHAINS * CHAIN_LENGTH >= Worksheet::PARALLEL_MIN_CELLS, "the sheet must take the pool path");
+
+    Worksheet sheet(4);
+    sheet.SetText(ChainText());
+
+    const calc::WorksheetStats& stats = sheet.Recalculate();
+    EXPECT_EQ(stats.recomputed, CHAINS * CHAIN_LENGTH);
+    EXPECT_EQ(stats.components, CHAINS);
+    EXPECT_EQ(stats.threads, 4u);
+    for (std::size_t row = 0; row < CHAIN_LENGTH; ++row)
+    {
+        for (std::size_t chain = 0; chain < CHAINS; ++chain)
+        {
+            ASSERT_EQ(Value(sheet, row * CHAINS + chain), static_cast<double>(chain + row));
+        }
+    }
+
+    // Правка одной головы — одна цепочка, без пула
+    sheet.SetLine(3, "k3_0 = 100");
+    EXPECT_EQ(sheet.Recalculate().recomputed, CHAIN_LENGTH);
+    EXPECT_EQ(stats.components, 1u);
+    EXPECT_EQ(stats.threads, 1u);
+    EXPECT_EQ(Value(sheet, (CHAIN_LENGTH - 1) * CHAINS + 3), 100.0 + CHAIN_LENGTH - 1);
+}
+
+TEST(WorksheetParallel, JoinedChainsAreOneComponent)
+{
+    Worksheet sheet(4);
+    std::string text = ChainText();
+    text += "joined = " + ChainName(0, CHAIN_LENGTH - 1) + " + " + ChainName(1, CHAIN_LENGTH - 1) + "\n";
+    sheet.SetText(text);
+
+    const calc::WorksheetStats& stats = sheet.Recalculate();
+    EXPECT_EQ(stats.recomputed, CHAINS * CHAIN_LENGTH + 1);
+    EXPECT_EQ(stats.components, CHAINS - 1);
+    EXPECT_EQ(stats.threads, 4u);
+    EXPECT_EQ(Value(sheet, CHAINS * CHAIN_LENGTH), 2.0 * (CHAIN_LENGTH - 1) + 1.0);
+
+    // Все головы сразу: снова через пул, ответы те же, что у пересчёта в одном потоке
+    for (std::size_t chain = 0; chain < CHAINS; ++chain)
+    {
+        sheet.SetLine(chain, ChainName(chain, 0) + " = " + std::to_string(10 * chain));
+    }
+    EXPECT_EQ(sheet.Recalculate().threads, 4u);
+
+    Worksheet serial(1);
+    std::string written;
+    sheet.WriteText(written);
+    serial.SetText(written);
+    EXPECT_EQ(serial.Recalculate().threads, 1u);
+    for (std::size_t line = 0; line < sheet.GetLineCount(); ++line)
+    {
+        ASSERT_EQ(Value(sheet, line), Value(serial, line)) << sheet.GetLine(line);
+    }
+}
+
+} // namespace